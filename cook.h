@@ -37,6 +37,8 @@ LICENSE:
 
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdarg.h>
+#include <stdint.h>
 
 #ifndef COOKDEF
 #define COOKDEF
@@ -54,6 +56,19 @@ LICENSE:
 #define COOK_FREE(ptr) free(ptr)
 #endif
 
+// Every allocation made by cook goes through these three macros, @tag names
+// the subsystem ("vec", "sb", "fs", ...). With COOK_ALLOC_STATS defined they
+// are routed to the statistics layer, otherwise straight to COOK_ALLOC & co.
+#ifdef COOK_ALLOC_STATS
+#  define COOK__ALLOC(size, tag)        cook_stats_alloc((size), (tag), __FILE__, __LINE__)
+#  define COOK__REALLOC(ptr, size, tag) cook_stats_realloc((ptr), (size), (tag), __FILE__, __LINE__)
+#  define COOK__FREE(ptr)               cook_stats_free(ptr)
+#else
+#  define COOK__ALLOC(size, tag)        COOK_ALLOC(size)
+#  define COOK__REALLOC(ptr, size, tag) COOK_REALLOC(ptr, size)
+#  define COOK__FREE(ptr)               COOK_FREE(ptr)
+#endif
+
 #ifndef COOK_ASSERT
 #include <assert.h>
 #define COOK_ASSERT(x) assert(x)
@@ -71,6 +86,46 @@ LICENSE:
 #define COOK_TEMP_BUFFER_CAP (1024*8)
 #endif
 
+#ifndef COOK_CSV_BUFFER_SIZE
+#define COOK_CSV_BUFFER_SIZE (1024*1024)
+#endif
+
+#ifndef COOK_ARENA_BLOCK_SIZE
+#define COOK_ARENA_BLOCK_SIZE (64*1024)
+#endif
+
+#ifndef COOK_PAGE_SIZE
+#define COOK_PAGE_SIZE 4096
+#endif
+
+#ifndef COOK_HUGE_PAGE_SIZE
+#define COOK_HUGE_PAGE_SIZE (2*1024*1024)
+#endif
+
+#ifndef COOK_CACHELINE
+#define COOK_CACHELINE 64
+#endif
+
+#ifndef COOK_POOL_SLAB_OBJS
+#define COOK_POOL_SLAB_OBJS 256
+#endif
+
+#ifndef COOK_POOL_CACHE_BATCH
+#define COOK_POOL_CACHE_BATCH 32
+#endif
+
+#ifndef COOK_SC_SPAN_SIZE
+#define COOK_SC_SPAN_SIZE (256*1024)
+#endif
+
+#ifndef COOK_THREAD_LOCAL
+#  if defined(_MSC_VER)
+#    define COOK_THREAD_LOCAL __declspec(thread)
+#  else
+#    define COOK_THREAD_LOCAL __thread
+#  endif
+#endif
+
 //====================================================
 //============== MACRO USAGE GUIDELINES ==============
 //====================================================
@@ -163,21 +218,24 @@ LICENSE:
 
 // cook_vec_grow - grow the vector cap
 // @vec: pointer to vector
-#define cook_vec_grow(vec)                                                      \
+#define cook_vec_grow(vec) cook__vec_grow(vec, "vec")
+
+#define cook__vec_grow(vec, tag)                                                \
     do {                                                                        \
         (vec)->cap = (vec)->cap < COOK_INIT_CAP ? COOK_INIT_CAP : 2*(vec)->cap; \
-        (vec)->items = realloc((vec)->items, (vec)->cap*sizeof(*(vec)->items)); \
+        (vec)->items = COOK__REALLOC((vec)->items,                              \
+                (vec)->cap*sizeof(*(vec)->items), tag);                         \
         COOK_ASSERT((vec)->items && "out of memory");                           \
     } while (0)
 
 // cook_vec_free - free the vector
 // @vec: pointer to vector
-#define cook_vec_free(vec)                    \
-    do {                                      \
-        if ((vec)->items) free((vec)->items); \
-        (vec)->items = NULL;                  \
-        (vec)->len = 0;                       \
-        (vec)->cap = 0;                       \
+#define cook_vec_free(vec)                           \
+    do {                                             \
+        if ((vec)->items) COOK__FREE((vec)->items);  \
+        (vec)->items = NULL;                         \
+        (vec)->len = 0;                              \
+        (vec)->cap = 0;                              \
     } while (0)
 
 // cook_vec_push - push an item to vector
@@ -209,6 +267,50 @@ LICENSE:
 // Return: pointer past the last element
 #define cook_vec_end(vec) ((vec)->items + (vec)->len)
 
+// cook_vec_reserve_pages - make room for at least @n items in page-backed memory
+// @vec: pointer to vector
+// @n: number of items
+// @flags: COOK_PAGES_* flags
+//
+// Note: for multi-GB vectors, see 'page memory' below. A vector grown with
+//       the _pages macros must only be grown/freed with the _pages macros
+#define cook_vec_reserve_pages(vec, n, flags)                                  \
+    do {                                                                       \
+        if ((size_t)(n) > (vec)->cap) {                                        \
+            size_t cook__old = (vec)->cap*sizeof(*(vec)->items);               \
+            size_t cook__new = cook_pages_round((n)*sizeof(*(vec)->items),     \
+                                                flags);                        \
+            (vec)->items = cook_pages_realloc((vec)->items, cook__old,         \
+                                              cook__new, flags);               \
+            COOK_ASSERT((vec)->items && "out of memory");                      \
+            (vec)->cap = cook__new/sizeof(*(vec)->items);                      \
+        }                                                                      \
+    } while (0)
+
+// cook_vec_push_pages - push an item to a page-backed vector
+// @vec: pointer to vector
+// @item: element to push
+// @flags: COOK_PAGES_* flags
+#define cook_vec_push_pages(vec, item, flags)                                   \
+    do {                                                                        \
+        if ((vec)->len + 1 > (vec)->cap) {                                      \
+            cook_vec_reserve_pages(vec, (vec)->cap < COOK_INIT_CAP ?            \
+                                   COOK_INIT_CAP : 2*(vec)->cap, flags);        \
+        }                                                                       \
+        (vec)->items[(vec)->len++] = (item);                                    \
+    } while (0)
+
+// cook_vec_free_pages - free a page-backed vector
+// @vec: pointer to vector
+// @flags: COOK_PAGES_* flags used to grow it
+#define cook_vec_free_pages(vec, flags)                                         \
+    do {                                                                        \
+        cook_pages_free((vec)->items, (vec)->cap*sizeof(*(vec)->items), flags); \
+        (vec)->items = NULL;                                                    \
+        (vec)->len = 0;                                                         \
+        (vec)->cap = 0;                                                         \
+    } while (0)
+
 // cook_vec_reset - reset the size of vector to zero
 // @vec: pointer to vector
 //
@@ -293,6 +395,46 @@ LICENSE:
 // Return: @n aligned down to multiple of @k
 #define COOK_ALIGN_DOWN(n, k) ((n)&~((k)-1))
 
+// COOK_IS_POW2 - check if value is a power of two
+// @n: value to check
+//
+// Return: non-zero if @n is a power of two, zero otherwise (also for 0)
+#define COOK_IS_POW2(n) ((n) != 0 && ((n)&((n)-1)) == 0)
+
+// COOK_CACHELINE_ALIGN_UP - align value up to a whole number of cache lines
+// @n: value to align
+//
+// Return: @n aligned up to multiple of COOK_CACHELINE
+#define COOK_CACHELINE_ALIGN_UP(n) COOK_ALIGN_UP(n, COOK_CACHELINE)
+
+// COOK_CACHELINE_PADDED - union type holding @type padded to whole cache lines
+// @type: type of the padded value
+//
+// Note: the value is accessed through the '.value' member, combine it with
+//       COOK_CACHELINE_ALIGNED so that neighbours never share a cache line
+//
+// Example:
+// ```
+//     struct counters {
+//         COOK_CACHELINE_PADDED(long) hits;   // written by thread A
+//         COOK_CACHELINE_PADDED(long) misses; // written by thread B
+//     } COOK_CACHELINE_ALIGNED;
+//
+//     counters.hits.value++;
+// ```
+#define COOK_CACHELINE_PADDED(type)                       \
+    union {                                               \
+        type value;                                       \
+        char pad[COOK_CACHELINE_ALIGN_UP(sizeof(type))];  \
+    }
+
+// COOK_CACHELINE_ALIGNED - attribute aligning a type or variable to a cache line
+#if defined(_MSC_VER)
+#  define COOK_CACHELINE_ALIGNED __declspec(align(COOK_CACHELINE))
+#else
+#  define COOK_CACHELINE_ALIGNED __attribute__((aligned(COOK_CACHELINE)))
+#endif
+
 
 //////////////////////////////////////////////////////
 /////////////////////// string view
@@ -333,6 +475,75 @@ COOKDEF cook_string_view_t cook_sv_from_parts(const char *data, size_t len);
 // Return: true if string views are equal, false otherwise
 COOKDEF bool cook_sv_equal(cook_string_view_t a, cook_string_view_t b);
 
+// cook_sv_equal_nocase - check if two string views are equal ignoring ASCII case
+// @a: first string view
+// @b: second string view
+//
+// Return: true if string views are equal after folding 'A'-'Z' to lowercase
+COOKDEF bool cook_sv_equal_nocase(cook_string_view_t a, cook_string_view_t b);
+
+// cook_sv_compare - three-way lexicographic comparison of two string views
+// @a: first string view
+// @b: second string view
+//
+// Note: bytes compare as unsigned char (same order as memcmp), and a view
+//       sorts before every longer view it is a prefix of
+//
+// Example:
+// ```
+//     qsort(keys, count, sizeof(keys[0]), by_sv); // by_sv wraps cook_sv_compare
+//     cook_sv_compare(cook_sv_from_cstr("app"), cook_sv_from_cstr("apple")); // < 0
+// ```
+//
+// Return: negative if @a < @b, 0 if equal, positive if @a > @b
+COOKDEF int cook_sv_compare(cook_string_view_t a, cook_string_view_t b);
+
+// cook_sv_compare_nocase - cook_sv_compare() ignoring ASCII case
+// @a: first string view
+// @b: second string view
+//
+// Note: 'A'-'Z' fold to lowercase before comparing, other bytes (including
+//       UTF-8) compare as is, the locale is not consulted
+//
+// Return: negative if @a < @b, 0 if equal, positive if @a > @b
+COOKDEF int cook_sv_compare_nocase(cook_string_view_t a, cook_string_view_t b);
+
+// cook_sv_common_prefix - length of the longest common prefix of two views
+// @a: first string view
+// @b: second string view
+//
+// Return: index of the first differing byte, or the length of the shorter view
+COOKDEF size_t cook_sv_common_prefix(cook_string_view_t a, cook_string_view_t b);
+
+// cook_sv_sort - sort string views in place, in cook_sv_compare() order
+// @items: string views to sort
+// @count: number of string views
+//
+// Note: multikey quicksort on 8-byte chunks cached next to each view, so
+//       most steps compare integers instead of chasing pointers; small
+//       ranges finish with insertion sort. Not stable: the order of views
+//       with equal contents is unspecified
+//
+// Example:
+// ```
+//     cook_vec_sort_sv(&lines); // lines.items is a cook_string_view_t *
+// ```
+COOKDEF void cook_sv_sort(cook_string_view_t *items, size_t count);
+
+// cook_sv_sort_parallel - cook_sv_sort() on several threads
+// @items: string views to sort
+// @count: number of string views
+// @threads: number of threads to use, 0 for one per online CPU
+//
+// Note: the top partitioning steps run on the calling thread until the
+//       ranges are small enough to share out, below ~64K views it just
+//       calls cook_sv_sort(). Needs pthreads (-pthread) outside Windows
+COOKDEF void cook_sv_sort_parallel(cook_string_view_t *items, size_t count, size_t threads);
+
+// cook_vec_sort_sv - sort a vector of string views with cook_sv_sort()
+// @vec: pointer to vector of cook_string_view_t
+#define cook_vec_sort_sv(vec) cook_sv_sort((vec)->items, (vec)->len)
+
 // cook_sv_starts_with - check if string view starts with prefix
 // @sv: string view to check
 // @prefix: prefix to look for
@@ -399,6 +610,327 @@ COOKDEF cook_string_view_t cook_sv_rtrim(cook_string_view_t sv);
 // Return: string view with trailing newline(s) removed
 COOKDEF cook_string_view_t cook_sv_chomp(cook_string_view_t sv);
 
+// Searches return a byte index into @sv, or COOK_SV_NPOS if nothing matches.
+// On x86 they run SSE2 kernels, switching to AVX2 at runtime when the cpu
+// has it; elsewhere (or with COOK_NO_SIMD defined) they fall back to memchr
+// and plain loops.
+#define COOK_SV_NPOS ((size_t)-1)
+
+// cook_sv_find_char - find first occurrence of a byte
+// @sv: string view to search
+// @c: byte to find
+//
+// Return: index of the first @c, or COOK_SV_NPOS
+COOKDEF size_t cook_sv_find_char(cook_string_view_t sv, char c);
+
+// cook_sv_rfind_char - find last occurrence of a byte
+// @sv: string view to search
+// @c: byte to find
+//
+// Return: index of the last @c, or COOK_SV_NPOS
+COOKDEF size_t cook_sv_rfind_char(cook_string_view_t sv, char c);
+
+// cook_sv_find_any - find first byte that is in a set
+// @sv: string view to search
+// @set: bytes to look for, in any order
+//
+// Example:
+// ```
+//     size_t i = cook_sv_find_any(line, cook_sv_from_cstr(",;\t"));
+// ```
+//
+// Return: index of the first byte of @sv contained in @set, or COOK_SV_NPOS
+COOKDEF size_t cook_sv_find_any(cook_string_view_t sv, cook_string_view_t set);
+
+// cook_sv_find - find first occurrence of a substring
+// @sv: string view to search
+// @needle: substring to find
+//
+// Note: candidates are filtered by comparing the first and last byte of
+//       @needle at 16/32 positions at once, only those get a full compare
+//
+// Return: index of the first match, 0 for an empty @needle, or COOK_SV_NPOS
+COOKDEF size_t cook_sv_find(cook_string_view_t sv, cook_string_view_t needle);
+
+// cook_sv_count_char - count occurrences of a byte
+// @sv: string view to search
+// @c: byte to count
+//
+// Return: number of bytes equal to @c
+COOKDEF size_t cook_sv_count_char(cook_string_view_t sv, char c);
+
+// A set of bytes, built once and reused by every search that takes it. It
+// keeps a 256-bit membership table for scalar code and two 16-byte nibble
+// tables for the SIMD lookup.
+typedef struct cook_byteset {
+    uint64_t bits[4];
+    unsigned char nibbles[2][16];
+} cook_byteset_t;
+
+// cook_byteset_has - check if a byte is in a byte set
+// @set: pointer to byte set
+// @c: byte to check
+#define cook_byteset_has(set, c) \
+    ((((set)->bits[(unsigned char)(c) >> 6]) >> ((unsigned char)(c) & 63)) & 1)
+
+// cook_byteset_make - build a byte set
+// @bytes: bytes in the set, in any order
+//
+// Example:
+// ```
+//     cook_byteset_t seps = cook_byteset_make(cook_sv_from_cstr(",;|"));
+// ```
+//
+// Return: byte set containing every byte of @bytes
+COOKDEF cook_byteset_t cook_byteset_make(cook_string_view_t bytes);
+
+// cook_sv_find_byteset - find first byte that is in a byte set
+// @sv: string view to search
+// @set: pointer to byte set
+//
+// Return: index of the first byte of @sv contained in @set, or COOK_SV_NPOS
+COOKDEF size_t cook_sv_find_byteset(cook_string_view_t sv, const cook_byteset_t *set);
+
+// The chop functions cut the front field off @sv and advance @sv past it and
+// its delimiter. When no delimiter is left the whole rest is returned and
+// @sv becomes empty. The returned views point into the original buffer.
+//
+// Example:
+// ```
+//     cook_string_view_t rest = cook_sv_from_cstr("GET /index.html HTTP/1.1");
+//     cook_string_view_t method = cook_sv_chop_by_delim(&rest, ' '); // "GET"
+//     cook_string_view_t path = cook_sv_chop_by_delim(&rest, ' ');   // "/index.html"
+// ```
+
+// cook_sv_chop_by_delim - chop the field before a delimiter byte
+// @sv: pointer to string view, advanced past the delimiter
+// @delim: delimiter byte
+//
+// Return: field before the first @delim
+COOKDEF cook_string_view_t cook_sv_chop_by_delim(cook_string_view_t *sv, char delim);
+
+// cook_sv_chop_by_set - chop the field before any byte of a set
+// @sv: pointer to string view, advanced past the delimiter
+// @set: pointer to byte set of delimiters
+//
+// Return: field before the first delimiter
+COOKDEF cook_string_view_t cook_sv_chop_by_set(cook_string_view_t *sv, const cook_byteset_t *set);
+
+// cook_sv_chop_by_space - chop the next whitespace-separated word
+// @sv: pointer to string view, advanced past the word
+//
+// Note: runs of whitespace (space, \t, \n, \v, \f, \r) count as one
+//       separator and never produce empty words
+//
+// Return: next word, or an empty view when only whitespace is left
+COOKDEF cook_string_view_t cook_sv_chop_by_space(cook_string_view_t *sv);
+
+// Split iterator: walks the fields of a buffer separated by any byte of a
+// delimiter set, without allocating. Every delimiter ends a field, so
+// "a,,b," yields "a", "", "b" and "".
+//
+// Example:
+// ```
+//     cook_sv_split_iter_t it = cook_sv_split_iter(line, cook_sv_from_cstr(",;"));
+//     cook_string_view_t field;
+//     while (cook_sv_split_next(&it, &field)) printf(SV_FMT"\n", SV_ARG(field));
+// ```
+typedef struct cook_sv_split_iter {
+    cook_string_view_t rest;
+    cook_byteset_t delims;
+    const char *block; // 64-byte block that @mask describes
+    uint64_t mask;     // delimiters in @block not handed out yet
+    bool done;
+} cook_sv_split_iter_t;
+
+// cook_sv_split_iter - start splitting a string view
+// @sv: string view to split
+// @delims: delimiter bytes
+//
+// Return: iterator positioned before the first field
+COOKDEF cook_sv_split_iter_t cook_sv_split_iter(cook_string_view_t sv, cook_string_view_t delims);
+
+// cook_sv_split_next - get the next field
+// @it: pointer to iterator
+// @field: receives the field
+//
+// Return: true if a field was produced, false when the input is exhausted
+COOKDEF bool cook_sv_split_next(cook_sv_split_iter_t *it, cook_string_view_t *field);
+
+// Line iterator: walks the lines of a buffer, such as a whole file from
+// cook_fs_readfile(), without allocating. Newlines are found a 64-byte block
+// at a time. Lines come without their "\n" or "\r\n", and a final line
+// without a newline is still produced, so "a\r\nb" and "a\nb\n" both
+// yield "a" and "b".
+//
+// Example:
+// ```
+//     cook_sv_line_iter_t it = cook_sv_line_iter(text);
+//     cook_string_view_t line;
+//     while (cook_sv_line_next(&it, &line)) printf(SV_FMT"\n", SV_ARG(line));
+// ```
+typedef struct cook_sv_line_iter {
+    cook_string_view_t rest;
+    const char *block; // 64-byte block that @mask describes
+    uint64_t mask;     // newlines in @block not handed out yet
+} cook_sv_line_iter_t;
+
+// cook_sv_line_iter - start iterating the lines of a string view
+// @sv: text to iterate
+//
+// Return: iterator positioned before the first line
+COOKDEF cook_sv_line_iter_t cook_sv_line_iter(cook_string_view_t sv);
+
+// cook_sv_line_next - get the next line
+// @it: pointer to iterator
+// @line: receives the line, without its line ending
+//
+// Return: true if a line was produced, false when the input is exhausted
+COOKDEF bool cook_sv_line_next(cook_sv_line_iter_t *it, cook_string_view_t *line);
+
+// cook_sv_count_lines - count the lines cook_sv_line_next() would produce
+// @sv: text to count
+//
+// Return: number of "\n", plus one if the text does not end with one
+COOKDEF size_t cook_sv_count_lines(cook_string_view_t sv);
+
+// cook_byteset_from_pred - build a byte set from a <ctype.h> style predicate
+// @pred: predicate such as isspace or ispunct, called for every byte value
+//
+// Return: byte set of the bytes @pred accepts
+COOKDEF cook_byteset_t cook_byteset_from_pred(int (*pred)(int));
+
+// cook_sv_ltrim_set - trim bytes of a set from the left end
+// @sv: string view to trim
+// @set: pointer to byte set of bytes to drop
+//
+// Note: cook_sv_ltrim()/cook_sv_rtrim()/cook_sv_trim()/cook_sv_chomp() are
+//       these with the sets " \t" and "\r\n"
+//
+// Return: left-trimmed string view, {0} if every byte is in @set
+COOKDEF cook_string_view_t cook_sv_ltrim_set(cook_string_view_t sv, const cook_byteset_t *set);
+
+// cook_sv_rtrim_set - trim bytes of a set from the right end
+// @sv: string view to trim
+// @set: pointer to byte set of bytes to drop
+//
+// Return: right-trimmed string view, {0} if every byte is in @set
+COOKDEF cook_string_view_t cook_sv_rtrim_set(cook_string_view_t sv, const cook_byteset_t *set);
+
+// cook_sv_trim_set - trim bytes of a set from both ends
+// @sv: string view to trim
+// @set: pointer to byte set of bytes to drop
+//
+// Example:
+// ```
+//     cook_byteset_t quotes = cook_byteset_make(cook_sv_from_cstr("\"' "));
+//     cook_string_view_t v = cook_sv_trim_set(cook_sv_from_cstr(" 'hi' "), &quotes); // "hi"
+// ```
+//
+// Return: trimmed string view, {0} if every byte is in @set
+COOKDEF cook_string_view_t cook_sv_trim_set(cook_string_view_t sv, const cook_byteset_t *set);
+
+// cook_sv_trim_space - trim all ASCII whitespace (space, \t, \n, \v, \f, \r)
+// @sv: string view to trim
+//
+// Return: trimmed string view, {0} if @sv is all whitespace
+COOKDEF cook_string_view_t cook_sv_trim_space(cook_string_view_t sv);
+
+// cook_sv_is_digits - check if a string view is made of '0'-'9' only
+// @sv: string view to check
+//
+// Return: true if @sv is non-empty and every byte is an ASCII digit
+COOKDEF bool cook_sv_is_digits(cook_string_view_t sv);
+
+// The ASCII transforms write @src.len bytes to @dst, which may be @src.data
+// itself for an in-place update. Bytes >= 0x80 are copied unchanged, so
+// UTF-8 text stays valid.
+
+// cook_ascii_lower - copy bytes with 'A'-'Z' turned into 'a'-'z'
+// @dst: destination buffer of at least @src.len bytes
+// @src: source bytes
+COOKDEF void cook_ascii_lower(char *dst, cook_string_view_t src);
+
+// cook_ascii_upper - copy bytes with 'a'-'z' turned into 'A'-'Z'
+// @dst: destination buffer of at least @src.len bytes
+// @src: source bytes
+COOKDEF void cook_ascii_upper(char *dst, cook_string_view_t src);
+
+// cook_ascii_replace - copy bytes with every @from replaced by @to
+// @dst: destination buffer of at least @src.len bytes
+// @src: source bytes
+// @from: byte to replace
+// @to: replacement byte
+COOKDEF void cook_ascii_replace(char *dst, cook_string_view_t src, char from, char to);
+
+
+//////////////////////////////////////////////////////
+/////////////////////// number parsing
+//////////////////////////////////////////////////////
+
+// The parsers read a number from the front of a string view, which does not
+// need to be NUL-terminated, and never look at the locale. They return the
+// number of bytes consumed, so the rest of the view can be parsed next:
+// ```
+//     cook_string_view_t row = cook_sv_from_cstr("42,3.5e2");
+//     int64_t a;
+//     double b;
+//     size_t n = cook_sv_parse_i64(row, &a);                      // n = 2, a = 42
+//     cook_sv_parse_f64(cook_sv_slice(row, n + 1, row.len), &b);  // b = 350.0
+// ```
+// A return of 0 means there was no number at the front, or (for integers)
+// the value does not fit the type; *@out is left untouched then. Leading
+// whitespace is not skipped.
+
+// cook_sv_parse_u64 - parse an unsigned decimal integer
+// @sv: string view starting with [+]digits
+// @out: receives the value
+//
+// Return: bytes consumed, 0 on no digits or overflow
+COOKDEF size_t cook_sv_parse_u64(cook_string_view_t sv, uint64_t *out);
+COOKDEF size_t cook_sv_parse_u32(cook_string_view_t sv, uint32_t *out);
+COOKDEF size_t cook_sv_parse_u16(cook_string_view_t sv, uint16_t *out);
+COOKDEF size_t cook_sv_parse_u8(cook_string_view_t sv, uint8_t *out);
+
+// cook_sv_parse_i64 - parse a signed decimal integer
+// @sv: string view starting with [+-]digits
+// @out: receives the value
+//
+// Return: bytes consumed, 0 on no digits or overflow
+COOKDEF size_t cook_sv_parse_i64(cook_string_view_t sv, int64_t *out);
+COOKDEF size_t cook_sv_parse_i32(cook_string_view_t sv, int32_t *out);
+COOKDEF size_t cook_sv_parse_i16(cook_string_view_t sv, int16_t *out);
+COOKDEF size_t cook_sv_parse_i8(cook_string_view_t sv, int8_t *out);
+
+// cook_sv_parse_hex - parse a hexadecimal integer
+// @sv: string view starting with [0x|0X]hexdigits
+// @out: receives the value
+//
+// Return: bytes consumed, 0 on no digits or overflow
+COOKDEF size_t cook_sv_parse_hex(cook_string_view_t sv, uint64_t *out);
+
+// cook_sv_parse_f64 - parse a floating-point number, correctly rounded
+// @sv: string view starting with [+-]digits[.digits][(e|E)[+-]digits],
+//      or inf, infinity, nan in any case
+// @out: receives the value
+//
+// Note: values are rounded to nearest-even like strtod: exact small cases use
+//       one double multiply, the rest the Eisel-Lemire 128-bit algorithm.
+//       The rare inputs it cannot decide (more than 19 significant digits
+//       sitting right at a rounding boundary) compare all their digits with
+//       the halfway point as big integers, without allocating.
+//       Out-of-range values give +-inf or +-0 and still count as parsed.
+//
+// Return: bytes consumed, 0 if @sv does not start with a number
+COOKDEF size_t cook_sv_parse_f64(cook_string_view_t sv, double *out);
+
+// cook_sv_parse_f32 - cook_sv_parse_f64() rounded to float directly
+// @sv: string view starting with a number
+// @out: receives the value
+//
+// Return: bytes consumed, 0 if @sv does not start with a number
+COOKDEF size_t cook_sv_parse_f32(cook_string_view_t sv, float *out);
+
 
 //////////////////////////////////////////////////////
 /////////////////////// string builder
@@ -434,6 +966,42 @@ COOKDEF void cook_sb_append_sv(cook_string_builder_t *sb, cook_string_view_t sv)
 // @len: len of data in bytes
 COOKDEF void cook_sb_append_parts(cook_string_builder_t *sb, const void *data, size_t len);
 
+// cook_sb_reserve - make room for more bytes in string builder
+// @sb: string builder pointer
+// @n: bytes about to be appended
+//
+// Note: one reallocation at most, to twice the capacity or to the length
+//       needed if that is more, so a builder that is filled piece by piece
+//       still grows geometrically
+COOKDEF void cook_sb_reserve(cook_string_builder_t *sb, size_t n);
+
+// cook_sb_concat_n - append several string views, growing once
+// @sb: string builder pointer
+// @svs: string views to append
+// @count: number of string views
+COOKDEF void cook_sb_concat_n(cook_string_builder_t *sb, const cook_string_view_t *svs, size_t count);
+
+// cook_sb_concat - append the string views given as arguments, growing once
+// @sb: string builder pointer
+// @...: string views to append
+//
+// Example:
+// ```
+//     cook_sb_concat(&sb, dir, cook_sv_from_cstr("/"), name, cook_sv_from_cstr(".c"));
+// ```
+#define cook_sb_concat(sb, ...)                                                 \
+    cook_sb_concat_n(sb, (const cook_string_view_t[]){__VA_ARGS__},             \
+                     sizeof((cook_string_view_t[]){__VA_ARGS__})/sizeof(cook_string_view_t))
+
+// cook_sb_join - append string views with a separator between them
+// @sb: string builder pointer
+// @svs: string views to append
+// @count: number of string views
+// @sep: separator, not appended before the first or after the last
+//
+// Note: the total length is summed first, the builder grows once
+COOKDEF void cook_sb_join(cook_string_builder_t *sb, const cook_string_view_t *svs, size_t count, cook_string_view_t sep);
+
 // cook_sb_reset - reset string builder to empty state
 // @sb: string builder pointer
 //
@@ -451,60 +1019,563 @@ COOKDEF void cook_sb_free(cook_string_builder_t *sb);
 // Return: string view of builder's current contents
 COOKDEF cook_string_view_t cook_sb_view(const cook_string_builder_t *sb);
 
-// cook_sb_append - append formatted string to string builder
+// cook_sb_to_lower - lower ASCII letters of builder's contents in place
+// @sb: pointer to string builder
+COOKDEF void cook_sb_to_lower(cook_string_builder_t *sb);
+
+// cook_sb_to_upper - upper ASCII letters of builder's contents in place
+// @sb: pointer to string builder
+COOKDEF void cook_sb_to_upper(cook_string_builder_t *sb);
+
+// cook_sb_replace_byte - replace every @from in builder's contents by @to
+// @sb: pointer to string builder
+// @from: byte to replace
+// @to: replacement byte
+COOKDEF void cook_sb_replace_byte(cook_string_builder_t *sb, char from, char to);
+
+// cook_sb_append_u64 - append an unsigned integer in decimal
+// @sb: pointer to string builder
+// @v: value to append
+//
+// Note: the digits are written two at a time from a table, straight into
+//       the builder; the same as "%llu", without parsing a format
+COOKDEF void cook_sb_append_u64(cook_string_builder_t *sb, uint64_t v);
+
+// cook_sb_append_i64 - append a signed integer in decimal
+// @sb: pointer to string builder
+// @v: value to append
+COOKDEF void cook_sb_append_i64(cook_string_builder_t *sb, int64_t v);
+
+// cook_sb_append_u64_padded - append an unsigned integer, right aligned
+// @sb: pointer to string builder
+// @v: value to append
+// @width: minimum number of bytes to append
+// @fill: byte to pad on the left with, '0' or ' ' for "%0*llu" or "%*llu"
+COOKDEF void cook_sb_append_u64_padded(cook_string_builder_t *sb, uint64_t v, size_t width, char fill);
+
+// cook_sb_append_hex - append an unsigned integer in lowercase hex
+// @sb: pointer to string builder
+// @v: value to append
+// @width: minimum number of digits, padded with '0', 0 for no padding
+//
+// Note: no "0x" prefix, the same as "%0*llx"
+COOKDEF void cook_sb_append_hex(cook_string_builder_t *sb, uint64_t v, size_t width);
+
+// cook_sb_append_f64 - append the shortest decimal that reads back as @v
+// @sb: pointer to string builder
+// @v: value to append
+//
+// Note: the digits are the fewest that cook_sv_parse_f64() or strtod() turn
+//       back into @v, the closest to @v if there is a choice (Schubfach).
+//       Notation follows JavaScript: "1.5", "100", "0.001", "1e+21",
+//       "1.5e-7"; then "-0", "inf", "-inf" and "nan"
+//
+// Example:
+// ```
+//     cook_sb_append_f64(&sb, 0.1);     // "0.1", where "%.17g" gives "0.10000000000000001"
+//     cook_sb_append_f64(&sb, 1e100);   // "1e+100"
+// ```
+COOKDEF void cook_sb_append_f64(cook_string_builder_t *sb, double v);
+
+// cook_sb_append_f32 - cook_sb_append_f64() with the shortest digits for
+//                      a float, "0.1" for 0.1f rather than "0.10000000149011612"
+// @sb: pointer to string builder
+// @v: value to append
+COOKDEF void cook_sb_append_f32(cook_string_builder_t *sb, float v);
+
+// cook_sb_appendf - append formatted string to string builder
 // @sb: pointer to string builder
 // @fmt: format string
 // @...: arguments for formatting
 //
-// Note: append formatted string to string builder using temporary memory,
-//       the macro handles memory allocation and copying automatically
+// Note: the text is formatted straight into the builder's spare capacity,
+//       one vsnprintf() call when it fits, and a second after growing the
+//       builder once when it does not; there is no limit on its length.
+//       Arguments must not point into the builder's own buffer, use
+//       cook_sb_append() for that
 //
 // Example:
 // ```
 //     cook_string_builder_t sb = {0};
-//     cook_sb_append(&sb, "value: %d", 42);     // sb contains "value: 42"
-//     cook_sb_append(&sb, ", name: %s", "test"); // sb contains "value: 42, name: test"
-// ```
-#define cook_sb_append(sb, fmt, ...)                             \
-    do {                                                         \
-        size_t checkpoint = cook_temp_save();                    \
-        const char *cstr = cook_temp_strfmt(fmt, ##__VA_ARGS__); \
-        size_t len = strlen(cstr);                               \
-        cook_sb_append_parts(sb, (const void *) cstr, len);      \
-        cook_temp_rewind(checkpoint);                            \
-    } while (0)
+//     cook_sb_appendf(&sb, "value: %d", 42);     // sb contains "value: 42"
+//     cook_sb_appendf(&sb, ", name: %s", "test"); // sb contains "value: 42, name: test"
+// ```
+COOKDEF void cook_sb_appendf(cook_string_builder_t *sb, const char *fmt, ...);
+
+// cook_sb_vappendf - cook_sb_appendf() with a va_list
+COOKDEF void cook_sb_vappendf(cook_string_builder_t *sb, const char *fmt, va_list args);
+
+// cook_sb_append - append formatted string to string builder
+// @sb: pointer to string builder
+// @fmt: format string
+// @...: arguments for formatting, may point into @sb itself
+//
+// Note: the text is formatted into a buffer of its own first, on the stack
+//       or in a scratch arena when it is long, and then copied
+COOKDEF void cook_sb_append(cook_string_builder_t *sb, const char *fmt, ...);
 
 
 //////////////////////////////////////////////////////
-/////////////////////// input/output
+/////////////////////// hashed string view
 //////////////////////////////////////////////////////
 
-typedef struct cook_reader cook_reader_t;
-struct cook_reader {
-    void *ctx;
-    long (*read)(cook_reader_t *r, void *buf, size_t size);
-    void (*close)(cook_reader_t *r);
-    const char *(*error)(cook_reader_t *r);
-};
+// A string view that carries its hash. Hash a key once, where it comes in,
+// and every table or cache it is looked up in after that reuses the hash,
+// and most mismatches are rejected without touching the bytes.
+//
+// Example:
+// ```
+//     cook_hashed_sv_t key = cook_hsv_from_sv(path);
+//     size_t i = key.hash & (cap - 1);
+//     while (slots[i].data && !cook_hsv_equal(slots[i], key)) i = (i + 1) & (cap - 1);
+// ```
 
-typedef struct cook_writer cook_writer_t;
-struct cook_writer {
-    void *ctx;
-    long (*write)(cook_writer_t *w, const void *data, size_t size);
-    int (*flush)(cook_writer_t *w);
-    void (*close)(cook_writer_t *w);
-    const char *(*error)(cook_writer_t *w);
-};
+typedef struct cook_hashed_sv {
+    const char *data;
+    size_t len;
+    uint64_t hash; // cook_sv_hash() of the bytes
+} cook_hashed_sv_t;
 
+// cook_sv_hash - hash the bytes of a string view
+// @sv: bytes to hash
+//
+// Note: all 64 bits are mixed, so the low bits can index a table of a power
+//       of two size; the value differs between byte orders, do not store it
+//
+// Return: 64-bit hash of @sv
+COOKDEF uint64_t cook_sv_hash(cook_string_view_t sv);
 
-//////////////////////////////////////////////////////
-/////////////////////// mini cmd
-//////////////////////////////////////////////////////
+// cook_hsv_from_sv - hash a string view
+// @sv: string view, the bytes are referenced, not copied
+COOKDEF cook_hashed_sv_t cook_hsv_from_sv(cook_string_view_t sv);
 
-typedef cook_string_builder_t cook_cmd_t;
+// cook_hsv_from_sb - hash the contents of a string builder
+// @sb: string builder, its buffer is referenced until it is changed
+COOKDEF cook_hashed_sv_t cook_hsv_from_sb(const cook_string_builder_t *sb);
 
-// cook_cmd_append - append a formated string to cmd
-// @cmd: pointer to cmd
+// cook_hsv_equal - check if two hashed string views have the same bytes
+// @a: first hashed string view
+// @b: second hashed string view
+//
+// Note: the hashes and lengths are compared first, the bytes only when both
+//       agree
+COOKDEF bool cook_hsv_equal(cook_hashed_sv_t a, cook_hashed_sv_t b);
+
+// cook_hsv_view - drop the hash of a hashed string view
+// @hsv: hashed string view
+COOKDEF cook_string_view_t cook_hsv_view(cook_hashed_sv_t hsv);
+
+
+//////////////////////////////////////////////////////
+/////////////////////// UTF-8
+//////////////////////////////////////////////////////
+
+// Valid UTF-8 follows RFC 3629: shortest form only, no surrogates
+// (U+D800-U+DFFF) and nothing above U+10FFFF.
+
+#define COOK_UTF8_REPLACEMENT 0xFFFD
+
+// cook_utf8_validate - find the first invalid UTF-8 sequence
+// @sv: bytes to check
+//
+// Note: vectorized with AVX2 when the CPU has it (three nibble lookup
+//       tables classify every byte pair), all-ASCII blocks are skipped
+//       with a single test
+//
+// Return: @sv.len if @sv is valid UTF-8, else the offset of the first
+//         byte of the first invalid or truncated sequence
+COOKDEF size_t cook_utf8_validate(cook_string_view_t sv);
+
+// cook_utf8_valid - check if a string view is valid UTF-8
+// @sv: bytes to check
+//
+// Return: true if @sv is valid UTF-8
+COOKDEF bool cook_utf8_valid(cook_string_view_t sv);
+
+// cook_utf8_is_ascii - check if a string view is plain 7-bit ASCII
+// @sv: bytes to check
+//
+// Return: true if no byte of @sv is >= 0x80
+COOKDEF bool cook_utf8_is_ascii(cook_string_view_t sv);
+
+// cook_utf8_count - count the codepoints of valid UTF-8
+// @sv: UTF-8 text
+//
+// Note: counts the bytes that do not continue a sequence, on invalid input
+//       this is not the number of cook_utf8_next() steps
+//
+// Return: number of codepoints
+COOKDEF size_t cook_utf8_count(cook_string_view_t sv);
+
+// cook_utf8_next - decode the first codepoint and chop it off
+// @sv: string view to advance
+// @cp: receives the codepoint, COOK_UTF8_REPLACEMENT for an invalid sequence
+//
+// Note: an invalid or truncated sequence consumes one byte
+//
+// Example:
+// ```
+//     cook_string_view_t text = cook_sv_from_cstr("h\xc3\xa9llo");
+//     uint32_t cp;
+//     while (cook_utf8_next(&text, &cp)) printf("U+%04X ", cp); // U+0068 U+00E9 ...
+// ```
+//
+// Return: false if @sv was empty
+COOKDEF bool cook_utf8_next(cook_string_view_t *sv, uint32_t *cp);
+
+// cook_sb_append_utf8 - append a codepoint encoded as UTF-8
+// @sb: pointer to string builder
+// @cp: codepoint
+//
+// Return: false for surrogates and values above U+10FFFF, nothing is appended
+COOKDEF bool cook_sb_append_utf8(cook_string_builder_t *sb, uint32_t cp);
+
+// The transcoders append code units in native byte order: 2 bytes per unit
+// for UTF-16, 4 for UTF-32, so @sb.len grows by a multiple of the unit size.
+// Input is validated first and nothing is appended if it is not UTF-8.
+
+// cook_sb_append_utf16 - append UTF-8 text converted to UTF-16
+// @sb: pointer to string builder
+// @src: UTF-8 text
+//
+// Return: false if @src is not valid UTF-8
+COOKDEF bool cook_sb_append_utf16(cook_string_builder_t *sb, cook_string_view_t src);
+
+// cook_sb_append_utf32 - append UTF-8 text converted to UTF-32
+// @sb: pointer to string builder
+// @src: UTF-8 text
+//
+// Return: false if @src is not valid UTF-8
+COOKDEF bool cook_sb_append_utf32(cook_string_builder_t *sb, cook_string_view_t src);
+
+
+//////////////////////////////////////////////////////
+/////////////////////// multi-pattern matching
+//////////////////////////////////////////////////////
+
+// A matcher is compiled once from a list of patterns and then finds all of
+// them in a single pass: an Aho-Corasick automaton turned into a DFA over
+// byte classes (bytes that occur in no pattern share one column), plus a
+// Teddy prefilter for sets of up to 64 patterns. Teddy looks up the first
+// 1-3 bytes of every position in nibble tables with pshufb, 32 positions
+// per step, and only verifies positions whose fingerprint fits a pattern
+// bucket.
+//
+// Example:
+// ```
+//     cook_string_view_t words[] = {cook_sv_from_cstr("error"), cook_sv_from_cstr("panic")};
+//     cook_matcher_t m;
+//     cook_matcher_init(&m, words, 2);
+//     cook_match_t match;
+//     if (cook_matcher_find(&m, line, &match)) {
+//         printf("pattern %zu at %zu\n", match.pattern, match.offset);
+//     }
+//     cook_matcher_free(&m);
+// ```
+
+typedef struct cook_match {
+    size_t pattern; // index into the pattern list given to cook_matcher_init()
+    size_t offset;  // offset of the first byte of the match
+} cook_match_t;
+
+// cook_match_fn - called for every match, return false to stop the scan
+typedef bool (*cook_match_fn)(cook_match_t match, void *user);
+
+typedef struct cook_matcher {
+    // DFA: entry [state + class] is the next state, premultiplied by
+    // class_count, states that end a pattern are numbered last
+    uint32_t *delta;
+    uint32_t match_start;
+    unsigned char classes[256];
+    size_t class_count;
+    size_t state_count;
+    uint32_t *state_pattern; // per state, a pattern ending there or UINT32_MAX
+    uint32_t *dict_link;     // per state, closest suffix state with a pattern
+    uint32_t *min_pattern;   // per state, lowest pattern ending there or at a suffix
+    uint32_t *same_pattern;  // per pattern, next pattern with the same bytes
+    cook_string_view_t *patterns; // copies, in one allocation with their bytes
+    size_t count;
+    // Teddy prefilter, if count <= 64
+    bool teddy;
+    size_t teddy_len;
+    unsigned char teddy_lo[3][16];
+    unsigned char teddy_hi[3][16];
+    uint32_t teddy_order[64];
+    size_t teddy_bucket[9];
+} cook_matcher_t;
+
+// a stream starts zero-initialized
+typedef struct cook_match_stream {
+    uint32_t state;
+    size_t offset; // bytes fed so far
+} cook_match_stream_t;
+
+// cook_matcher_init - compile a matcher for a list of patterns
+// @m: matcher to initialize
+// @patterns: patterns to look for, copied, duplicates are allowed
+// @count: number of patterns
+//
+// Return: false if there are no patterns, one of them is empty or the
+//         automaton would be too large, @m is left empty then
+COOKDEF bool cook_matcher_init(cook_matcher_t *m, const cook_string_view_t *patterns, size_t count);
+
+// cook_matcher_free - free a matcher
+// @m: matcher to free
+COOKDEF void cook_matcher_free(cook_matcher_t *m);
+
+// cook_matcher_find - find the first match in a text
+// @m: compiled matcher
+// @text: text to search
+// @match: receives the match that ends first, the lowest pattern index
+//         among matches ending at the same byte
+//
+// Return: true if any pattern occurs in @text
+COOKDEF bool cook_matcher_find(const cook_matcher_t *m, cook_string_view_t text, cook_match_t *match);
+
+// cook_matcher_feed - scan the next chunk of a stream and report all matches
+// @m: compiled matcher
+// @stream: stream state, zero-initialized before the first chunk
+// @chunk: next bytes of the stream
+// @fn: called for every match in order of end offset, offsets count from
+//      the start of the stream, so a match may begin in an earlier chunk
+// @user: passed to @fn
+//
+// Return: bytes of @chunk consumed, less than @chunk.len if @fn stopped the
+//         scan (the stream then continues right after the reported match)
+COOKDEF size_t cook_matcher_feed(const cook_matcher_t *m, cook_match_stream_t *stream,
+                                 cook_string_view_t chunk, cook_match_fn fn, void *user);
+
+
+//////////////////////////////////////////////////////
+/////////////////////// glob
+//////////////////////////////////////////////////////
+
+// A glob is compiled once from one or more patterns into a DFA over byte
+// classes and then matches a name with one table lookup per byte, however
+// many stars the patterns have. Several patterns compile into one DFA, so a
+// set of extensions costs the same per name as a single one.
+//
+// Syntax:
+//     *       any run of bytes except '/'
+//     **      any run of bytes, '/' included; "**/" at the start of a path
+//             component also matches no directory at all
+//     ?       one byte except '/'
+//     [a-z]   one byte of the set, "[!...]" or "[^...]" for the complement,
+//             never '/'
+//     {a,b}   one of the comma separated alternatives, which may nest and
+//             hold wildcards themselves
+//     \c      the byte c itself
+//
+// The whole name must match, so "*.c" matches "main.c" but not
+// "src/main.c"; "**/*.c" matches both.
+//
+// Example:
+// ```
+//     cook_string_view_t sources[] = {cook_sv_from_cstr("*.{c,h}"), cook_sv_from_cstr("Makefile")};
+//     cook_glob_t glob;
+//     cook_glob_init(&glob, sources, 2);
+//     cook_dir_t *dir = cook_fs_opendir(".");
+//     const char *name;
+//     while ((name = cook_fs_readdir(dir)) != NULL) {
+//         if (cook_glob_match(&glob, cook_sv_from_cstr(name), NULL)) printf("%s\n", name);
+//     }
+//     cook_fs_closedir(dir);
+//     cook_glob_free(&glob);
+// ```
+
+typedef struct cook_glob {
+    // entry [state + class] is the next state, premultiplied by
+    // class_count, state 0 matches nothing and never leaves
+    uint32_t *delta;
+    uint32_t *accept; // per state, lowest pattern matching there or UINT32_MAX
+    uint32_t start;
+    uint32_t match_start; // states from here on accept, they are numbered last
+    unsigned char classes[256];
+    size_t class_count;
+    size_t state_count;
+    size_t count;
+} cook_glob_t;
+
+// cook_glob_init - compile a glob from a list of patterns
+// @glob: glob to initialize
+// @patterns: patterns, see the syntax above, not referenced afterwards
+// @count: number of patterns
+//
+// Return: false if there are no patterns, one of them has an unclosed '['
+//         or '{' or a trailing '\', or the DFA would be too large; @glob is
+//         left empty then
+COOKDEF bool cook_glob_init(cook_glob_t *glob, const cook_string_view_t *patterns, size_t count);
+
+// cook_glob_free - free a glob
+// @glob: glob to free
+COOKDEF void cook_glob_free(cook_glob_t *glob);
+
+// cook_glob_match - check if a name matches any pattern of a glob
+// @glob: compiled glob
+// @name: name or path to match
+// @pattern: receives the index of the lowest matching pattern, may be NULL
+//
+// Return: true if @name matches
+COOKDEF bool cook_glob_match(const cook_glob_t *glob, cook_string_view_t name, size_t *pattern);
+
+// cook_glob_filter - keep the names that match a glob
+// @glob: compiled glob
+// @names: names to filter, the matching ones are moved to the front in
+//         their original order
+// @count: number of names
+//
+// Example:
+// ```
+//     // the C sources among the entries of a directory
+//     size_t n = cook_glob_filter(&sources, names, count);
+// ```
+//
+// Return: number of matching names
+COOKDEF size_t cook_glob_filter(const cook_glob_t *glob, cook_string_view_t *names, size_t count);
+
+
+//////////////////////////////////////////////////////
+/////////////////////// input/output
+//////////////////////////////////////////////////////
+
+typedef struct cook_reader cook_reader_t;
+struct cook_reader {
+    void *ctx;
+    long (*read)(cook_reader_t *r, void *buf, size_t size);
+    void (*close)(cook_reader_t *r);
+    const char *(*error)(cook_reader_t *r);
+};
+
+typedef struct cook_writer cook_writer_t;
+struct cook_writer {
+    void *ctx;
+    long (*write)(cook_writer_t *w, const void *data, size_t size);
+    int (*flush)(cook_writer_t *w);
+    void (*close)(cook_writer_t *w);
+    const char *(*error)(cook_writer_t *w);
+};
+
+
+//////////////////////////////////////////////////////
+/////////////////////// CSV
+//////////////////////////////////////////////////////
+
+// A zero-copy CSV/TSV reader: records come as arrays of string views into
+// the input. Quotes, delimiters and newlines are found 64 bytes at a time;
+// a prefix xor over the quote bits marks what is inside quotes, so
+// delimiters and newlines there are skipped without a byte loop. A field
+// that starts with a quote is quoted, the view then excludes the quotes and
+// any "" inside is only resolved when cook_csv_unescape() asks for it.
+// Lines may end in "\n" or "\r\n".
+//
+// Example:
+// ```
+//     cook_csv_t csv = cook_csv_from_sv(text, ',');
+//     cook_csv_record_t record = {0};
+//     cook_string_builder_t sb = {0};
+//     while (cook_csv_next(&csv, &record)) {
+//         cook_sb_reset(&sb);
+//         cook_string_view_t name = cook_csv_unescape(record.items[0], &sb);
+//         printf(SV_FMT" has %zu fields\n", SV_ARG(name), record.len);
+//     }
+//     cook_vec_free(&record);
+// ```
+
+typedef struct cook_csv_field {
+    cook_string_view_t sv; // field without its surrounding quotes
+    bool escaped;          // @sv still holds "" pairs
+} cook_csv_field_t;
+
+typedef struct cook_csv_record {
+    cook_csv_field_t *items;
+    size_t len;
+    size_t cap;
+} cook_csv_record_t;
+
+typedef struct cook_csv {
+    cook_string_view_t rest; // input from the start of the next record
+    const char *block;       // 64-byte block that @mask describes
+    uint64_t mask;           // field ends in @block not handed out yet
+    uint64_t inside;         // all ones if @block ends inside quotes
+    char delim;
+    // reading from a cook_reader_t
+    cook_reader_t *reader;
+    char *buf;
+    size_t cap;
+    bool eof;
+} cook_csv_t;
+
+// cook_csv_from_sv - read CSV from a buffer that holds all of it
+// @text: the whole input
+// @delim: field delimiter, ',' for CSV or '\t' for TSV
+//
+// Return: reader positioned before the first record
+COOKDEF cook_csv_t cook_csv_from_sv(cook_string_view_t text, char delim);
+
+// cook_csv_from_reader - read CSV incrementally from a cook_reader_t
+// @reader: source, read in chunks of up to COOK_CSV_BUFFER_SIZE bytes
+// @delim: field delimiter
+//
+// Note: a read error ends the input like the end of file does, ask
+//       @reader for its error afterwards
+//
+// Return: reader positioned before the first record, free it with
+//         cook_csv_free()
+COOKDEF cook_csv_t cook_csv_from_reader(cook_reader_t *reader, char delim);
+
+// cook_csv_free - free the buffer of a reader made by cook_csv_from_reader()
+// @csv: pointer to CSV reader
+COOKDEF void cook_csv_free(cook_csv_t *csv);
+
+// cook_csv_next - get the next record
+// @csv: pointer to CSV reader
+// @record: receives the fields, its storage is reused from call to call
+//
+// Note: an empty line is a record with one empty field; with a
+//       cook_reader_t the fields point into the read buffer and are only
+//       valid until the next call
+//
+// Return: true if a record was produced, false at the end of the input
+COOKDEF bool cook_csv_next(cook_csv_t *csv, cook_csv_record_t *record);
+
+// cook_csv_unescape - get the value of a field
+// @field: field from a record
+// @sb: receives the value if @field has "" pairs to undo
+//
+// Return: @field.sv if it has no escapes, otherwise a view of the value
+//         appended to @sb, valid until @sb grows again
+COOKDEF cook_string_view_t cook_csv_unescape(cook_csv_field_t field, cook_string_builder_t *sb);
+
+// cook_csv_fn - called for every record of cook_csv_parse_parallel()
+// @record: the record, only valid during the call
+// @chunk: index of the chunk the record is in, chunks are in input order
+//         and each one is parsed by a single thread, front to back
+typedef void (*cook_csv_fn)(const cook_csv_record_t *record, size_t chunk, void *user);
+
+// cook_csv_parse_parallel - parse a buffer with several threads
+// @text: the whole input
+// @delim: field delimiter
+// @threads: number of threads, 0 for one per processor, at most 64
+// @fn: called for every record, from several threads at once
+// @user: passed to @fn
+//
+// Note: the input is cut into one chunk per thread at record boundaries.
+//       The quotes of every chunk are counted first, in parallel, so the
+//       cut points know whether they are inside a quoted field.
+//
+// Return: number of chunks, @chunk is below it
+COOKDEF size_t cook_csv_parse_parallel(cook_string_view_t text, char delim, size_t threads,
+                                       cook_csv_fn fn, void *user);
+
+
+//////////////////////////////////////////////////////
+/////////////////////// mini cmd
+//////////////////////////////////////////////////////
+
+typedef cook_string_builder_t cook_cmd_t;
+
+// cook_cmd_append - append a formated string to cmd
+// @cmd: pointer to cmd
 // @fmt: string format
 // @...: variable parameters
 #define cook_cmd_append(cmd, fmt, ...)           \
@@ -602,6 +1673,21 @@ COOKDEF bool cook_expect_str_eq(const char *s1, const char *s2);
 // Return: pointer to allocated memory, or NULL if allocation failed
 COOKDEF void *cook_temp_alloc(size_t size);
 
+// cook_temp_alloc_aligned - allocate aligned temporary memory
+// @size: size in bytes to allocate
+// @align: alignment in bytes, power of two up to COOK_PAGE_SIZE
+//
+// Note: the padding in front of the block belongs to the allocation, so
+//       cook_temp_save()/cook_temp_rewind() around it stay exact
+//
+// Example:
+// ```
+//     float *v = cook_temp_alloc_aligned(256*sizeof(float), 32); // for AVX loads
+// ```
+//
+// Return: pointer to allocated memory, or NULL if allocation failed
+COOKDEF void *cook_temp_alloc_aligned(size_t size, size_t align);
+
 // cook_temp_strdup - duplicate C string to temporary memory
 // @cstr: null-terminated C string to duplicate
 //
@@ -738,650 +1824,8908 @@ COOKDEF const char *cook_temp_path_basename(const char *path);
 
 
 //////////////////////////////////////////////////////
-/////////////////////// file system
-/////////////////////// (steal from https://github.com/lunarmodules/luafilesystem.git)
+/////////////////////// page memory
 //////////////////////////////////////////////////////
 
-typedef struct cook_dir_t cook_dir_t;
-typedef struct {
-    unsigned int mode;
-    long long ino;
-    long long size;
-    long long atime;
-    long long mtime;
-    long long ctime;
-} cook_attr_t;
+// Large buffers (multi-GB arenas and vectors) are better mapped directly from
+// the kernel: they can use huge pages (fewer TLB misses), be pre-faulted in
+// one go, and give physical memory back without unmapping.
+//
+// On Linux this needs mmap/madvise, so compile with _GNU_SOURCE (or
+// _DEFAULT_SOURCE) defined before the first include. Everywhere else, or when
+// a feature is missing, the flags degrade silently and the heap is used.
+
+#define COOK_PAGES_MMAP      (1u<<0) // map pages directly (implied by the others)
+#define COOK_PAGES_HUGE      (1u<<1) // transparent huge pages (MADV_HUGEPAGE)
+#define COOK_PAGES_HUGETLB   (1u<<2) // explicit huge pages (MAP_HUGETLB), falls back to HUGE
+#define COOK_PAGES_POPULATE  (1u<<3) // pre-fault all pages when mapping (MAP_POPULATE)
+#define COOK_PAGES_RELEASE   (1u<<4) // arenas return rewound pages (MADV_DONTNEED)
+#define COOK_PAGES_LAZY_FREE (1u<<5) // like RELEASE, but with MADV_FREE
+
+// cook_pages_round - round size up to what a mapping with @flags really takes
+// @size: size in bytes
+// @flags: COOK_PAGES_* flags
+//
+// Return: @size rounded to COOK_PAGE_SIZE, or to COOK_HUGE_PAGE_SIZE with huge pages
+COOKDEF size_t cook_pages_round(size_t size, unsigned int flags);
 
-// cook_fs_readfile - read the entire file
-// @path: file path
-// Return: buffer in heap, filled with file content
-COOKDEF char *cook_fs_readfile(const char *path);
+// cook_pages_alloc - map zero-filled pages
+// @size: size in bytes
+// @flags: COOK_PAGES_* flags
+//
+// Return: page aligned memory (huge page aligned with huge pages), or NULL on error
+COOKDEF void *cook_pages_alloc(size_t size, unsigned int flags);
+
+// cook_pages_realloc - resize a mapping, moving it if needed
+// @ptr: memory from cook_pages_alloc(), or NULL
+// @old_size: size passed when it was allocated
+// @new_size: new size in bytes
+// @flags: same flags as for the allocation
+//
+// Return: pointer to resized memory, or NULL on error (@ptr stays valid);
+//         huge page aligned with huge pages, like cook_pages_alloc()
+COOKDEF void *cook_pages_realloc(void *ptr, size_t old_size, size_t new_size, unsigned int flags);
+
+// cook_pages_free - unmap pages
+// @ptr: memory from cook_pages_alloc(), NULL is ignored
+// @size: size passed when it was allocated
+// @flags: same flags as for the allocation
+COOKDEF void cook_pages_free(void *ptr, size_t size, unsigned int flags);
+
+// cook_pages_release - give the physical pages of a range back to the OS
+// @ptr: start of the range
+// @size: size of the range in bytes
+// @flags: COOK_PAGES_LAZY_FREE selects MADV_FREE, otherwise MADV_DONTNEED
+//
+// Note: only whole pages inside the range are released, the mapping stays
+//       valid and reads back zeros (or the old data with MADV_FREE until the
+//       kernel reclaims it)
+COOKDEF void cook_pages_release(void *ptr, size_t size, unsigned int flags);
 
-// cook_fs_cwd - get the current work directory
-// Return: string in heap, contains the absolute path
-COOKDEF char *cook_fs_cwd(void);
 
-// cook_fs_mkdir - create a directory
-// @path: directory path
-// Note: it will fail if the directory has been existed
-// Return: true if successfully created, false otherwise
-COOKDEF bool cook_fs_mkdir(const char *path);
+//////////////////////////////////////////////////////
+/////////////////////// arena allocator
+//////////////////////////////////////////////////////
 
-// cook_fs_rmdir - remove a empty directory
-// @path: directory path
-// Note: it will fail if the directory does not exist or has other files
-// Return: true if successfully removed, false otherwise
-COOKDEF bool cook_fs_rmdir(const char *path);
+// An arena is a growable version of the temporary allocator: memory comes
+// from a chain of blocks, allocations are pointer bumps, and everything is
+// released at once with cook_arena_rewind()/cook_arena_reset()/cook_arena_free().
+// Blocks are kept after a rewind and reused by later allocations.
+//
+// A zero-initialized arena is ready to use, set @block_size before the first
+// allocation to change the minimum block size (default COOK_ARENA_BLOCK_SIZE).
+// Set @page_flags (COOK_PAGES_*) to map blocks directly, e.g. for a multi-GB
+// arena on huge pages that returns rewound memory to the OS:
+// ```
+//     cook_arena_t big = {
+//         .block_size = 1ull << 30,
+//         .page_flags = COOK_PAGES_HUGE | COOK_PAGES_RELEASE
+//     };
+// ```
+//
+// Example:
+// ```
+//     cook_arena_t arena = {0};
+//     cook_arena_mark_t mark = cook_arena_save(&arena);
+//     char *buf = cook_arena_alloc(&arena, 1024);
+//     cook_arena_rewind(&arena, mark); // buf is freed
+//     cook_arena_free(&arena);
+// ```
 
-// cook_fs_chdir - change work directory
-// @path: destinated directory path
-// Return: true if successfully changed, false otherwise
-COOKDEF bool cook_fs_chdir(const char *path);
+typedef struct cook_arena_block cook_arena_block_t;
+typedef struct cook_arena {
+    cook_arena_block_t *begin;
+    cook_arena_block_t *end;
+    size_t block_size;
+    unsigned int page_flags;
+} cook_arena_t;
+
+typedef struct cook_arena_mark {
+    cook_arena_block_t *block;
+    size_t used;
+} cook_arena_mark_t;
+
+// cook_arena_alloc - allocate memory from arena
+// @arena: pointer to arena
+// @size: size in bytes to allocate
+//
+// Return: pointer aligned to sizeof(void*), or NULL if @size is 0
+COOKDEF void *cook_arena_alloc(cook_arena_t *arena, size_t size);
 
-// cook_fs_opendir - open a directory
-// @path: directory path
-// Return: a pointer to directory handle, or NULL on error
-COOKDEF cook_dir_t *cook_fs_opendir(const char *path);
+// cook_arena_alloc_aligned - allocate aligned memory from arena
+// @arena: pointer to arena
+// @size: size in bytes to allocate
+// @align: alignment in bytes, power of two up to COOK_PAGE_SIZE
+//
+// Return: pointer aligned to @align, or NULL if @size is 0
+COOKDEF void *cook_arena_alloc_aligned(cook_arena_t *arena, size_t size, size_t align);
 
-// cook_fs_closedir - close a directory
-// @handle: a pointer to cook_dir_t
-COOKDEF void cook_fs_closedir(cook_dir_t *handle);
+// cook_arena_memdup - copy a memory block into arena
+// @arena: pointer to arena
+// @data: data to copy
+// @size: size of @data in bytes
+//
+// Return: pointer to the copy
+COOKDEF void *cook_arena_memdup(cook_arena_t *arena, const void *data, size_t size);
 
-// cook_fs_readdir - read a item from directory
-// @handle: a pointer to cook_dir_t
-// Return: a string in local buffer, contains the relatively file path
-COOKDEF const char *cook_fs_readdir(cook_dir_t *handle);
+// cook_arena_save - save current arena state
+// @arena: pointer to arena
+//
+// Return: mark that can be used with cook_arena_rewind()
+COOKDEF cook_arena_mark_t cook_arena_save(cook_arena_t *arena);
 
-// cook_fs_move - move the file to anoter place (rename)
-// @old_path: source
-// @new_path: destination
-// Return: true if successfully move, false otherwise
-COOKDEF bool cook_fs_move(const char *old_path, const char *new_path);
+// cook_arena_rewind - rewind arena to a saved mark
+// @arena: pointer to arena
+// @mark: mark returned by cook_arena_save()
+//
+// Note: all memory allocated after @mark is freed, the next allocation
+//       returns the same address it would have returned right after the save
+COOKDEF void cook_arena_rewind(cook_arena_t *arena, cook_arena_mark_t mark);
 
-// cook_fs_stat - get the attribute of file
-// @path: file path
-// @attr_ptr: pointer to cook_attr_t, stores the result
-// Return: true if successfully get, false otherwise
-COOKDEF bool cook_fs_stat(const char *path, cook_attr_t *attr_ptr);
+// cook_arena_reset - free all allocations, keep the blocks
+// @arena: pointer to arena
+COOKDEF void cook_arena_reset(cook_arena_t *arena);
 
-// cook_fs_isdir - check if the path is directory
-// @path: file path
-// Note: call cook_fs_stat internal, use COOK_ASSERT to check if cook_fs_stat is fine,
-//       not mixed the result of cook_fs_stat with cook_fs_isdir (both are boolean)
-// Return: true if the path is directory, false otherwise
-COOKDEF bool cook_fs_isdir(const char *path);
+// cook_arena_free - release all blocks of arena
+// @arena: pointer to arena
+COOKDEF void cook_arena_free(cook_arena_t *arena);
 
-// cook_fs_isfile - check if the path is regular file
-// @path: file path
-// Note: same to cook_fs_isdir
-// Return: true if the path is file, false otherwise
-COOKDEF bool cook_fs_isfile(const char *path);
+// cook_arena_strfmt - format string into arena memory
+// @arena: pointer to arena
+// @fmt: format string
+// @...: arguments for formatting
+//
+// Return: formatted NUL-terminated string, or NULL on format error
+COOKDEF const char *cook_arena_strfmt(cook_arena_t *arena, const char *fmt, ...);
 
-// cook_fs_exists - check if the path exists
-// @path: file path
-// Return: true if the path exists, false otherwise
-COOKDEF bool cook_fs_exists(const char *path);
+// cook_arena_vstrfmt - cook_arena_strfmt() with a va_list
+COOKDEF const char *cook_arena_vstrfmt(cook_arena_t *arena, const char *fmt, va_list args);
 
-// get the string in static buffer, which contains the information
-COOKDEF const char *cook_fs_type2string(cook_attr_t *attr_ptr);
-COOKDEF const char *cook_fs_perm2string(cook_attr_t *attr_ptr);
 
-#endif // COOK_H
+//////////////////////////////////////////////////////
+/////////////////////// scratch arenas
+//////////////////////////////////////////////////////
 
-#ifdef COOK_IMPLEMENTATION
+// Every thread owns COOK_SCRATCH_COUNT arenas for short-lived memory. A
+// function that returns its result in a caller's arena and needs scratch
+// space of its own passes that arena as a conflict, so it is handed a
+// different one and rewinding the scratch never frees the result:
+// ```
+//     const char *upper_join(cook_arena_t *out, const char *a, const char *b) {
+//         cook_scratch_t scratch = cook_scratch_get(out);
+//         const char *tmp = cook_arena_strfmt(scratch.arena, "%s/%s", a, b);
+//         char *result = cook_arena_memdup(out, tmp, strlen(tmp) + 1);
+//         for (char *c = result; *c; c++) *c = toupper(*c);
+//         cook_scratch_end(scratch);
+//         return result;
+//     }
+// ```
+// Scratch memory is thread-local, so unlike cook_temp_* it is safe to use
+// from several threads, and it grows instead of running out.
 
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <stdarg.h>
+#ifndef COOK_SCRATCH_COUNT
+#define COOK_SCRATCH_COUNT 2
+#endif
 
-#include <errno.h>
-#include <time.h>
-#include <sys/stat.h>
+typedef struct cook_scratch {
+    cook_arena_t *arena;
+    cook_arena_mark_t mark;
+} cook_scratch_t;
 
-#ifdef _WIN32
-#  include <direct.h>
-#  include <windows.h>
-#  include <io.h>
-#  include <sys/locking.h>
-#  include <sys/utime.h>
+// cook_scratch_get - borrow a scratch arena of the calling thread
+// @...: arenas the result must not alias (may be empty or NULL)
+//
+// Return: scratch whose arena is none of the conflicting arenas,
+//         give it back with cook_scratch_end()
+#define cook_scratch_get(...)                                           \
+    cook_scratch_begin((cook_arena_t *[]){NULL, ##__VA_ARGS__},         \
+                       sizeof((cook_arena_t *[]){NULL, ##__VA_ARGS__})  \
+                           / sizeof(cook_arena_t *))
+
+// COOK_SCRATCH_SCOPE - run a block with a scratch arena rewound at its end
+// @name: name of the cook_scratch_t inside the block
+// @...: conflicting arenas, as for cook_scratch_get()
+//
+// Note: leaving the block with break, goto or return skips the rewind
+//
+// Example:
+// ```
+//     COOK_SCRATCH_SCOPE(s) {
+//         const char *path = cook_arena_strfmt(s.arena, "%s/%s", dir, name);
+//         cook_fs_exists(path);
+//     } // everything allocated from s.arena is freed here
+// ```
+#define COOK_SCRATCH_SCOPE(name, ...)                                        \
+    for (cook_scratch_t name = cook_scratch_get(__VA_ARGS__),                \
+             *cook__scope_##name = &name;                                    \
+         cook__scope_##name; cook_scratch_end(name), cook__scope_##name = NULL)
+
+// cook_scratch_begin - borrow a scratch arena avoiding @conflicts
+// @conflicts: array of arenas to avoid, NULL entries are ignored
+// @count: number of entries in @conflicts
+//
+// Return: scratch, see cook_scratch_get()
+COOKDEF cook_scratch_t cook_scratch_begin(cook_arena_t **conflicts, size_t count);
+
+// cook_scratch_end - rewind a scratch arena to where it was borrowed
+// @scratch: scratch returned by cook_scratch_get()/cook_scratch_begin()
+COOKDEF void cook_scratch_end(cook_scratch_t scratch);
+
+// cook_scratch_release - free the scratch arenas of the calling thread
+//
+// Note: call before a thread exits, no scratch may be in use
+COOKDEF void cook_scratch_release(void);
+
+
+//////////////////////////////////////////////////////
+/////////////////////// allocator
+//////////////////////////////////////////////////////
+
+// A runtime allocator handle. Anything that owns memory on behalf of the
+// caller can take a 'cook_allocator_t *' instead of calling malloc directly,
+// so the same code runs on the heap, a pool, or any other backing store.
+//
+// @size passed to free/realloc is the size the block was requested with,
+// allocators that track sizes themselves are free to ignore it.
+typedef struct cook_allocator cook_allocator_t;
+struct cook_allocator {
+    void *ctx;
+    void *(*alloc)(cook_allocator_t *a, size_t size);
+    void *(*realloc)(cook_allocator_t *a, void *ptr, size_t old_size, size_t new_size);
+    void (*free)(cook_allocator_t *a, void *ptr, size_t size);
+};
+
+#define cook_allocator_alloc(a, size)                    ((a)->alloc((a), (size)))
+#define cook_allocator_realloc(a, ptr, old_size, size)   ((a)->realloc((a), (ptr), (old_size), (size)))
+#define cook_allocator_free(a, ptr, size)                ((a)->free((a), (ptr), (size)))
+
+// cook_heap_allocator - get the allocator backed by COOK_ALLOC/COOK_REALLOC/COOK_FREE
+//
+// Return: pointer to a static allocator, never NULL
+COOKDEF cook_allocator_t *cook_heap_allocator(void);
+
+
+//////////////////////////////////////////////////////
+/////////////////////// allocation statistics
+//////////////////////////////////////////////////////
+
+// cook_free - release memory returned by cook (cook_fs_readfile, cook_fs_cwd)
+// @ptr: pointer to release, NULL is ignored
+//
+// Note: same as COOK_FREE, but keeps the statistics below accurate
+COOKDEF void cook_free(void *ptr);
+
+#ifdef COOK_ALLOC_STATS
+
+// Opt-in instrumentation: define COOK_ALLOC_STATS (in every file including
+// cook.h) and all cook allocations are counted per tag and per callsite.
+// Memory released behind cook's back (plain free()) keeps counting as live.
+//
+// Example:
+// ```
+//     #define COOK_ALLOC_STATS
+//     #define COOK_IMPLEMENTATION
+//     #include "cook.h"
+//
+//     handle_request();
+//     cook_alloc_stats_summary(); // per tag
+//     cook_alloc_stats_detail();  // per callsite, most bytes first
+// ```
+
+typedef struct cook_alloc_stats {
+    const char *tag;    // NULL for the total
+    const char *file;   // NULL unless it is a callsite entry
+    size_t line;
+    size_t allocs;      // fresh allocations (including realloc of NULL)
+    size_t reallocs;    // resizes of existing blocks
+    size_t frees;
+    size_t bytes;       // bytes requested by allocs and reallocs
+    size_t live_bytes;
+    size_t peak_bytes;
+    size_t copy_bytes;  // bytes moved by reallocs that changed address
+} cook_alloc_stats_t;
+
+// the hooks behind COOK__ALLOC/COOK__REALLOC/COOK__FREE
+COOKDEF void *cook_stats_alloc(size_t size, const char *tag, const char *file, size_t line);
+COOKDEF void *cook_stats_realloc(void *ptr, size_t size, const char *tag, const char *file, size_t line);
+COOKDEF void cook_stats_free(void *ptr);
+
+// cook_alloc_stats_get - get the counters of one tag
+// @tag: subsystem tag ("vec", "sb", "fs", "pool", "arena"), or NULL for the total
+//
+// Return: copy of the counters, all zero if the tag was never seen
+COOKDEF cook_alloc_stats_t cook_alloc_stats_get(const char *tag);
+
+// cook_alloc_stats_summary - print the total and the counters of every tag
+COOKDEF void cook_alloc_stats_summary(void);
+
+// cook_alloc_stats_detail - print the counters of every callsite
+//
+// Note: callsites are sorted by requested bytes, biggest first
+COOKDEF void cook_alloc_stats_detail(void);
+
+// cook_alloc_stats_reset - clear counters, keep tracking live blocks
+//
+// Note: handy to measure one request: reset, run it, print
+COOKDEF void cook_alloc_stats_reset(void);
+
+#endif // COOK_ALLOC_STATS
+
+
+//////////////////////////////////////////////////////
+/////////////////////// pool allocator
+//////////////////////////////////////////////////////
+
+// A pool hands out objects of one fixed size. Objects are carved from slabs
+// of @slab_objs objects, and freed objects are kept on an intrusive free list
+// (the first word of a free object points to the next one), so alloc/free
+// are a couple of pointer moves and nodes stay packed together in memory.
+//
+// All pool functions are thread safe. For heavy multi-threaded use, give each
+// thread a 'cook_pool_cache_t', which moves objects to/from the pool in
+// batches of COOK_POOL_CACHE_BATCH and touches the shared lock only then.
+//
+// Example:
+// ```
+//     cook_pool_t pool;
+//     cook_pool_init(&pool, sizeof(struct node), 0);
+//     struct node *n = cook_pool_alloc(&pool);
+//     cook_pool_free(&pool, n);
+//     cook_pool_destroy(&pool);
+// ```
+
+typedef struct cook_pool_slab cook_pool_slab_t;
+typedef struct cook_pool {
+    size_t obj_size;
+    size_t slab_objs;
+    cook_pool_slab_t *slabs;
+    void *free_list;
+    size_t live;
+    size_t total;
+    volatile long lock;
+    cook_allocator_t allocator;
+} cook_pool_t;
+
+typedef struct cook_pool_cache {
+    cook_pool_t *pool;
+    void *free_list;
+    size_t count;
+} cook_pool_cache_t;
+
+// cook_pool_init - initialize a pool of fixed-size objects
+// @pool: pointer to pool
+// @obj_size: size of each object in bytes
+// @slab_objs: number of objects per slab, 0 means COOK_POOL_SLAB_OBJS
+//
+// Note: @obj_size is rounded up to pointer size, objects are pointer aligned
+COOKDEF void cook_pool_init(cook_pool_t *pool, size_t obj_size, size_t slab_objs);
+
+// cook_pool_destroy - release all slabs of the pool
+// @pool: pointer to pool
+//
+// Note: every object from the pool becomes invalid
+COOKDEF void cook_pool_destroy(cook_pool_t *pool);
+
+// cook_pool_alloc - take one object from the pool
+// @pool: pointer to pool
+//
+// Return: pointer to uninitialized object of @pool->obj_size bytes
+COOKDEF void *cook_pool_alloc(cook_pool_t *pool);
+
+// cook_pool_free - give one object back to the pool
+// @pool: pointer to pool
+// @ptr: object returned by this pool, NULL is ignored
+COOKDEF void cook_pool_free(cook_pool_t *pool, void *ptr);
+
+// cook_pool_free_bulk - give many objects back to the pool at once
+// @pool: pointer to pool
+// @ptrs: array of objects returned by this pool
+// @n: number of objects in @ptrs
+//
+// Note: takes the lock once for the whole batch
+COOKDEF void cook_pool_free_bulk(cook_pool_t *pool, void **ptrs, size_t n);
+
+// cook_pool_reset - free every object of the pool at once
+// @pool: pointer to pool
+//
+// Note: keep the slabs for reuse, caches bound to this pool must be
+//       dropped (not flushed) before the reset
+COOKDEF void cook_pool_reset(cook_pool_t *pool);
+
+// cook_pool_allocator - get the allocator interface of the pool
+// @pool: pointer to pool
+//
+// Note: alloc and realloc return NULL for sizes larger than
+//       @pool->obj_size, like malloc/realloc do when out of memory; a
+//       failed realloc leaves the object valid
+//
+// Return: allocator that serves requests from @pool
+COOKDEF cook_allocator_t *cook_pool_allocator(cook_pool_t *pool);
+
+// cook_pool_cache_init - bind a per-thread cache to a pool
+// @cache: pointer to cache
+// @pool: pool to refill from and flush to
+COOKDEF void cook_pool_cache_init(cook_pool_cache_t *cache, cook_pool_t *pool);
+
+// cook_pool_cache_alloc - take one object through the cache
+// @cache: pointer to cache
+//
+// Return: pointer to uninitialized object
+COOKDEF void *cook_pool_cache_alloc(cook_pool_cache_t *cache);
+
+// cook_pool_cache_free - give one object back through the cache
+// @cache: pointer to cache
+// @ptr: object from the bound pool, NULL is ignored
+COOKDEF void cook_pool_cache_free(cook_pool_cache_t *cache, void *ptr);
+
+// cook_pool_cache_flush - return all cached objects to the pool
+// @cache: pointer to cache
+//
+// Note: call it before the owning thread exits
+COOKDEF void cook_pool_cache_flush(cook_pool_cache_t *cache);
+
+
+//////////////////////////////////////////////////////
+/////////////////////// size-class allocator
+//////////////////////////////////////////////////////
+
+// A general purpose malloc replacement for allocation heavy, multi-threaded
+// programs. Requests up to COOK_SC_MAX_SMALL bytes are rounded to one of 40
+// size classes (4 per power of two), and each thread keeps a cache of free
+// objects per class, so the common alloc/free touches no lock at all. Caches
+// refill from and spill to a central depot in batches; the depot carves
+// objects out of COOK_SC_SPAN_SIZE aligned spans. Larger requests are mapped
+// directly and unmapped on free.
+//
+// Span memory is reused but never given back to the OS.
+//
+// To run all of cook on it, define the hooks before including cook.h:
+// ```
+//     #define COOK_ALLOC(size)        cook_sc_malloc(size)
+//     #define COOK_REALLOC(ptr, size) cook_sc_realloc(ptr, size)
+//     #define COOK_FREE(ptr)          cook_sc_free(ptr)
+//     #define COOK_IMPLEMENTATION
+//     #include "cook.h"
+// ```
+
+#define COOK_SC_MAX_SMALL (32*1024)
+
+// cook_sc_malloc - allocate memory (same contract as malloc)
+// @size: size in bytes
+//
+// Return: 16-byte aligned memory, or NULL if the system is out of memory
+COOKDEF void *cook_sc_malloc(size_t size);
+
+// cook_sc_realloc - resize memory (same contract as realloc)
+// @ptr: memory from cook_sc_malloc()/cook_sc_realloc(), or NULL
+// @size: new size in bytes, 0 frees @ptr and returns NULL
+//
+// Return: pointer to resized memory, or NULL on error (@ptr stays valid)
+COOKDEF void *cook_sc_realloc(void *ptr, size_t size);
+
+// cook_sc_free - free memory (same contract as free)
+// @ptr: memory from cook_sc_malloc()/cook_sc_realloc(), NULL is ignored
+COOKDEF void cook_sc_free(void *ptr);
+
+// cook_sc_usable_size - get the real size of a block
+// @ptr: memory from cook_sc_malloc()/cook_sc_realloc()
+//
+// Return: size of the size class (or mapping) backing @ptr
+COOKDEF size_t cook_sc_usable_size(void *ptr);
+
+// cook_sc_thread_flush - give the calling thread's cached objects back
+//
+// Note: call it before a thread exits, otherwise its cache is lost
+COOKDEF void cook_sc_thread_flush(void);
+
+// cook_sc_report - print a fragmentation report for every size class
+//
+// Note: per-thread counters are published in batches, flush the threads
+//       first for exact numbers
+COOKDEF void cook_sc_report(void);
+
+
+//////////////////////////////////////////////////////
+/////////////////////// TLSF allocator
+//////////////////////////////////////////////////////
+
+// Two-Level Segregated Fit: a general purpose allocator over one memory
+// region given by the caller, with O(1) malloc, free and realloc (apart from
+// the copy when realloc has to move). Free blocks are binned by a first
+// level (power of two) and a second level (32 linear steps inside it); two
+// bitmaps find a fitting non-empty bin with a couple of bit scans, and
+// neighbours are merged on free through boundary tags. No system call and
+// no search loop on any path, so worst-case latency is bounded.
+//
+// The control structure lives at the start of the region. The allocator is
+// not thread safe, use one per thread or lock around it.
+//
+// Example:
+// ```
+//     static char region[1 << 20];
+//     cook_tlsf_t *tlsf = cook_tlsf_create(region, sizeof(region));
+//     void *p = cook_tlsf_malloc(tlsf, 100);
+//     cook_tlsf_free(tlsf, p);
+// ```
+//
+// To run cook itself on a TLSF region, point the hooks at a global one:
+// ```
+//     extern cook_tlsf_t *my_tlsf;
+//     #define COOK_ALLOC(size)        cook_tlsf_malloc(my_tlsf, size)
+//     #define COOK_REALLOC(ptr, size) cook_tlsf_realloc(my_tlsf, ptr, size)
+//     #define COOK_FREE(ptr)          cook_tlsf_free(my_tlsf, ptr)
+// ```
+
+typedef struct cook_tlsf cook_tlsf_t;
+
+// cook_tlsf_create - set up an allocator inside a memory region
+// @mem: start of the region, kept until the allocator is no longer used
+// @size: size of the region in bytes
+//
+// Return: the allocator (placed at the start of @mem), or NULL if @size is
+//         too small to hold the control structure and one block
+COOKDEF cook_tlsf_t *cook_tlsf_create(void *mem, size_t size);
+
+// cook_tlsf_malloc - allocate memory from the region
+// @tlsf: allocator
+// @size: size in bytes
+//
+// Return: 16-byte aligned memory, or NULL if no free block is large enough
+COOKDEF void *cook_tlsf_malloc(cook_tlsf_t *tlsf, size_t size);
+
+// cook_tlsf_realloc - resize memory, in place when the next block allows it
+// @tlsf: allocator
+// @ptr: memory from this allocator, or NULL
+// @size: new size in bytes, 0 frees @ptr and returns NULL
+//
+// Return: pointer to resized memory, or NULL on error (@ptr stays valid)
+COOKDEF void *cook_tlsf_realloc(cook_tlsf_t *tlsf, void *ptr, size_t size);
+
+// cook_tlsf_free - give memory back to the region
+// @tlsf: allocator
+// @ptr: memory from this allocator, NULL is ignored
+COOKDEF void cook_tlsf_free(cook_tlsf_t *tlsf, void *ptr);
+
+// cook_tlsf_free_bytes - get the number of free bytes in the region
+// @tlsf: allocator
+//
+// Return: sum of the sizes of all free blocks
+COOKDEF size_t cook_tlsf_free_bytes(cook_tlsf_t *tlsf);
+
+// cook_tlsf_allocator - get the allocator interface of a TLSF region
+// @tlsf: allocator
+//
+// Return: allocator that serves requests from @tlsf
+COOKDEF cook_allocator_t *cook_tlsf_allocator(cook_tlsf_t *tlsf);
+
+
+//////////////////////////////////////////////////////
+/////////////////////// file system
+/////////////////////// (steal from https://github.com/lunarmodules/luafilesystem.git)
+//////////////////////////////////////////////////////
+
+typedef struct cook_dir_t cook_dir_t;
+typedef struct {
+    unsigned int mode;
+    long long ino;
+    long long size;
+    long long atime;
+    long long mtime;
+    long long ctime;
+} cook_attr_t;
+
+// cook_fs_readfile - read the entire file
+// @path: file path
+// Return: buffer in heap, filled with file content
+COOKDEF char *cook_fs_readfile(const char *path);
+
+// cook_fs_cwd - get the current work directory
+// Return: string in heap, contains the absolute path
+COOKDEF char *cook_fs_cwd(void);
+
+// cook_fs_mkdir - create a directory
+// @path: directory path
+// Note: it will fail if the directory has been existed
+// Return: true if successfully created, false otherwise
+COOKDEF bool cook_fs_mkdir(const char *path);
+
+// cook_fs_rmdir - remove a empty directory
+// @path: directory path
+// Note: it will fail if the directory does not exist or has other files
+// Return: true if successfully removed, false otherwise
+COOKDEF bool cook_fs_rmdir(const char *path);
+
+// cook_fs_chdir - change work directory
+// @path: destinated directory path
+// Return: true if successfully changed, false otherwise
+COOKDEF bool cook_fs_chdir(const char *path);
+
+// cook_fs_opendir - open a directory
+// @path: directory path
+// Return: a pointer to directory handle, or NULL on error
+COOKDEF cook_dir_t *cook_fs_opendir(const char *path);
+
+// cook_fs_closedir - close a directory
+// @handle: a pointer to cook_dir_t
+COOKDEF void cook_fs_closedir(cook_dir_t *handle);
+
+// cook_fs_readdir - read a item from directory
+// @handle: a pointer to cook_dir_t
+// Return: a string in local buffer, contains the relatively file path
+COOKDEF const char *cook_fs_readdir(cook_dir_t *handle);
+
+// cook_fs_move - move the file to anoter place (rename)
+// @old_path: source
+// @new_path: destination
+// Return: true if successfully move, false otherwise
+COOKDEF bool cook_fs_move(const char *old_path, const char *new_path);
+
+// cook_fs_stat - get the attribute of file
+// @path: file path
+// @attr_ptr: pointer to cook_attr_t, stores the result
+// Return: true if successfully get, false otherwise
+COOKDEF bool cook_fs_stat(const char *path, cook_attr_t *attr_ptr);
+
+// cook_fs_isdir - check if the path is directory
+// @path: file path
+// Note: call cook_fs_stat internal, use COOK_ASSERT to check if cook_fs_stat is fine,
+//       not mixed the result of cook_fs_stat with cook_fs_isdir (both are boolean)
+// Return: true if the path is directory, false otherwise
+COOKDEF bool cook_fs_isdir(const char *path);
+
+// cook_fs_isfile - check if the path is regular file
+// @path: file path
+// Note: same to cook_fs_isdir
+// Return: true if the path is file, false otherwise
+COOKDEF bool cook_fs_isfile(const char *path);
+
+// cook_fs_exists - check if the path exists
+// @path: file path
+// Return: true if the path exists, false otherwise
+COOKDEF bool cook_fs_exists(const char *path);
+
+// get the string in static buffer, which contains the information
+COOKDEF const char *cook_fs_type2string(cook_attr_t *attr_ptr);
+COOKDEF const char *cook_fs_perm2string(cook_attr_t *attr_ptr);
+
+
+//////////////////////////////////////////////////////
+/////////////////////// JSON
+//////////////////////////////////////////////////////
+
+// A two-stage JSON parser in the style of simdjson. Stage one classifies 64
+// bytes at a time with SIMD compares: it finds the bytes escaped by a
+// backslash, marks what is inside strings with a prefix xor over the
+// quotes, and writes the offsets of every structural byte (brackets,
+// colons, commas, quotes and scalar starts) to an index. Stage two walks
+// the index and checks the grammar. Both stages run on 64 KB at a time, so
+// the index stays in cache. Stage two fills a tape: one node per value, in
+// document order, and each container knows how many nodes it spans.
+// Strings, numbers and literals are views into the input; escapes are
+// decoded and numbers converted only when asked for.
+//
+// Example:
+// ```
+//     cook_json_t doc = {0};
+//     if (!cook_json_parse(&doc, text, NULL)) {
+//         printf("%s at %zu\n", doc.error, doc.error_offset);
+//     }
+//     const cook_json_node_t *users = cook_json_get(cook_json_root(&doc), "users");
+//     cook_json_iter_t it = cook_json_iter(users);
+//     const cook_json_node_t *user;
+//     while (cook_json_iter_next(&it, NULL, &user)) {
+//         double age;
+//         if (cook_json_number(cook_json_get(user, "age"), &age)) printf("%g\n", age);
+//     }
+//     cook_json_free(&doc);
+// ```
+
+#ifndef COOK_JSON_MAX_DEPTH
+#define COOK_JSON_MAX_DEPTH 1024
+#endif
+
+typedef enum cook_json_type {
+    COOK_JSON_NULL,
+    COOK_JSON_FALSE,
+    COOK_JSON_TRUE,
+    COOK_JSON_NUMBER,
+    COOK_JSON_STRING,
+    COOK_JSON_ARRAY,
+    COOK_JSON_OBJECT,
+} cook_json_type_t;
+
+typedef struct cook_json_node {
+    // strings without their quotes, numbers and literals as written,
+    // containers from bracket to bracket
+    cook_string_view_t sv;
+    cook_json_type_t type;
+    uint32_t skip;  // nodes this value spans, the next sibling is at node + skip
+    uint32_t count; // elements of an array, members of an object
+    bool escaped;   // a string with backslash escapes, see cook_json_string()
+} cook_json_node_t;
+
+typedef struct cook_json {
+    cook_json_node_t *nodes; // the tape, object members are a key node and a value node
+    size_t len;
+    size_t cap;
+    uint32_t *index;         // stage one output, kept for the next parse
+    size_t index_cap;
+    bool arena;              // @nodes came from an arena
+    const char *error;       // why the last parse failed
+    size_t error_offset;     // where in the input
+} cook_json_t;
+
+// cook_json_parse - parse a JSON document
+// @doc: document, zero-initialized before the first parse and reusable
+// @text: the input, which must outlive @doc since the nodes point into it
+// @arena: if not NULL the nodes are allocated from it, otherwise they are
+//         kept in @doc and reused by the next parse
+//
+// Note: the input must be smaller than 2 GB; it is not checked to be
+//       valid UTF-8, see cook_utf8_valid()
+//
+// Return: true on success, otherwise @doc->error and @doc->error_offset
+//         describe the first problem found
+COOKDEF bool cook_json_parse(cook_json_t *doc, cook_string_view_t text, cook_arena_t *arena);
+
+// cook_json_free - free a document
+// @doc: document to free, nodes from an arena are left to the arena
+COOKDEF void cook_json_free(cook_json_t *doc);
+
+// cook_json_root - get the top-level value of a parsed document
+// @doc: parsed document
+COOKDEF const cook_json_node_t *cook_json_root(const cook_json_t *doc);
+
+// Iterator over the elements of an array or the members of an object. For
+// an object each step yields the key and the value, for an array the key
+// is NULL. Anything else iterates as empty.
+typedef struct cook_json_iter {
+    const cook_json_node_t *at;
+    const cook_json_node_t *end;
+    bool object;
+} cook_json_iter_t;
+
+// cook_json_iter - start iterating a container
+// @node: array or object node, may be NULL
+COOKDEF cook_json_iter_t cook_json_iter(const cook_json_node_t *node);
+
+// cook_json_iter_next - get the next element or member
+// @it: pointer to iterator
+// @key: receives the key node of an object member, may be NULL
+// @value: receives the value node
+//
+// Return: true if there was one, false at the end of the container
+COOKDEF bool cook_json_iter_next(cook_json_iter_t *it, const cook_json_node_t **key,
+                                 const cook_json_node_t **value);
+
+// cook_json_get - look up an object member by key
+// @object: object node, may be NULL
+// @key: key to look for, compared after decoding escapes in the keys
+//
+// Return: value of the first member with @key, or NULL
+COOKDEF const cook_json_node_t *cook_json_get(const cook_json_node_t *object, const char *key);
+
+// cook_json_string - get the value of a string node
+// @node: string node
+// @sb: receives the decoded string if @node has escapes
+//
+// Return: @node->sv if it has no escapes, otherwise a view of the decoded
+//         string appended to @sb, valid until @sb grows again
+COOKDEF cook_string_view_t cook_json_string(const cook_json_node_t *node, cook_string_builder_t *sb);
+
+// cook_json_number - convert a number node to a double
+// @node: number node, may be NULL
+// @out: receives the value
+//
+// Return: false if @node is not a number
+COOKDEF bool cook_json_number(const cook_json_node_t *node, double *out);
+
+// cook_json_int - convert a number node to an integer
+// @node: number node, may be NULL
+// @out: receives the value
+//
+// Return: false if @node is not a number, has a fraction or exponent, or
+//         does not fit
+COOKDEF bool cook_json_int(const cook_json_node_t *node, int64_t *out);
+
+
+//////////////////////////////////////////////////////
+/////////////////////// regular expressions
+//////////////////////////////////////////////////////
+
+// A regex is compiled to an NFA, and the DFA is built from it lazily while
+// matching: a DFA state is a set of NFA states, made the first time a byte
+// leads to it and then reused. Each byte costs one table lookup once the
+// states a text needs exist, and building a state is bounded by the size of
+// the NFA, so matching is linear in the text whatever the pattern; there
+// is no backtracking. The states live in an arena, which is dropped when it
+// grows past COOK_REGEX_CACHE_SIZE and rebuilt as needed.
+//
+// When every match starts with the same literal, the matcher skips to the
+// next occurrence of it with cook_sv_find() whenever it has no partial match.
+//
+// Syntax, on bytes:
+//     .           any byte except '\n'
+//     [a-z] [^a]  byte classes, with [:alpha:], [:digit:], [:alnum:],
+//                 [:space:], [:upper:], [:lower:], [:xdigit:], [:punct:]
+//     \d \w \s    digit, word byte, space, and \D \W \S for the complements
+//     \n \t \r    and the other C escapes, \xHH for any byte, \c for a
+//                 punctuation byte c
+//     ab a|b      concatenation and alternation
+//     (a) (?:a)   groups, both only group
+//     * + ? {m} {m,} {m,n}  repetition, a '?' after it is accepted and ignored
+//     ^ $         start and end of the text
+//
+// Example:
+// ```
+//     cook_regex_t re;
+//     if (!cook_regex_init(&re, cook_sv_from_cstr("connection (refused|timed out)"))) {
+//         printf("%s at %zu\n", re.error, re.error_offset);
+//     }
+//     cook_sv_line_iter_t it = cook_sv_line_iter(log);
+//     cook_string_view_t line;
+//     while (cook_sv_line_next(&it, &line)) {
+//         if (cook_regex_match(&re, line)) printf(SV_FMT"\n", SV_ARG(line));
+//     }
+//     cook_regex_free(&re);
+// ```
+
+#ifndef COOK_REGEX_CACHE_SIZE
+#define COOK_REGEX_CACHE_SIZE (1024*1024)
+#endif
+
+typedef struct cook__regex_inst cook__regex_inst_t;
+typedef struct cook__regex_state cook__regex_state_t;
+
+typedef struct cook_regex {
+    cook__regex_inst_t *prog; // the NFA
+    size_t prog_len;
+    uint32_t entry;
+    unsigned char classes[256];
+    size_t class_count;
+    cook_string_view_t prefix; // literal every match starts with, may be empty
+    // the lazy DFA
+    cook_arena_t cache;
+    size_t cache_used;
+    size_t cache_resets;
+    cook__regex_state_t *start;   // before the first byte
+    cook__regex_state_t *restart; // no partial match, after the first byte
+    cook__regex_state_t **table;  // every state, by its NFA states
+    size_t table_cap;
+    size_t state_count;
+    uint32_t *mark; // scratch for building states
+    uint32_t *stack;
+    uint32_t *set;
+    uint32_t gen;
+    const char *error;
+    size_t error_offset;
+} cook_regex_t;
+
+// cook_regex_init - compile a regex
+// @re: regex to initialize
+// @pattern: the regex, see the syntax above, not referenced afterwards
+//
+// Return: false if @pattern is malformed or too large, @re->error and
+//         @re->error_offset say why and where; @re needs no cook_regex_free()
+//         then
+COOKDEF bool cook_regex_init(cook_regex_t *re, cook_string_view_t pattern);
+
+// cook_regex_free - free a regex and its DFA states
+// @re: regex to free
+COOKDEF void cook_regex_free(cook_regex_t *re);
+
+// cook_regex_match - check if a regex matches anywhere in a text
+// @re: compiled regex, its DFA cache grows while matching, so one regex is
+//      not to be shared between threads
+// @text: text to search
+//
+// Return: true if @text contains a match
+COOKDEF bool cook_regex_match(cook_regex_t *re, cook_string_view_t text);
+
+
+//////////////////////////////////////////////////////
+/////////////////////// rope
+//////////////////////////////////////////////////////
+
+// A rope is a piece table for large editable text: the text is a sequence
+// of pieces, each a view into bytes that never change, kept in the leaves
+// and inner nodes of an AVL tree ordered by position. Every node knows the
+// byte length of its subtree, so finding a position, inserting and deleting
+// walk one path and rebalance along it: O(log n) in the number of pieces,
+// whatever the length of the text.
+//
+// The initial text is referenced, not copied. Inserted text is copied into
+// an arena owned by the rope, back to back, so typing grows the piece it
+// extends instead of adding one per keystroke. Deleted bytes stay in the
+// arena until cook_rope_free(). Nodes come from a pool.
+//
+// Example:
+// ```
+//     cook_rope_t rope;
+//     cook_rope_init(&rope, cook_sv_from_cstr("hello world"));
+//     cook_rope_insert(&rope, 5, cook_sv_from_cstr(","));
+//     cook_rope_delete(&rope, 0, 1);
+//     cook_rope_insert(&rope, 0, cook_sv_from_cstr("H"));
+//     cook_rope_iter_t it = cook_rope_iter(&rope, 0);
+//     cook_string_view_t chunk;
+//     while (cook_rope_iter_next(&it, &chunk)) printf(SV_FMT, SV_ARG(chunk));
+//     cook_rope_free(&rope);
+// ```
+
+// an AVL tree of n nodes is less than 1.44*log2(n) high, enough for any
+// number of nodes that fits in memory
+#define COOK__ROPE_MAX_HEIGHT 96
+
+typedef struct cook__rope_node cook__rope_node_t;
+
+typedef struct cook_rope {
+    cook__rope_node_t *root;
+    size_t pieces;
+    cook_pool_t nodes;
+    cook_arena_t text; // inserted text
+} cook_rope_t;
+
+typedef struct cook_rope_iter {
+    cook__rope_node_t *stack[COOK__ROPE_MAX_HEIGHT]; // pieces left to visit
+    size_t top;
+    size_t skip; // bytes to skip in the next piece
+} cook_rope_iter_t;
+
+// cook_rope_init - initialize a rope
+// @rope: rope to initialize
+// @text: initial text, may be empty, referenced until cook_rope_free()
+COOKDEF void cook_rope_init(cook_rope_t *rope, cook_string_view_t text);
+
+// cook_rope_free - free the nodes and the inserted text of a rope
+// @rope: rope to free
+COOKDEF void cook_rope_free(cook_rope_t *rope);
+
+// cook_rope_len - get the length of the text
+// @rope: pointer to rope
+//
+// Return: length in bytes
+COOKDEF size_t cook_rope_len(const cook_rope_t *rope);
+
+// cook_rope_insert - insert text at a position
+// @rope: pointer to rope
+// @pos: byte offset, at most cook_rope_len()
+// @sv: text to insert, copied
+COOKDEF void cook_rope_insert(cook_rope_t *rope, size_t pos, cook_string_view_t sv);
+
+// cook_rope_delete - delete a range of text
+// @rope: pointer to rope
+// @pos: byte offset of the range
+// @len: length of the range, clamped to the end of the text
+COOKDEF void cook_rope_delete(cook_rope_t *rope, size_t pos, size_t len);
+
+// cook_rope_index - get the byte at a position
+// @rope: pointer to rope
+// @pos: byte offset, less than cook_rope_len()
+//
+// Return: the byte
+COOKDEF char cook_rope_index(const cook_rope_t *rope, size_t pos);
+
+// cook_rope_iter - start iterating the text from a position
+// @rope: pointer to rope, not to be modified while iterating
+// @pos: byte offset to start at, cook_rope_len() or more gives no chunks
+//
+// Return: iterator
+COOKDEF cook_rope_iter_t cook_rope_iter(const cook_rope_t *rope, size_t pos);
+
+// cook_rope_iter_next - get the next chunk of text
+// @it: pointer to iterator
+// @chunk: set to the chunk, one piece or the rest of it
+//
+// Return: false at the end of the text
+COOKDEF bool cook_rope_iter_next(cook_rope_iter_t *it, cook_string_view_t *chunk);
+
+// cook_rope_flatten - append the whole text to a string builder
+// @rope: pointer to rope
+// @sb: string builder, grown once
+//
+// Return: view of the appended text, valid until @sb changes
+COOKDEF cook_string_view_t cook_rope_flatten(const cook_rope_t *rope, cook_string_builder_t *sb);
+
+// cook_rope_write - write the whole text to a writer, chunk by chunk
+// @rope: pointer to rope
+// @w: writer, not flushed
+//
+// Return: false if a write failed, @w->error may say why
+COOKDEF bool cook_rope_write(const cook_rope_t *rope, cook_writer_t *w);
+
+#endif // COOK_H
+
+#ifdef COOK_IMPLEMENTATION
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <float.h>
+
+#include <errno.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#  include <direct.h>
+#  include <windows.h>
+#  include <io.h>
+#  include <sys/locking.h>
+#  include <sys/utime.h>
+#  include <fcntl.h>
+#  include <intrin.h>
+#  include <malloc.h>
+#else
+#  include <unistd.h>
+#  include <dirent.h>
 #  include <fcntl.h>
+#  include <sys/types.h>
+#  include <utime.h>
+#  include <sched.h>
+#  include <sys/mman.h>
+#  include <pthread.h>
+#endif
+
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || \
+    defined(_M_X64) || defined(_M_IX86) || defined(_M_ARM64)
+#  define COOK__LITTLE_ENDIAN
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#  define COOK__FORCE_INLINE inline __attribute__((always_inline))
+#else
+#  define COOK__FORCE_INLINE inline
+#endif
+
+#if !defined(COOK_NO_SIMD) && defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#  define COOK__SIMD_X86
+#  include <immintrin.h>
+#endif
+
+#ifdef _WIN32
+#  define chdir(p) (_chdir(p))
+#  define getcwd(d, s) (_getcwd(d, s))
+#  define rmdir(p) (_rmdir(p))
+#  ifndef fileno
+#    define fileno(f) (_fileno(f))
+#  endif
+#endif
+
+#ifdef _WIN32
+#  ifndef S_ISDIR
+#    define S_ISDIR(mode) (mode&_S_IFDIR)
+#  endif
+#  ifndef S_ISREG
+#    define S_ISREG(mode) (mode&_S_IFREG)
+#  endif
+#  define STAT_STRUCT struct _stati64
+#  define STAT_FUNC _stati64
+#else
+#  define STAT_STRUCT struct stat
+#  define STAT_FUNC stat
+#endif
+
+struct cook_dir_t {
+    bool closed;
+#ifdef _WIN32
+    intptr_t hFile;
+    char pattern[COOK_MAX_PATH_LEN + 1];
+#else
+    DIR *dp;
+#endif
+    char buffer[COOK_MAX_PATH_LEN + 1];
+};
+
+COOKDEF char *cook_fs_readfile(const char *path) {
+    FILE *fp = NULL;
+    char *buffer = NULL;
+    long size;
+
+    fp = fopen(path, "rb");
+    if (!fp) goto fail;
+
+    fseek(fp, 0, SEEK_END);
+    size = ftell(fp);
+    rewind(fp);
+    if (size <= 0) goto fail;
+
+    buffer = COOK__ALLOC(size + 1, "fs");
+    COOK_ASSERT(buffer != NULL && "out of memory");
+    if (fread(buffer, size, 1, fp) != 1) goto fail;
+    buffer[size] = '\0';
+
+    fclose(fp);
+    return buffer;
+fail:
+    if (fp) fclose(fp);
+    if (buffer) COOK__FREE(buffer);
+    return NULL;
+}
+
+COOKDEF char *cook_fs_cwd(void) {
+    char *path = NULL;
+    size_t size = 128;
+
+    while (1) {
+        char *temp_path = COOK__REALLOC(path, size, "fs");
+        COOK_ASSERT(temp_path != NULL && "out of memory");
+        path = temp_path;
+        if (getcwd(temp_path, size)) break;
+        if (errno != ERANGE) {
+            COOK__FREE(temp_path);
+            fprintf(stderr, "ERROR: cook_fs_cwd: %s\n", strerror(errno));
+            return NULL;
+        }
+        size *= 2;
+    }
+
+    return path;
+}
+
+COOKDEF bool cook_fs_mkdir(const char *path) {
+#ifdef _WIN32
+#  define cook__fs_mkdir _mkdir
+#else
+#  define cook__fs_mkdir(path) (mkdir((path), \
+    S_IRUSR | S_IWUSR | S_IXUSR | S_IRGRP | S_IWGRP | S_IXGRP | S_IROTH | S_IXOTH))
+#endif
+    if (cook__fs_mkdir(path) != 0) {
+        fprintf(stderr, "ERROR: cook_fs_mkdir: %s\n", strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+COOKDEF bool cook_fs_rmdir(const char *path) {
+    if (rmdir(path) != 0) {
+        fprintf(stderr, "ERROR: cook_fs_rmdir: %s\n", strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+COOKDEF bool cook_fs_chdir(const char *path) {
+    if (chdir(path) != 0) {
+        fprintf(stderr, "ERROR: cook_fs_chdir: %s\n", strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+COOKDEF cook_dir_t *cook_fs_opendir(const char *path) {
+    cook_dir_t *handle = NULL;
+
+    handle = COOK__ALLOC(sizeof(cook_dir_t), "fs");
+    if (!handle) COOK_ASSERT(handle != NULL && "out of memory");
+
+#ifdef _WIN32
+    handle->hFile = 0L;
+    if (strlen(path) > COOK_MAX_PATH_LEN - 2) {
+        fprintf(stderr, "ERROR: cook_fs_opendir: path too long: %s\n", path);
+        goto fail;
+    } else {
+        snprintf(handle->pattern, sizeof(handle->pattern), "%s/*", path);
+    }
+#else
+    handle->dp = opendir(path);
+    if (!handle->dp) {
+        fprintf(stderr, "ERROR: cook_fs_opendir: %s\n", strerror(errno));
+        goto fail;
+    }
+#endif
+    handle->closed = false;
+
+    return handle;
+fail:
+    if (handle) COOK__FREE(handle);
+    return NULL;
+}
+
+COOKDEF void cook_fs_closedir(cook_dir_t *handle) {
+#ifdef _WIN32
+    if (!handle->closed && handle->hFile) _findclose(handle->hFile);
+#else
+    if (!handle->closed && handle->dp) closedir(handle->dp);
+#endif
+    COOK__FREE(handle);
+}
+
+COOKDEF const char *cook_fs_readdir(cook_dir_t *handle) {
+#ifdef _WIN32
+    struct _finddata_t c_file;
+    if (handle->hFile == 0L) { /* first entry */
+        if ((handle->hFile = _findfirst(handle->pattern, &c_file)) == -1L) {
+            fprintf(stderr, "ERROR: cook_fs_readdir: %s\n", strerror(errno));
+            handle->closed = true;
+            return NULL;
+        } else {
+            if (strlen(c_file.name) > COOK_MAX_PATH_LEN) {
+                fprintf(stderr, "ERROR: cook_fs_readdir: path too long: %s\n", c_file.name);
+                return NULL;
+            }
+            snprintf(handle->buffer, sizeof(handle->buffer), "%s", c_file.name);
+            return handle->buffer;
+        }
+    } else { /* next entry */
+        if (_findnext(handle->hFile, &c_file) == -1L) {
+            /* no more entries => close directory */
+            _findclose(handle->hFile);
+            handle->closed = true;
+            return NULL;
+        } else {
+            if (strlen(c_file.name) > COOK_MAX_PATH_LEN) {
+                fprintf(stderr, "ERROR: cook_fs_readdir: path too long: %s\n", c_file.name);
+                return NULL;
+            }
+            snprintf(handle->buffer, sizeof(handle->buffer), "%s", c_file.name);
+            return handle->buffer;
+        }
+    }
+#else
+    struct dirent *entry;
+    if ((entry = readdir(handle->dp)) != NULL) {
+        if (strlen(entry->d_name) > COOK_MAX_PATH_LEN) {
+            fprintf(stderr, "ERROR: cook_fs_readdir: path too long: %s\n", entry->d_name);
+            return NULL;
+        }
+        snprintf(handle->buffer, sizeof(handle->buffer), "%s", entry->d_name);
+        return handle->buffer;
+    } else {
+        /* no more entries => close directory */
+        closedir(handle->dp);
+        handle->closed = true;
+        return NULL;
+    }
+#endif
+}
+
+COOKDEF bool cook_fs_move(const char *old_path, const char *new_path) {
+    if (rename(old_path, new_path) != 0) {
+        fprintf(stderr, "ERROR: cook_fs_move: %s\n", strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+COOKDEF bool cook_fs_stat(const char *path, cook_attr_t *attr_ptr) {
+    STAT_STRUCT info = {0};
+    if (STAT_FUNC(path, &info)) {
+        fprintf(stderr, "ERROR: cook_fs_stat: %s\n", strerror(errno));
+        return false;
+    }
+    attr_ptr->mode  = info.st_mode;
+    attr_ptr->ino   = info.st_ino;
+    attr_ptr->atime = info.st_atime;
+    attr_ptr->mtime = info.st_mtime;
+    attr_ptr->ctime = info.st_ctime;
+    attr_ptr->size  = info.st_size;
+    return true;
+}
+
+COOKDEF bool cook_fs_isdir(const char *path) {
+    cook_attr_t attr;
+    COOK_ASSERT(cook_fs_stat(path, &attr) && "unexpected error occurs");
+    return S_ISDIR(attr.mode);
+}
+
+COOKDEF bool cook_fs_isfile(const char *path) {
+    cook_attr_t attr;
+    COOK_ASSERT(cook_fs_stat(path, &attr) && "unexpected error occurs");
+    return S_ISREG(attr.mode);
+}
+
+COOKDEF bool cook_fs_exists(const char *path) {
+    cook_attr_t attr;
+    if (!cook_fs_stat(path, &attr)) return false;
+    return true;
+}
+
+COOKDEF const char *cook_fs_type2string(cook_attr_t *attr_ptr) {
+    int mode = attr_ptr->mode;
+    if (S_ISREG(mode)) {
+        return "file";
+    } else if (S_ISDIR(mode)) {
+        return "dir";
+    } else {
+        return "other";
+    }
+}
+
+COOKDEF const char *cook_fs_perm2string(cook_attr_t *attr_ptr) {
+    static char perms[10] = "---------";
+    for (int i = 0; i < 9; i++) perms[i] = '-';
+    int mode = attr_ptr->mode;
+#ifdef _WIN32
+    if (mode & _S_IREAD)  perms[0] = perms[3] = perms[6] = 'r';
+    if (mode & _S_IWRITE) perms[1] = perms[4] = perms[7] = 'w';
+    if (mode & _S_IEXEC)  perms[2] = perms[5] = perms[8] = 'x';
+#else
+    if (mode & S_IRUSR) perms[0] = 'r';
+    if (mode & S_IWUSR) perms[1] = 'w';
+    if (mode & S_IXUSR) perms[2] = 'x';
+    if (mode & S_IRGRP) perms[3] = 'r';
+    if (mode & S_IWGRP) perms[4] = 'w';
+    if (mode & S_IXGRP) perms[5] = 'x';
+    if (mode & S_IROTH) perms[6] = 'r';
+    if (mode & S_IWOTH) perms[7] = 'w';
+    if (mode & S_IXOTH) perms[8] = 'x';
+#endif
+    return perms;
+}
+
+COOKDEF cook_string_view_t cook_sv_from_cstr(const char *cstr) {
+    return (cook_string_view_t) {
+        .data = cstr,
+        .len = cstr ? strlen(cstr) : 0
+    };
+}
+
+COOKDEF cook_string_view_t cook_sv_from_parts(const char *data, size_t len) {
+    return (cook_string_view_t) {
+        .data = data,
+        .len = len
+    };
+}
+
+COOKDEF bool cook_sv_equal(cook_string_view_t a, cook_string_view_t b) {
+    if (a.len == b.len && memcmp(a.data, b.data, a.len) == 0) {
+        return true;
+    } else {
+        return false;
+    }
+}
+
+COOKDEF bool cook_sv_starts_with(cook_string_view_t sv, cook_string_view_t prefix) {
+    if (prefix.len > sv.len) return false;
+    return memcmp(sv.data, prefix.data, prefix.len) == 0;
+}
+
+COOKDEF bool cook_sv_ends_with(cook_string_view_t sv, cook_string_view_t postfix) {
+    if (postfix.len > sv.len) return false;
+    size_t offset = sv.len - postfix.len;
+    return memcmp(sv.data + offset, postfix.data, postfix.len) == 0;
+}
+
+COOKDEF bool cook_sv_empty(cook_string_view_t sv) {
+    return sv.data == NULL || sv.len == 0;
+}
+
+COOKDEF cook_string_view_t cook_sv_slice(cook_string_view_t sv, size_t begin, size_t end) {
+    cook_string_view_t res = {0};
+
+    if (begin >= end || end - begin > sv.len) return res;
+    res.data = sv.data + begin;
+    res.len = end - begin;
+    return res;
+}
+
+// cook__ctz64 - index of the lowest set bit of a non-zero value
+static unsigned int cook__ctz64(uint64_t n) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned int)__builtin_ctzll(n);
+#else
+    unsigned int r = 0;
+    while (!(n & 1)) {
+        n >>= 1;
+        r++;
+    }
+    return r;
+#endif
+}
+
+// cook__clz64 - number of leading zero bits of a non-zero value
+static unsigned int cook__clz64(uint64_t n) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned int)__builtin_clzll(n);
+#else
+    unsigned int r = 0;
+    while (!(n >> 63)) {
+        n <<= 1;
+        r++;
+    }
+    return r;
+#endif
+}
+
+// cook__popcount64 - number of set bits
+static inline unsigned int cook__popcount64(uint64_t n) {
+    // without the popcnt instruction the builtin is a libgcc call
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__POPCNT__) || defined(__aarch64__))
+    return (unsigned int)__builtin_popcountll(n);
+#else
+    n -= (n >> 1) & 0x5555555555555555ull;
+    n = (n & 0x3333333333333333ull) + ((n >> 2) & 0x3333333333333333ull);
+    n = (n + (n >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return (unsigned int)((n*0x0101010101010101ull) >> 56);
+#endif
+}
+
+// cook__ascii_flip_scalar - xor 0x20 into every byte in [first, first + 26)
+static void cook__ascii_flip_scalar(char *dst, const char *src, size_t n, char first) {
+    for (size_t i = 0; i < n; i++) {
+        unsigned char c = (unsigned char)src[i];
+        dst[i] = (char)((unsigned)(c - (unsigned char)first) < 26u ? c ^ 0x20 : c);
+    }
+}
+
+// cook__find_scalar - substring search by memchr on the first byte
+// @from: first candidate position
+static size_t cook__find_scalar(const char *s, size_t n, const char *needle, size_t k, size_t from) {
+    size_t last = n - k;
+    for (size_t i = from; i <= last; i++) {
+        const char *p = memchr(s + i, needle[0], last - i + 1);
+        if (!p) break;
+        i = (size_t)(p - s);
+        if (memcmp(p + 1, needle + 1, k - 1) == 0) return i;
+    }
+    return COOK_SV_NPOS;
+}
+
+// cook__ascii_fold - lowercase 'A'-'Z', leave every other byte alone
+static inline unsigned char cook__ascii_fold(unsigned char c) {
+    return (unsigned)(c - 'A') < 26u ? (unsigned char)(c | 0x20) : c;
+}
+
+// cook__mismatch_scalar - index of the first differing byte, @n if none
+static size_t cook__mismatch_scalar(const char *a, const char *b, size_t n) {
+    size_t i = 0;
+#ifdef COOK__LITTLE_ENDIAN
+    for (; i + 8 <= n; i += 8) {
+        uint64_t x, y;
+        memcpy(&x, a + i, 8);
+        memcpy(&y, b + i, 8);
+        if (x != y) return i + cook__ctz64(x ^ y)/8;
+    }
+#endif
+    while (i < n && a[i] == b[i]) i++;
+    return i;
+}
+
+#ifdef COOK__LITTLE_ENDIAN
+// cook__ascii_fold8 - cook__ascii_fold() on 8 bytes at once; bytes are
+// classified on their low 7 bits so no carry crosses into the next byte
+static inline uint64_t cook__ascii_fold8(uint64_t x) {
+    uint64_t low7 = x & 0x7F7F7F7F7F7F7F7Full;
+    uint64_t ge_a = low7 + 0x3F3F3F3F3F3F3F3Full;  // 0x80 - 'A'
+    uint64_t gt_z = low7 + 0x2525252525252525ull;  // 0x80 - 'Z' - 1
+    uint64_t upper = ge_a & ~gt_z & ~x & 0x8080808080808080ull;
+    return x | upper >> 2;
+}
+#endif
+
+static size_t cook__mismatch_nocase_scalar(const char *a, const char *b, size_t n) {
+    size_t i = 0;
+#ifdef COOK__LITTLE_ENDIAN
+    for (; i + 8 <= n; i += 8) {
+        uint64_t x, y;
+        memcpy(&x, a + i, 8);
+        memcpy(&y, b + i, 8);
+        x = cook__ascii_fold8(x);
+        y = cook__ascii_fold8(y);
+        if (x != y) return i + cook__ctz64(x ^ y)/8;
+    }
+#endif
+    while (i < n && cook__ascii_fold((unsigned char)a[i]) == cook__ascii_fold((unsigned char)b[i])) i++;
+    return i;
+}
+
+#ifdef COOK__SIMD_X86
+
+// The kernels below need n >= the vector width: the last partial vector is
+// handled by an overlapping load that ends exactly at s + n.
+
+#define COOK__AVX2 __attribute__((target("avx2")))
+
+static bool cook__cpu_avx2(void) {
+    return __builtin_cpu_supports("avx2");
+}
+
+static size_t cook__find_char_sse2(const char *s, size_t n, char c) {
+    __m128i v = _mm_set1_epi8(c);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        unsigned m = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(s + i)), v));
+        if (m) return i + (size_t)__builtin_ctz(m);
+    }
+    if (i < n) {
+        size_t j = n - 16;
+        unsigned m = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(s + j)), v));
+        m >>= i - j;
+        if (m) return i + (size_t)__builtin_ctz(m);
+    }
+    return COOK_SV_NPOS;
+}
+
+COOK__AVX2 static size_t cook__find_char_avx2(const char *s, size_t n, char c) {
+    __m256i v = _mm256_set1_epi8(c);
+    unsigned m = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)s), v));
+    if (m) return (size_t)__builtin_ctz(m);
+    // continue from the next 32-byte boundary, split loads are slow
+    size_t i = 32 - ((uintptr_t)s & 31);
+    for (; i + 128 <= n; i += 128) {
+        __m256i a = _mm256_cmpeq_epi8(_mm256_load_si256((const __m256i *)(s + i)), v);
+        __m256i b = _mm256_cmpeq_epi8(_mm256_load_si256((const __m256i *)(s + i + 32)), v);
+        __m256i d = _mm256_cmpeq_epi8(_mm256_load_si256((const __m256i *)(s + i + 64)), v);
+        __m256i e = _mm256_cmpeq_epi8(_mm256_load_si256((const __m256i *)(s + i + 96)), v);
+        if (_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(d, e)))) break;
+    }
+    for (; i + 32 <= n; i += 32) {
+        m = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i *)(s + i)), v));
+        if (m) return i + (size_t)__builtin_ctz(m);
+    }
+    if (i < n) {
+        size_t j = n - 32;
+        m = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(s + j)), v));
+        m >>= i - j;
+        if (m) return i + (size_t)__builtin_ctz(m);
+    }
+    return COOK_SV_NPOS;
+}
+
+static size_t cook__rfind_char_sse2(const char *s, size_t n, char c) {
+    __m128i v = _mm_set1_epi8(c);
+    size_t i = n;
+    for (; i >= 16; i -= 16) {
+        unsigned m = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(s + i - 16)), v));
+        if (m) return i - 16 + 31 - (size_t)__builtin_clz(m);
+    }
+    if (i > 0) {
+        unsigned m = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)s), v));
+        m &= (1u << i) - 1;
+        if (m) return 31 - (size_t)__builtin_clz(m);
+    }
+    return COOK_SV_NPOS;
+}
+
+COOK__AVX2 static size_t cook__rfind_char_avx2(const char *s, size_t n, char c) {
+    __m256i v = _mm256_set1_epi8(c);
+    size_t i = n;
+    for (; i >= 128; i -= 128) {
+        const char *p = s + i - 128;
+        __m256i a = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)p), v);
+        __m256i b = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(p + 32)), v);
+        __m256i d = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(p + 64)), v);
+        __m256i e = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(p + 96)), v);
+        if (_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(d, e)))) break;
+    }
+    for (; i >= 32; i -= 32) {
+        unsigned m = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(s + i - 32)), v));
+        if (m) return i - 32 + 31 - (size_t)__builtin_clz(m);
+    }
+    if (i > 0) {
+        unsigned m = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)s), v));
+        m &= (1u << i) - 1;
+        if (m) return 31 - (size_t)__builtin_clz(m);
+    }
+    return COOK_SV_NPOS;
+}
+
+// Counting subtracts the 0/-1 compare results into byte counters and folds
+// them into 64-bit lanes with psadbw before any of them can overflow.
+
+static size_t cook__count_char_sse2(const char *s, size_t n, char c) {
+    __m128i v = _mm_set1_epi8(c), zero = _mm_setzero_si128(), total = zero;
+    size_t i = 0;
+    while (i + 16 <= n) {
+        size_t end = n - i > 255*16 ? i + 255*16 : n;
+        __m128i acc = zero;
+        for (; i + 16 <= end; i += 16) {
+            acc = _mm_sub_epi8(acc, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(s + i)), v));
+        }
+        total = _mm_add_epi64(total, _mm_sad_epu8(acc, zero));
+    }
+    uint64_t lanes[2];
+    _mm_storeu_si128((__m128i *)lanes, total);
+    size_t count = (size_t)(lanes[0] + lanes[1]);
+    for (; i < n; i++) count += s[i] == c;
+    return count;
+}
+
+COOK__AVX2 static size_t cook__count_char_avx2(const char *s, size_t n, char c) {
+    __m256i v = _mm256_set1_epi8(c), zero = _mm256_setzero_si256(), total = zero;
+    size_t i = 0;
+    while (i + 32 <= n) {
+        size_t end = n - i > 255*32 ? i + 255*32 : n;
+        __m256i acc = zero;
+        for (; i + 32 <= end; i += 32) {
+            acc = _mm256_sub_epi8(acc, _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(s + i)), v));
+        }
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(acc, zero));
+    }
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, total);
+    size_t count = (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    for (; i < n; i++) count += s[i] == c;
+    return count;
+}
+
+// Set membership for any byte set: the low nibble picks a byte from one of
+// two 16-entry tables (high nibble 0-7 or 8-15), whose bit (hi & 7) says if
+// the byte is in the set. Both lookups are a single pshufb. The tables are
+// built by cook_byteset_make().
+COOK__AVX2 static inline unsigned cook__set_mask_avx2(const char *p, const cook_byteset_t *set) {
+    __m256i table_a = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)set->nibbles[0]));
+    __m256i table_b = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)set->nibbles[1]));
+    __m256i bits = _mm256_broadcastsi128_si256(
+        _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128));
+    __m256i nibble = _mm256_set1_epi8(0x0f);
+
+    __m256i x = _mm256_loadu_si256((const __m256i *)p);
+    __m256i lo = _mm256_and_si256(x, nibble);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(x, 4), nibble);
+    __m256i row = _mm256_blendv_epi8(_mm256_shuffle_epi8(table_a, lo),
+                                     _mm256_shuffle_epi8(table_b, lo),
+                                     _mm256_cmpgt_epi8(hi, _mm256_set1_epi8(7)));
+    __m256i bit = _mm256_shuffle_epi8(bits, hi);
+    return (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit));
+}
+
+// cook__find_set_avx2 - first byte whose membership in @set equals @in
+COOK__AVX2 static size_t cook__find_set_avx2(const char *s, size_t n, const cook_byteset_t *set, bool in) {
+    unsigned flip = in ? 0 : ~0u;
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        unsigned m = cook__set_mask_avx2(s + i, set) ^ flip;
+        if (m) return i + (size_t)__builtin_ctz(m);
+    }
+    if (i < n) {
+        size_t j = n - 32;
+        unsigned m = (cook__set_mask_avx2(s + j, set) ^ flip) >> (i - j);
+        if (m) return i + (size_t)__builtin_ctz(m);
+    }
+    return COOK_SV_NPOS;
+}
+
+// cook__rfind_set_avx2 - last byte whose membership in @set equals @in
+COOK__AVX2 static size_t cook__rfind_set_avx2(const char *s, size_t n, const cook_byteset_t *set, bool in) {
+    unsigned flip = in ? 0 : ~0u;
+    size_t i = n;
+    for (; i >= 32; i -= 32) {
+        unsigned m = cook__set_mask_avx2(s + i - 32, set) ^ flip;
+        if (m) return i - 32 + 31 - (size_t)__builtin_clz(m);
+    }
+    if (i > 0) {
+        unsigned m = (cook__set_mask_avx2(s, set) ^ flip) & ((1u << i) - 1);
+        if (m) return 31 - (size_t)__builtin_clz(m);
+    }
+    return COOK_SV_NPOS;
+}
+
+// cook__set_mask64_avx2 - membership bits of 64 bytes, all must be readable
+COOK__AVX2 static uint64_t cook__set_mask64_avx2(const char *s, const cook_byteset_t *set) {
+    return (uint64_t)cook__set_mask_avx2(s, set) | (uint64_t)cook__set_mask_avx2(s + 32, set) << 32;
+}
+
+// cook__char_mask64_sse2 - bits of the bytes equal to @c, 64 must be readable
+static uint64_t cook__char_mask64_sse2(const char *s, char c) {
+    __m128i v = _mm_set1_epi8(c);
+    uint64_t mask = 0;
+    for (int k = 0; k < 4; k++) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(s + 16*k));
+        mask |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, v)) << 16*k;
+    }
+    return mask;
+}
+
+COOK__AVX2 static uint64_t cook__char_mask64_avx2(const char *s, char c) {
+    __m256i v = _mm256_set1_epi8(c);
+    __m256i lo = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)s), v);
+    __m256i hi = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(s + 32)), v);
+    return (uint64_t)(uint32_t)_mm256_movemask_epi8(lo) | (uint64_t)(uint32_t)_mm256_movemask_epi8(hi) << 32;
+}
+
+// Substring search (k >= 2): a position is a candidate when both the first
+// and the last byte of the needle match there, only candidates are memcmp'd.
+
+static size_t cook__find_sse2(const char *s, size_t n, const char *needle, size_t k) {
+    __m128i first = _mm_set1_epi8(needle[0]), last = _mm_set1_epi8(needle[k - 1]);
+    size_t i = 0;
+    for (; i + k - 1 + 16 <= n; i += 16) {
+        __m128i head = _mm_loadu_si128((const __m128i *)(s + i));
+        __m128i tail = _mm_loadu_si128((const __m128i *)(s + i + k - 1));
+        unsigned m = (unsigned)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, last)));
+        for (; m; m &= m - 1) {
+            size_t at = i + (size_t)__builtin_ctz(m);
+            if (memcmp(s + at + 1, needle + 1, k - 2) == 0) return at;
+        }
+    }
+    return cook__find_scalar(s, n, needle, k, i);
+}
+
+COOK__AVX2 static size_t cook__find_avx2(const char *s, size_t n, const char *needle, size_t k) {
+    __m256i first = _mm256_set1_epi8(needle[0]), last = _mm256_set1_epi8(needle[k - 1]);
+    size_t i = 0;
+    for (; i + k - 1 + 32 <= n; i += 32) {
+        __m256i head = _mm256_loadu_si256((const __m256i *)(s + i));
+        __m256i tail = _mm256_loadu_si256((const __m256i *)(s + i + k - 1));
+        unsigned m = (unsigned)_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(head, first), _mm256_cmpeq_epi8(tail, last)));
+        for (; m; m &= m - 1) {
+            size_t at = i + (size_t)__builtin_ctz(m);
+            if (memcmp(s + at + 1, needle + 1, k - 2) == 0) return at;
+        }
+    }
+    return cook__find_scalar(s, n, needle, k, i);
+}
+
+// ASCII transforms. A byte is in [first, first + n) when adding
+// 0x80 - first (wrapping) moves it into [-128, -128 + n) as a signed byte,
+// so one add and one signed compare classify 16/32 bytes.
+
+static void cook__ascii_flip_sse2(char *dst, const char *src, size_t n, char first) {
+    __m128i bias = _mm_set1_epi8((char)(0x80 - first)), limit = _mm_set1_epi8(-128 + 26);
+    __m128i flip = _mm_set1_epi8(0x20);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i letter = _mm_cmpgt_epi8(limit, _mm_add_epi8(x, bias));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_xor_si128(x, _mm_and_si128(letter, flip)));
+    }
+    cook__ascii_flip_scalar(dst + i, src + i, n - i, first);
+}
+
+COOK__AVX2 static void cook__ascii_flip_avx2(char *dst, const char *src, size_t n, char first) {
+    __m256i bias = _mm256_set1_epi8((char)(0x80 - first)), limit = _mm256_set1_epi8(-128 + 26);
+    __m256i flip = _mm256_set1_epi8(0x20);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i letter = _mm256_cmpgt_epi8(limit, _mm256_add_epi8(x, bias));
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_xor_si256(x, _mm256_and_si256(letter, flip)));
+    }
+    // no calls into non-AVX code here: gcc may turn them into tail jumps
+    // without a vzeroupper, and legacy SSE with dirty upper halves is slow
+    for (; i < n; i++) {
+        unsigned char c = (unsigned char)src[i];
+        dst[i] = (char)((unsigned)(c - (unsigned char)first) < 26u ? c ^ 0x20 : c);
+    }
+}
+
+static void cook__ascii_replace_sse2(char *dst, const char *src, size_t n, char from, char to) {
+    __m128i vfrom = _mm_set1_epi8(from), vto = _mm_set1_epi8(to);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i hit = _mm_cmpeq_epi8(x, vfrom);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_xor_si128(x, _mm_and_si128(hit, _mm_xor_si128(x, vto))));
+    }
+    for (; i < n; i++) dst[i] = src[i] == from ? to : src[i];
+}
+
+COOK__AVX2 static void cook__ascii_replace_avx2(char *dst, const char *src, size_t n, char from, char to) {
+    __m256i vfrom = _mm256_set1_epi8(from), vto = _mm256_set1_epi8(to);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i hit = _mm256_cmpeq_epi8(x, vfrom);
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_blendv_epi8(x, vto, hit));
+    }
+    for (; i < n; i++) dst[i] = src[i] == from ? to : src[i];
+}
+
+static bool cook__is_digits_sse2(const char *s, size_t n) {
+    __m128i bias = _mm_set1_epi8((char)(0x80 - '0')), limit = _mm_set1_epi8(-128 + 9);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i x = _mm_add_epi8(_mm_loadu_si128((const __m128i *)(s + i)), bias);
+        if (_mm_movemask_epi8(_mm_cmpgt_epi8(x, limit))) return false;
+    }
+    for (; i < n; i++) {
+        if ((unsigned)(s[i] - '0') > 9) return false;
+    }
+    return true;
+}
+
+COOK__AVX2 static bool cook__is_digits_avx2(const char *s, size_t n) {
+    __m256i bias = _mm256_set1_epi8((char)(0x80 - '0')), limit = _mm256_set1_epi8(-128 + 9);
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m256i a = _mm256_add_epi8(_mm256_loadu_si256((const __m256i *)(s + i)), bias);
+        __m256i b = _mm256_add_epi8(_mm256_loadu_si256((const __m256i *)(s + i + 32)), bias);
+        __m256i bad = _mm256_or_si256(_mm256_cmpgt_epi8(a, limit), _mm256_cmpgt_epi8(b, limit));
+        if (_mm256_movemask_epi8(bad)) return false;
+    }
+    for (; i < n; i++) {
+        if ((unsigned)(s[i] - '0') > 9) return false;
+    }
+    return true;
+}
+
+// Mismatch kernels: compare both inputs a vector at a time, the first zero
+// bit of the equality mask is the first differing byte.
+
+static size_t cook__mismatch_sse2(const char *a, const char *b, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(a + i)), _mm_loadu_si128((const __m128i *)(b + i)));
+        unsigned m = (unsigned)_mm_movemask_epi8(eq) ^ 0xFFFF;
+        if (m) return i + (size_t)__builtin_ctz(m);
+    }
+    if (i < n) {
+        size_t j = n - 16;
+        __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(a + j)), _mm_loadu_si128((const __m128i *)(b + j)));
+        unsigned m = ((unsigned)_mm_movemask_epi8(eq) ^ 0xFFFF) >> (i - j);
+        if (m) return i + (size_t)__builtin_ctz(m);
+    }
+    return n;
+}
+
+COOK__AVX2 static size_t cook__mismatch_avx2(const char *a, const char *b, size_t n) {
+    size_t i = 0;
+    // long shared prefixes: test 64 bytes per branch
+    for (; i + 64 <= n; i += 64) {
+        __m256i lo = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(a + i)), _mm256_loadu_si256((const __m256i *)(b + i)));
+        __m256i hi = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(a + i + 32)), _mm256_loadu_si256((const __m256i *)(b + i + 32)));
+        if ((unsigned)_mm256_movemask_epi8(_mm256_and_si256(lo, hi)) != 0xFFFFFFFFu) break;
+    }
+    for (; i + 32 <= n; i += 32) {
+        __m256i eq = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(a + i)), _mm256_loadu_si256((const __m256i *)(b + i)));
+        unsigned m = ~(unsigned)_mm256_movemask_epi8(eq);
+        if (m) return i + (size_t)__builtin_ctz(m);
+    }
+    if (i < n) {
+        size_t j = n - 32;
+        __m256i eq = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(a + j)), _mm256_loadu_si256((const __m256i *)(b + j)));
+        unsigned m = ~(unsigned)_mm256_movemask_epi8(eq) >> (i - j);
+        if (m) return i + (size_t)__builtin_ctz(m);
+    }
+    return n;
+}
+
+// case folding uses the same range trick as the ASCII transforms above
+static inline __m128i cook__fold_sse2(__m128i x) {
+    __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(-128 + 26), _mm_add_epi8(x, _mm_set1_epi8((char)(0x80 - 'A'))));
+    return _mm_or_si128(x, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+
+COOK__AVX2 static inline __m256i cook__fold_avx2(__m256i x) {
+    __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 26), _mm256_add_epi8(x, _mm256_set1_epi8((char)(0x80 - 'A'))));
+    return _mm256_or_si256(x, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+
+static size_t cook__mismatch_nocase_sse2(const char *a, const char *b, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i y = _mm_loadu_si128((const __m128i *)(b + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) == 0xFFFF) continue;
+        unsigned m = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(cook__fold_sse2(x), cook__fold_sse2(y))) ^ 0xFFFF;
+        if (m) return i + (size_t)__builtin_ctz(m);
+    }
+    if (i < n) {
+        size_t j = n - 16;
+        __m128i x = cook__fold_sse2(_mm_loadu_si128((const __m128i *)(a + j)));
+        __m128i y = cook__fold_sse2(_mm_loadu_si128((const __m128i *)(b + j)));
+        unsigned m = ((unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) ^ 0xFFFF) >> (i - j);
+        if (m) return i + (size_t)__builtin_ctz(m);
+    }
+    return n;
+}
+
+COOK__AVX2 static size_t cook__mismatch_nocase_avx2(const char *a, const char *b, size_t n) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i *)(b + i));
+        // identical blocks need no folding, the common case in shared prefixes
+        if ((unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)) == 0xFFFFFFFFu) continue;
+        unsigned m = ~(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(cook__fold_avx2(x), cook__fold_avx2(y)));
+        if (m) return i + (size_t)__builtin_ctz(m);
+    }
+    if (i < n) {
+        size_t j = n - 32;
+        __m256i x = cook__fold_avx2(_mm256_loadu_si256((const __m256i *)(a + j)));
+        __m256i y = cook__fold_avx2(_mm256_loadu_si256((const __m256i *)(b + j)));
+        unsigned m = ~(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)) >> (i - j);
+        if (m) return i + (size_t)__builtin_ctz(m);
+    }
+    return n;
+}
+
+#endif // COOK__SIMD_X86
+
+// cook__mismatch - index of the first differing byte of @a and @b, @n if none
+static size_t cook__mismatch(const char *a, const char *b, size_t n) {
+#ifdef COOK__SIMD_X86
+    if (n >= 32 && cook__cpu_avx2()) return cook__mismatch_avx2(a, b, n);
+    if (n >= 16) return cook__mismatch_sse2(a, b, n);
+#endif
+    return cook__mismatch_scalar(a, b, n);
+}
+
+static size_t cook__mismatch_nocase(const char *a, const char *b, size_t n) {
+#ifdef COOK__SIMD_X86
+    if (n >= 32 && cook__cpu_avx2()) return cook__mismatch_nocase_avx2(a, b, n);
+    if (n >= 16) return cook__mismatch_nocase_sse2(a, b, n);
+#endif
+    return cook__mismatch_nocase_scalar(a, b, n);
+}
+
+COOKDEF bool cook_sv_equal_nocase(cook_string_view_t a, cook_string_view_t b) {
+    return a.len == b.len && cook__mismatch_nocase(a.data, b.data, a.len) == a.len;
+}
+
+COOKDEF int cook_sv_compare(cook_string_view_t a, cook_string_view_t b) {
+    size_t n = a.len < b.len ? a.len : b.len;
+    size_t i = cook__mismatch(a.data, b.data, n);
+    if (i < n) return (int)(unsigned char)a.data[i] - (int)(unsigned char)b.data[i];
+    return (a.len > b.len) - (a.len < b.len);
+}
+
+COOKDEF int cook_sv_compare_nocase(cook_string_view_t a, cook_string_view_t b) {
+    size_t n = a.len < b.len ? a.len : b.len;
+    size_t i = cook__mismatch_nocase(a.data, b.data, n);
+    if (i < n) return (int)cook__ascii_fold((unsigned char)a.data[i]) - (int)cook__ascii_fold((unsigned char)b.data[i]);
+    return (a.len > b.len) - (a.len < b.len);
+}
+
+COOKDEF size_t cook_sv_common_prefix(cook_string_view_t a, cook_string_view_t b) {
+    return cook__mismatch(a.data, b.data, a.len < b.len ? a.len : b.len);
+}
+
+// cook__bswap64 - reverse the byte order of a 64-bit value
+static inline uint64_t cook__bswap64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap64(x);
+#elif defined(_MSC_VER)
+    return _byteswap_uint64(x);
+#else
+    x = (x & 0x00000000FFFFFFFFull) << 32 | (x & 0xFFFFFFFF00000000ull) >> 32;
+    x = (x & 0x0000FFFF0000FFFFull) << 16 | (x & 0xFFFF0000FFFF0000ull) >> 16;
+    return (x & 0x00FF00FF00FF00FFull) << 8 | (x & 0xFF00FF00FF00FF00ull) >> 8;
+#endif
+}
+
+// A view being sorted, with the 8 bytes at the current depth cached as a
+// big-endian integer (zero padded past the end), so comparing keys orders
+// those bytes like memcmp.
+typedef struct cook__sort_entry {
+    uint64_t key;
+    const char *data;
+    size_t len;
+} cook__sort_entry_t;
+
+// a range of entries whose views all share their first @depth bytes
+typedef struct cook__sort_task {
+    cook__sort_entry_t *items;
+    size_t count;
+    size_t depth;
+    bool keys_valid; // keys hold the chunk at @depth
+} cook__sort_task_t;
+
+#define COOK__SORT_CUTOFF 16
+
+static uint64_t cook__sort_key(const cook__sort_entry_t *e, size_t depth) {
+    const unsigned char *p = (const unsigned char *)e->data + depth;
+    size_t rest = e->len - depth;
+    uint64_t key = 0;
+    if (rest >= 8) {
+        memcpy(&key, p, 8);
+#ifdef COOK__LITTLE_ENDIAN
+        key = cook__bswap64(key);
+#endif
+        return key;
+    }
+    for (size_t i = 0; i < rest; i++) key |= (uint64_t)p[i] << (56 - 8*i);
+    return key;
+}
+
+static void cook__sort_fill_keys(cook__sort_task_t *t) {
+    for (size_t i = 0; i < t->count; i++) t->items[i].key = cook__sort_key(&t->items[i], t->depth);
+    t->keys_valid = true;
+}
+
+static void cook__sort_insertion(cook__sort_entry_t *items, size_t count, size_t depth) {
+    for (size_t i = 1; i < count; i++) {
+        cook__sort_entry_t e = items[i];
+        cook_string_view_t rest = cook_sv_from_parts(e.data + depth, e.len - depth);
+        size_t j = i;
+        for (; j > 0; j--) {
+            const cook__sort_entry_t *prev = &items[j - 1];
+            if (prev->key < e.key) break;
+            if (prev->key == e.key &&
+                cook_sv_compare(cook_sv_from_parts(prev->data + depth, prev->len - depth), rest) <= 0) break;
+            items[j] = *prev;
+        }
+        items[j] = e;
+    }
+}
+
+static inline void cook__sort_swap(cook__sort_entry_t *a, cook__sort_entry_t *b) {
+    cook__sort_entry_t t = *a;
+    *a = *b;
+    *b = t;
+}
+
+static inline uint64_t cook__median3(uint64_t a, uint64_t b, uint64_t c) {
+    if (a < b) return b < c ? b : (a < c ? c : a);
+    return a < c ? a : (b < c ? c : b);
+}
+
+// cook__sort_split - one ternary partition step on the cached keys
+// @t: range with valid keys, more than COOK__SORT_CUTOFF entries
+// @parts: receives the non-trivial ranges left to sort
+//
+// Return: number of ranges written to @parts
+static size_t cook__sort_split(cook__sort_task_t t, cook__sort_task_t parts[3]) {
+    cook__sort_entry_t *e = t.items;
+    size_t n = t.count;
+    uint64_t pivot;
+    if (n >= 128) {
+        size_t s = n/8;
+        pivot = cook__median3(cook__median3(e[0].key, e[s].key, e[2*s].key),
+                              cook__median3(e[3*s].key, e[4*s].key, e[5*s].key),
+                              cook__median3(e[6*s].key, e[7*s].key, e[n - 1].key));
+    } else {
+        pivot = cook__median3(e[0].key, e[n/2].key, e[n - 1].key);
+    }
+
+    size_t lt = 0, i = 0, gt = n;
+    while (i < gt) {
+        if (e[i].key < pivot) cook__sort_swap(&e[lt++], &e[i++]);
+        else if (e[i].key > pivot) cook__sort_swap(&e[i], &e[--gt]);
+        else i++;
+    }
+
+    // views ending inside this chunk are equal to each other up to their
+    // length (the key pads with zeros), a shorter one sorts first
+    cook__sort_entry_t *eq = e + lt;
+    size_t eq_count = gt - lt, done = 0;
+    for (size_t len = 0; len <= 8; len++) {
+        for (size_t j = done; j < eq_count; j++) {
+            if (eq[j].len - t.depth == len) cook__sort_swap(&eq[done++], &eq[j]);
+        }
+    }
+
+    size_t count = 0;
+    cook__sort_task_t all[3] = {
+        {e, lt, t.depth, true},
+        {e + gt, n - gt, t.depth, true},
+        {eq + done, eq_count - done, t.depth + 8, false},
+    };
+    for (size_t j = 0; j < 3; j++) {
+        if (all[j].count > 1) parts[count++] = all[j];
+    }
+    return count;
+}
+
+static void cook__sort_run(cook__sort_task_t t) {
+    for (;;) {
+        if (!t.keys_valid) cook__sort_fill_keys(&t);
+        if (t.count <= COOK__SORT_CUTOFF) {
+            cook__sort_insertion(t.items, t.count, t.depth);
+            return;
+        }
+        cook__sort_task_t parts[3];
+        size_t count = cook__sort_split(t, parts);
+        if (count == 0) return;
+        // recurse on the smaller ranges and loop on the largest, which keeps
+        // the stack O(log n) however long the shared prefixes are
+        size_t largest = 0;
+        for (size_t i = 1; i < count; i++) {
+            if (parts[i].count > parts[largest].count) largest = i;
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (i != largest) cook__sort_run(parts[i]);
+        }
+        t = parts[largest];
+    }
+}
+
+static cook__sort_entry_t *cook__sort_entries(const cook_string_view_t *items, size_t count) {
+    cook__sort_entry_t *entries = COOK__ALLOC(count*sizeof(*entries), "sv");
+    COOK_ASSERT(entries != NULL && "out of memory");
+    for (size_t i = 0; i < count; i++) {
+        entries[i].data = items[i].data;
+        entries[i].len = items[i].len;
+    }
+    return entries;
+}
+
+static void cook__sort_finish(cook_string_view_t *items, cook__sort_entry_t *entries, size_t count) {
+    for (size_t i = 0; i < count; i++) items[i] = cook_sv_from_parts(entries[i].data, entries[i].len);
+    COOK__FREE(entries);
+}
+
+COOKDEF void cook_sv_sort(cook_string_view_t *items, size_t count) {
+    if (count < 2) return;
+    cook__sort_entry_t *entries = cook__sort_entries(items, count);
+    cook__sort_run((cook__sort_task_t){entries, count, 0, false});
+    cook__sort_finish(items, entries, count);
+}
+
+// cook__cpu_count - number of online processors, at least 1
+static size_t cook__cpu_count(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (size_t)info.dwNumberOfProcessors : 1;
+#else
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    return online > 0 ? (size_t)online : 1;
+#endif
+}
+
+#define COOK__MAX_THREADS 64
+
+typedef struct cook__thread_job {
+    void (*fn)(void *arg);
+    void *arg;
+} cook__thread_job_t;
+
+#ifdef _WIN32
+static DWORD WINAPI cook__thread_main(LPVOID arg) {
+    cook__thread_job_t *job = arg;
+    job->fn(job->arg);
+    return 0;
+}
+#else
+static void *cook__thread_main(void *arg) {
+    cook__thread_job_t *job = arg;
+    job->fn(job->arg);
+    return NULL;
+}
+#endif
+
+// cook__run_parallel - call @fn on every argument, each on its own thread
+// @args: array of @count arguments of @size bytes, the first one runs on
+//        the calling thread
+//
+// Note: an argument whose thread cannot be started runs on the calling
+//       thread instead, so the work always gets done
+static void cook__run_parallel(void (*fn)(void *arg), void *args, size_t size, size_t count) {
+    COOK_ASSERT(count <= COOK__MAX_THREADS && "too many threads");
+    cook__thread_job_t jobs[COOK__MAX_THREADS];
+#ifdef _WIN32
+    HANDLE handles[COOK__MAX_THREADS];
+#else
+    pthread_t handles[COOK__MAX_THREADS];
+#endif
+    bool started[COOK__MAX_THREADS] = {0};
+    for (size_t i = 1; i < count; i++) {
+        jobs[i] = (cook__thread_job_t){fn, (char *)args + i*size};
+#ifdef _WIN32
+        handles[i] = CreateThread(NULL, 0, cook__thread_main, &jobs[i], 0, NULL);
+        started[i] = handles[i] != NULL;
+#else
+        started[i] = pthread_create(&handles[i], NULL, cook__thread_main, &jobs[i]) == 0;
+#endif
+        if (!started[i]) fn(jobs[i].arg);
+    }
+    fn(args);
+    for (size_t i = 1; i < count; i++) {
+        if (!started[i]) continue;
+#ifdef _WIN32
+        WaitForSingleObject(handles[i], INFINITE);
+        CloseHandle(handles[i]);
+#else
+        pthread_join(handles[i], NULL);
+#endif
+    }
+}
+
+typedef struct cook__sort_tasks {
+    cook__sort_task_t *items;
+    size_t len;
+    size_t cap;
+} cook__sort_tasks_t;
+
+// the tasks of one thread, every @stride-th task of the list
+typedef struct cook__sort_worker {
+    const cook__sort_task_t *tasks;
+    size_t count;
+    size_t first;
+    size_t stride;
+} cook__sort_worker_t;
+
+static void cook__sort_work(void *arg) {
+    const cook__sort_worker_t *w = arg;
+    for (size_t i = w->first; i < w->count; i += w->stride) cook__sort_run(w->tasks[i]);
+}
+
+static int cook__sort_task_larger(const void *a, const void *b) {
+    size_t x = ((const cook__sort_task_t *)a)->count, y = ((const cook__sort_task_t *)b)->count;
+    return (x < y) - (x > y);
+}
+
+COOKDEF void cook_sv_sort_parallel(cook_string_view_t *items, size_t count, size_t threads) {
+    if (threads == 0) threads = cook__cpu_count();
+    if (threads > COOK__MAX_THREADS) threads = COOK__MAX_THREADS;
+    if (threads < 2 || count < ((size_t)1 << 16)) {
+        cook_sv_sort(items, count);
+        return;
+    }
+
+    cook__sort_entry_t *entries = cook__sort_entries(items, count);
+
+    // partition on this thread until every range is small enough that
+    // dealing them out balances the threads
+    size_t grain = count/(threads*8);
+    cook__sort_tasks_t pending = {0}, ready = {0};
+    cook_vec_push(&pending, ((cook__sort_task_t){entries, count, 0, false}));
+    while (pending.len > 0) {
+        cook__sort_task_t t = pending.items[--pending.len];
+        if (t.count <= grain) {
+            cook_vec_push(&ready, t);
+            continue;
+        }
+        if (!t.keys_valid) cook__sort_fill_keys(&t);
+        cook__sort_task_t parts[3];
+        size_t n = cook__sort_split(t, parts);
+        for (size_t i = 0; i < n; i++) cook_vec_push(&pending, parts[i]);
+    }
+
+    // largest first, dealt round-robin: every thread gets a similar mix
+    qsort(ready.items, ready.len, sizeof(*ready.items), cook__sort_task_larger);
+    cook__sort_worker_t workers[COOK__MAX_THREADS];
+    for (size_t i = 0; i < threads; i++) {
+        workers[i] = (cook__sort_worker_t){ready.items, ready.len, i, threads};
+    }
+    cook__run_parallel(cook__sort_work, workers, sizeof(workers[0]), threads);
+
+    cook_vec_free(&pending);
+    cook_vec_free(&ready);
+    cook__sort_finish(items, entries, count);
+}
+
+COOKDEF size_t cook_sv_find_char(cook_string_view_t sv, char c) {
+#ifdef COOK__SIMD_X86
+    if (sv.len >= 32 && cook__cpu_avx2()) return cook__find_char_avx2(sv.data, sv.len, c);
+    if (sv.len >= 16) return cook__find_char_sse2(sv.data, sv.len, c);
+    for (size_t i = 0; i < sv.len; i++) {
+        if (sv.data[i] == c) return i;
+    }
+    return COOK_SV_NPOS;
+#else
+    const char *p = sv.len ? memchr(sv.data, c, sv.len) : NULL;
+    return p ? (size_t)(p - sv.data) : COOK_SV_NPOS;
+#endif
+}
+
+COOKDEF size_t cook_sv_rfind_char(cook_string_view_t sv, char c) {
+#ifdef COOK__SIMD_X86
+    if (sv.len >= 32 && cook__cpu_avx2()) return cook__rfind_char_avx2(sv.data, sv.len, c);
+    if (sv.len >= 16) return cook__rfind_char_sse2(sv.data, sv.len, c);
+#endif
+    for (size_t i = sv.len; i > 0; i--) {
+        if (sv.data[i-1] == c) return i - 1;
+    }
+    return COOK_SV_NPOS;
+}
+
+COOKDEF size_t cook_sv_find_any(cook_string_view_t sv, cook_string_view_t set) {
+    if (set.len == 0) return COOK_SV_NPOS;
+    if (set.len == 1) return cook_sv_find_char(sv, set.data[0]);
+    if (sv.len < 64) {
+        // too short to pay for building the table, search each byte of the
+        // set in the part before the best match so far
+        size_t best = sv.len;
+        for (size_t j = 0; j < set.len && best > 0; j++) {
+            const char *p = memchr(sv.data, set.data[j], best);
+            if (p) best = (size_t)(p - sv.data);
+        }
+        return best < sv.len ? best : COOK_SV_NPOS;
+    }
+    cook_byteset_t byteset = cook_byteset_make(set);
+    return cook_sv_find_byteset(sv, &byteset);
+}
+
+COOKDEF size_t cook_sv_find(cook_string_view_t sv, cook_string_view_t needle) {
+    if (needle.len == 0) return 0;
+    if (needle.len > sv.len) return COOK_SV_NPOS;
+    if (needle.len == 1) return cook_sv_find_char(sv, needle.data[0]);
+#ifdef COOK__SIMD_X86
+    if (cook__cpu_avx2()) return cook__find_avx2(sv.data, sv.len, needle.data, needle.len);
+    return cook__find_sse2(sv.data, sv.len, needle.data, needle.len);
+#else
+    return cook__find_scalar(sv.data, sv.len, needle.data, needle.len, 0);
+#endif
+}
+
+COOKDEF size_t cook_sv_count_char(cook_string_view_t sv, char c) {
+#ifdef COOK__SIMD_X86
+    if (sv.len >= 32 && cook__cpu_avx2()) return cook__count_char_avx2(sv.data, sv.len, c);
+    return cook__count_char_sse2(sv.data, sv.len, c);
+#else
+    size_t count = 0;
+    for (size_t i = 0; i < sv.len; i++) count += sv.data[i] == c;
+    return count;
+#endif
+}
+
+COOKDEF cook_byteset_t cook_byteset_make(cook_string_view_t bytes) {
+    cook_byteset_t set = {0};
+    for (size_t i = 0; i < bytes.len; i++) {
+        unsigned char b = (unsigned char)bytes.data[i];
+        set.bits[b >> 6] |= (uint64_t)1 << (b & 63);
+        set.nibbles[b >> 7][b & 15] |= (unsigned char)(1u << ((b >> 4) & 7));
+    }
+    return set;
+}
+
+COOKDEF cook_byteset_t cook_byteset_from_pred(int (*pred)(int)) {
+    cook_byteset_t set = {0};
+    for (int c = 0; c < 256; c++) {
+        if (!pred(c)) continue;
+        set.bits[c >> 6] |= (uint64_t)1 << (c & 63);
+        set.nibbles[c >> 7][c & 15] |= (unsigned char)(1u << ((c >> 4) & 7));
+    }
+    return set;
+}
+
+// cook__find_set - first byte of @s whose membership in @set equals @in
+static size_t cook__find_set(const char *s, size_t n, const cook_byteset_t *set, bool in) {
+#ifdef COOK__SIMD_X86
+    if (n >= 32 && cook__cpu_avx2()) return cook__find_set_avx2(s, n, set, in);
+#endif
+    for (size_t i = 0; i < n; i++) {
+        if ((bool)cook_byteset_has(set, s[i]) == in) return i;
+    }
+    return COOK_SV_NPOS;
+}
+
+// cook__rfind_set - last byte of @s whose membership in @set equals @in
+static size_t cook__rfind_set(const char *s, size_t n, const cook_byteset_t *set, bool in) {
+#ifdef COOK__SIMD_X86
+    if (n >= 32 && cook__cpu_avx2()) return cook__rfind_set_avx2(s, n, set, in);
+#endif
+    for (size_t i = n; i > 0; i--) {
+        if ((bool)cook_byteset_has(set, s[i-1]) == in) return i - 1;
+    }
+    return COOK_SV_NPOS;
+}
+
+COOKDEF size_t cook_sv_find_byteset(cook_string_view_t sv, const cook_byteset_t *set) {
+    return cook__find_set(sv.data, sv.len, set, true);
+}
+
+// fixed sets, spelled out as cook_byteset_make() would build them
+static const cook_byteset_t cook__space_set = {
+    .bits = { (1ull << ' ') | (1ull << '\t') | (1ull << '\n') | (1ull << '\v') | (1ull << '\f') | (1ull << '\r') },
+    .nibbles = { { [0] = 1 << 2, [9] = 1, [10] = 1, [11] = 1, [12] = 1, [13] = 1 } },
+};
+
+static const cook_byteset_t cook__blank_set = {
+    .bits = { (1ull << ' ') | (1ull << '\t') },
+    .nibbles = { { [0] = 1 << 2, [9] = 1 } },
+};
+
+static const cook_byteset_t cook__newline_set = {
+    .bits = { (1ull << '\n') | (1ull << '\r') },
+    .nibbles = { { [10] = 1, [13] = 1 } },
+};
+
+// cook__sv_chop_at - split @sv at index @i, dropping the delimiter byte there
+static cook_string_view_t cook__sv_chop_at(cook_string_view_t *sv, size_t i) {
+    cook_string_view_t field = *sv;
+    if (i == COOK_SV_NPOS) {
+        if (sv->data) sv->data += sv->len;
+        sv->len = 0;
+    } else {
+        field.len = i;
+        sv->data += i + 1;
+        sv->len -= i + 1;
+    }
+    return field;
+}
+
+COOKDEF cook_string_view_t cook_sv_chop_by_delim(cook_string_view_t *sv, char delim) {
+    return cook__sv_chop_at(sv, cook_sv_find_char(*sv, delim));
+}
+
+COOKDEF cook_string_view_t cook_sv_chop_by_set(cook_string_view_t *sv, const cook_byteset_t *set) {
+    return cook__sv_chop_at(sv, cook_sv_find_byteset(*sv, set));
+}
+
+COOKDEF cook_string_view_t cook_sv_chop_by_space(cook_string_view_t *sv) {
+    size_t begin = cook__find_set(sv->data, sv->len, &cook__space_set, false);
+    if (begin == COOK_SV_NPOS) begin = sv->len;
+    if (begin > 0) {
+        sv->data += begin;
+        sv->len -= begin;
+    }
+    return cook__sv_chop_at(sv, cook_sv_find_byteset(*sv, &cook__space_set));
+}
+
+COOKDEF cook_string_view_t cook_sv_ltrim_set(cook_string_view_t sv, const cook_byteset_t *set) {
+    size_t i = cook__find_set(sv.data, sv.len, set, false);
+    if (i == COOK_SV_NPOS) return (cook_string_view_t) {0};
+    return cook_sv_from_parts(sv.data + i, sv.len - i);
+}
+
+COOKDEF cook_string_view_t cook_sv_rtrim_set(cook_string_view_t sv, const cook_byteset_t *set) {
+    size_t i = cook__rfind_set(sv.data, sv.len, set, false);
+    if (i == COOK_SV_NPOS) return (cook_string_view_t) {0};
+    return cook_sv_from_parts(sv.data, i + 1);
+}
+
+COOKDEF cook_string_view_t cook_sv_trim_set(cook_string_view_t sv, const cook_byteset_t *set) {
+    return cook_sv_rtrim_set(cook_sv_ltrim_set(sv, set), set);
+}
+
+COOKDEF cook_string_view_t cook_sv_trim_space(cook_string_view_t sv) {
+    return cook_sv_trim_set(sv, &cook__space_set);
+}
+
+COOKDEF cook_string_view_t cook_sv_ltrim(cook_string_view_t sv) {
+    return cook_sv_ltrim_set(sv, &cook__blank_set);
+}
+
+COOKDEF cook_string_view_t cook_sv_rtrim(cook_string_view_t sv) {
+    return cook_sv_rtrim_set(sv, &cook__blank_set);
+}
+
+COOKDEF cook_string_view_t cook_sv_trim(cook_string_view_t sv) {
+    return cook_sv_trim_set(sv, &cook__blank_set);
+}
+
+COOKDEF cook_string_view_t cook_sv_chomp(cook_string_view_t sv) {
+    return cook_sv_rtrim_set(sv, &cook__newline_set);
+}
+
+COOKDEF bool cook_sv_is_digits(cook_string_view_t sv) {
+    if (sv.len == 0) return false;
+#ifdef COOK__SIMD_X86
+    if (sv.len >= 64 && cook__cpu_avx2()) return cook__is_digits_avx2(sv.data, sv.len);
+    return cook__is_digits_sse2(sv.data, sv.len);
+#else
+    for (size_t i = 0; i < sv.len; i++) {
+        if ((unsigned)(sv.data[i] - '0') > 9) return false;
+    }
+    return true;
+#endif
+}
+
+COOKDEF void cook_ascii_lower(char *dst, cook_string_view_t src) {
+#ifdef COOK__SIMD_X86
+    if (src.len >= 32 && cook__cpu_avx2()) cook__ascii_flip_avx2(dst, src.data, src.len, 'A');
+    else cook__ascii_flip_sse2(dst, src.data, src.len, 'A');
+#else
+    cook__ascii_flip_scalar(dst, src.data, src.len, 'A');
+#endif
+}
+
+COOKDEF void cook_ascii_upper(char *dst, cook_string_view_t src) {
+#ifdef COOK__SIMD_X86
+    if (src.len >= 32 && cook__cpu_avx2()) cook__ascii_flip_avx2(dst, src.data, src.len, 'a');
+    else cook__ascii_flip_sse2(dst, src.data, src.len, 'a');
+#else
+    cook__ascii_flip_scalar(dst, src.data, src.len, 'a');
+#endif
+}
+
+COOKDEF void cook_ascii_replace(char *dst, cook_string_view_t src, char from, char to) {
+#ifdef COOK__SIMD_X86
+    if (src.len >= 32 && cook__cpu_avx2()) cook__ascii_replace_avx2(dst, src.data, src.len, from, to);
+    else cook__ascii_replace_sse2(dst, src.data, src.len, from, to);
+#else
+    for (size_t i = 0; i < src.len; i++) dst[i] = src.data[i] == from ? to : src.data[i];
+#endif
+}
+
+COOKDEF cook_sv_split_iter_t cook_sv_split_iter(cook_string_view_t sv, cook_string_view_t delims) {
+    return (cook_sv_split_iter_t) {
+        .rest = sv,
+        .delims = cook_byteset_make(delims),
+        .block = NULL,
+        .mask = 0,
+        .done = false
+    };
+}
+
+// cook__byteset_mask64 - membership bits of the first min(@n, 64) bytes of @s
+static uint64_t cook__byteset_mask64(const char *s, size_t n, const cook_byteset_t *set) {
+#ifdef COOK__SIMD_X86
+    if (n >= 64 && cook__cpu_avx2()) return cook__set_mask64_avx2(s, set);
+#endif
+    uint64_t mask = 0;
+    if (n > 64) n = 64;
+    for (size_t i = 0; i < n; i++) mask |= (uint64_t)cook_byteset_has(set, s[i]) << i;
+    return mask;
+}
+
+COOKDEF bool cook_sv_split_next(cook_sv_split_iter_t *it, cook_string_view_t *field) {
+    if (it->done) return false;
+    // delimiters are found a 64-byte block at a time and handed out from
+    // the block mask, so short fields do not each pay for a search
+    const char *end = it->rest.data + it->rest.len;
+    while (!it->mask) {
+        const char *next = it->block ? it->block + 64 : it->rest.data;
+        if (next >= end) {
+            // the last field is the one without a delimiter after it
+            it->done = true;
+            *field = cook__sv_chop_at(&it->rest, COOK_SV_NPOS);
+            return true;
+        }
+        it->block = next;
+        it->mask = cook__byteset_mask64(next, (size_t)(end - next), &it->delims);
+    }
+    size_t i = (size_t)(it->block + cook__ctz64(it->mask) - it->rest.data);
+    it->mask &= it->mask - 1;
+    *field = cook__sv_chop_at(&it->rest, i);
+    return true;
+}
+
+// cook__char_mask64 - bits of the bytes equal to @c among the first min(@n, 64)
+static uint64_t cook__char_mask64(const char *s, size_t n, char c) {
+#ifdef COOK__SIMD_X86
+    if (n >= 64) return cook__cpu_avx2() ? cook__char_mask64_avx2(s, c) : cook__char_mask64_sse2(s, c);
+#endif
+    uint64_t mask = 0;
+    if (n > 64) n = 64;
+    for (size_t i = 0; i < n; i++) mask |= (uint64_t)(s[i] == c) << i;
+    return mask;
+}
+
+COOKDEF cook_sv_line_iter_t cook_sv_line_iter(cook_string_view_t sv) {
+    return (cook_sv_line_iter_t) {
+        .rest = sv,
+        .block = NULL,
+        .mask = 0
+    };
+}
+
+COOKDEF bool cook_sv_line_next(cook_sv_line_iter_t *it, cook_string_view_t *line) {
+    // same block scheme as cook_sv_split_next(), a text that ends with a
+    // newline has no empty line after it
+    while (!it->mask) {
+        if (it->rest.len == 0) return false;
+        const char *end = it->rest.data + it->rest.len;
+        const char *next = it->block ? it->block + 64 : it->rest.data;
+        if (next >= end) {
+            *line = cook__sv_chop_at(&it->rest, COOK_SV_NPOS);
+            return true;
+        }
+        it->block = next;
+        it->mask = cook__char_mask64(next, (size_t)(end - next), '\n');
+    }
+    size_t i = (size_t)(it->block + cook__ctz64(it->mask) - it->rest.data);
+    it->mask &= it->mask - 1;
+    *line = cook__sv_chop_at(&it->rest, i);
+    if (line->len > 0 && line->data[line->len - 1] == '\r') line->len--;
+    return true;
+}
+
+COOKDEF size_t cook_sv_count_lines(cook_string_view_t sv) {
+    if (sv.len == 0) return 0;
+    return cook_sv_count_char(sv, '\n') + (sv.data[sv.len - 1] != '\n');
+}
+
+#define cook__is_digit(c) ((unsigned)((c) - '0') < 10u)
+
+#ifdef COOK__LITTLE_ENDIAN
+// cook__is_8digits - check if 8 bytes loaded little-endian are all '0'-'9'
+static inline bool cook__is_8digits(uint64_t v) {
+    return ((v & 0xF0F0F0F0F0F0F0F0ull) |
+            (((v + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+}
+
+// cook__parse_8digits - value of 8 digit bytes loaded little-endian
+static inline uint32_t cook__parse_8digits(uint64_t v) {
+    v -= 0x3030303030303030ull;
+    v = v*10 + (v >> 8);
+    v = (((v & 0x000000FF000000FFull) * (100 + (1000000ull << 32))) +
+         (((v >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32)))) >> 32;
+    return (uint32_t)v;
+}
+#endif
+
+// cook__parse_uint - parse decimal digits into a value no larger than @max
+//
+// Return: bytes consumed, 0 on no digits or overflow
+static size_t cook__parse_uint(const char *s, size_t n, uint64_t max, uint64_t *out) {
+    size_t i = 0;
+    while (i < n && s[i] == '0') i++;
+    size_t begin = i;
+    uint64_t v = 0;
+#ifdef COOK__LITTLE_ENDIAN
+    // two blocks of 8 digits cannot overflow 64 bits, no checks needed
+    while (i + 8 <= n && i - begin <= 8) {
+        uint64_t block;
+        memcpy(&block, s + i, 8);
+        if (!cook__is_8digits(block)) break;
+        v = v*100000000 + cook__parse_8digits(block);
+        i += 8;
+    }
+#endif
+    for (; i < n && cook__is_digit(s[i]); i++) {
+        unsigned d = (unsigned)(s[i] - '0');
+        if (v > (max - d)/10) return 0;
+        v = v*10 + d;
+    }
+    if (i == 0 || v > max) return 0;
+    *out = v;
+    return i;
+}
+
+// cook__parse_int - parse a signed decimal integer within [@min, @max]
+static size_t cook__parse_int(cook_string_view_t sv, int64_t min, int64_t max, int64_t *out) {
+    size_t sign = sv.len > 0 && (sv.data[0] == '-' || sv.data[0] == '+');
+    bool neg = sign && sv.data[0] == '-';
+    uint64_t limit = neg ? (uint64_t)(-(min + 1)) + 1 : (uint64_t)max;
+    uint64_t v;
+    size_t n = cook__parse_uint(sv.data + sign, sv.len - sign, limit, &v);
+    if (n == 0) return 0;
+    // -(v - 1) - 1 stays in range for v = 2^63
+    *out = neg ? (v ? -(int64_t)(v - 1) - 1 : 0) : (int64_t)v;
+    return n + sign;
+}
+
+COOKDEF size_t cook_sv_parse_u64(cook_string_view_t sv, uint64_t *out) {
+    size_t sign = sv.len > 0 && sv.data[0] == '+';
+    size_t n = cook__parse_uint(sv.data + sign, sv.len - sign, UINT64_MAX, out);
+    return n ? n + sign : 0;
+}
+
+COOKDEF size_t cook_sv_parse_u32(cook_string_view_t sv, uint32_t *out) {
+    uint64_t v;
+    size_t sign = sv.len > 0 && sv.data[0] == '+';
+    size_t n = cook__parse_uint(sv.data + sign, sv.len - sign, UINT32_MAX, &v);
+    if (n == 0) return 0;
+    *out = (uint32_t)v;
+    return n + sign;
+}
+
+COOKDEF size_t cook_sv_parse_u16(cook_string_view_t sv, uint16_t *out) {
+    uint64_t v;
+    size_t sign = sv.len > 0 && sv.data[0] == '+';
+    size_t n = cook__parse_uint(sv.data + sign, sv.len - sign, UINT16_MAX, &v);
+    if (n == 0) return 0;
+    *out = (uint16_t)v;
+    return n + sign;
+}
+
+COOKDEF size_t cook_sv_parse_u8(cook_string_view_t sv, uint8_t *out) {
+    uint64_t v;
+    size_t sign = sv.len > 0 && sv.data[0] == '+';
+    size_t n = cook__parse_uint(sv.data + sign, sv.len - sign, UINT8_MAX, &v);
+    if (n == 0) return 0;
+    *out = (uint8_t)v;
+    return n + sign;
+}
+
+COOKDEF size_t cook_sv_parse_i64(cook_string_view_t sv, int64_t *out) {
+    return cook__parse_int(sv, INT64_MIN, INT64_MAX, out);
+}
+
+COOKDEF size_t cook_sv_parse_i32(cook_string_view_t sv, int32_t *out) {
+    int64_t v;
+    size_t n = cook__parse_int(sv, INT32_MIN, INT32_MAX, &v);
+    if (n) *out = (int32_t)v;
+    return n;
+}
+
+COOKDEF size_t cook_sv_parse_i16(cook_string_view_t sv, int16_t *out) {
+    int64_t v;
+    size_t n = cook__parse_int(sv, INT16_MIN, INT16_MAX, &v);
+    if (n) *out = (int16_t)v;
+    return n;
+}
+
+COOKDEF size_t cook_sv_parse_i8(cook_string_view_t sv, int8_t *out) {
+    int64_t v;
+    size_t n = cook__parse_int(sv, INT8_MIN, INT8_MAX, &v);
+    if (n) *out = (int8_t)v;
+    return n;
+}
+
+// cook__hex_value - value of a hex digit, 16 if @c is not one
+static unsigned cook__hex_value(char c) {
+    if (cook__is_digit(c)) return (unsigned)(c - '0');
+    unsigned lower = (unsigned)(c | 0x20) - 'a';
+    return lower < 6 ? lower + 10 : 16;
+}
+
+COOKDEF size_t cook_sv_parse_hex(cook_string_view_t sv, uint64_t *out) {
+    size_t i = 0;
+    if (sv.len > 2 && sv.data[0] == '0' && (sv.data[1] | 0x20) == 'x' && cook__hex_value(sv.data[2]) < 16) i = 2;
+    size_t begin = i;
+    uint64_t v = 0;
+    for (; i < sv.len; i++) {
+        unsigned d = cook__hex_value(sv.data[i]);
+        if (d >= 16) break;
+        if (v >> 60) return 0;
+        v = v << 4 | d;
+    }
+    if (i == begin) return 0;
+    *out = v;
+    return i;
+}
+
+// Truncated 128-bit approximations of 5^q for q in [-342, 324], two 64-bit
+// words (high, low) per power, normalized so the top bit is set. Generated
+// the same way as the table of the fast_float library; the parser stops at
+// 308, the float formatter needs the powers down to the smallest subnormal.
+static const uint64_t cook__pow5_128[] = {
+    0xeef453d6923bd65aull, 0x113faa2906a13b3full,
+    0x9558b4661b6565f8ull, 0x4ac7ca59a424c507ull,
+    0xbaaee17fa23ebf76ull, 0x5d79bcf00d2df649ull,
+    0xe95a99df8ace6f53ull, 0xf4d82c2c107973dcull,
+    0x91d8a02bb6c10594ull, 0x79071b9b8a4be869ull,
+    0xb64ec836a47146f9ull, 0x9748e2826cdee284ull,
+    0xe3e27a444d8d98b7ull, 0xfd1b1b2308169b25ull,
+    0x8e6d8c6ab0787f72ull, 0xfe30f0f5e50e20f7ull,
+    0xb208ef855c969f4full, 0xbdbd2d335e51a935ull,
+    0xde8b2b66b3bc4723ull, 0xad2c788035e61382ull,
+    0x8b16fb203055ac76ull, 0x4c3bcb5021afcc31ull,
+    0xaddcb9e83c6b1793ull, 0xdf4abe242a1bbf3dull,
+    0xd953e8624b85dd78ull, 0xd71d6dad34a2af0dull,
+    0x87d4713d6f33aa6bull, 0x8672648c40e5ad68ull,
+    0xa9c98d8ccb009506ull, 0x680efdaf511f18c2ull,
+    0xd43bf0effdc0ba48ull, 0x0212bd1b2566def2ull,
+    0x84a57695fe98746dull, 0x014bb630f7604b57ull,
+    0xa5ced43b7e3e9188ull, 0x419ea3bd35385e2dull,
+    0xcf42894a5dce35eaull, 0x52064cac828675b9ull,
+    0x818995ce7aa0e1b2ull, 0x7343efebd1940993ull,
+    0xa1ebfb4219491a1full, 0x1014ebe6c5f90bf8ull,
+    0xca66fa129f9b60a6ull, 0xd41a26e077774ef6ull,
+    0xfd00b897478238d0ull, 0x8920b098955522b4ull,
+    0x9e20735e8cb16382ull, 0x55b46e5f5d5535b0ull,
+    0xc5a890362fddbc62ull, 0xeb2189f734aa831dull,
+    0xf712b443bbd52b7bull, 0xa5e9ec7501d523e4ull,
+    0x9a6bb0aa55653b2dull, 0x47b233c92125366eull,
+    0xc1069cd4eabe89f8ull, 0x999ec0bb696e840aull,
+    0xf148440a256e2c76ull, 0xc00670ea43ca250dull,
+    0x96cd2a865764dbcaull, 0x380406926a5e5728ull,
+    0xbc807527ed3e12bcull, 0xc605083704f5ecf2ull,
+    0xeba09271e88d976bull, 0xf7864a44c633682eull,
+    0x93445b8731587ea3ull, 0x7ab3ee6afbe0211dull,
+    0xb8157268fdae9e4cull, 0x5960ea05bad82964ull,
+    0xe61acf033d1a45dfull, 0x6fb92487298e33bdull,
+    0x8fd0c16206306babull, 0xa5d3b6d479f8e056ull,
+    0xb3c4f1ba87bc8696ull, 0x8f48a4899877186cull,
+    0xe0b62e2929aba83cull, 0x331acdabfe94de87ull,
+    0x8c71dcd9ba0b4925ull, 0x9ff0c08b7f1d0b14ull,
+    0xaf8e5410288e1b6full, 0x07ecf0ae5ee44dd9ull,
+    0xdb71e91432b1a24aull, 0xc9e82cd9f69d6150ull,
+    0x892731ac9faf056eull, 0xbe311c083a225cd2ull,
+    0xab70fe17c79ac6caull, 0x6dbd630a48aaf406ull,
+    0xd64d3d9db981787dull, 0x092cbbccdad5b108ull,
+    0x85f0468293f0eb4eull, 0x25bbf56008c58ea5ull,
+    0xa76c582338ed2621ull, 0xaf2af2b80af6f24eull,
+    0xd1476e2c07286faaull, 0x1af5af660db4aee1ull,
+    0x82cca4db847945caull, 0x50d98d9fc890ed4dull,
+    0xa37fce126597973cull, 0xe50ff107bab528a0ull,
+    0xcc5fc196fefd7d0cull, 0x1e53ed49a96272c8ull,
+    0xff77b1fcbebcdc4full, 0x25e8e89c13bb0f7aull,
+    0x9faacf3df73609b1ull, 0x77b191618c54e9acull,
+    0xc795830d75038c1dull, 0xd59df5b9ef6a2417ull,
+    0xf97ae3d0d2446f25ull, 0x4b0573286b44ad1dull,
+    0x9becce62836ac577ull, 0x4ee367f9430aec32ull,
+    0xc2e801fb244576d5ull, 0x229c41f793cda73full,
+    0xf3a20279ed56d48aull, 0x6b43527578c1110full,
+    0x9845418c345644d6ull, 0x830a13896b78aaa9ull,
+    0xbe5691ef416bd60cull, 0x23cc986bc656d553ull,
+    0xedec366b11c6cb8full, 0x2cbfbe86b7ec8aa8ull,
+    0x94b3a202eb1c3f39ull, 0x7bf7d71432f3d6a9ull,
+    0xb9e08a83a5e34f07ull, 0xdaf5ccd93fb0cc53ull,
+    0xe858ad248f5c22c9ull, 0xd1b3400f8f9cff68ull,
+    0x91376c36d99995beull, 0x23100809b9c21fa1ull,
+    0xb58547448ffffb2dull, 0xabd40a0c2832a78aull,
+    0xe2e69915b3fff9f9ull, 0x16c90c8f323f516cull,
+    0x8dd01fad907ffc3bull, 0xae3da7d97f6792e3ull,
+    0xb1442798f49ffb4aull, 0x99cd11cfdf41779cull,
+    0xdd95317f31c7fa1dull, 0x40405643d711d583ull,
+    0x8a7d3eef7f1cfc52ull, 0x482835ea666b2572ull,
+    0xad1c8eab5ee43b66ull, 0xda3243650005eecfull,
+    0xd863b256369d4a40ull, 0x90bed43e40076a82ull,
+    0x873e4f75e2224e68ull, 0x5a7744a6e804a291ull,
+    0xa90de3535aaae202ull, 0x711515d0a205cb36ull,
+    0xd3515c2831559a83ull, 0x0d5a5b44ca873e03ull,
+    0x8412d9991ed58091ull, 0xe858790afe9486c2ull,
+    0xa5178fff668ae0b6ull, 0x626e974dbe39a872ull,
+    0xce5d73ff402d98e3ull, 0xfb0a3d212dc8128full,
+    0x80fa687f881c7f8eull, 0x7ce66634bc9d0b99ull,
+    0xa139029f6a239f72ull, 0x1c1fffc1ebc44e80ull,
+    0xc987434744ac874eull, 0xa327ffb266b56220ull,
+    0xfbe9141915d7a922ull, 0x4bf1ff9f0062baa8ull,
+    0x9d71ac8fada6c9b5ull, 0x6f773fc3603db4a9ull,
+    0xc4ce17b399107c22ull, 0xcb550fb4384d21d3ull,
+    0xf6019da07f549b2bull, 0x7e2a53a146606a48ull,
+    0x99c102844f94e0fbull, 0x2eda7444cbfc426dull,
+    0xc0314325637a1939ull, 0xfa911155fefb5308ull,
+    0xf03d93eebc589f88ull, 0x793555ab7eba27caull,
+    0x96267c7535b763b5ull, 0x4bc1558b2f3458deull,
+    0xbbb01b9283253ca2ull, 0x9eb1aaedfb016f16ull,
+    0xea9c227723ee8bcbull, 0x465e15a979c1cadcull,
+    0x92a1958a7675175full, 0x0bfacd89ec191ec9ull,
+    0xb749faed14125d36ull, 0xcef980ec671f667bull,
+    0xe51c79a85916f484ull, 0x82b7e12780e7401aull,
+    0x8f31cc0937ae58d2ull, 0xd1b2ecb8b0908810ull,
+    0xb2fe3f0b8599ef07ull, 0x861fa7e6dcb4aa15ull,
+    0xdfbdcece67006ac9ull, 0x67a791e093e1d49aull,
+    0x8bd6a141006042bdull, 0xe0c8bb2c5c6d24e0ull,
+    0xaecc49914078536dull, 0x58fae9f773886e18ull,
+    0xda7f5bf590966848ull, 0xaf39a475506a899eull,
+    0x888f99797a5e012dull, 0x6d8406c952429603ull,
+    0xaab37fd7d8f58178ull, 0xc8e5087ba6d33b83ull,
+    0xd5605fcdcf32e1d6ull, 0xfb1e4a9a90880a64ull,
+    0x855c3be0a17fcd26ull, 0x5cf2eea09a55067full,
+    0xa6b34ad8c9dfc06full, 0xf42faa48c0ea481eull,
+    0xd0601d8efc57b08bull, 0xf13b94daf124da26ull,
+    0x823c12795db6ce57ull, 0x76c53d08d6b70858ull,
+    0xa2cb1717b52481edull, 0x54768c4b0c64ca6eull,
+    0xcb7ddcdda26da268ull, 0xa9942f5dcf7dfd09ull,
+    0xfe5d54150b090b02ull, 0xd3f93b35435d7c4cull,
+    0x9efa548d26e5a6e1ull, 0xc47bc5014a1a6dafull,
+    0xc6b8e9b0709f109aull, 0x359ab6419ca1091bull,
+    0xf867241c8cc6d4c0ull, 0xc30163d203c94b62ull,
+    0x9b407691d7fc44f8ull, 0x79e0de63425dcf1dull,
+    0xc21094364dfb5636ull, 0x985915fc12f542e4ull,
+    0xf294b943e17a2bc4ull, 0x3e6f5b7b17b2939dull,
+    0x979cf3ca6cec5b5aull, 0xa705992ceecf9c42ull,
+    0xbd8430bd08277231ull, 0x50c6ff782a838353ull,
+    0xece53cec4a314ebdull, 0xa4f8bf5635246428ull,
+    0x940f4613ae5ed136ull, 0x871b7795e136be99ull,
+    0xb913179899f68584ull, 0x28e2557b59846e3full,
+    0xe757dd7ec07426e5ull, 0x331aeada2fe589cfull,
+    0x9096ea6f3848984full, 0x3ff0d2c85def7621ull,
+    0xb4bca50b065abe63ull, 0x0fed077a756b53a9ull,
+    0xe1ebce4dc7f16dfbull, 0xd3e8495912c62894ull,
+    0x8d3360f09cf6e4bdull, 0x64712dd7abbbd95cull,
+    0xb080392cc4349decull, 0xbd8d794d96aacfb3ull,
+    0xdca04777f541c567ull, 0xecf0d7a0fc5583a0ull,
+    0x89e42caaf9491b60ull, 0xf41686c49db57244ull,
+    0xac5d37d5b79b6239ull, 0x311c2875c522ced5ull,
+    0xd77485cb25823ac7ull, 0x7d633293366b828bull,
+    0x86a8d39ef77164bcull, 0xae5dff9c02033197ull,
+    0xa8530886b54dbdebull, 0xd9f57f830283fdfcull,
+    0xd267caa862a12d66ull, 0xd072df63c324fd7bull,
+    0x8380dea93da4bc60ull, 0x4247cb9e59f71e6dull,
+    0xa46116538d0deb78ull, 0x52d9be85f074e608ull,
+    0xcd795be870516656ull, 0x67902e276c921f8bull,
+    0x806bd9714632dff6ull, 0x00ba1cd8a3db53b6ull,
+    0xa086cfcd97bf97f3ull, 0x80e8a40eccd228a4ull,
+    0xc8a883c0fdaf7df0ull, 0x6122cd128006b2cdull,
+    0xfad2a4b13d1b5d6cull, 0x796b805720085f81ull,
+    0x9cc3a6eec6311a63ull, 0xcbe3303674053bb0ull,
+    0xc3f490aa77bd60fcull, 0xbedbfc4411068a9cull,
+    0xf4f1b4d515acb93bull, 0xee92fb5515482d44ull,
+    0x991711052d8bf3c5ull, 0x751bdd152d4d1c4aull,
+    0xbf5cd54678eef0b6ull, 0xd262d45a78a0635dull,
+    0xef340a98172aace4ull, 0x86fb897116c87c34ull,
+    0x9580869f0e7aac0eull, 0xd45d35e6ae3d4da0ull,
+    0xbae0a846d2195712ull, 0x8974836059cca109ull,
+    0xe998d258869facd7ull, 0x2bd1a438703fc94bull,
+    0x91ff83775423cc06ull, 0x7b6306a34627ddcfull,
+    0xb67f6455292cbf08ull, 0x1a3bc84c17b1d542ull,
+    0xe41f3d6a7377eecaull, 0x20caba5f1d9e4a93ull,
+    0x8e938662882af53eull, 0x547eb47b7282ee9cull,
+    0xb23867fb2a35b28dull, 0xe99e619a4f23aa43ull,
+    0xdec681f9f4c31f31ull, 0x6405fa00e2ec94d4ull,
+    0x8b3c113c38f9f37eull, 0xde83bc408dd3dd04ull,
+    0xae0b158b4738705eull, 0x9624ab50b148d445ull,
+    0xd98ddaee19068c76ull, 0x3badd624dd9b0957ull,
+    0x87f8a8d4cfa417c9ull, 0xe54ca5d70a80e5d6ull,
+    0xa9f6d30a038d1dbcull, 0x5e9fcf4ccd211f4cull,
+    0xd47487cc8470652bull, 0x7647c3200069671full,
+    0x84c8d4dfd2c63f3bull, 0x29ecd9f40041e073ull,
+    0xa5fb0a17c777cf09ull, 0xf468107100525890ull,
+    0xcf79cc9db955c2ccull, 0x7182148d4066eeb4ull,
+    0x81ac1fe293d599bfull, 0xc6f14cd848405530ull,
+    0xa21727db38cb002full, 0xb8ada00e5a506a7cull,
+    0xca9cf1d206fdc03bull, 0xa6d90811f0e4851cull,
+    0xfd442e4688bd304aull, 0x908f4a166d1da663ull,
+    0x9e4a9cec15763e2eull, 0x9a598e4e043287feull,
+    0xc5dd44271ad3cdbaull, 0x40eff1e1853f29fdull,
+    0xf7549530e188c128ull, 0xd12bee59e68ef47cull,
+    0x9a94dd3e8cf578b9ull, 0x82bb74f8301958ceull,
+    0xc13a148e3032d6e7ull, 0xe36a52363c1faf01ull,
+    0xf18899b1bc3f8ca1ull, 0xdc44e6c3cb279ac1ull,
+    0x96f5600f15a7b7e5ull, 0x29ab103a5ef8c0b9ull,
+    0xbcb2b812db11a5deull, 0x7415d448f6b6f0e7ull,
+    0xebdf661791d60f56ull, 0x111b495b3464ad21ull,
+    0x936b9fcebb25c995ull, 0xcab10dd900beec34ull,
+    0xb84687c269ef3bfbull, 0x3d5d514f40eea742ull,
+    0xe65829b3046b0afaull, 0x0cb4a5a3112a5112ull,
+    0x8ff71a0fe2c2e6dcull, 0x47f0e785eaba72abull,
+    0xb3f4e093db73a093ull, 0x59ed216765690f56ull,
+    0xe0f218b8d25088b8ull, 0x306869c13ec3532cull,
+    0x8c974f7383725573ull, 0x1e414218c73a13fbull,
+    0xafbd2350644eeacfull, 0xe5d1929ef90898faull,
+    0xdbac6c247d62a583ull, 0xdf45f746b74abf39ull,
+    0x894bc396ce5da772ull, 0x6b8bba8c328eb783ull,
+    0xab9eb47c81f5114full, 0x066ea92f3f326564ull,
+    0xd686619ba27255a2ull, 0xc80a537b0efefebdull,
+    0x8613fd0145877585ull, 0xbd06742ce95f5f36ull,
+    0xa798fc4196e952e7ull, 0x2c48113823b73704ull,
+    0xd17f3b51fca3a7a0ull, 0xf75a15862ca504c5ull,
+    0x82ef85133de648c4ull, 0x9a984d73dbe722fbull,
+    0xa3ab66580d5fdaf5ull, 0xc13e60d0d2e0ebbaull,
+    0xcc963fee10b7d1b3ull, 0x318df905079926a8ull,
+    0xffbbcfe994e5c61full, 0xfdf17746497f7052ull,
+    0x9fd561f1fd0f9bd3ull, 0xfeb6ea8bedefa633ull,
+    0xc7caba6e7c5382c8ull, 0xfe64a52ee96b8fc0ull,
+    0xf9bd690a1b68637bull, 0x3dfdce7aa3c673b0ull,
+    0x9c1661a651213e2dull, 0x06bea10ca65c084eull,
+    0xc31bfa0fe5698db8ull, 0x486e494fcff30a62ull,
+    0xf3e2f893dec3f126ull, 0x5a89dba3c3efccfaull,
+    0x986ddb5c6b3a76b7ull, 0xf89629465a75e01cull,
+    0xbe89523386091465ull, 0xf6bbb397f1135823ull,
+    0xee2ba6c0678b597full, 0x746aa07ded582e2cull,
+    0x94db483840b717efull, 0xa8c2a44eb4571cdcull,
+    0xba121a4650e4ddebull, 0x92f34d62616ce413ull,
+    0xe896a0d7e51e1566ull, 0x77b020baf9c81d17ull,
+    0x915e2486ef32cd60ull, 0x0ace1474dc1d122eull,
+    0xb5b5ada8aaff80b8ull, 0x0d819992132456baull,
+    0xe3231912d5bf60e6ull, 0x10e1fff697ed6c69ull,
+    0x8df5efabc5979c8full, 0xca8d3ffa1ef463c1ull,
+    0xb1736b96b6fd83b3ull, 0xbd308ff8a6b17cb2ull,
+    0xddd0467c64bce4a0ull, 0xac7cb3f6d05ddbdeull,
+    0x8aa22c0dbef60ee4ull, 0x6bcdf07a423aa96bull,
+    0xad4ab7112eb3929dull, 0x86c16c98d2c953c6ull,
+    0xd89d64d57a607744ull, 0xe871c7bf077ba8b7ull,
+    0x87625f056c7c4a8bull, 0x11471cd764ad4972ull,
+    0xa93af6c6c79b5d2dull, 0xd598e40d3dd89bcfull,
+    0xd389b47879823479ull, 0x4aff1d108d4ec2c3ull,
+    0x843610cb4bf160cbull, 0xcedf722a585139baull,
+    0xa54394fe1eedb8feull, 0xc2974eb4ee658828ull,
+    0xce947a3da6a9273eull, 0x733d226229feea32ull,
+    0x811ccc668829b887ull, 0x0806357d5a3f525full,
+    0xa163ff802a3426a8ull, 0xca07c2dcb0cf26f7ull,
+    0xc9bcff6034c13052ull, 0xfc89b393dd02f0b5ull,
+    0xfc2c3f3841f17c67ull, 0xbbac2078d443ace2ull,
+    0x9d9ba7832936edc0ull, 0xd54b944b84aa4c0dull,
+    0xc5029163f384a931ull, 0x0a9e795e65d4df11ull,
+    0xf64335bcf065d37dull, 0x4d4617b5ff4a16d5ull,
+    0x99ea0196163fa42eull, 0x504bced1bf8e4e45ull,
+    0xc06481fb9bcf8d39ull, 0xe45ec2862f71e1d6ull,
+    0xf07da27a82c37088ull, 0x5d767327bb4e5a4cull,
+    0x964e858c91ba2655ull, 0x3a6a07f8d510f86full,
+    0xbbe226efb628afeaull, 0x890489f70a55368bull,
+    0xeadab0aba3b2dbe5ull, 0x2b45ac74ccea842eull,
+    0x92c8ae6b464fc96full, 0x3b0b8bc90012929dull,
+    0xb77ada0617e3bbcbull, 0x09ce6ebb40173744ull,
+    0xe55990879ddcaabdull, 0xcc420a6a101d0515ull,
+    0x8f57fa54c2a9eab6ull, 0x9fa946824a12232dull,
+    0xb32df8e9f3546564ull, 0x47939822dc96abf9ull,
+    0xdff9772470297ebdull, 0x59787e2b93bc56f7ull,
+    0x8bfbea76c619ef36ull, 0x57eb4edb3c55b65aull,
+    0xaefae51477a06b03ull, 0xede622920b6b23f1ull,
+    0xdab99e59958885c4ull, 0xe95fab368e45ecedull,
+    0x88b402f7fd75539bull, 0x11dbcb0218ebb414ull,
+    0xaae103b5fcd2a881ull, 0xd652bdc29f26a119ull,
+    0xd59944a37c0752a2ull, 0x4be76d3346f0495full,
+    0x857fcae62d8493a5ull, 0x6f70a4400c562ddbull,
+    0xa6dfbd9fb8e5b88eull, 0xcb4ccd500f6bb952ull,
+    0xd097ad07a71f26b2ull, 0x7e2000a41346a7a7ull,
+    0x825ecc24c873782full, 0x8ed400668c0c28c8ull,
+    0xa2f67f2dfa90563bull, 0x728900802f0f32faull,
+    0xcbb41ef979346bcaull, 0x4f2b40a03ad2ffb9ull,
+    0xfea126b7d78186bcull, 0xe2f610c84987bfa8ull,
+    0x9f24b832e6b0f436ull, 0x0dd9ca7d2df4d7c9ull,
+    0xc6ede63fa05d3143ull, 0x91503d1c79720dbbull,
+    0xf8a95fcf88747d94ull, 0x75a44c6397ce912aull,
+    0x9b69dbe1b548ce7cull, 0xc986afbe3ee11abaull,
+    0xc24452da229b021bull, 0xfbe85badce996168ull,
+    0xf2d56790ab41c2a2ull, 0xfae27299423fb9c3ull,
+    0x97c560ba6b0919a5ull, 0xdccd879fc967d41aull,
+    0xbdb6b8e905cb600full, 0x5400e987bbc1c920ull,
+    0xed246723473e3813ull, 0x290123e9aab23b68ull,
+    0x9436c0760c86e30bull, 0xf9a0b6720aaf6521ull,
+    0xb94470938fa89bceull, 0xf808e40e8d5b3e69ull,
+    0xe7958cb87392c2c2ull, 0xb60b1d1230b20e04ull,
+    0x90bd77f3483bb9b9ull, 0xb1c6f22b5e6f48c2ull,
+    0xb4ecd5f01a4aa828ull, 0x1e38aeb6360b1af3ull,
+    0xe2280b6c20dd5232ull, 0x25c6da63c38de1b0ull,
+    0x8d590723948a535full, 0x579c487e5a38ad0eull,
+    0xb0af48ec79ace837ull, 0x2d835a9df0c6d851ull,
+    0xdcdb1b2798182244ull, 0xf8e431456cf88e65ull,
+    0x8a08f0f8bf0f156bull, 0x1b8e9ecb641b58ffull,
+    0xac8b2d36eed2dac5ull, 0xe272467e3d222f3full,
+    0xd7adf884aa879177ull, 0x5b0ed81dcc6abb0full,
+    0x86ccbb52ea94baeaull, 0x98e947129fc2b4e9ull,
+    0xa87fea27a539e9a5ull, 0x3f2398d747b36224ull,
+    0xd29fe4b18e88640eull, 0x8eec7f0d19a03aadull,
+    0x83a3eeeef9153e89ull, 0x1953cf68300424acull,
+    0xa48ceaaab75a8e2bull, 0x5fa8c3423c052dd7ull,
+    0xcdb02555653131b6ull, 0x3792f412cb06794dull,
+    0x808e17555f3ebf11ull, 0xe2bbd88bbee40bd0ull,
+    0xa0b19d2ab70e6ed6ull, 0x5b6aceaeae9d0ec4ull,
+    0xc8de047564d20a8bull, 0xf245825a5a445275ull,
+    0xfb158592be068d2eull, 0xeed6e2f0f0d56712ull,
+    0x9ced737bb6c4183dull, 0x55464dd69685606bull,
+    0xc428d05aa4751e4cull, 0xaa97e14c3c26b886ull,
+    0xf53304714d9265dfull, 0xd53dd99f4b3066a8ull,
+    0x993fe2c6d07b7fabull, 0xe546a8038efe4029ull,
+    0xbf8fdb78849a5f96ull, 0xde98520472bdd033ull,
+    0xef73d256a5c0f77cull, 0x963e66858f6d4440ull,
+    0x95a8637627989aadull, 0xdde7001379a44aa8ull,
+    0xbb127c53b17ec159ull, 0x5560c018580d5d52ull,
+    0xe9d71b689dde71afull, 0xaab8f01e6e10b4a6ull,
+    0x9226712162ab070dull, 0xcab3961304ca70e8ull,
+    0xb6b00d69bb55c8d1ull, 0x3d607b97c5fd0d22ull,
+    0xe45c10c42a2b3b05ull, 0x8cb89a7db77c506aull,
+    0x8eb98a7a9a5b04e3ull, 0x77f3608e92adb242ull,
+    0xb267ed1940f1c61cull, 0x55f038b237591ed3ull,
+    0xdf01e85f912e37a3ull, 0x6b6c46dec52f6688ull,
+    0x8b61313bbabce2c6ull, 0x2323ac4b3b3da015ull,
+    0xae397d8aa96c1b77ull, 0xabec975e0a0d081aull,
+    0xd9c7dced53c72255ull, 0x96e7bd358c904a21ull,
+    0x881cea14545c7575ull, 0x7e50d64177da2e54ull,
+    0xaa242499697392d2ull, 0xdde50bd1d5d0b9e9ull,
+    0xd4ad2dbfc3d07787ull, 0x955e4ec64b44e864ull,
+    0x84ec3c97da624ab4ull, 0xbd5af13bef0b113eull,
+    0xa6274bbdd0fadd61ull, 0xecb1ad8aeacdd58eull,
+    0xcfb11ead453994baull, 0x67de18eda5814af2ull,
+    0x81ceb32c4b43fcf4ull, 0x80eacf948770ced7ull,
+    0xa2425ff75e14fc31ull, 0xa1258379a94d028dull,
+    0xcad2f7f5359a3b3eull, 0x096ee45813a04330ull,
+    0xfd87b5f28300ca0dull, 0x8bca9d6e188853fcull,
+    0x9e74d1b791e07e48ull, 0x775ea264cf55347eull,
+    0xc612062576589ddaull, 0x95364afe032a819eull,
+    0xf79687aed3eec551ull, 0x3a83ddbd83f52205ull,
+    0x9abe14cd44753b52ull, 0xc4926a9672793543ull,
+    0xc16d9a0095928a27ull, 0x75b7053c0f178294ull,
+    0xf1c90080baf72cb1ull, 0x5324c68b12dd6339ull,
+    0x971da05074da7beeull, 0xd3f6fc16ebca5e04ull,
+    0xbce5086492111aeaull, 0x88f4bb1ca6bcf585ull,
+    0xec1e4a7db69561a5ull, 0x2b31e9e3d06c32e6ull,
+    0x9392ee8e921d5d07ull, 0x3aff322e62439fd0ull,
+    0xb877aa3236a4b449ull, 0x09befeb9fad487c3ull,
+    0xe69594bec44de15bull, 0x4c2ebe687989a9b4ull,
+    0x901d7cf73ab0acd9ull, 0x0f9d37014bf60a11ull,
+    0xb424dc35095cd80full, 0x538484c19ef38c95ull,
+    0xe12e13424bb40e13ull, 0x2865a5f206b06fbaull,
+    0x8cbccc096f5088cbull, 0xf93f87b7442e45d4ull,
+    0xafebff0bcb24aafeull, 0xf78f69a51539d749ull,
+    0xdbe6fecebdedd5beull, 0xb573440e5a884d1cull,
+    0x89705f4136b4a597ull, 0x31680a88f8953031ull,
+    0xabcc77118461cefcull, 0xfdc20d2b36ba7c3eull,
+    0xd6bf94d5e57a42bcull, 0x3d32907604691b4dull,
+    0x8637bd05af6c69b5ull, 0xa63f9a49c2c1b110ull,
+    0xa7c5ac471b478423ull, 0x0fcf80dc33721d54ull,
+    0xd1b71758e219652bull, 0xd3c36113404ea4a9ull,
+    0x83126e978d4fdf3bull, 0x645a1cac083126eaull,
+    0xa3d70a3d70a3d70aull, 0x3d70a3d70a3d70a4ull,
+    0xccccccccccccccccull, 0xcccccccccccccccdull,
+    0x8000000000000000ull, 0x0000000000000000ull,
+    0xa000000000000000ull, 0x0000000000000000ull,
+    0xc800000000000000ull, 0x0000000000000000ull,
+    0xfa00000000000000ull, 0x0000000000000000ull,
+    0x9c40000000000000ull, 0x0000000000000000ull,
+    0xc350000000000000ull, 0x0000000000000000ull,
+    0xf424000000000000ull, 0x0000000000000000ull,
+    0x9896800000000000ull, 0x0000000000000000ull,
+    0xbebc200000000000ull, 0x0000000000000000ull,
+    0xee6b280000000000ull, 0x0000000000000000ull,
+    0x9502f90000000000ull, 0x0000000000000000ull,
+    0xba43b74000000000ull, 0x0000000000000000ull,
+    0xe8d4a51000000000ull, 0x0000000000000000ull,
+    0x9184e72a00000000ull, 0x0000000000000000ull,
+    0xb5e620f480000000ull, 0x0000000000000000ull,
+    0xe35fa931a0000000ull, 0x0000000000000000ull,
+    0x8e1bc9bf04000000ull, 0x0000000000000000ull,
+    0xb1a2bc2ec5000000ull, 0x0000000000000000ull,
+    0xde0b6b3a76400000ull, 0x0000000000000000ull,
+    0x8ac7230489e80000ull, 0x0000000000000000ull,
+    0xad78ebc5ac620000ull, 0x0000000000000000ull,
+    0xd8d726b7177a8000ull, 0x0000000000000000ull,
+    0x878678326eac9000ull, 0x0000000000000000ull,
+    0xa968163f0a57b400ull, 0x0000000000000000ull,
+    0xd3c21bcecceda100ull, 0x0000000000000000ull,
+    0x84595161401484a0ull, 0x0000000000000000ull,
+    0xa56fa5b99019a5c8ull, 0x0000000000000000ull,
+    0xcecb8f27f4200f3aull, 0x0000000000000000ull,
+    0x813f3978f8940984ull, 0x4000000000000000ull,
+    0xa18f07d736b90be5ull, 0x5000000000000000ull,
+    0xc9f2c9cd04674edeull, 0xa400000000000000ull,
+    0xfc6f7c4045812296ull, 0x4d00000000000000ull,
+    0x9dc5ada82b70b59dull, 0xf020000000000000ull,
+    0xc5371912364ce305ull, 0x6c28000000000000ull,
+    0xf684df56c3e01bc6ull, 0xc732000000000000ull,
+    0x9a130b963a6c115cull, 0x3c7f400000000000ull,
+    0xc097ce7bc90715b3ull, 0x4b9f100000000000ull,
+    0xf0bdc21abb48db20ull, 0x1e86d40000000000ull,
+    0x96769950b50d88f4ull, 0x1314448000000000ull,
+    0xbc143fa4e250eb31ull, 0x17d955a000000000ull,
+    0xeb194f8e1ae525fdull, 0x5dcfab0800000000ull,
+    0x92efd1b8d0cf37beull, 0x5aa1cae500000000ull,
+    0xb7abc627050305adull, 0xf14a3d9e40000000ull,
+    0xe596b7b0c643c719ull, 0x6d9ccd05d0000000ull,
+    0x8f7e32ce7bea5c6full, 0xe4820023a2000000ull,
+    0xb35dbf821ae4f38bull, 0xdda2802c8a800000ull,
+    0xe0352f62a19e306eull, 0xd50b2037ad200000ull,
+    0x8c213d9da502de45ull, 0x4526f422cc340000ull,
+    0xaf298d050e4395d6ull, 0x9670b12b7f410000ull,
+    0xdaf3f04651d47b4cull, 0x3c0cdd765f114000ull,
+    0x88d8762bf324cd0full, 0xa5880a69fb6ac800ull,
+    0xab0e93b6efee0053ull, 0x8eea0d047a457a00ull,
+    0xd5d238a4abe98068ull, 0x72a4904598d6d880ull,
+    0x85a36366eb71f041ull, 0x47a6da2b7f864750ull,
+    0xa70c3c40a64e6c51ull, 0x999090b65f67d924ull,
+    0xd0cf4b50cfe20765ull, 0xfff4b4e3f741cf6dull,
+    0x82818f1281ed449full, 0xbff8f10e7a8921a4ull,
+    0xa321f2d7226895c7ull, 0xaff72d52192b6a0dull,
+    0xcbea6f8ceb02bb39ull, 0x9bf4f8a69f764490ull,
+    0xfee50b7025c36a08ull, 0x02f236d04753d5b4ull,
+    0x9f4f2726179a2245ull, 0x01d762422c946590ull,
+    0xc722f0ef9d80aad6ull, 0x424d3ad2b7b97ef5ull,
+    0xf8ebad2b84e0d58bull, 0xd2e0898765a7deb2ull,
+    0x9b934c3b330c8577ull, 0x63cc55f49f88eb2full,
+    0xc2781f49ffcfa6d5ull, 0x3cbf6b71c76b25fbull,
+    0xf316271c7fc3908aull, 0x8bef464e3945ef7aull,
+    0x97edd871cfda3a56ull, 0x97758bf0e3cbb5acull,
+    0xbde94e8e43d0c8ecull, 0x3d52eeed1cbea317ull,
+    0xed63a231d4c4fb27ull, 0x4ca7aaa863ee4bddull,
+    0x945e455f24fb1cf8ull, 0x8fe8caa93e74ef6aull,
+    0xb975d6b6ee39e436ull, 0xb3e2fd538e122b44ull,
+    0xe7d34c64a9c85d44ull, 0x60dbbca87196b616ull,
+    0x90e40fbeea1d3a4aull, 0xbc8955e946fe31cdull,
+    0xb51d13aea4a488ddull, 0x6babab6398bdbe41ull,
+    0xe264589a4dcdab14ull, 0xc696963c7eed2dd1ull,
+    0x8d7eb76070a08aecull, 0xfc1e1de5cf543ca2ull,
+    0xb0de65388cc8ada8ull, 0x3b25a55f43294bcbull,
+    0xdd15fe86affad912ull, 0x49ef0eb713f39ebeull,
+    0x8a2dbf142dfcc7abull, 0x6e3569326c784337ull,
+    0xacb92ed9397bf996ull, 0x49c2c37f07965404ull,
+    0xd7e77a8f87daf7fbull, 0xdc33745ec97be906ull,
+    0x86f0ac99b4e8dafdull, 0x69a028bb3ded71a3ull,
+    0xa8acd7c0222311bcull, 0xc40832ea0d68ce0cull,
+    0xd2d80db02aabd62bull, 0xf50a3fa490c30190ull,
+    0x83c7088e1aab65dbull, 0x792667c6da79e0faull,
+    0xa4b8cab1a1563f52ull, 0x577001b891185938ull,
+    0xcde6fd5e09abcf26ull, 0xed4c0226b55e6f86ull,
+    0x80b05e5ac60b6178ull, 0x544f8158315b05b4ull,
+    0xa0dc75f1778e39d6ull, 0x696361ae3db1c721ull,
+    0xc913936dd571c84cull, 0x03bc3a19cd1e38e9ull,
+    0xfb5878494ace3a5full, 0x04ab48a04065c723ull,
+    0x9d174b2dcec0e47bull, 0x62eb0d64283f9c76ull,
+    0xc45d1df942711d9aull, 0x3ba5d0bd324f8394ull,
+    0xf5746577930d6500ull, 0xca8f44ec7ee36479ull,
+    0x9968bf6abbe85f20ull, 0x7e998b13cf4e1ecbull,
+    0xbfc2ef456ae276e8ull, 0x9e3fedd8c321a67eull,
+    0xefb3ab16c59b14a2ull, 0xc5cfe94ef3ea101eull,
+    0x95d04aee3b80ece5ull, 0xbba1f1d158724a12ull,
+    0xbb445da9ca61281full, 0x2a8a6e45ae8edc97ull,
+    0xea1575143cf97226ull, 0xf52d09d71a3293bdull,
+    0x924d692ca61be758ull, 0x593c2626705f9c56ull,
+    0xb6e0c377cfa2e12eull, 0x6f8b2fb00c77836cull,
+    0xe498f455c38b997aull, 0x0b6dfb9c0f956447ull,
+    0x8edf98b59a373fecull, 0x4724bd4189bd5eacull,
+    0xb2977ee300c50fe7ull, 0x58edec91ec2cb657ull,
+    0xdf3d5e9bc0f653e1ull, 0x2f2967b66737e3edull,
+    0x8b865b215899f46cull, 0xbd79e0d20082ee74ull,
+    0xae67f1e9aec07187ull, 0xecd8590680a3aa11ull,
+    0xda01ee641a708de9ull, 0xe80e6f4820cc9495ull,
+    0x884134fe908658b2ull, 0x3109058d147fdcddull,
+    0xaa51823e34a7eedeull, 0xbd4b46f0599fd415ull,
+    0xd4e5e2cdc1d1ea96ull, 0x6c9e18ac7007c91aull,
+    0x850fadc09923329eull, 0x03e2cf6bc604ddb0ull,
+    0xa6539930bf6bff45ull, 0x84db8346b786151cull,
+    0xcfe87f7cef46ff16ull, 0xe612641865679a63ull,
+    0x81f14fae158c5f6eull, 0x4fcb7e8f3f60c07eull,
+    0xa26da3999aef7749ull, 0xe3be5e330f38f09dull,
+    0xcb090c8001ab551cull, 0x5cadf5bfd3072cc5ull,
+    0xfdcb4fa002162a63ull, 0x73d9732fc7c8f7f6ull,
+    0x9e9f11c4014dda7eull, 0x2867e7fddcdd9afaull,
+    0xc646d63501a1511dull, 0xb281e1fd541501b8ull,
+    0xf7d88bc24209a565ull, 0x1f225a7ca91a4226ull,
+    0x9ae757596946075full, 0x3375788de9b06958ull,
+    0xc1a12d2fc3978937ull, 0x0052d6b1641c83aeull,
+    0xf209787bb47d6b84ull, 0xc0678c5dbd23a49aull,
+    0x9745eb4d50ce6332ull, 0xf840b7ba963646e0ull,
+    0xbd176620a501fbffull, 0xb650e5a93bc3d898ull,
+    0xec5d3fa8ce427affull, 0xa3e51f138ab4cebeull,
+    0x93ba47c980e98cdfull, 0xc66f336c36b10137ull,
+    0xb8a8d9bbe123f017ull, 0xb80b0047445d4184ull,
+    0xe6d3102ad96cec1dull, 0xa60dc059157491e5ull,
+    0x9043ea1ac7e41392ull, 0x87c89837ad68db2full,
+    0xb454e4a179dd1877ull, 0x29babe4598c311fbull,
+    0xe16a1dc9d8545e94ull, 0xf4296dd6fef3d67aull,
+    0x8ce2529e2734bb1dull, 0x1899e4a65f58660cull,
+    0xb01ae745b101e9e4ull, 0x5ec05dcff72e7f8full,
+    0xdc21a1171d42645dull, 0x76707543f4fa1f73ull,
+    0x899504ae72497ebaull, 0x6a06494a791c53a8ull,
+    0xabfa45da0edbde69ull, 0x0487db9d17636892ull,
+    0xd6f8d7509292d603ull, 0x45a9d2845d3c42b6ull,
+    0x865b86925b9bc5c2ull, 0x0b8a2392ba45a9b2ull,
+    0xa7f26836f282b732ull, 0x8e6cac7768d7141eull,
+    0xd1ef0244af2364ffull, 0x3207d795430cd926ull,
+    0x8335616aed761f1full, 0x7f44e6bd49e807b8ull,
+    0xa402b9c5a8d3a6e7ull, 0x5f16206c9c6209a6ull,
+    0xcd036837130890a1ull, 0x36dba887c37a8c0full,
+    0x802221226be55a64ull, 0xc2494954da2c9789ull,
+    0xa02aa96b06deb0fdull, 0xf2db9baa10b7bd6cull,
+    0xc83553c5c8965d3dull, 0x6f92829494e5acc7ull,
+    0xfa42a8b73abbf48cull, 0xcb772339ba1f17f9ull,
+    0x9c69a97284b578d7ull, 0xff2a760414536efbull,
+    0xc38413cf25e2d70dull, 0xfef5138519684abaull,
+    0xf46518c2ef5b8cd1ull, 0x7eb258665fc25d69ull,
+    0x98bf2f79d5993802ull, 0xef2f773ffbd97a61ull,
+    0xbeeefb584aff8603ull, 0xaafb550ffacfd8faull,
+    0xeeaaba2e5dbf6784ull, 0x95ba2a53f983cf38ull,
+    0x952ab45cfa97a0b2ull, 0xdd945a747bf26183ull,
+    0xba756174393d88dfull, 0x94f971119aeef9e4ull,
+    0xe912b9d1478ceb17ull, 0x7a37cd5601aab85dull,
+    0x91abb422ccb812eeull, 0xac62e055c10ab33aull,
+    0xb616a12b7fe617aaull, 0x577b986b314d6009ull,
+    0xe39c49765fdf9d94ull, 0xed5a7e85fda0b80bull,
+    0x8e41ade9fbebc27dull, 0x14588f13be847307ull,
+    0xb1d219647ae6b31cull, 0x596eb2d8ae258fc8ull,
+    0xde469fbd99a05fe3ull, 0x6fca5f8ed9aef3bbull,
+    0x8aec23d680043beeull, 0x25de7bb9480d5854ull,
+    0xada72ccc20054ae9ull, 0xaf561aa79a10ae6aull,
+    0xd910f7ff28069da4ull, 0x1b2ba1518094da04ull,
+    0x87aa9aff79042286ull, 0x90fb44d2f05d0842ull,
+    0xa99541bf57452b28ull, 0x353a1607ac744a53ull,
+    0xd3fa922f2d1675f2ull, 0x42889b8997915ce8ull,
+    0x847c9b5d7c2e09b7ull, 0x69956135febada11ull,
+    0xa59bc234db398c25ull, 0x43fab9837e699095ull,
+    0xcf02b2c21207ef2eull, 0x94f967e45e03f4bbull,
+    0x8161afb94b44f57dull, 0x1d1be0eebac278f5ull,
+    0xa1ba1ba79e1632dcull, 0x6462d92a69731732ull,
+    0xca28a291859bbf93ull, 0x7d7b8f7503cfdcfeull,
+    0xfcb2cb35e702af78ull, 0x5cda735244c3d43eull,
+    0x9defbf01b061adabull, 0x3a0888136afa64a7ull,
+    0xc56baec21c7a1916ull, 0x088aaa1845b8fdd0ull,
+    0xf6c69a72a3989f5bull, 0x8aad549e57273d45ull,
+    0x9a3c2087a63f6399ull, 0x36ac54e2f678864bull,
+    0xc0cb28a98fcf3c7full, 0x84576a1bb416a7ddull,
+    0xf0fdf2d3f3c30b9full, 0x656d44a2a11c51d5ull,
+    0x969eb7c47859e743ull, 0x9f644ae5a4b1b325ull,
+    0xbc4665b596706114ull, 0x873d5d9f0dde1feeull,
+    0xeb57ff22fc0c7959ull, 0xa90cb506d155a7eaull,
+    0x9316ff75dd87cbd8ull, 0x09a7f12442d588f2ull,
+    0xb7dcbf5354e9beceull, 0x0c11ed6d538aeb2full,
+    0xe5d3ef282a242e81ull, 0x8f1668c8a86da5faull,
+    0x8fa475791a569d10ull, 0xf96e017d694487bcull,
+    0xb38d92d760ec4455ull, 0x37c981dcc395a9acull,
+    0xe070f78d3927556aull, 0x85bbe253f47b1417ull,
+    0x8c469ab843b89562ull, 0x93956d7478ccec8eull,
+    0xaf58416654a6babbull, 0x387ac8d1970027b2ull,
+    0xdb2e51bfe9d0696aull, 0x06997b05fcc0319eull,
+    0x88fcf317f22241e2ull, 0x441fece3bdf81f03ull,
+    0xab3c2fddeeaad25aull, 0xd527e81cad7626c3ull,
+    0xd60b3bd56a5586f1ull, 0x8a71e223d8d3b074ull,
+    0x85c7056562757456ull, 0xf6872d5667844e49ull,
+    0xa738c6bebb12d16cull, 0xb428f8ac016561dbull,
+    0xd106f86e69d785c7ull, 0xe13336d701beba52ull,
+    0x82a45b450226b39cull, 0xecc0024661173473ull,
+    0xa34d721642b06084ull, 0x27f002d7f95d0190ull,
+    0xcc20ce9bd35c78a5ull, 0x31ec038df7b441f4ull,
+    0xff290242c83396ceull, 0x7e67047175a15271ull,
+    0x9f79a169bd203e41ull, 0x0f0062c6e984d386ull,
+    0xc75809c42c684dd1ull, 0x52c07b78a3e60868ull,
+    0xf92e0c3537826145ull, 0xa7709a56ccdf8a82ull,
+    0x9bbcc7a142b17ccbull, 0x88a66076400bb691ull,
+    0xc2abf989935ddbfeull, 0x6acff893d00ea435ull,
+    0xf356f7ebf83552feull, 0x0583f6b8c4124d43ull,
+    0x98165af37b2153deull, 0xc3727a337a8b704aull,
+    0xbe1bf1b059e9a8d6ull, 0x744f18c0592e4c5cull,
+    0xeda2ee1c7064130cull, 0x1162def06f79df73ull,
+    0x9485d4d1c63e8be7ull, 0x8addcb5645ac2ba8ull,
+    0xb9a74a0637ce2ee1ull, 0x6d953e2bd7173692ull,
+    0xe8111c87c5c1ba99ull, 0xc8fa8db6ccdd0437ull,
+    0x910ab1d4db9914a0ull, 0x1d9c9892400a22a2ull,
+    0xb54d5e4a127f59c8ull, 0x2503beb6d00cab4bull,
+    0xe2a0b5dc971f303aull, 0x2e44ae64840fd61dull,
+    0x8da471a9de737e24ull, 0x5ceaecfed289e5d2ull,
+    0xb10d8e1456105dadull, 0x7425a83e872c5f47ull,
+    0xdd50f1996b947518ull, 0xd12f124e28f77719ull,
+    0x8a5296ffe33cc92full, 0x82bd6b70d99aaa6full,
+    0xace73cbfdc0bfb7bull, 0x636cc64d1001550bull,
+    0xd8210befd30efa5aull, 0x3c47f7e05401aa4eull,
+    0x8714a775e3e95c78ull, 0x65acfaec34810a71ull,
+    0xa8d9d1535ce3b396ull, 0x7f1839a741a14d0dull,
+    0xd31045a8341ca07cull, 0x1ede48111209a050ull,
+    0x83ea2b892091e44dull, 0x934aed0aab460432ull,
+    0xa4e4b66b68b65d60ull, 0xf81da84d5617853full,
+    0xce1de40642e3f4b9ull, 0x36251260ab9d668eull,
+    0x80d2ae83e9ce78f3ull, 0xc1d72b7c6b426019ull,
+    0xa1075a24e4421730ull, 0xb24cf65b8612f81full,
+    0xc94930ae1d529cfcull, 0xdee033f26797b627ull,
+    0xfb9b7cd9a4a7443cull, 0x169840ef017da3b1ull,
+    0x9d412e0806e88aa5ull, 0x8e1f289560ee864eull,
+    0xc491798a08a2ad4eull, 0xf1a6f2bab92a27e2ull,
+    0xf5b5d7ec8acb58a2ull, 0xae10af696774b1dbull,
+    0x9991a6f3d6bf1765ull, 0xacca6da1e0a8ef29ull,
+    0xbff610b0cc6edd3full, 0x17fd090a58d32af3ull,
+    0xeff394dcff8a948eull, 0xddfc4b4cef07f5b0ull,
+    0x95f83d0a1fb69cd9ull, 0x4abdaf101564f98eull,
+    0xbb764c4ca7a4440full, 0x9d6d1ad41abe37f1ull,
+    0xea53df5fd18d5513ull, 0x84c86189216dc5edull,
+    0x92746b9be2f8552cull, 0x32fd3cf5b4e49bb4ull,
+    0xb7118682dbb66a77ull, 0x3fbc8c33221dc2a1ull,
+    0xe4d5e82392a40515ull, 0x0fabaf3feaa5334aull,
+    0x8f05b1163ba6832dull, 0x29cb4d87f2a7400eull,
+    0xb2c71d5bca9023f8ull, 0x743e20e9ef511012ull,
+    0xdf78e4b2bd342cf6ull, 0x914da9246b255416ull,
+    0x8bab8eefb6409c1aull, 0x1ad089b6c2f7548eull,
+    0xae9672aba3d0c320ull, 0xa184ac2473b529b1ull,
+    0xda3c0f568cc4f3e8ull, 0xc9e5d72d90a2741eull,
+    0x8865899617fb1871ull, 0x7e2fa67c7a658892ull,
+    0xaa7eebfb9df9de8dull, 0xddbb901b98feeab7ull,
+    0xd51ea6fa85785631ull, 0x552a74227f3ea565ull,
+    0x8533285c936b35deull, 0xd53a88958f87275full,
+    0xa67ff273b8460356ull, 0x8a892abaf368f137ull,
+    0xd01fef10a657842cull, 0x2d2b7569b0432d85ull,
+    0x8213f56a67f6b29bull, 0x9c3b29620e29fc73ull,
+    0xa298f2c501f45f42ull, 0x8349f3ba91b47b8full,
+    0xcb3f2f7642717713ull, 0x241c70a936219a73ull,
+    0xfe0efb53d30dd4d7ull, 0xed238cd383aa0110ull,
+    0x9ec95d1463e8a506ull, 0xf4363804324a40aaull,
+    0xc67bb4597ce2ce48ull, 0xb143c6053edcd0d5ull,
+    0xf81aa16fdc1b81daull, 0xdd94b7868e94050aull,
+    0x9b10a4e5e9913128ull, 0xca7cf2b4191c8326ull,
+    0xc1d4ce1f63f57d72ull, 0xfd1c2f611f63a3f0ull,
+    0xf24a01a73cf2dccfull, 0xbc633b39673c8cecull,
+    0x976e41088617ca01ull, 0xd5be0503e085d813ull,
+    0xbd49d14aa79dbc82ull, 0x4b2d8644d8a74e18ull,
+    0xec9c459d51852ba2ull, 0xddf8e7d60ed1219eull,
+    0x93e1ab8252f33b45ull, 0xcabb90e5c942b503ull,
+    0xb8da1662e7b00a17ull, 0x3d6a751f3b936243ull,
+    0xe7109bfba19c0c9dull, 0x0cc512670a783ad4ull,
+    0x906a617d450187e2ull, 0x27fb2b80668b24c5ull,
+    0xb484f9dc9641e9daull, 0xb1f9f660802dedf6ull,
+    0xe1a63853bbd26451ull, 0x5e7873f8a0396973ull,
+    0x8d07e33455637eb2ull, 0xdb0b487b6423e1e8ull,
+    0xb049dc016abc5e5full, 0x91ce1a9a3d2cda62ull,
+    0xdc5c5301c56b75f7ull, 0x7641a140cc7810fbull,
+    0x89b9b3e11b6329baull, 0xa9e904c87fcb0a9dull,
+    0xac2820d9623bf429ull, 0x546345fa9fbdcd44ull,
+    0xd732290fbacaf133ull, 0xa97c177947ad4095ull,
+    0x867f59a9d4bed6c0ull, 0x49ed8eabcccc485dull,
+    0xa81f301449ee8c70ull, 0x5c68f256bfff5a74ull,
+    0xd226fc195c6a2f8cull, 0x73832eec6fff3111ull,
+    0x83585d8fd9c25db7ull, 0xc831fd53c5ff7eabull,
+    0xa42e74f3d032f525ull, 0xba3e7ca8b77f5e55ull,
+    0xcd3a1230c43fb26full, 0x28ce1bd2e55f35ebull,
+    0x80444b5e7aa7cf85ull, 0x7980d163cf5b81b3ull,
+    0xa0555e361951c366ull, 0xd7e105bcc332621full,
+    0xc86ab5c39fa63440ull, 0x8dd9472bf3fefaa7ull,
+    0xfa856334878fc150ull, 0xb14f98f6f0feb951ull,
+    0x9c935e00d4b9d8d2ull, 0x6ed1bf9a569f33d3ull,
+    0xc3b8358109e84f07ull, 0x0a862f80ec4700c8ull,
+    0xf4a642e14c6262c8ull, 0xcd27bb612758c0faull,
+    0x98e7e9cccfbd7dbdull, 0x8038d51cb897789cull,
+    0xbf21e44003acdd2cull, 0xe0470a63e6bd56c3ull,
+    0xeeea5d5004981478ull, 0x1858ccfce06cac74ull,
+    0x95527a5202df0ccbull, 0x0f37801e0c43ebc8ull,
+    0xbaa718e68396cffdull, 0xd30560258f54e6baull,
+    0xe950df20247c83fdull, 0x47c6b82ef32a2069ull,
+    0x91d28b7416cdd27eull, 0x4cdc331d57fa5441ull,
+    0xb6472e511c81471dull, 0xe0133fe4adf8e952ull,
+    0xe3d8f9e563a198e5ull, 0x58180fddd97723a6ull,
+    0x8e679c2f5e44ff8full, 0x570f09eaa7ea7648ull,
+    0xb201833b35d63f73ull, 0x2cd2cc6551e513daull,
+    0xde81e40a034bcf4full, 0xf8077f7ea65e58d1ull,
+    0x8b112e86420f6191ull, 0xfb04afaf27faf782ull,
+    0xadd57a27d29339f6ull, 0x79c5db9af1f9b563ull,
+    0xd94ad8b1c7380874ull, 0x18375281ae7822bcull,
+    0x87cec76f1c830548ull, 0x8f2293910d0b15b5ull,
+    0xa9c2794ae3a3c69aull, 0xb2eb3875504ddb22ull,
+    0xd433179d9c8cb841ull, 0x5fa60692a46151ebull,
+    0x849feec281d7f328ull, 0xdbc7c41ba6bcd333ull,
+    0xa5c7ea73224deff3ull, 0x12b9b522906c0800ull,
+    0xcf39e50feae16befull, 0xd768226b34870a00ull,
+    0x81842f29f2cce375ull, 0xe6a1158300d46640ull,
+    0xa1e53af46f801c53ull, 0x60495ae3c1097fd0ull,
+    0xca5e89b18b602368ull, 0x385bb19cb14bdfc4ull,
+    0xfcf62c1dee382c42ull, 0x46729e03dd9ed7b5ull,
+    0x9e19db92b4e31ba9ull, 0x6c07a2c26a8346d1ull,
+};
+
+#define COOK__POW5_MIN_Q (-342)
+
+// binary layout of the target type for the float parser
+typedef struct cook__float_format {
+    int mantissa_bits;   // explicit mantissa bits
+    int sign_bit;        // index of the sign bit
+    int min_exponent;    // exponent bias, negated
+    int infinite_power;  // biased exponent of inf/nan
+    int min_round_even;  // q range where halfway cases can be exact
+    int max_round_even;
+    int smallest_pow10;  // below: always rounds to zero
+    int largest_pow10;   // above: always rounds to inf
+    int fast_max_pow10;  // exact powers of ten in the type
+    uint64_t fast_max_mantissa;
+} cook__float_format_t;
+
+static const cook__float_format_t cook__binary64 = {52, 63, -1023, 0x7FF, -4, 23, -342, 308, 22, 1ull << 53};
+static const cook__float_format_t cook__binary32 = {23, 31, -127, 0xFF, -17, 10, -65, 38, 10, 1ull << 24};
+
+// a decimal number as scanned: w * 10^e10, with w holding the first 19
+// significant digits
+typedef struct cook__decimal {
+    uint64_t w;
+    int64_t e10;
+    bool neg;
+    bool truncated; // non-zero digits were dropped after the first 19
+    int special;    // 0, or 'i' for infinity, 'n' for nan
+} cook__decimal_t;
+
+// cook__match_word - case-insensitive match of lowercase @word at @s
+static bool cook__match_word(const char *s, size_t n, const char *word) {
+    size_t i = 0;
+    for (; word[i]; i++) {
+        if (i >= n || (s[i] | 0x20) != word[i]) return false;
+    }
+    return true;
+}
+
+// cook__scan_decimal - parse the syntax of a decimal float
+//
+// Return: bytes consumed, 0 if @s does not start with a number
+static size_t cook__scan_decimal(const char *s, size_t n, cook__decimal_t *d) {
+    size_t i = 0;
+    d->w = 0;
+    d->e10 = 0;
+    d->neg = false;
+    d->truncated = false;
+    d->special = 0;
+    if (i < n && (s[i] == '-' || s[i] == '+')) d->neg = s[i++] == '-';
+
+    uint64_t w = 0;
+    int64_t e10 = 0;
+    int taken = 0; // significant digits in w
+    size_t digits_begin = i;
+    for (; i < n && cook__is_digit(s[i]); i++) {
+#ifdef COOK__LITTLE_ENDIAN
+        if (w != 0 && taken <= 19 - 8 && i + 8 <= n) {
+            uint64_t block;
+            memcpy(&block, s + i, 8);
+            if (cook__is_8digits(block)) {
+                w = w*100000000 + cook__parse_8digits(block);
+                taken += 8;
+                i += 7;
+                continue;
+            }
+        }
+#endif
+        unsigned digit = (unsigned)(s[i] - '0');
+        if (taken < 19) {
+            w = w*10 + digit;
+            taken += w != 0;
+        } else {
+            e10++;
+            d->truncated |= digit != 0;
+        }
+    }
+    size_t int_digits = i - digits_begin;
+
+    size_t frac_digits = 0;
+    if (i < n && s[i] == '.') {
+        size_t frac_begin = ++i;
+        for (; i < n && cook__is_digit(s[i]); i++) {
+#ifdef COOK__LITTLE_ENDIAN
+            if (w != 0 && taken <= 19 - 8 && i + 8 <= n) {
+                uint64_t block;
+                memcpy(&block, s + i, 8);
+                if (cook__is_8digits(block)) {
+                    w = w*100000000 + cook__parse_8digits(block);
+                    taken += 8;
+                    e10 -= 8;
+                    i += 7;
+                    continue;
+                }
+            }
+#endif
+            unsigned digit = (unsigned)(s[i] - '0');
+            if (taken < 19) {
+                w = w*10 + digit;
+                taken += w != 0;
+                e10--;
+            } else {
+                d->truncated |= digit != 0;
+            }
+        }
+        frac_digits = i - frac_begin;
+        if (int_digits == 0 && frac_digits == 0) i--; // a lone '.' is not part of it
+    }
+
+    if (int_digits == 0 && frac_digits == 0) {
+        size_t begin = i;
+        if (cook__match_word(s + i, n - i, "infinity")) i += 8;
+        else if (cook__match_word(s + i, n - i, "inf")) i += 3;
+        else if (cook__match_word(s + i, n - i, "nan")) i += 3;
+        else return 0;
+        d->special = (s[begin] | 0x20) == 'i' ? 'i' : 'n';
+        return i;
+    }
+
+    if (i < n && (s[i] | 0x20) == 'e') {
+        size_t j = i + 1;
+        bool exp_neg = false;
+        if (j < n && (s[j] == '-' || s[j] == '+')) exp_neg = s[j++] == '-';
+        if (j < n && cook__is_digit(s[j])) {
+            int64_t exp = 0;
+            for (; j < n && cook__is_digit(s[j]); j++) {
+                // anything this large is inf or zero already
+                if (exp < 100000) exp = exp*10 + (s[j] - '0');
+            }
+            e10 += exp_neg ? -exp : exp;
+            i = j;
+        }
+    }
+
+    d->w = w;
+    d->e10 = e10;
+    return i;
+}
+
+// cook__mul128 - full 64x64 -> 128-bit product
+static void cook__mul128(uint64_t a, uint64_t b, uint64_t *hi, uint64_t *lo) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 r = (unsigned __int128)a*b;
+    *hi = (uint64_t)(r >> 64);
+    *lo = (uint64_t)r;
+#else
+    uint64_t a_lo = (uint32_t)a, a_hi = a >> 32, b_lo = (uint32_t)b, b_hi = b >> 32;
+    uint64_t ll = a_lo*b_lo, lh = a_lo*b_hi, hl = a_hi*b_lo, hh = a_hi*b_hi;
+    uint64_t mid = (ll >> 32) + (uint32_t)lh + (uint32_t)hl;
+    *lo = (mid << 32) | (uint32_t)ll;
+    *hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif
+}
+
+// cook__eisel_lemire - round w * 10^q to the binary format @f
+// @mantissa: receives the explicit mantissa bits
+// @power2: receives the biased exponent
+//
+// Return: false if the product was not precise enough to decide the
+//         rounding, the result may then be one float off
+static bool cook__eisel_lemire(uint64_t w, int64_t q, const cook__float_format_t *f,
+                               uint64_t *mantissa, int32_t *power2) {
+    if (w == 0 || q < f->smallest_pow10) {
+        *mantissa = 0;
+        *power2 = 0;
+        return true;
+    }
+    if (q > f->largest_pow10) {
+        *mantissa = 0;
+        *power2 = f->infinite_power;
+        return true;
+    }
+
+    int lz = (int)cook__clz64(w);
+    w <<= lz;
+
+    // the top mantissa_bits + 3 bits of w * 5^q, using the second table
+    // word only when the first product leaves them undecided
+    const uint64_t *pow5 = &cook__pow5_128[2*(q - COOK__POW5_MIN_Q)];
+    uint64_t hi, lo;
+    cook__mul128(w, pow5[0], &hi, &lo);
+    uint64_t precision_mask = UINT64_MAX >> (f->mantissa_bits + 3);
+    bool exact = true;
+    if ((hi & precision_mask) == precision_mask) {
+        uint64_t hi2, lo2;
+        cook__mul128(w, pow5[1], &hi2, &lo2);
+        lo += hi2;
+        if (hi2 > lo) hi++;
+        exact = lo != UINT64_MAX || (q >= -27 && q <= 55);
+    }
+
+    int upperbit = (int)(hi >> 63);
+    int shift = upperbit + 64 - f->mantissa_bits - 3;
+    uint64_t m = hi >> shift;
+    // floor(log2(10^q)) + 63, valid for |q| < 1700
+    int32_t p2 = (int32_t)((((152170 + 65536)*q) >> 16) + 63) + upperbit - lz - f->min_exponent;
+
+    if (p2 <= 0) {
+        // subnormal or zero
+        if (-p2 + 1 >= 64) {
+            *mantissa = 0;
+            *power2 = 0;
+            return exact;
+        }
+        m >>= -p2 + 1;
+        m += m & 1;
+        m >>= 1;
+        *power2 = m < (1ull << f->mantissa_bits) ? 0 : 1;
+        *mantissa = m & ~(1ull << f->mantissa_bits);
+        return exact;
+    }
+
+    // exactly halfway between two floats: round to even
+    if (lo <= 1 && q >= f->min_round_even && q <= f->max_round_even && (m & 3) == 1 && (m << shift) == hi) {
+        m &= ~(uint64_t)1;
+    }
+    m += m & 1;
+    m >>= 1;
+    if (m >= (2ull << f->mantissa_bits)) {
+        m = 1ull << f->mantissa_bits;
+        p2++;
+    }
+    m &= ~(1ull << f->mantissa_bits);
+    if (p2 >= f->infinite_power) {
+        p2 = f->infinite_power;
+        m = 0;
+    }
+    *mantissa = m;
+    *power2 = p2;
+    return exact;
+}
+
+// The slow path compares the decimal with the point halfway between two
+// neighboring floats exactly, as big integers. A halfway point has at most
+// 767 significant digits, so digits past the first COOK__SLOW_DIGITS only
+// matter when the rest is exactly halfway, and then only whether one of
+// them is non-zero. With 10^e = 5^e * 2^e, the largest operand is about
+// 54 bits times 5^1091, well inside COOK__BIGINT_LIMBS.
+#define COOK__SLOW_DIGITS  768
+#define COOK__BIGINT_LIMBS 128
+
+// unsigned integer, 32-bit limbs, least significant first, no zero limbs
+// at the top
+typedef struct cook__bigint {
+    uint32_t limbs[COOK__BIGINT_LIMBS];
+    size_t len;
+} cook__bigint_t;
+
+// cook__bigint_mul_add - @b = @b * @mul + @add
+static void cook__bigint_mul_add(cook__bigint_t *b, uint32_t mul, uint32_t add) {
+    uint64_t carry = add;
+    for (size_t i = 0; i < b->len; i++) {
+        uint64_t v = (uint64_t)b->limbs[i]*mul + carry;
+        b->limbs[i] = (uint32_t)v;
+        carry = v >> 32;
+    }
+    if (carry != 0) {
+        COOK_ASSERT(b->len < COOK__BIGINT_LIMBS && "big integer overflow");
+        b->limbs[b->len++] = (uint32_t)carry;
+    }
+}
+
+// cook__bigint_mul_pow5 - @b = @b * 5^@e
+static void cook__bigint_mul_pow5(cook__bigint_t *b, uint64_t e) {
+    static const uint32_t pow5[] = {1, 5, 25, 125, 625, 3125, 15625, 78125, 390625, 1953125, 9765625,
+                                    48828125, 244140625, 1220703125};
+    for (; e >= 13; e -= 13) cook__bigint_mul_add(b, pow5[13], 0);
+    if (e > 0) cook__bigint_mul_add(b, pow5[e], 0);
+}
+
+// cook__bigint_shl - @b = @b * 2^@e
+static void cook__bigint_shl(cook__bigint_t *b, uint64_t e) {
+    if (b->len == 0) return;
+    size_t words = (size_t)(e/32);
+    unsigned bits = (unsigned)(e%32);
+    COOK_ASSERT(e/32 + b->len < COOK__BIGINT_LIMBS && "big integer overflow");
+    if (bits != 0) {
+        uint32_t carry = 0;
+        for (size_t i = 0; i < b->len; i++) {
+            uint32_t v = b->limbs[i];
+            b->limbs[i] = v << bits | carry;
+            carry = v >> (32 - bits);
+        }
+        if (carry != 0) b->limbs[b->len++] = carry;
+    }
+    if (words != 0) {
+        memmove(b->limbs + words, b->limbs, b->len*sizeof(*b->limbs));
+        memset(b->limbs, 0, words*sizeof(*b->limbs));
+        b->len += words;
+    }
+}
+
+static int cook__bigint_cmp(const cook__bigint_t *a, const cook__bigint_t *b) {
+    if (a->len != b->len) return a->len < b->len ? -1 : 1;
+    for (size_t i = a->len; i-- > 0;) {
+        if (a->limbs[i] != b->limbs[i]) return a->limbs[i] < b->limbs[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+// the digits of a decimal as scanned by cook__scan_decimal(): digits * 10^e10
+typedef struct cook__big_decimal {
+    cook__bigint_t digits; // the first COOK__SLOW_DIGITS significant digits
+    int64_t e10;
+    bool sticky;           // non-zero digits were dropped after those
+} cook__big_decimal_t;
+
+// cook__scan_big_decimal - read all the digits of the @n bytes that
+// cook__scan_decimal() consumed
+static void cook__scan_big_decimal(const char *s, size_t n, cook__big_decimal_t *d) {
+    static const uint32_t pow10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+    size_t i = 0, taken = 0;
+    uint32_t chunk = 0;
+    int chunk_len = 0;
+    bool frac = false;
+    d->digits.len = 0;
+    d->e10 = 0;
+    d->sticky = false;
+    if (i < n && (s[i] == '-' || s[i] == '+')) i++;
+    for (; i < n; i++) {
+        if (s[i] == '.') {
+            frac = true;
+            continue;
+        }
+        if (!cook__is_digit(s[i])) break;
+        unsigned digit = (unsigned)(s[i] - '0');
+        if (taken == COOK__SLOW_DIGITS) {
+            d->sticky |= digit != 0;
+            d->e10 += !frac;
+            continue;
+        }
+        d->e10 -= frac;
+        if (taken == 0 && digit == 0) continue;
+        chunk = chunk*10 + digit;
+        taken++;
+        if (++chunk_len == 9) {
+            cook__bigint_mul_add(&d->digits, pow10[9], chunk);
+            chunk = 0;
+            chunk_len = 0;
+        }
+    }
+    if (chunk_len > 0) cook__bigint_mul_add(&d->digits, pow10[chunk_len], chunk);
+    // the same exponent syntax and clamp as cook__scan_decimal()
+    if (i < n && (s[i] | 0x20) == 'e') {
+        bool exp_neg = false;
+        if (++i < n && (s[i] == '-' || s[i] == '+')) exp_neg = s[i++] == '-';
+        int64_t exp = 0;
+        for (; i < n && cook__is_digit(s[i]); i++) {
+            if (exp < 100000) exp = exp*10 + (s[i] - '0');
+        }
+        d->e10 += exp_neg ? -exp : exp;
+    }
+}
+
+// cook__cmp_halfway - compare @d with the point halfway between the
+// positive float @bits and the next one up
+//
+// Return: <0, 0 or >0 as @d is below, at or above that point
+static int cook__cmp_halfway(const cook__big_decimal_t *d, const cook__float_format_t *f, uint64_t bits) {
+    uint64_t m = bits & ((1ull << f->mantissa_bits) - 1);
+    int64_t p2 = (int64_t)(bits >> f->mantissa_bits);
+    if (p2 == 0) p2 = 1;
+    else m |= 1ull << f->mantissa_bits;
+    // halfway is (2m + 1) * 2^e2
+    int64_t e2 = p2 + f->min_exponent - f->mantissa_bits - 1;
+
+    uint64_t half = 2*m + 1;
+    cook__bigint_t lhs = d->digits, rhs;
+    rhs.limbs[0] = (uint32_t)half;
+    rhs.limbs[1] = (uint32_t)(half >> 32);
+    rhs.len = rhs.limbs[1] != 0 ? 2 : 1;
+    if (d->e10 >= 0) cook__bigint_mul_pow5(&lhs, (uint64_t)d->e10);
+    else cook__bigint_mul_pow5(&rhs, (uint64_t)-d->e10);
+    if (d->e10 >= e2) cook__bigint_shl(&lhs, (uint64_t)(d->e10 - e2));
+    else cook__bigint_shl(&rhs, (uint64_t)(e2 - d->e10));
+    int cmp = cook__bigint_cmp(&lhs, &rhs);
+    return cmp == 0 && d->sticky ? 1 : cmp;
+}
+
+// cook__round_slow - the float nearest to the @n bytes at @s, starting
+// from @bits, a positive float at most one off
+static uint64_t cook__round_slow(const char *s, size_t n, const cook__float_format_t *f, uint64_t bits) {
+    cook__big_decimal_t d;
+    cook__scan_big_decimal(s, n, &d);
+    uint64_t inf = (uint64_t)f->infinite_power << f->mantissa_bits;
+    for (;;) {
+        // ties go to the even one
+        int cmp;
+        if (bits < inf && ((cmp = cook__cmp_halfway(&d, f, bits)) > 0 || (cmp == 0 && (bits & 1)))) {
+            bits++;
+        } else if (bits > 0 && ((cmp = cook__cmp_halfway(&d, f, bits - 1)) < 0 || (cmp == 0 && (bits & 1)))) {
+            bits--;
+        } else {
+            return bits;
+        }
+    }
+}
+
+// cook__decimal_to_bits - bit pattern of the float nearest to @d, which
+// cook__scan_decimal() read from the @n bytes at @s
+static uint64_t cook__decimal_to_bits(const cook__decimal_t *d, const char *s, size_t n, const cook__float_format_t *f) {
+    uint64_t m;
+    int32_t p2;
+    if (d->special) {
+        m = d->special == 'n' ? 1ull << (f->mantissa_bits - 1) : 0;
+        p2 = f->infinite_power;
+    } else {
+        bool exact = cook__eisel_lemire(d->w, d->e10, f, &m, &p2);
+        if (exact && d->truncated) {
+            // the dropped digits lie between w and w + 1
+            uint64_t m_up;
+            int32_t p2_up;
+            exact = cook__eisel_lemire(d->w + 1, d->e10, f, &m_up, &p2_up) && m == m_up && p2 == p2_up;
+        }
+        if (!exact) {
+            uint64_t bits = cook__round_slow(s, n, f, m | (uint64_t)p2 << f->mantissa_bits);
+            return bits | (uint64_t)d->neg << f->sign_bit;
+        }
+    }
+    return m | (uint64_t)p2 << f->mantissa_bits | (uint64_t)d->neg << f->sign_bit;
+}
+
+static const double cook__pow10_f64[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static const float cook__pow10_f32[] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+
+COOKDEF size_t cook_sv_parse_f64(cook_string_view_t sv, double *out) {
+    cook__decimal_t d;
+    size_t n = cook__scan_decimal(sv.data, sv.len, &d);
+    if (n == 0) return 0;
+
+#if FLT_EVAL_METHOD == 0
+    // w and 10^|e10| are both exact doubles, so one IEEE operation rounds
+    // correctly
+    if (!d.special && !d.truncated && d.w <= cook__binary64.fast_max_mantissa &&
+        d.e10 >= -cook__binary64.fast_max_pow10 && d.e10 <= cook__binary64.fast_max_pow10) {
+        double v = (double)d.w;
+        v = d.e10 < 0 ? v/cook__pow10_f64[-d.e10] : v*cook__pow10_f64[d.e10];
+        *out = d.neg ? -v : v;
+        return n;
+    }
+#endif
+
+    uint64_t bits = cook__decimal_to_bits(&d, sv.data, n, &cook__binary64);
+    memcpy(out, &bits, sizeof(*out));
+    return n;
+}
+
+COOKDEF size_t cook_sv_parse_f32(cook_string_view_t sv, float *out) {
+    cook__decimal_t d;
+    size_t n = cook__scan_decimal(sv.data, sv.len, &d);
+    if (n == 0) return 0;
+
+#if FLT_EVAL_METHOD == 0
+    if (!d.special && !d.truncated && d.w <= cook__binary32.fast_max_mantissa &&
+        d.e10 >= -cook__binary32.fast_max_pow10 && d.e10 <= cook__binary32.fast_max_pow10) {
+        float v = (float)d.w;
+        v = d.e10 < 0 ? v/cook__pow10_f32[-d.e10] : v*cook__pow10_f32[d.e10];
+        *out = d.neg ? -v : v;
+        return n;
+    }
+#endif
+
+    uint32_t bits = (uint32_t)cook__decimal_to_bits(&d, sv.data, n, &cook__binary32);
+    memcpy(out, &bits, sizeof(*out));
+    return n;
+}
+
+COOKDEF void cook_sb_append_sv(cook_string_builder_t *sb, cook_string_view_t sv) {
+    cook_sb_append_parts(sb, sv.data, sv.len);
+}
+
+// cook__copy_short - memcpy() without the call for the short pieces a
+// builder is mostly made of, two fixed size copies that may overlap
+static inline void cook__copy_short(char *dst, const char *src, size_t n) {
+    if (n >= 8 && n <= 16) {
+        memcpy(dst, src, 8);
+        memcpy(dst + n - 8, src + n - 8, 8);
+    } else if (n >= 4 && n < 8) {
+        memcpy(dst, src, 4);
+        memcpy(dst + n - 4, src + n - 4, 4);
+    } else if (n > 0 && n < 4) {
+        dst[0] = src[0];
+        dst[n/2] = src[n/2];
+        dst[n - 1] = src[n - 1];
+    } else if (n > 16) {
+        memcpy(dst, src, n);
+    }
+}
+
+COOKDEF void cook_sb_append_parts(cook_string_builder_t *sb, const void *data, size_t len) {
+    if (len == 0) return;
+    cook_sb_reserve(sb, len);
+    cook__copy_short(cook_vec_end(sb), data, len);
+    sb->len += len;
+}
+
+COOKDEF void cook_sb_reserve(cook_string_builder_t *sb, size_t n) {
+    if (n <= sb->cap - sb->len) return;
+    COOK_ASSERT(n <= SIZE_MAX - sb->len && "string builder too large");
+    size_t need = sb->len + n, cap = sb->cap < COOK_INIT_CAP ? COOK_INIT_CAP : sb->cap;
+    if (cap <= SIZE_MAX/2) cap *= 2;
+    if (cap < need) cap = need;
+    sb->items = COOK__REALLOC(sb->items, cap, "sb");
+    COOK_ASSERT(sb->items && "out of memory");
+    sb->cap = cap;
+}
+
+COOKDEF void cook_sb_concat_n(cook_string_builder_t *sb, const cook_string_view_t *svs, size_t count) {
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) total += svs[i].len;
+    cook_sb_reserve(sb, total);
+    char *p = cook_vec_end(sb);
+    for (size_t i = 0; i < count; i++) {
+        cook__copy_short(p, svs[i].data, svs[i].len);
+        p += svs[i].len;
+    }
+    sb->len += total;
+}
+
+COOKDEF void cook_sb_join(cook_string_builder_t *sb, const cook_string_view_t *svs, size_t count, cook_string_view_t sep) {
+    if (count == 0) return;
+    if (sep.len == 0) {
+        cook_sb_concat_n(sb, svs, count);
+        return;
+    }
+    size_t total = (count - 1)*sep.len;
+    for (size_t i = 0; i < count; i++) total += svs[i].len;
+    cook_sb_reserve(sb, total);
+    char *p = cook_vec_end(sb);
+    cook__copy_short(p, svs[0].data, svs[0].len);
+    p += svs[0].len;
+    for (size_t i = 1; i < count; i++) {
+        cook__copy_short(p, sep.data, sep.len);
+        p += sep.len;
+        cook__copy_short(p, svs[i].data, svs[i].len);
+        p += svs[i].len;
+    }
+    sb->len += total;
+}
+
+COOKDEF void cook_sb_reset(cook_string_builder_t *sb) {
+    cook_vec_reset(sb);
+}
+
+COOKDEF void cook_sb_free(cook_string_builder_t *sb) {
+    cook_vec_free(sb);
+}
+
+COOKDEF cook_string_view_t cook_sb_view(const cook_string_builder_t *sb) {
+    return (cook_string_view_t) {
+        .data = sb->items,
+        .len = sb->len
+    };
+}
+
+COOKDEF void cook_sb_to_lower(cook_string_builder_t *sb) {
+    cook_ascii_lower(sb->items, cook_sb_view(sb));
+}
+
+COOKDEF void cook_sb_to_upper(cook_string_builder_t *sb) {
+    cook_ascii_upper(sb->items, cook_sb_view(sb));
+}
+
+COOKDEF void cook_sb_replace_byte(cook_string_builder_t *sb, char from, char to) {
+    cook_ascii_replace(sb->items, cook_sb_view(sb), from, to);
+}
+
+COOKDEF void cook_sb_appendf(cook_string_builder_t *sb, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    cook_sb_vappendf(sb, fmt, args);
+    va_end(args);
+}
+
+COOKDEF void cook_sb_append(cook_string_builder_t *sb, const char *fmt, ...) {
+    char buf[256];
+    va_list args, copy;
+    va_start(args, fmt);
+    va_copy(copy, args);
+    int len = vsnprintf(buf, sizeof(buf), fmt, copy);
+    va_end(copy);
+    if (len >= 0 && (size_t)len < sizeof(buf)) {
+        cook_sb_append_parts(sb, buf, (size_t)len);
+    } else if (len >= 0) {
+        // the length is known, so allocate it instead of cook_arena_vstrfmt()
+        // measuring the text a second time
+        cook_scratch_t scratch = cook_scratch_get();
+        char *text = cook_arena_alloc(scratch.arena, (size_t)len + 1);
+        vsnprintf(text, (size_t)len + 1, fmt, args);
+        cook_sb_append_parts(sb, text, (size_t)len);
+        cook_scratch_end(scratch);
+    }
+    va_end(args);
+}
+
+COOKDEF void cook_sb_vappendf(cook_string_builder_t *sb, const char *fmt, va_list args) {
+    // leave room for at least a short line, most texts then fit the first time
+    cook_sb_reserve(sb, COOK_INIT_CAP/2);
+    va_list copy;
+    va_copy(copy, args);
+    size_t room = sb->cap - sb->len;
+    int len = vsnprintf(cook_vec_end(sb), room, fmt, copy);
+    va_end(copy);
+    if (len < 0) return;
+    if ((size_t)len >= room) {
+        cook_sb_reserve(sb, (size_t)len + 1);
+        vsnprintf(cook_vec_end(sb), (size_t)len + 1, fmt, args);
+    }
+    sb->len += (size_t)len;
+}
+
+static const char cook__digit_pairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static const uint64_t cook__pow10_u64[20] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+    10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull,
+    1000000000000000ull, 10000000000000000ull, 100000000000000000ull, 1000000000000000000ull,
+    10000000000000000000ull,
+};
+
+// cook__count_digits - number of decimal digits of @v, 1 for 0
+static inline unsigned cook__count_digits(uint64_t v) {
+    v |= 1;
+    // floor(log10(2^bits)) is the digit count or one short of it
+    unsigned n = (64 - cook__clz64(v))*1233 >> 12;
+    return n + (v >= cook__pow10_u64[n]);
+}
+
+// cook__write_digits - write the decimal digits of @v so they end at @end
+static inline void cook__write_digits(char *end, uint64_t v) {
+    // eight digits at a time, their four pairs do not wait on each other
+    while (v >= 100000000) {
+        uint64_t q = v/100000000;
+        uint32_t r = (uint32_t)(v - q*100000000), hi = r/10000, lo = r % 10000;
+        v = q;
+        end -= 8;
+        memcpy(end, cook__digit_pairs + 2*(hi/100), 2);
+        memcpy(end + 2, cook__digit_pairs + 2*(hi % 100), 2);
+        memcpy(end + 4, cook__digit_pairs + 2*(lo/100), 2);
+        memcpy(end + 6, cook__digit_pairs + 2*(lo % 100), 2);
+    }
+    uint32_t w = (uint32_t)v;
+    while (w >= 100) {
+        uint32_t pair = w % 100;
+        w /= 100;
+        end -= 2;
+        memcpy(end, cook__digit_pairs + 2*pair, 2);
+    }
+    if (w >= 10) {
+        memcpy(end - 2, cook__digit_pairs + 2*w, 2);
+    } else {
+        end[-1] = (char)('0' + w);
+    }
+}
+
+// cook__sb_room - make room for @n more bytes
+//
+// Return: where they go, the length is not changed
+static inline char *cook__sb_room(cook_string_builder_t *sb, size_t n) {
+    cook_sb_reserve(sb, n);
+    return cook_vec_end(sb);
+}
+
+COOKDEF void cook_sb_append_u64(cook_string_builder_t *sb, uint64_t v) {
+    unsigned n = cook__count_digits(v);
+    cook__write_digits(cook__sb_room(sb, n) + n, v);
+    sb->len += n;
+}
+
+COOKDEF void cook_sb_append_i64(cook_string_builder_t *sb, int64_t v) {
+    uint64_t u = v < 0 ? 0 - (uint64_t)v : (uint64_t)v;
+    unsigned n = cook__count_digits(u) + (v < 0);
+    char *p = cook__sb_room(sb, n);
+    p[0] = '-';
+    cook__write_digits(p + n, u);
+    sb->len += n;
+}
+
+COOKDEF void cook_sb_append_u64_padded(cook_string_builder_t *sb, uint64_t v, size_t width, char fill) {
+    size_t n = cook__count_digits(v), total = n < width ? width : n;
+    char *p = cook__sb_room(sb, total);
+    memset(p, fill, total - n);
+    cook__write_digits(p + total, v);
+    sb->len += total;
+}
+
+COOKDEF void cook_sb_append_hex(cook_string_builder_t *sb, uint64_t v, size_t width) {
+    size_t n = (64 - cook__clz64(v | 1) + 3)/4, total = n < width ? width : n;
+    char *p = cook__sb_room(sb, total);
+    memset(p, '0', total - n);
+    char *end = p + total;
+    do {
+        *--end = "0123456789abcdef"[v & 15];
+        v >>= 4;
+    } while (v);
+    sb->len += total;
+}
+
+// Schubfach, R. Giulietti, "The Schubfach way to render doubles" (2020),
+// as in the reference implementation of the paper: the rounding interval
+// of c*2^q is scaled by 10^-k, picked so the interval holds one or two
+// numbers with the fewest digits, with a 126-bit (64-bit for floats)
+// approximation of 10^-k rounded up, taken from cook__pow5_128
+
+// floor(log10(2^e)), floor(log10(3/4*2^e)) and floor(log2(10^e))
+static inline int cook__flog10_pow2(int e) { return (int)((int64_t)e*661971961083 >> 41); }
+static inline int cook__flog10_three_quarters_pow2(int e) { return (int)(((int64_t)e*661971961083 - 274743187321) >> 41); }
+static inline int cook__flog2_pow10(int e) { return (int)((int64_t)e*913124641741 >> 38); }
+
+// cook__schubfach_rop - round to odd of g*cp/2^127, g = g1*2^63 + g0
+static inline uint64_t cook__schubfach_rop(uint64_t g1, uint64_t g0, uint64_t cp) {
+    uint64_t x1, y0, y1, unused;
+    cook__mul128(g0, cp, &x1, &unused);
+    cook__mul128(g1, cp, &y1, &y0);
+    uint64_t z = (y0 >> 1) + x1;
+    return (y1 + (z >> 63)) | (((z & 0x7FFFFFFFFFFFFFFFull) + 0x7FFFFFFFFFFFFFFFull) >> 63);
+}
+
+// cook__schubfach_pick - shortest, then closest, decimal in the scaled
+// interval [vbl, vbr] around vb, all four times the value
+// @out: 1 if the ends of the interval are excluded
+// @e: receives the decimal exponent of the result
+static uint64_t cook__schubfach_pick(uint64_t vb, uint64_t vbl, uint64_t vbr, unsigned out, int k, int *e) {
+    uint64_t s = vb >> 2;
+    *e = k;
+    if (s >= 10) {
+        // one digit less, if only one of the two candidates is inside;
+        // the reference stops at two digits, as Java wants them
+        uint64_t sp10 = s/10*10, tp10 = sp10 + 10;
+        bool upin = vbl + out <= sp10 << 2;
+        bool wpin = (tp10 << 2) + out <= vbr;
+        if (upin != wpin) return upin ? sp10 : tp10;
+    }
+    uint64_t t = s + 1;
+    bool uin = vbl + out <= s << 2;
+    bool win = (t << 2) + out <= vbr;
+    if (uin != win) return uin ? s : t;
+    uint64_t mid = (s + t) << 1;
+    return vb < mid || (vb == mid && (s & 1) == 0) ? s : t;
+}
+
+// cook__schubfach64 - shortest decimal f*10^e that rounds to c*2^q
+static uint64_t cook__schubfach64(int q, uint64_t c, int *e) {
+    unsigned out = (unsigned)(c & 1);
+    uint64_t cb = c << 2, cbr = cb + 2, cbl;
+    int k;
+    if (c != (uint64_t)1 << 52 || q == -1074) {
+        cbl = cb - 2;
+        k = cook__flog10_pow2(q);
+    } else {
+        // the gap below a power of two is half the one above
+        cbl = cb - 1;
+        k = cook__flog10_three_quarters_pow2(q);
+    }
+    int h = q + cook__flog2_pow10(-k) + 2;
+    // the truncated 128 bits, to 126 bits and one more
+    const uint64_t *pow5 = &cook__pow5_128[2*(-k - COOK__POW5_MIN_Q)];
+    uint64_t hi = pow5[0] >> 2, lo = (pow5[0] << 62 | pow5[1] >> 2) + 1;
+    hi += lo == 0;
+    uint64_t g1 = hi << 1 | lo >> 63, g0 = lo & 0x7FFFFFFFFFFFFFFFull;
+    uint64_t vb = cook__schubfach_rop(g1, g0, cb << h);
+    uint64_t vbl = cook__schubfach_rop(g1, g0, cbl << h);
+    uint64_t vbr = cook__schubfach_rop(g1, g0, cbr << h);
+    return cook__schubfach_pick(vb, vbl, vbr, out, k, e);
+}
+
+// cook__schubfach32_rop - round to odd of g*cp/2^95
+static inline uint64_t cook__schubfach32_rop(uint64_t g, uint64_t cp) {
+    uint64_t x1, unused;
+    cook__mul128(g, cp, &x1, &unused);
+    return (x1 >> 31) | (((x1 & 0xFFFFFFFFull) + 0xFFFFFFFFull) >> 32);
+}
+
+// cook__schubfach32 - cook__schubfach64() for floats
+static uint64_t cook__schubfach32(int q, uint64_t c, int *e) {
+    unsigned out = (unsigned)(c & 1);
+    uint64_t cb = c << 2, cbr = cb + 2, cbl;
+    int k;
+    if (c != (uint64_t)1 << 23 || q == -149) {
+        cbl = cb - 2;
+        k = cook__flog10_pow2(q);
+    } else {
+        cbl = cb - 1;
+        k = cook__flog10_three_quarters_pow2(q);
+    }
+    int h = q + cook__flog2_pow10(-k) + 33;
+    uint64_t g = (cook__pow5_128[2*(-k - COOK__POW5_MIN_Q)] >> 1) + 1;
+    uint64_t vb = cook__schubfach32_rop(g, cb << h);
+    uint64_t vbl = cook__schubfach32_rop(g, cbl << h);
+    uint64_t vbr = cook__schubfach32_rop(g, cbr << h);
+    return cook__schubfach_pick(vb, vbl, vbr, out, k, e);
+}
+
+// cook__sb_append_decimal - append f*10^e the way JavaScript prints numbers
+static void cook__sb_append_decimal(cook_string_builder_t *sb, bool neg, uint64_t f, int e) {
+    while (f >= 10 && f % 10 == 0) {
+        f /= 10;
+        e++;
+    }
+    char digits[20];
+    int n = (int)cook__count_digits(f);
+    cook__write_digits(digits + n, f);
+    int point = e + n; // the value is 0.digits * 10^point
+    char *p = cook__sb_room(sb, 32), *begin = p;
+    if (neg) *p++ = '-';
+    if (point >= n && point <= 21) {
+        memcpy(p, digits, (size_t)n);
+        memset(p + n, '0', (size_t)(point - n));
+        p += point;
+    } else if (point > 0 && point <= 21) {
+        memcpy(p, digits, (size_t)point);
+        p[point] = '.';
+        memcpy(p + point + 1, digits + point, (size_t)(n - point));
+        p += n + 1;
+    } else if (point > -6 && point <= 0) {
+        memcpy(p, "0.000000", (size_t)(2 - point));
+        memcpy(p + 2 - point, digits, (size_t)n);
+        p += 2 - point + n;
+    } else {
+        *p++ = digits[0];
+        if (n > 1) {
+            *p++ = '.';
+            memcpy(p, digits + 1, (size_t)(n - 1));
+            p += n - 1;
+        }
+        int exp = point - 1;
+        *p++ = 'e';
+        *p++ = exp < 0 ? '-' : '+';
+        unsigned u = (unsigned)(exp < 0 ? -exp : exp), width = cook__count_digits(u);
+        cook__write_digits(p + width, u);
+        p += width;
+    }
+    sb->len += (size_t)(p - begin);
+}
+
+COOKDEF void cook_sb_append_f64(cook_string_builder_t *sb, double v) {
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    bool neg = bits >> 63;
+    uint64_t t = bits & (((uint64_t)1 << 52) - 1);
+    int be = (int)(bits >> 52) & 0x7FF;
+    if (be == 0x7FF) {
+        cook_sb_append_sv(sb, cook_sv_from_cstr(t ? "nan" : neg ? "-inf" : "inf"));
+        return;
+    }
+    uint64_t f = 0;
+    int e = 0;
+    if (be != 0) {
+        int shift = 1075 - be;
+        uint64_t c = (uint64_t)1 << 52 | t;
+        if (shift > 0 && shift < 53 && (c >> shift) << shift == c) {
+            f = c >> shift; // an integer below 2^53
+        } else {
+            f = cook__schubfach64(-shift, c, &e);
+        }
+    } else if (t >= 3) {
+        f = cook__schubfach64(-1074, t, &e);
+    } else if (t != 0) {
+        // the interval is too narrow for the algorithm, 5e-324 and 1e-323
+        f = t == 1 ? 5 : 1;
+        e = t == 1 ? -324 : -323;
+    }
+    cook__sb_append_decimal(sb, neg, f, e);
+}
+
+COOKDEF void cook_sb_append_f32(cook_string_builder_t *sb, float v) {
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    bool neg = bits >> 31;
+    uint64_t t = bits & ((1u << 23) - 1);
+    int be = (int)(bits >> 23) & 0xFF;
+    if (be == 0xFF) {
+        cook_sb_append_sv(sb, cook_sv_from_cstr(t ? "nan" : neg ? "-inf" : "inf"));
+        return;
+    }
+    uint64_t f = 0;
+    int e = 0;
+    if (be != 0) {
+        int shift = 150 - be;
+        uint64_t c = (uint64_t)1 << 23 | t;
+        if (shift > 0 && shift < 24 && (c >> shift) << shift == c) {
+            f = c >> shift;
+        } else {
+            f = cook__schubfach32(-shift, c, &e);
+        }
+    } else if (t >= 8) {
+        f = cook__schubfach32(-149, t, &e);
+    } else if (t != 0) {
+        // 1e-45 to 1e-44, one digit each
+        f = (uint64_t)"\0\1\3\4\6\7\10\1"[t];
+        e = t == 7 ? -44 : -45;
+    }
+    cook__sb_append_decimal(sb, neg, f, e);
+}
+
+// cook__hash_mix - finalizer of MurmurHash3, every input bit reaches every
+// output bit
+static inline uint64_t cook__hash_mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+COOKDEF uint64_t cook_sv_hash(cook_string_view_t sv) {
+    const uint64_t k = 0x9E3779B97F4A7C15ull;
+    uint64_t h = (uint64_t)sv.len*k;
+    size_t i = 0;
+    // two words per step, each multiplied on its own so the products overlap
+    for (; i + 16 <= sv.len; i += 16) {
+        uint64_t x, y;
+        memcpy(&x, sv.data + i, 8);
+        memcpy(&y, sv.data + i + 8, 8);
+        h = (h ^ (x*k)) + ((y ^ h)*0xC2B2AE3D27D4EB4Full);
+        h = (h << 31 | h >> 33)*k;
+    }
+    if (i + 8 <= sv.len) {
+        uint64_t x;
+        memcpy(&x, sv.data + i, 8);
+        h = ((h ^ x)*k);
+        h ^= h >> 29;
+        i += 8;
+    }
+    if (i < sv.len) {
+        uint64_t x = 0;
+        memcpy(&x, sv.data + i, sv.len - i);
+        h = ((h ^ x)*k);
+    }
+    return cook__hash_mix(h);
+}
+
+COOKDEF cook_hashed_sv_t cook_hsv_from_sv(cook_string_view_t sv) {
+    cook_hashed_sv_t hsv = {sv.data, sv.len, cook_sv_hash(sv)};
+    return hsv;
+}
+
+COOKDEF cook_hashed_sv_t cook_hsv_from_sb(const cook_string_builder_t *sb) {
+    return cook_hsv_from_sv(cook_sb_view(sb));
+}
+
+COOKDEF bool cook_hsv_equal(cook_hashed_sv_t a, cook_hashed_sv_t b) {
+    return a.hash == b.hash && a.len == b.len && (a.len == 0 || a.data == b.data || memcmp(a.data, b.data, a.len) == 0);
+}
+
+COOKDEF cook_string_view_t cook_hsv_view(cook_hashed_sv_t hsv) {
+    return cook_sv_from_parts(hsv.data, hsv.len);
+}
+
+// cook__utf8_decode - decode one UTF-8 sequence
+// @s: first byte of the sequence
+// @n: bytes available, at least 1
+// @cp: receives the codepoint
+//
+// Return: length of the sequence, 0 if it is invalid or truncated
+static size_t cook__utf8_decode(const unsigned char *s, size_t n, uint32_t *cp) {
+    unsigned c = s[0];
+    if (c < 0x80) {
+        *cp = c;
+        return 1;
+    }
+    size_t len;
+    uint32_t v, min;
+    if (c >= 0xC2 && c <= 0xDF) {
+        len = 2;
+        v = c & 0x1F;
+        min = 0x80;
+    } else if ((c & 0xF0) == 0xE0) {
+        len = 3;
+        v = c & 0x0F;
+        min = 0x800;
+    } else if (c >= 0xF0 && c <= 0xF4) {
+        len = 4;
+        v = c & 0x07;
+        min = 0x10000;
+    } else {
+        return 0;
+    }
+    if (n < len) return 0;
+    for (size_t k = 1; k < len; k++) {
+        if ((s[k] & 0xC0) != 0x80) return 0;
+        v = v << 6 | (s[k] & 0x3F);
+    }
+    if (v < min || v > 0x10FFFF || (v >= 0xD800 && v <= 0xDFFF)) return 0;
+    *cp = v;
+    return len;
+}
+
+static size_t cook__utf8_validate_scalar(const unsigned char *s, size_t n, size_t i) {
+    while (i < n) {
+        if (i + 8 <= n) {
+            uint64_t w;
+            memcpy(&w, s + i, 8);
+            if (!(w & 0x8080808080808080ull)) {
+                i += 8;
+                continue;
+            }
+        }
+        uint32_t cp;
+        size_t len = cook__utf8_decode(s + i, n - i, &cp);
+        if (len == 0) return i;
+        i += len;
+    }
+    return n;
+}
+
+// cook__utf8_count_scalar - number of bytes that are not 10xxxxxx
+static size_t cook__utf8_count_scalar(const char *s, size_t n) {
+    size_t count = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t w;
+        memcpy(&w, s + i, 8);
+        uint64_t cont = w & ~(w << 1) & 0x8080808080808080ull;
+        count += 8 - (size_t)(((cont >> 7)*0x0101010101010101ull) >> 56);
+    }
+    for (; i < n; i++) count += ((unsigned char)s[i] & 0xC0) != 0x80;
+    return count;
+}
+
+#ifdef COOK__SIMD_X86
+
+// cook__utf8_boundary - back up from @i to the start of the sequence it is in
+static size_t cook__utf8_boundary(const char *s, size_t i) {
+    for (size_t k = 1; k <= 3 && k <= i; k++) {
+        if (((unsigned char)s[i - k] & 0xC0) != 0x80) return i - k;
+    }
+    return i;
+}
+
+// Byte-pair classes of the lookup validator (Keiser & Lemire, "Validating
+// UTF-8 In Less Than One Instruction Per Byte"). Each table maps a nibble
+// to the set of errors it is compatible with, a pair is invalid when all
+// three lookups agree on one error.
+#define COOK__U8_TOO_SHORT  (1 << 0) // lead not followed by a continuation
+#define COOK__U8_TOO_LONG   (1 << 1) // ASCII followed by a continuation
+#define COOK__U8_OVERLONG_3 (1 << 2) // E0 80..9F
+#define COOK__U8_TOO_LARGE  (1 << 3) // F4 90..BF, F5..FF
+#define COOK__U8_SURROGATE  (1 << 4) // ED A0..BF
+#define COOK__U8_OVERLONG_2 (1 << 5) // C0..C1
+#define COOK__U8_TOO_LARGE_1000 (1 << 6) // F5..FF 80..8F
+#define COOK__U8_OVERLONG_4 (1 << 6) // F0 80..8F
+#define COOK__U8_TWO_CONTS  (1 << 7) // continuation after continuation
+#define COOK__U8_CARRY (COOK__U8_TOO_SHORT | COOK__U8_TOO_LONG | COOK__U8_TWO_CONTS)
+
+#define COOK__U8_TABLE(...) _mm256_setr_epi8(__VA_ARGS__, __VA_ARGS__)
+
+// cook__utf8_validate_avx2 - validate 32-byte blocks
+//
+// Return: where the scalar validator has to take over, the start of the
+//         first block with an error or the partial block at the end
+COOK__AVX2 static size_t cook__utf8_validate_avx2(const char *s, size_t n) {
+    const __m256i byte_1_high = COOK__U8_TABLE(
+        COOK__U8_TOO_LONG, COOK__U8_TOO_LONG, COOK__U8_TOO_LONG, COOK__U8_TOO_LONG,
+        COOK__U8_TOO_LONG, COOK__U8_TOO_LONG, COOK__U8_TOO_LONG, COOK__U8_TOO_LONG,
+        (char)COOK__U8_TWO_CONTS, (char)COOK__U8_TWO_CONTS, (char)COOK__U8_TWO_CONTS, (char)COOK__U8_TWO_CONTS,
+        COOK__U8_TOO_SHORT | COOK__U8_OVERLONG_2,
+        COOK__U8_TOO_SHORT,
+        COOK__U8_TOO_SHORT | COOK__U8_OVERLONG_3 | COOK__U8_SURROGATE,
+        COOK__U8_TOO_SHORT | COOK__U8_TOO_LARGE | COOK__U8_TOO_LARGE_1000 | COOK__U8_OVERLONG_4);
+    const __m256i byte_1_low = COOK__U8_TABLE(
+        (char)(COOK__U8_CARRY | COOK__U8_OVERLONG_3 | COOK__U8_OVERLONG_2 | COOK__U8_OVERLONG_4),
+        (char)(COOK__U8_CARRY | COOK__U8_OVERLONG_2),
+        (char)COOK__U8_CARRY,
+        (char)COOK__U8_CARRY,
+        (char)(COOK__U8_CARRY | COOK__U8_TOO_LARGE),
+        (char)(COOK__U8_CARRY | COOK__U8_TOO_LARGE | COOK__U8_TOO_LARGE_1000),
+        (char)(COOK__U8_CARRY | COOK__U8_TOO_LARGE | COOK__U8_TOO_LARGE_1000),
+        (char)(COOK__U8_CARRY | COOK__U8_TOO_LARGE | COOK__U8_TOO_LARGE_1000),
+        (char)(COOK__U8_CARRY | COOK__U8_TOO_LARGE | COOK__U8_TOO_LARGE_1000),
+        (char)(COOK__U8_CARRY | COOK__U8_TOO_LARGE | COOK__U8_TOO_LARGE_1000),
+        (char)(COOK__U8_CARRY | COOK__U8_TOO_LARGE | COOK__U8_TOO_LARGE_1000),
+        (char)(COOK__U8_CARRY | COOK__U8_TOO_LARGE | COOK__U8_TOO_LARGE_1000),
+        (char)(COOK__U8_CARRY | COOK__U8_TOO_LARGE | COOK__U8_TOO_LARGE_1000),
+        (char)(COOK__U8_CARRY | COOK__U8_TOO_LARGE | COOK__U8_TOO_LARGE_1000 | COOK__U8_SURROGATE),
+        (char)(COOK__U8_CARRY | COOK__U8_TOO_LARGE | COOK__U8_TOO_LARGE_1000),
+        (char)(COOK__U8_CARRY | COOK__U8_TOO_LARGE | COOK__U8_TOO_LARGE_1000));
+    const __m256i byte_2_high = COOK__U8_TABLE(
+        COOK__U8_TOO_SHORT, COOK__U8_TOO_SHORT, COOK__U8_TOO_SHORT, COOK__U8_TOO_SHORT,
+        COOK__U8_TOO_SHORT, COOK__U8_TOO_SHORT, COOK__U8_TOO_SHORT, COOK__U8_TOO_SHORT,
+        (char)(COOK__U8_TOO_LONG | COOK__U8_OVERLONG_2 | COOK__U8_TWO_CONTS | COOK__U8_OVERLONG_3 |
+               COOK__U8_TOO_LARGE_1000 | COOK__U8_OVERLONG_4),
+        (char)(COOK__U8_TOO_LONG | COOK__U8_OVERLONG_2 | COOK__U8_TWO_CONTS | COOK__U8_OVERLONG_3 | COOK__U8_TOO_LARGE),
+        (char)(COOK__U8_TOO_LONG | COOK__U8_OVERLONG_2 | COOK__U8_TWO_CONTS | COOK__U8_SURROGATE | COOK__U8_TOO_LARGE),
+        (char)(COOK__U8_TOO_LONG | COOK__U8_OVERLONG_2 | COOK__U8_TWO_CONTS | COOK__U8_SURROGATE | COOK__U8_TOO_LARGE),
+        COOK__U8_TOO_SHORT, COOK__U8_TOO_SHORT, COOK__U8_TOO_SHORT, COOK__U8_TOO_SHORT);
+    // a block ending in these still waits for continuation bytes
+    const __m256i incomplete_max = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+    __m256i prev = _mm256_setzero_si256(), incomplete = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i in = _mm256_loadu_si256((const __m256i *)(s + i));
+        if (_mm256_movemask_epi8(in) == 0) {
+            if (!_mm256_testz_si256(incomplete, incomplete)) break;
+            prev = in;
+            continue;
+        }
+        // the input shifted by 1, 2, 3 bytes, pulling in the end of @prev
+        __m256i carry = _mm256_permute2x128_si256(prev, in, 0x21);
+        __m256i prev1 = _mm256_alignr_epi8(in, carry, 15);
+        __m256i prev2 = _mm256_alignr_epi8(in, carry, 14);
+        __m256i prev3 = _mm256_alignr_epi8(in, carry, 13);
+
+        __m256i special = _mm256_and_si256(
+            _mm256_and_si256(_mm256_shuffle_epi8(byte_1_high, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+                             _mm256_shuffle_epi8(byte_1_low, _mm256_and_si256(prev1, nibble))),
+            _mm256_shuffle_epi8(byte_2_high, _mm256_and_si256(_mm256_srli_epi16(in, 4), nibble)));
+        // the third and fourth bytes of 3/4-byte sequences must be two
+        // continuations in a row, everywhere else that pair is an error
+        __m256i third = _mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0 - 0x80)));
+        __m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80)));
+        __m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8((char)0x80));
+        __m256i error = _mm256_xor_si256(must23, special);
+        if (!_mm256_testz_si256(error, error)) break;
+
+        incomplete = _mm256_subs_epu8(in, incomplete_max);
+        prev = in;
+    }
+    return i;
+}
+
+COOK__AVX2 static bool cook__is_ascii_avx2(const char *s, size_t n) {
+    size_t i = 0;
+    for (; i + 128 <= n; i += 128) {
+        __m256i a = _mm256_or_si256(_mm256_loadu_si256((const __m256i *)(s + i)), _mm256_loadu_si256((const __m256i *)(s + i + 32)));
+        __m256i b = _mm256_or_si256(_mm256_loadu_si256((const __m256i *)(s + i + 64)), _mm256_loadu_si256((const __m256i *)(s + i + 96)));
+        if (_mm256_movemask_epi8(_mm256_or_si256(a, b))) return false;
+    }
+    for (; i + 32 <= n; i += 32) {
+        if (_mm256_movemask_epi8(_mm256_loadu_si256((const __m256i *)(s + i)))) return false;
+    }
+    return !_mm256_movemask_epi8(_mm256_loadu_si256((const __m256i *)(s + n - 32)));
+}
+
+// cook__utf8_count_avx2 - cook__utf8_count_scalar() on @n / 32 blocks
+COOK__AVX2 static size_t cook__utf8_count_avx2(const char *s, size_t n) {
+    const __m256i cont_max = _mm256_set1_epi8(-65); // 0xBF as a signed byte
+    size_t count = 0, i = 0;
+    while (i + 32 <= n) {
+        // byte counters flush before they can wrap
+        __m256i acc = _mm256_setzero_si256();
+        for (size_t k = 0; k < 255 && i + 32 <= n; k++, i += 32) {
+            __m256i in = _mm256_loadu_si256((const __m256i *)(s + i));
+            acc = _mm256_sub_epi8(acc, _mm256_cmpgt_epi8(in, cont_max));
+        }
+        uint64_t sums[4];
+        _mm256_storeu_si256((__m256i *)sums, _mm256_sad_epu8(acc, _mm256_setzero_si256()));
+        count += (size_t)(sums[0] + sums[1] + sums[2] + sums[3]);
+    }
+    return count;
+}
+
+#endif // COOK__SIMD_X86
+
+COOKDEF size_t cook_utf8_validate(cook_string_view_t sv) {
+    size_t i = 0;
+#ifdef COOK__SIMD_X86
+    if (sv.len >= 32 && cook__cpu_avx2()) i = cook__utf8_boundary(sv.data, cook__utf8_validate_avx2(sv.data, sv.len));
+#endif
+    return cook__utf8_validate_scalar((const unsigned char *)sv.data, sv.len, i);
+}
+
+COOKDEF bool cook_utf8_valid(cook_string_view_t sv) {
+    return cook_utf8_validate(sv) == sv.len;
+}
+
+COOKDEF bool cook_utf8_is_ascii(cook_string_view_t sv) {
+#ifdef COOK__SIMD_X86
+    if (sv.len >= 32 && cook__cpu_avx2()) return cook__is_ascii_avx2(sv.data, sv.len);
+#endif
+    size_t i = 0;
+    uint64_t acc = 0;
+    for (; i + 8 <= sv.len; i += 8) {
+        uint64_t w;
+        memcpy(&w, sv.data + i, 8);
+        acc |= w;
+    }
+    for (; i < sv.len; i++) acc |= (unsigned char)sv.data[i];
+    return !(acc & 0x8080808080808080ull);
+}
+
+COOKDEF size_t cook_utf8_count(cook_string_view_t sv) {
+    size_t count = 0, i = 0;
+#ifdef COOK__SIMD_X86
+    if (sv.len >= 32 && cook__cpu_avx2()) {
+        i = sv.len & ~(size_t)31;
+        count = cook__utf8_count_avx2(sv.data, i);
+    }
+#endif
+    return count + cook__utf8_count_scalar(sv.data + i, sv.len - i);
+}
+
+COOKDEF bool cook_utf8_next(cook_string_view_t *sv, uint32_t *cp) {
+    if (sv->len == 0) return false;
+    size_t len = cook__utf8_decode((const unsigned char *)sv->data, sv->len, cp);
+    if (len == 0) {
+        *cp = COOK_UTF8_REPLACEMENT;
+        len = 1;
+    }
+    sv->data += len;
+    sv->len -= len;
+    return true;
+}
+
+COOKDEF bool cook_sb_append_utf8(cook_string_builder_t *sb, uint32_t cp) {
+    unsigned char buf[4];
+    size_t len;
+    if (cp < 0x80) {
+        buf[0] = (unsigned char)cp;
+        len = 1;
+    } else if (cp < 0x800) {
+        buf[0] = (unsigned char)(0xC0 | cp >> 6);
+        buf[1] = (unsigned char)(0x80 | (cp & 0x3F));
+        len = 2;
+    } else if (cp < 0x10000) {
+        if (cp >= 0xD800 && cp <= 0xDFFF) return false;
+        buf[0] = (unsigned char)(0xE0 | cp >> 12);
+        buf[1] = (unsigned char)(0x80 | (cp >> 6 & 0x3F));
+        buf[2] = (unsigned char)(0x80 | (cp & 0x3F));
+        len = 3;
+    } else if (cp <= 0x10FFFF) {
+        buf[0] = (unsigned char)(0xF0 | cp >> 18);
+        buf[1] = (unsigned char)(0x80 | (cp >> 12 & 0x3F));
+        buf[2] = (unsigned char)(0x80 | (cp >> 6 & 0x3F));
+        buf[3] = (unsigned char)(0x80 | (cp & 0x3F));
+        len = 4;
+    } else {
+        return false;
+    }
+    cook_sb_append_parts(sb, buf, len);
+    return true;
+}
+
+// cook__utf8_put - store one code point as UTF-16 (@unit 2) or UTF-32 (@unit 4)
+//
+// Return: number of code units stored
+static inline size_t cook__utf8_put(char *dst, uint32_t cp, size_t unit) {
+    if (unit == 4) {
+        memcpy(dst, &cp, 4);
+        return 1;
+    }
+    if (cp < 0x10000) {
+        uint16_t u = (uint16_t)cp;
+        memcpy(dst, &u, 2);
+        return 1;
+    }
+    cp -= 0x10000;
+    uint16_t pair[2] = {(uint16_t)(0xD800 | cp >> 10), (uint16_t)(0xDC00 | (cp & 0x3FF))};
+    memcpy(dst, pair, 4);
+    return 2;
+}
+
+// cook__utf8_widen - convert valid UTF-8 to UTF-16 (@unit 2) or UTF-32 (@unit 4)
+//
+// Note: decodes without checks, the input must have been validated
+//
+// Return: number of code units written to @dst
+static size_t cook__utf8_widen(char *dst, const char *src, size_t n, size_t unit) {
+    const unsigned char *s = (const unsigned char *)src;
+    size_t i = 0, out = 0;
+    while (i < n) {
+        size_t end = n;
+#ifdef COOK__SIMD_X86
+        if (i + 16 <= n) {
+            __m128i x = _mm_loadu_si128((const __m128i *)(s + i));
+            if (_mm_movemask_epi8(x) == 0) {
+                // zero-extend 16 ASCII bytes
+                __m128i zero = _mm_setzero_si128();
+                __m128i lo = _mm_unpacklo_epi8(x, zero), hi = _mm_unpackhi_epi8(x, zero);
+                char *p = dst + out*unit;
+                if (unit == 2) {
+                    _mm_storeu_si128((__m128i *)p, lo);
+                    _mm_storeu_si128((__m128i *)(p + 16), hi);
+                } else {
+                    _mm_storeu_si128((__m128i *)p, _mm_unpacklo_epi16(lo, zero));
+                    _mm_storeu_si128((__m128i *)(p + 16), _mm_unpackhi_epi16(lo, zero));
+                    _mm_storeu_si128((__m128i *)(p + 32), _mm_unpacklo_epi16(hi, zero));
+                    _mm_storeu_si128((__m128i *)(p + 48), _mm_unpackhi_epi16(hi, zero));
+                }
+                i += 16;
+                out += 16;
+                continue;
+            }
+            // decode this window one code point at a time, then try again
+            end = i + 16;
+        }
+#endif
+        while (i < end) {
+            unsigned c = s[i];
+            uint32_t cp;
+            if (c < 0x80) {
+                cp = c;
+                i += 1;
+            } else if (c < 0xE0) {
+                cp = (c & 0x1Fu) << 6 | (s[i + 1] & 0x3Fu);
+                i += 2;
+            } else if (c < 0xF0) {
+                cp = (c & 0x0Fu) << 12 | (s[i + 1] & 0x3Fu) << 6 | (s[i + 2] & 0x3Fu);
+                i += 3;
+            } else {
+                cp = (c & 0x07u) << 18 | (s[i + 1] & 0x3Fu) << 12 | (s[i + 2] & 0x3Fu) << 6 | (s[i + 3] & 0x3Fu);
+                i += 4;
+            }
+            out += cook__utf8_put(dst + out*unit, cp, unit);
+        }
+    }
+    return out;
+}
+
+COOKDEF bool cook_sb_append_utf16(cook_string_builder_t *sb, cook_string_view_t src) {
+    if (!cook_utf8_valid(src)) return false;
+    // never more units than bytes
+    cook_sb_reserve(sb, 2*src.len);
+    sb->len += 2*cook__utf8_widen(cook_vec_end(sb), src.data, src.len, 2);
+    return true;
+}
+
+COOKDEF bool cook_sb_append_utf32(cook_string_builder_t *sb, cook_string_view_t src) {
+    if (!cook_utf8_valid(src)) return false;
+    cook_sb_reserve(sb, 4*src.len);
+    sb->len += 4*cook__utf8_widen(cook_vec_end(sb), src.data, src.len, 4);
+    return true;
+}
+
+#define COOK__MATCH_NONE UINT32_MAX
+
+typedef struct cook__matcher_key {
+    cook_string_view_t sv;
+    uint32_t pattern;
+} cook__matcher_key_t;
+
+// cook__matcher_renumber - move per-state values to their new state numbers
+// @states: the values are state numbers too
+static void cook__matcher_renumber(uint32_t *values, const uint32_t *perm, uint32_t *tmp, size_t n, bool states) {
+    for (size_t i = 0; i < n; i++) {
+        uint32_t v = values[i];
+        tmp[perm[i]] = states && v != COOK__MATCH_NONE ? perm[v] : v;
+    }
+    memcpy(values, tmp, n*sizeof(*values));
+}
+
+static int cook__matcher_key_compare(const void *a, const void *b) {
+    return cook_sv_compare(((const cook__matcher_key_t *)a)->sv, ((const cook__matcher_key_t *)b)->sv);
+}
+
+// cook__teddy_build - fingerprint buckets of similar patterns for the prefilter
+static void cook__teddy_build(cook_matcher_t *m) {
+    size_t min_len = SIZE_MAX;
+    cook__matcher_key_t keys[64];
+    for (size_t i = 0; i < m->count; i++) {
+        if (m->patterns[i].len < min_len) min_len = m->patterns[i].len;
+        keys[i] = (cook__matcher_key_t){m->patterns[i], (uint32_t)i};
+    }
+    // sorted patterns share prefixes with their neighbours, so contiguous
+    // buckets keep the nibble masks tight
+    qsort(keys, m->count, sizeof(keys[0]), cook__matcher_key_compare);
+    size_t buckets = m->count < 8 ? m->count : 8;
+    m->teddy = true;
+    m->teddy_len = min_len < 3 ? min_len : 3;
+    memset(m->teddy_lo, 0, sizeof(m->teddy_lo));
+    memset(m->teddy_hi, 0, sizeof(m->teddy_hi));
+    for (size_t b = 0; b <= 8; b++) m->teddy_bucket[b] = b < buckets ? b*m->count/buckets : m->count;
+    for (size_t b = 0; b < buckets; b++) {
+        for (size_t i = m->teddy_bucket[b]; i < m->teddy_bucket[b + 1]; i++) {
+            m->teddy_order[i] = keys[i].pattern;
+            for (size_t k = 0; k < m->teddy_len; k++) {
+                unsigned char c = (unsigned char)keys[i].sv.data[k];
+                m->teddy_lo[k][c & 15] |= (unsigned char)(1u << b);
+                m->teddy_hi[k][c >> 4] |= (unsigned char)(1u << b);
+            }
+        }
+    }
+}
+
+COOKDEF bool cook_matcher_init(cook_matcher_t *m, const cook_string_view_t *patterns, size_t count) {
+    memset(m, 0, sizeof(*m));
+    if (count == 0 || count >= COOK__MATCH_NONE) return false;
+
+    size_t total = 0;
+    bool used[256] = {0};
+    for (size_t i = 0; i < count; i++) {
+        if (patterns[i].len == 0) return false;
+        total += patterns[i].len;
+        for (size_t j = 0; j < patterns[i].len; j++) used[(unsigned char)patterns[i].data[j]] = true;
+    }
+    // class 0 is every byte that occurs in no pattern
+    m->class_count = 1;
+    for (size_t c = 0; c < 256; c++) m->classes[c] = used[c] ? (unsigned char)m->class_count++ : 0;
+    size_t max_states = total + 1;
+    if (max_states > UINT32_MAX/m->class_count) return false;
+
+    m->patterns = COOK__ALLOC(count*sizeof(*m->patterns) + total, "matcher");
+    m->delta = COOK__ALLOC(max_states*m->class_count*sizeof(*m->delta), "matcher");
+    m->state_pattern = COOK__ALLOC(max_states*sizeof(uint32_t), "matcher");
+    m->dict_link = COOK__ALLOC(max_states*sizeof(uint32_t), "matcher");
+    m->min_pattern = COOK__ALLOC(max_states*sizeof(uint32_t), "matcher");
+    m->same_pattern = COOK__ALLOC(count*sizeof(uint32_t), "matcher");
+    uint32_t *fail = COOK__ALLOC(max_states*sizeof(uint32_t), "matcher");
+    uint32_t *queue = COOK__ALLOC(max_states*sizeof(uint32_t), "matcher");
+    COOK_ASSERT(m->patterns && m->delta && m->state_pattern && m->dict_link && m->min_pattern &&
+                m->same_pattern && fail && queue && "out of memory");
+    m->count = count;
+    memset(m->delta, 0xFF, max_states*m->class_count*sizeof(*m->delta));
+    memset(m->state_pattern, 0xFF, max_states*sizeof(uint32_t));
+    memset(m->min_pattern, 0xFF, max_states*sizeof(uint32_t));
+
+    // the trie, with the pattern bytes copied behind the view array
+    char *bytes = (char *)(m->patterns + count);
+    m->state_count = 1;
+    for (size_t i = 0; i < count; i++) {
+        memcpy(bytes, patterns[i].data, patterns[i].len);
+        m->patterns[i] = cook_sv_from_parts(bytes, patterns[i].len);
+        bytes += patterns[i].len;
+        uint32_t s = 0;
+        for (size_t j = 0; j < patterns[i].len; j++) {
+            uint32_t *next = &m->delta[s*m->class_count + m->classes[(unsigned char)patterns[i].data[j]]];
+            if (*next == COOK__MATCH_NONE) *next = (uint32_t)m->state_count++;
+            s = *next;
+        }
+        m->same_pattern[i] = m->state_pattern[s];
+        m->state_pattern[s] = (uint32_t)i;
+        if (m->min_pattern[s] == COOK__MATCH_NONE) m->min_pattern[s] = (uint32_t)i;
+    }
+
+    // breadth first: fail links, dictionary links, and the missing
+    // transitions borrowed from the fail state, whose row is complete
+    size_t head = 0, tail = 0;
+    fail[0] = 0;
+    m->dict_link[0] = COOK__MATCH_NONE;
+    for (size_t c = 0; c < m->class_count; c++) {
+        uint32_t t = m->delta[c];
+        if (t == COOK__MATCH_NONE) {
+            m->delta[c] = 0;
+        } else {
+            fail[t] = 0;
+            m->dict_link[t] = COOK__MATCH_NONE;
+            queue[tail++] = t;
+        }
+    }
+    while (head < tail) {
+        uint32_t s = queue[head++];
+        uint32_t *row = &m->delta[s*m->class_count];
+        const uint32_t *fail_row = &m->delta[fail[s]*m->class_count];
+        for (size_t c = 0; c < m->class_count; c++) {
+            uint32_t t = row[c];
+            if (t == COOK__MATCH_NONE) {
+                row[c] = fail_row[c];
+                continue;
+            }
+            uint32_t f = fail_row[c];
+            fail[t] = f;
+            m->dict_link[t] = m->state_pattern[f] != COOK__MATCH_NONE ? f : m->dict_link[f];
+            if (m->min_pattern[f] < m->min_pattern[t]) m->min_pattern[t] = m->min_pattern[f];
+            queue[tail++] = t;
+        }
+    }
+
+    // match states go last, so the scan loops spot them with one compare
+    // instead of masking a flag off every transition
+    uint32_t *perm = fail, next = 0;
+    for (size_t i = 0; i < m->state_count; i++) {
+        if (m->min_pattern[i] == COOK__MATCH_NONE) perm[i] = next++;
+    }
+    m->match_start = next*(uint32_t)m->class_count;
+    for (size_t i = 0; i < m->state_count; i++) {
+        if (m->min_pattern[i] != COOK__MATCH_NONE) perm[i] = next++;
+    }
+    cook__matcher_renumber(m->state_pattern, perm, queue, m->state_count, false);
+    cook__matcher_renumber(m->min_pattern, perm, queue, m->state_count, false);
+    cook__matcher_renumber(m->dict_link, perm, queue, m->state_count, true);
+    uint32_t *delta = COOK__ALLOC(m->state_count*m->class_count*sizeof(*delta), "matcher");
+    COOK_ASSERT(delta && "out of memory");
+    for (size_t i = 0; i < m->state_count; i++) {
+        for (size_t c = 0; c < m->class_count; c++) {
+            delta[perm[i]*m->class_count + c] = perm[m->delta[i*m->class_count + c]]*(uint32_t)m->class_count;
+        }
+    }
+    COOK__FREE(m->delta);
+    m->delta = delta;
+    COOK__FREE(fail);
+    COOK__FREE(queue);
+
+    if (count <= 64) cook__teddy_build(m);
+    return true;
+}
+
+COOKDEF void cook_matcher_free(cook_matcher_t *m) {
+    if (m->patterns) COOK__FREE(m->patterns);
+    if (m->delta) COOK__FREE(m->delta);
+    if (m->state_pattern) COOK__FREE(m->state_pattern);
+    if (m->dict_link) COOK__FREE(m->dict_link);
+    if (m->min_pattern) COOK__FREE(m->min_pattern);
+    if (m->same_pattern) COOK__FREE(m->same_pattern);
+    memset(m, 0, sizeof(*m));
+}
+
+static bool cook__matcher_find_dfa(const cook_matcher_t *m, cook_string_view_t text, cook_match_t *match) {
+    const unsigned char *s = (const unsigned char *)text.data;
+    uint32_t state = 0;
+    for (size_t i = 0; i < text.len; i++) {
+        state = m->delta[state + m->classes[s[i]]];
+        if (state >= m->match_start) {
+            uint32_t p = m->min_pattern[state/m->class_count];
+            match->pattern = p;
+            match->offset = i + 1 - m->patterns[p].len;
+            return true;
+        }
+    }
+    return false;
+}
+
+#ifdef COOK__SIMD_X86
+
+// cook__teddy_verify - check the patterns of the candidate buckets at @j
+// @best_end: end of the best match so far, updated with @best
+static void cook__teddy_verify(const cook_matcher_t *m, const char *s, size_t n, size_t j, unsigned bits,
+                               cook_match_t *best, size_t *best_end) {
+    for (; bits; bits &= bits - 1) {
+        size_t b = (size_t)cook__ctz64(bits);
+        for (size_t k = m->teddy_bucket[b]; k < m->teddy_bucket[b + 1]; k++) {
+            uint32_t p = m->teddy_order[k];
+            cook_string_view_t pat = m->patterns[p];
+            size_t end = j + pat.len;
+            if (end > n || end > *best_end || (end == *best_end && p > best->pattern)) continue;
+            if (memcmp(s + j, pat.data, pat.len) != 0) continue;
+            best->pattern = p;
+            best->offset = j;
+            *best_end = end;
+        }
+    }
+}
+
+static unsigned cook__teddy_bits(const cook_matcher_t *m, const char *s, size_t j) {
+    unsigned bits = 0xFF;
+    for (size_t k = 0; k < m->teddy_len; k++) {
+        unsigned char c = (unsigned char)s[j + k];
+        bits &= m->teddy_lo[k][c & 15] & m->teddy_hi[k][c >> 4];
+    }
+    return bits;
+}
+
+// cook__teddy_next_avx2 - find the next 32-byte block with candidate positions
+// @buckets: receives the candidate buckets of the 32 positions
+// @mask: receives the candidate positions, 0 if the scan reached the tail
+//
+// Return: start of the block, or of the tail the caller scans itself
+COOK__AVX2 static size_t cook__teddy_next_avx2(const cook_matcher_t *m, const char *s, size_t n, size_t i,
+                                               unsigned char buckets[32], uint32_t *mask) {
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i lo[3], hi[3];
+    for (size_t k = 0; k < 3; k++) {
+        lo[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)m->teddy_lo[k]));
+        hi[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)m->teddy_hi[k]));
+    }
+    size_t k = m->teddy_len;
+    for (; i + 32 + k - 1 <= n; i += 32) {
+        __m256i t = _mm256_set1_epi8(-1);
+        for (size_t j = 0; j < k; j++) {
+            __m256i x = _mm256_loadu_si256((const __m256i *)(s + i + j));
+            __m256i l = _mm256_shuffle_epi8(lo[j], _mm256_and_si256(x, nibble));
+            __m256i h = _mm256_shuffle_epi8(hi[j], _mm256_and_si256(_mm256_srli_epi16(x, 4), nibble));
+            t = _mm256_and_si256(t, _mm256_and_si256(l, h));
+        }
+        uint32_t found = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(t, _mm256_setzero_si256()));
+        if (found) {
+            _mm256_storeu_si256((__m256i *)buckets, t);
+            *mask = found;
+            return i;
+        }
+    }
+    *mask = 0;
+    return i;
+}
+
+static bool cook__matcher_find_teddy(const cook_matcher_t *m, cook_string_view_t text, cook_match_t *match) {
+    const char *s = text.data;
+    size_t n = text.len, i = 0, best_end = SIZE_MAX;
+    cook_match_t best = {COOK__MATCH_NONE, 0};
+    // candidates come in order of start, a match that starts at or after
+    // the best end cannot end earlier
+    while (i < best_end) {
+        unsigned char buckets[32];
+        uint32_t mask;
+        i = cook__teddy_next_avx2(m, s, n, i, buckets, &mask);
+        if (!mask) break;
+        for (; mask; mask &= mask - 1) {
+            size_t j = i + (size_t)cook__ctz64(mask);
+            if (j >= best_end) break;
+            cook__teddy_verify(m, s, n, j, buckets[j - i], &best, &best_end);
+        }
+        i += 32;
+    }
+    for (; i < best_end && i + m->teddy_len <= n; i++) {
+        unsigned bits = cook__teddy_bits(m, s, i);
+        if (bits) cook__teddy_verify(m, s, n, i, bits, &best, &best_end);
+    }
+    if (best_end == SIZE_MAX) return false;
+    *match = best;
+    return true;
+}
+
+#endif // COOK__SIMD_X86
+
+COOKDEF bool cook_matcher_find(const cook_matcher_t *m, cook_string_view_t text, cook_match_t *match) {
+#ifdef COOK__SIMD_X86
+    if (m->teddy && cook__cpu_avx2()) return cook__matcher_find_teddy(m, text, match);
+#endif
+    return cook__matcher_find_dfa(m, text, match);
+}
+
+COOKDEF size_t cook_matcher_feed(const cook_matcher_t *m, cook_match_stream_t *stream,
+                                 cook_string_view_t chunk, cook_match_fn fn, void *user) {
+    const unsigned char *s = (const unsigned char *)chunk.data;
+    uint32_t state = stream->state;
+    for (size_t i = 0; i < chunk.len; i++) {
+        state = m->delta[state + m->classes[s[i]]];
+        if (state < m->match_start) continue;
+
+        size_t end = stream->offset + i + 1;
+        bool more = true;
+        uint32_t at = state/(uint32_t)m->class_count;
+        if (m->state_pattern[at] == COOK__MATCH_NONE) at = m->dict_link[at];
+        for (; more && at != COOK__MATCH_NONE; at = m->dict_link[at]) {
+            for (uint32_t p = m->state_pattern[at]; more && p != COOK__MATCH_NONE; p = m->same_pattern[p]) {
+                more = fn((cook_match_t){p, end - m->patterns[p].len}, user);
+            }
+        }
+        if (!more) {
+            stream->state = state;
+            stream->offset += i + 1;
+            return i + 1;
+        }
+    }
+    stream->state = state;
+    stream->offset += chunk.len;
+    return chunk.len;
+}
+
+#define COOK__GLOB_NONE UINT32_MAX
+#define COOK__GLOB_MAX_STATES 65536
+
+enum {
+    COOK__GLOB_BYTE,  // takes a byte of bits, then goes to out
+    COOK__GLOB_SPLIT, // goes to out and out1 without taking a byte
+    COOK__GLOB_MATCH, // pattern out matches
+};
+
+typedef struct cook__glob_node {
+    int kind;
+    uint32_t out;
+    uint32_t out1;
+    uint64_t bits[4];
+} cook__glob_node_t;
+
+typedef struct cook__glob_compiler {
+    struct { cook__glob_node_t *items; size_t len, cap; } nodes;
+    struct { size_t *items; size_t len, cap; } starts; // item offsets, see cook__glob_range()
+    const char *pattern;
+} cook__glob_compiler_t;
+
+static uint32_t cook__glob_node(cook__glob_compiler_t *c, int kind, uint32_t out, uint32_t out1) {
+    cook__glob_node_t node = {kind, out, out1, {0}};
+    cook_vec_push(&c->nodes, node);
+    return (uint32_t)c->nodes.len - 1;
+}
+
+// cook__glob_byte - a node taking one byte of a set
+// @slash: whether the set may hold '/'
+static uint32_t cook__glob_byte(cook__glob_compiler_t *c, const uint64_t bits[4], bool slash, uint32_t out) {
+    uint32_t id = cook__glob_node(c, COOK__GLOB_BYTE, out, COOK__GLOB_NONE);
+    memcpy(c->nodes.items[id].bits, bits, sizeof(c->nodes.items[id].bits));
+    if (!slash) c->nodes.items[id].bits['/' >> 6] &= ~((uint64_t)1 << ('/' & 63));
+    return id;
+}
+
+// cook__glob_item - length of the item that starts at @p, 0 if it is malformed
+// @component: whether @p starts a path component
+static size_t cook__glob_item(const char *p, const char *end, bool component) {
+    size_t n = (size_t)(end - p), j = 1;
+    switch (*p) {
+    case '\\':
+        return n >= 2 ? 2 : 0;
+    case '[':
+        if (j < n && (p[j] == '!' || p[j] == '^')) j++;
+        if (j < n && p[j] == ']') j++;
+        while (j < n && p[j] != ']') j += p[j] == '\\' ? 2 : 1;
+        return j < n ? j + 1 : 0;
+    case '{':
+        for (size_t depth = 1; j < n; ) {
+            if (p[j] == '}' && --depth == 0) return j + 1;
+            if (p[j] == '{') depth++;
+            // only the length counts here, "**/" spans the same bytes either way
+            size_t k = p[j] == '{' || p[j] == '}' ? 1 : cook__glob_item(p + j, end, false);
+            if (k == 0) return 0;
+            j += k;
+        }
+        return 0;
+    case '*':
+        while (j < n && p[j] == '*') j++;
+        // "**/" starting a path component is one item
+        if (j >= 2 && j < n && p[j] == '/' && component) j++;
+        return j;
+    default:
+        return 1;
+    }
+}
+
+static uint32_t cook__glob_range(cook__glob_compiler_t *c, const char *p, const char *end, bool component,
+                                 uint32_t next);
+
+// cook__glob_compile_item - nodes for the item at @p of length @n, which
+// continue at @next
+// @component: whether @p starts a path component, and so do its alternatives
+//
+// Return: entry node
+static uint32_t cook__glob_compile_item(cook__glob_compiler_t *c, const char *p, size_t n, bool component,
+                                        uint32_t next) {
+    uint64_t bits[4] = {0};
+    uint32_t loop;
+    switch (*p) {
+    case '\\':
+        bits[(unsigned char)p[1] >> 6] = (uint64_t)1 << ((unsigned char)p[1] & 63);
+        return cook__glob_byte(c, bits, true, next);
+    case '?':
+        memset(bits, 0xFF, sizeof(bits));
+        return cook__glob_byte(c, bits, false, next);
+    case '[': {
+        size_t j = 1;
+        bool negate = p[j] == '!' || p[j] == '^';
+        if (negate) j++;
+        for (bool first = true; first || p[j] != ']'; first = false) {
+            if (p[j] == '\\') j++;
+            unsigned lo = (unsigned char)p[j++], hi = lo;
+            if (p[j] == '-' && p[j + 1] != ']') {
+                j++;
+                if (p[j] == '\\') j++;
+                hi = (unsigned char)p[j++];
+            }
+            for (unsigned b = lo; b <= hi; b++) bits[b >> 6] |= (uint64_t)1 << (b & 63);
+        }
+        if (negate) {
+            for (size_t k = 0; k < 4; k++) bits[k] = ~bits[k];
+        }
+        return cook__glob_byte(c, bits, false, next);
+    }
+    case '{': {
+        // one entry per alternative, joined by splits
+        uint32_t entry = COOK__GLOB_NONE;
+        const char *alt = p + 1, *close = p + n - 1;
+        for (const char *q = alt; ; ) {
+            if (q == close || *q == ',') {
+                uint32_t e = cook__glob_range(c, alt, q, component, next);
+                entry = entry == COOK__GLOB_NONE ? e : cook__glob_node(c, COOK__GLOB_SPLIT, entry, e);
+                if (q == close) return entry;
+                alt = ++q;
+            } else {
+                q += cook__glob_item(q, close, q == alt ? component : q[-1] == '/');
+            }
+        }
+    }
+    case '*':
+        // a loop over one byte, '/' too for "**"
+        if (p[n - 1] == '/') {
+            // ("**/")?: the loop has to end with a '/'
+            bits['/' >> 6] = (uint64_t)1 << ('/' & 63);
+            uint32_t slash = cook__glob_byte(c, bits, true, next);
+            memset(bits, 0xFF, sizeof(bits));
+            loop = cook__glob_node(c, COOK__GLOB_SPLIT, COOK__GLOB_NONE, slash);
+            uint32_t any = cook__glob_byte(c, bits, true, loop);
+            c->nodes.items[loop].out = any;
+            return cook__glob_node(c, COOK__GLOB_SPLIT, loop, next);
+        }
+        memset(bits, 0xFF, sizeof(bits));
+        loop = cook__glob_node(c, COOK__GLOB_SPLIT, COOK__GLOB_NONE, next);
+        uint32_t body = cook__glob_byte(c, bits, n > 1, loop);
+        c->nodes.items[loop].out = body;
+        return loop;
+    default:
+        bits[(unsigned char)*p >> 6] = (uint64_t)1 << ((unsigned char)*p & 63);
+        return cook__glob_byte(c, bits, true, next);
+    }
+}
+
+// cook__glob_range - nodes for the pattern bytes from @p to @end
+// @component: whether @p starts a path component, later items do after a '/'
+// @next: node to continue at after them
+//
+// Note: the items are compiled last to first, so every one knows its
+//       successor; their offsets wait on a stack shared by the nested
+//       alternatives instead of the call stack
+//
+// Return: entry node, COOK__GLOB_NONE if the pattern is malformed
+static uint32_t cook__glob_range(cook__glob_compiler_t *c, const char *p, const char *end, bool component,
+                                 uint32_t next) {
+    size_t base = c->starts.len;
+    for (const char *q = p; q < end; ) {
+        size_t n = cook__glob_item(q, end, q == p ? component : q[-1] == '/');
+        if (n == 0) {
+            c->starts.len = base;
+            return COOK__GLOB_NONE;
+        }
+        cook_vec_push(&c->starts, (size_t)(q - c->pattern));
+        q += n;
+    }
+    for (size_t k = c->starts.len; k-- > base; ) {
+        c->starts.len = k;
+        const char *q = c->pattern + c->starts.items[k];
+        bool starts = q == p ? component : q[-1] == '/';
+        next = cook__glob_compile_item(c, q, cook__glob_item(q, end, starts), starts, next);
+    }
+    return next;
+}
+
+typedef struct cook__glob_ids {
+    uint32_t *items;
+    size_t len;
+    size_t cap;
+} cook__glob_ids_t;
+
+typedef struct cook__glob_sets {
+    cook__glob_ids_t ids; // node ids of every set, back to back
+    struct { size_t *items; size_t len, cap; } offsets; // set i is ids[offsets[i], offsets[i + 1])
+    uint32_t *table; // open addressing, set index + 1, 0 is free
+    size_t table_cap;
+} cook__glob_sets_t;
+
+static int cook__glob_id_compare(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static size_t cook__glob_set_hash(const uint32_t *ids, size_t n) {
+    uint64_t h = 14695981039346656037ull;
+    for (size_t i = 0; i < n; i++) h = (h ^ ids[i])*1099511628211ull;
+    return (size_t)(h ^ h >> 29);
+}
+
+// cook__glob_intern - number of the DFA state for the node set at the end
+// of @sets->ids, which is dropped again if the set is known
+static uint32_t cook__glob_intern(cook__glob_sets_t *sets, size_t begin) {
+    const uint32_t *ids = sets->ids.items + begin;
+    size_t n = sets->ids.len - begin;
+    size_t mask = sets->table_cap - 1;
+    for (size_t i = cook__glob_set_hash(ids, n) & mask; ; i = (i + 1) & mask) {
+        uint32_t s = sets->table[i];
+        if (s == 0) break;
+        size_t at = sets->offsets.items[s - 1], len = sets->offsets.items[s] - at;
+        if (len == n && (n == 0 || memcmp(sets->ids.items + at, ids, n*sizeof(*ids)) == 0)) {
+            sets->ids.len = begin;
+            return s - 1;
+        }
+    }
+    uint32_t state = (uint32_t)sets->offsets.len - 1;
+    cook_vec_push(&sets->offsets, sets->ids.len);
+    // keep the table at most half full
+    if (2*sets->offsets.len > sets->table_cap) {
+        COOK__FREE(sets->table);
+        sets->table_cap *= 2;
+        sets->table = COOK__ALLOC(sets->table_cap*sizeof(uint32_t), "glob");
+        COOK_ASSERT(sets->table && "out of memory");
+        memset(sets->table, 0, sets->table_cap*sizeof(uint32_t));
+        mask = sets->table_cap - 1;
+        for (uint32_t s = 0; s + 1 < sets->offsets.len; s++) {
+            size_t at = sets->offsets.items[s], len = sets->offsets.items[s + 1] - at;
+            size_t i = cook__glob_set_hash(sets->ids.items + at, len) & mask;
+            while (sets->table[i] != 0) i = (i + 1) & mask;
+            sets->table[i] = s + 1;
+        }
+        return state;
+    }
+    size_t i = cook__glob_set_hash(ids, n) & mask;
+    while (sets->table[i] != 0) i = (i + 1) & mask;
+    sets->table[i] = state + 1;
+    return state;
+}
+
+// cook__glob_closure - add the BYTE and MATCH nodes reachable from @stack
+// without taking a byte to @sets->ids, sorted
+// @mark: per node, @gen if it was visited already
+static void cook__glob_closure(const cook__glob_compiler_t *c, cook__glob_sets_t *sets, uint32_t *mark, uint32_t gen,
+                               cook__glob_ids_t *stack) {
+    size_t begin = sets->ids.len;
+    while (stack->len > 0) {
+        uint32_t id = stack->items[--stack->len];
+        if (mark[id] == gen) continue;
+        mark[id] = gen;
+        const cook__glob_node_t *node = &c->nodes.items[id];
+        if (node->kind == COOK__GLOB_SPLIT) {
+            cook_vec_push(stack, node->out1);
+            cook_vec_push(stack, node->out);
+        } else {
+            cook_vec_push(&sets->ids, id);
+        }
+    }
+    qsort(sets->ids.items + begin, sets->ids.len - begin, sizeof(uint32_t), cook__glob_id_compare);
+}
+
+COOKDEF bool cook_glob_init(cook_glob_t *glob, const cook_string_view_t *patterns, size_t count) {
+    memset(glob, 0, sizeof(*glob));
+    if (count == 0 || count >= COOK__GLOB_NONE) return false;
+
+    // the NFA, entered through a chain of splits, one per pattern
+    cook__glob_compiler_t c = {0};
+    uint32_t start = COOK__GLOB_NONE;
+    for (size_t i = 0; i < count; i++) {
+        c.pattern = patterns[i].data;
+        uint32_t match = cook__glob_node(&c, COOK__GLOB_MATCH, (uint32_t)i, COOK__GLOB_NONE);
+        uint32_t entry = cook__glob_range(&c, patterns[i].data, patterns[i].data + patterns[i].len, true, match);
+        if (entry == COOK__GLOB_NONE) {
+            cook_vec_free(&c.nodes);
+            cook_vec_free(&c.starts);
+            return false;
+        }
+        start = start == COOK__GLOB_NONE ? entry : cook__glob_node(&c, COOK__GLOB_SPLIT, start, entry);
+    }
+    cook_vec_free(&c.starts);
+
+    // a new class wherever some byte set changes its mind
+    glob->class_count = 1;
+    glob->classes[0] = 0;
+    unsigned char first[256] = {0}; // a byte of every class
+    for (unsigned b = 1; b < 256; b++) {
+        bool boundary = false;
+        for (size_t i = 0; i < c.nodes.len && !boundary; i++) {
+            const uint64_t *bits = c.nodes.items[i].bits;
+            boundary = c.nodes.items[i].kind == COOK__GLOB_BYTE &&
+                       ((bits[b >> 6] >> (b & 63)) & 1) != ((bits[(b - 1) >> 6] >> ((b - 1) & 63)) & 1);
+        }
+        if (boundary) first[glob->class_count++] = (unsigned char)b;
+        glob->classes[b] = (unsigned char)(glob->class_count - 1);
+    }
+
+    // subset construction, state 0 is the empty set
+    cook__glob_sets_t sets = {0};
+    cook__glob_ids_t stack = {0}, delta = {0};
+    sets.table_cap = 64;
+    sets.table = COOK__ALLOC(sets.table_cap*sizeof(uint32_t), "glob");
+    uint32_t *mark = COOK__ALLOC(c.nodes.len*sizeof(uint32_t), "glob");
+    COOK_ASSERT(sets.table && mark && "out of memory");
+    memset(sets.table, 0, sets.table_cap*sizeof(uint32_t));
+    memset(mark, 0xFF, c.nodes.len*sizeof(uint32_t));
+    cook_vec_push(&sets.offsets, 0);
+    cook__glob_intern(&sets, 0);
+    cook_vec_push(&stack, start);
+    cook__glob_closure(&c, &sets, mark, 0, &stack);
+    glob->start = cook__glob_intern(&sets, 0);
+    bool ok = true;
+    uint32_t gen = 1;
+    for (size_t s = 0; s + 1 < sets.offsets.len; s++) {
+        if (sets.offsets.len > COOK__GLOB_MAX_STATES + 1) {
+            ok = false;
+            break;
+        }
+        for (size_t k = 0; k < glob->class_count; k++) {
+            unsigned char b = first[k];
+            for (size_t i = sets.offsets.items[s]; i < sets.offsets.items[s + 1]; i++) {
+                const cook__glob_node_t *node = &c.nodes.items[sets.ids.items[i]];
+                if (node->kind == COOK__GLOB_BYTE && ((node->bits[b >> 6] >> (b & 63)) & 1)) {
+                    cook_vec_push(&stack, node->out);
+                }
+            }
+            size_t begin = sets.ids.len;
+            cook__glob_closure(&c, &sets, mark, gen++, &stack);
+            cook_vec_push(&delta, cook__glob_intern(&sets, begin));
+        }
+    }
+
+    glob->state_count = sets.offsets.len - 1;
+    if (ok) {
+        glob->count = count;
+        size_t n = glob->state_count, cc = glob->class_count;
+        uint32_t *accept = COOK__ALLOC(n*sizeof(uint32_t), "glob");
+        uint32_t *perm = COOK__ALLOC(n*sizeof(uint32_t), "glob");
+        glob->accept = COOK__ALLOC(n*sizeof(uint32_t), "glob");
+        glob->delta = COOK__ALLOC(n*cc*sizeof(uint32_t), "glob");
+        COOK_ASSERT(accept && perm && glob->accept && glob->delta && "out of memory");
+        memset(perm, 0, n*sizeof(uint32_t));
+        for (size_t s = 0; s < n; s++) {
+            accept[s] = COOK__GLOB_NONE;
+            for (size_t i = sets.offsets.items[s]; i < sets.offsets.items[s + 1]; i++) {
+                const cook__glob_node_t *node = &c.nodes.items[sets.ids.items[i]];
+                if (node->kind == COOK__GLOB_MATCH && node->out < accept[s]) accept[s] = node->out;
+            }
+        }
+        // accepting states go last, so a match is one compare at the end
+        // instead of a division and a lookup; the dead state stays 0
+        uint32_t rejecting = 0;
+        for (size_t s = 0; s < n; s++) rejecting += accept[s] == COOK__GLOB_NONE;
+        glob->match_start = rejecting*(uint32_t)cc;
+        for (size_t s = 0, lo = 0, hi = rejecting; s < n; s++) {
+            perm[s] = (uint32_t)(accept[s] == COOK__GLOB_NONE ? lo++ : hi++);
+        }
+        for (size_t s = 0; s < n; s++) {
+            glob->accept[perm[s]] = accept[s];
+            for (size_t k = 0; k < cc; k++) glob->delta[perm[s]*cc + k] = perm[delta.items[s*cc + k]];
+        }
+        glob->start = perm[glob->start];
+        for (size_t i = 0; i < n*cc; i++) glob->delta[i] *= (uint32_t)cc;
+        glob->start *= (uint32_t)cc;
+        COOK__FREE(accept);
+        COOK__FREE(perm);
+    }
+    cook_vec_free(&delta);
+    if (!ok) memset(glob, 0, sizeof(*glob));
+    COOK__FREE(mark);
+    COOK__FREE(sets.table);
+    cook_vec_free(&sets.ids);
+    cook_vec_free(&sets.offsets);
+    cook_vec_free(&stack);
+    cook_vec_free(&c.nodes);
+    return ok;
+}
+
+COOKDEF void cook_glob_free(cook_glob_t *glob) {
+    if (glob->delta) COOK__FREE(glob->delta);
+    if (glob->accept) COOK__FREE(glob->accept);
+    memset(glob, 0, sizeof(*glob));
+}
+
+// cook__glob_run - the state a glob ends in after @name, premultiplied
+static inline uint32_t cook__glob_run(const cook_glob_t *glob, cook_string_view_t name) {
+    const unsigned char *s = (const unsigned char *)name.data;
+    uint32_t state = glob->start;
+    for (size_t i = 0; i < name.len && state != 0; i++) state = glob->delta[state + glob->classes[s[i]]];
+    return state;
+}
+
+COOKDEF bool cook_glob_match(const cook_glob_t *glob, cook_string_view_t name, size_t *pattern) {
+    uint32_t state = cook__glob_run(glob, name);
+    if (state < glob->match_start) return false;
+    if (pattern) *pattern = glob->accept[state/(uint32_t)glob->class_count];
+    return true;
+}
+
+COOKDEF size_t cook_glob_filter(const cook_glob_t *glob, cook_string_view_t *names, size_t count) {
+    size_t kept = 0;
+    for (size_t i = 0; i < count; i++) {
+        // stored either way, a branch on the outcome would mispredict
+        cook_string_view_t name = names[i];
+        names[kept] = name;
+        kept += cook__glob_run(glob, name) >= glob->match_start;
+    }
+    return kept;
+}
+
+// cook__prefix_xor - bit i becomes the xor of bits 0 to i
+static inline uint64_t cook__prefix_xor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+#ifdef COOK__SIMD_X86
+
+static uint64_t cook__csv_mask64_sse2(const char *s, char delim, uint64_t *quotes) {
+    __m128i q = _mm_set1_epi8('"'), d = _mm_set1_epi8(delim), nl = _mm_set1_epi8('\n');
+    uint64_t ends = 0, found = 0;
+    for (int k = 0; k < 4; k++) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(s + 16*k));
+        __m128i end = _mm_or_si128(_mm_cmpeq_epi8(x, d), _mm_cmpeq_epi8(x, nl));
+        found |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, q)) << 16*k;
+        ends |= (uint64_t)(unsigned)_mm_movemask_epi8(end) << 16*k;
+    }
+    *quotes = found;
+    return ends;
+}
+
+COOK__AVX2 static uint64_t cook__csv_mask64_avx2(const char *s, char delim, uint64_t *quotes) {
+    __m256i q = _mm256_set1_epi8('"'), d = _mm256_set1_epi8(delim), nl = _mm256_set1_epi8('\n');
+    __m256i lo = _mm256_loadu_si256((const __m256i *)s);
+    __m256i hi = _mm256_loadu_si256((const __m256i *)(s + 32));
+    __m256i lo_end = _mm256_or_si256(_mm256_cmpeq_epi8(lo, d), _mm256_cmpeq_epi8(lo, nl));
+    __m256i hi_end = _mm256_or_si256(_mm256_cmpeq_epi8(hi, d), _mm256_cmpeq_epi8(hi, nl));
+    *quotes = (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, q)) |
+              (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, q)) << 32;
+    return (uint64_t)(uint32_t)_mm256_movemask_epi8(lo_end) | (uint64_t)(uint32_t)_mm256_movemask_epi8(hi_end) << 32;
+}
+
+#endif // COOK__SIMD_X86
+
+// cook__csv_mask64 - field ends (delimiters and newlines) among the first
+// min(@n, 64) bytes of @s, @quotes receives the quotes
+static uint64_t cook__csv_mask64(const char *s, size_t n, char delim, uint64_t *quotes) {
+#ifdef COOK__SIMD_X86
+    if (n >= 64) return cook__cpu_avx2() ? cook__csv_mask64_avx2(s, delim, quotes) : cook__csv_mask64_sse2(s, delim, quotes);
+#endif
+    uint64_t ends = 0, found = 0;
+    if (n > 64) n = 64;
+    for (size_t i = 0; i < n; i++) {
+        found |= (uint64_t)(s[i] == '"') << i;
+        ends |= (uint64_t)(s[i] == delim || s[i] == '\n') << i;
+    }
+    *quotes = found;
+    return ends;
+}
+
+// cook__csv_field - make a field of the raw bytes [@begin, @end)
+static inline cook_csv_field_t cook__csv_field(const char *begin, const char *end, bool record_end) {
+    if (record_end && end > begin && end[-1] == '\r') end--;
+    cook_csv_field_t field = {cook_sv_from_parts(begin, (size_t)(end - begin)), false};
+    if (field.sv.len > 0 && begin[0] == '"') {
+        field.sv.data++;
+        field.sv.len -= 1 + (field.sv.len >= 2 && end[-1] == '"');
+        field.escaped = field.sv.len > 0 && memchr(field.sv.data, '"', field.sv.len) != NULL;
+    }
+    return field;
+}
+
+// cook__csv_parse - parse the record at the front of csv->rest
+// @final: the input ends where csv->rest ends
+//
+// Return: 1 for a record, 0 at the end of the input, -1 if the record may
+//         go on past the bytes read so far
+static int cook__csv_parse(cook_csv_t *csv, cook_csv_record_t *record, bool final) {
+    if (csv->rest.len == 0) return final ? 0 : -1;
+    // the scan state and the record live in locals, the compiler would
+    // reload them after every field stored otherwise
+    const char *field = csv->rest.data, *end = csv->rest.data + csv->rest.len;
+    const char *block = csv->block;
+    uint64_t mask = csv->mask, inside = csv->inside;
+    char delim = csv->delim;
+    cook_csv_field_t *items = record->items;
+    size_t len = 0, cap = record->cap;
+    for (;;) {
+        while (!mask) {
+            const char *next = block ? block + 64 : field;
+            if (next >= end) {
+                if (!final) return -1;
+                record->len = len;
+                cook_vec_push(record, cook__csv_field(field, end, true));
+                csv->rest = cook_sv_from_parts(end, 0);
+                return 1;
+            }
+            block = next;
+            uint64_t quotes;
+            uint64_t ends = cook__csv_mask64(block, (size_t)(end - block), delim, &quotes);
+            uint64_t quoted = cook__prefix_xor(quotes) ^ inside;
+            inside = (uint64_t)0 - (quoted >> 63);
+            mask = ends & ~quoted;
+        }
+        const char *at = block + cook__ctz64(mask);
+        mask &= mask - 1;
+        bool record_end = *at == '\n';
+        if (len == cap) {
+            record->len = len;
+            cook__vec_grow(record, "csv");
+            items = record->items;
+            cap = record->cap;
+        }
+        items[len++] = cook__csv_field(field, at, record_end);
+        field = at + 1;
+        if (record_end) break;
+    }
+    record->len = len;
+    csv->rest = cook_sv_from_parts(field, (size_t)(end - field));
+    csv->block = block;
+    csv->mask = mask;
+    csv->inside = inside;
+    return 1;
+}
+
+// cook__csv_refill - move the unparsed bytes to the front and read more
+static void cook__csv_refill(cook_csv_t *csv) {
+    size_t keep = csv->rest.len;
+    if (keep > 0 && csv->rest.data != csv->buf) memmove(csv->buf, csv->rest.data, keep);
+    if (keep == csv->cap) {
+        // a record longer than the buffer
+        csv->cap = csv->cap ? 2*csv->cap : COOK_CSV_BUFFER_SIZE;
+        csv->buf = COOK__REALLOC(csv->buf, csv->cap, "csv");
+        COOK_ASSERT(csv->buf != NULL && "out of memory");
+    }
+    long n = csv->reader->read(csv->reader, csv->buf + keep, csv->cap - keep);
+    if (n > 0) keep += (size_t)n;
+    else csv->eof = true;
+    // the scan restarts at the record, which is never inside quotes
+    csv->rest = cook_sv_from_parts(csv->buf, keep);
+    csv->block = NULL;
+    csv->mask = 0;
+    csv->inside = 0;
+}
+
+COOKDEF cook_csv_t cook_csv_from_sv(cook_string_view_t text, char delim) {
+    return (cook_csv_t) {
+        .rest = text,
+        .delim = delim
+    };
+}
+
+COOKDEF cook_csv_t cook_csv_from_reader(cook_reader_t *reader, char delim) {
+    return (cook_csv_t) {
+        .delim = delim,
+        .reader = reader
+    };
+}
+
+COOKDEF void cook_csv_free(cook_csv_t *csv) {
+    if (csv->buf) COOK__FREE(csv->buf);
+    csv->buf = NULL;
+    csv->cap = 0;
+    csv->rest = cook_sv_from_parts(NULL, 0);
+}
+
+COOKDEF bool cook_csv_next(cook_csv_t *csv, cook_csv_record_t *record) {
+    for (;;) {
+        int r = cook__csv_parse(csv, record, !csv->reader || csv->eof);
+        if (r >= 0) return r == 1;
+        cook__csv_refill(csv);
+    }
+}
+
+COOKDEF cook_string_view_t cook_csv_unescape(cook_csv_field_t field, cook_string_builder_t *sb) {
+    if (!field.escaped) return field.sv;
+    size_t start = sb->len;
+    cook_string_view_t rest = field.sv;
+    while (rest.len > 0) {
+        size_t i = cook_sv_find_char(rest, '"');
+        if (i == COOK_SV_NPOS) {
+            cook_sb_append_sv(sb, rest);
+            break;
+        }
+        // keep the first quote of a pair, skip the second
+        cook_sb_append_parts(sb, rest.data, i + 1);
+        i += 1 + (i + 1 < rest.len && rest.data[i + 1] == '"');
+        rest.data += i;
+        rest.len -= i;
+    }
+    return cook_sv_from_parts(sb->items + start, sb->len - start);
+}
+
+typedef struct cook__csv_chunk {
+    cook_string_view_t text;
+    char delim;
+    size_t index;
+    size_t quotes;
+    cook_csv_fn fn;
+    void *user;
+} cook__csv_chunk_t;
+
+static void cook__csv_count_quotes(void *arg) {
+    cook__csv_chunk_t *chunk = arg;
+    chunk->quotes = cook_sv_count_char(chunk->text, '"');
+}
+
+static void cook__csv_parse_chunk(void *arg) {
+    cook__csv_chunk_t *chunk = arg;
+    cook_csv_t csv = cook_csv_from_sv(chunk->text, chunk->delim);
+    cook_csv_record_t record = {0};
+    while (cook_csv_next(&csv, &record)) chunk->fn(&record, chunk->index, chunk->user);
+    cook_vec_free(&record);
+}
+
+// cook__csv_record_start - first record start at or after @i
+// @inside: whether @i is inside a quoted field
+static size_t cook__csv_record_start(cook_string_view_t text, size_t i, bool inside) {
+    cook_byteset_t set = cook_byteset_make(cook_sv_from_cstr("\"\n"));
+    while (i < text.len) {
+        size_t j = cook_sv_find_byteset(cook_sv_from_parts(text.data + i, text.len - i), &set);
+        if (j == COOK_SV_NPOS) break;
+        i += j + 1;
+        if (text.data[i - 1] == '"') inside = !inside;
+        else if (!inside) return i;
+    }
+    return text.len;
+}
+
+COOKDEF size_t cook_csv_parse_parallel(cook_string_view_t text, char delim, size_t threads,
+                                       cook_csv_fn fn, void *user) {
+    if (threads == 0) threads = cook__cpu_count();
+    if (threads > COOK__MAX_THREADS) threads = COOK__MAX_THREADS;
+    // at least a megabyte per chunk
+    size_t most = text.len/(1024*1024) + 1;
+    if (threads > most) threads = most;
+
+    cook__csv_chunk_t chunks[COOK__MAX_THREADS];
+    for (size_t i = 0; i < threads; i++) {
+        size_t begin = i*(text.len/threads), end = i + 1 == threads ? text.len : (i + 1)*(text.len/threads);
+        chunks[i] = (cook__csv_chunk_t){cook_sv_from_parts(text.data + begin, end - begin), delim, i, 0, fn, user};
+    }
+    if (threads > 1) cook__run_parallel(cook__csv_count_quotes, chunks, sizeof(chunks[0]), threads);
+
+    // the quotes before a cut tell whether it is inside a quoted field,
+    // then it moves forward to the next record
+    size_t starts[COOK__MAX_THREADS + 1], quotes = 0;
+    starts[0] = 0;
+    for (size_t i = 1; i < threads; i++) {
+        quotes += chunks[i - 1].quotes;
+        size_t start = cook__csv_record_start(text, (size_t)(chunks[i].text.data - text.data), quotes & 1);
+        starts[i] = start > starts[i - 1] ? start : starts[i - 1];
+    }
+    starts[threads] = text.len;
+    for (size_t i = 0; i < threads; i++) {
+        chunks[i].text = cook_sv_from_parts(text.data + starts[i], starts[i + 1] - starts[i]);
+    }
+    cook__run_parallel(cook__csv_parse_chunk, chunks, sizeof(chunks[0]), threads);
+    return threads;
+}
+
+// set in the index offset of the closing quote of a string with escapes
+#define COOK__JSON_ESCAPED 0x80000000u
+
+// input is indexed and parsed 64 KB at a time
+#define COOK__JSON_CHUNK (64*1024)
+
+// one 64-byte block of JSON, one bit per byte
+typedef struct cook__json_block {
+    uint64_t quote;
+    uint64_t backslash;
+    uint64_t op;    // {}[]:,
+    uint64_t space; // the four JSON whitespace bytes
+    uint64_t ctrl;  // bytes below 0x20, not allowed in strings
+} cook__json_block_t;
+
+// stage one state, carried from block to block
+typedef struct cook__json_scan {
+    uint64_t escape; // the first byte of the next block is escaped
+    uint64_t string; // all ones if the next block starts inside a string
+    uint64_t scalar; // the last byte was part of a number or literal
+    uint64_t slash;  // the string going on into the next block has a backslash
+    uint32_t *index;
+    size_t len;
+    size_t error;    // offset of a control character in a string, or SIZE_MAX
+} cook__json_scan_t;
+
+// cook__json_scan_block - append the structural offsets of the block at
+// @pos to the index
+static COOK__FORCE_INLINE void cook__json_scan_block(cook__json_scan_t *scan, const cook__json_block_t *b, size_t pos) {
+    const uint64_t odd = 0xAAAAAAAAAAAAAAAAull;
+    // a backslash escapes the next byte unless it is escaped itself:
+    // odd-length runs of backslashes escape, even-length ones do not
+    uint64_t escaped = scan->escape;
+    if (b->backslash) {
+        uint64_t start = b->backslash & ~scan->escape;
+        uint64_t code = (((start << 1) | odd) - start) ^ odd;
+        escaped = code ^ (b->backslash | scan->escape);
+        scan->escape = (code & b->backslash) >> 63;
+    } else {
+        scan->escape = 0;
+    }
+    // from each opening quote up to its closing quote
+    uint64_t quote = b->quote & ~escaped;
+    uint64_t string = cook__prefix_xor(quote) ^ scan->string;
+    scan->string = (uint64_t)0 - (string >> 63);
+    if ((b->ctrl & string) && scan->error == SIZE_MAX) scan->error = pos + cook__ctz64(b->ctrl & string);
+    uint64_t scalar = ~(b->op | b->space | quote | string);
+    uint64_t bits = (b->op & ~string) | quote | (scalar & ~(scalar << 1 | scan->scalar));
+    scan->scalar = scalar >> 63;
+
+    // closing quotes of strings with a backslash, quotes alternate between
+    // opening and closing and @begin is the last opening one
+    uint64_t slashes = b->backslash & string, flagged = 0;
+    if (slashes | scan->slash) {
+        uint64_t begin = 0;
+        for (uint64_t rest = quote; rest; rest &= rest - 1) {
+            uint64_t at = rest & (0 - rest);
+            if (!(at & string)) {
+                bool slash = begin ? (slashes & (at - begin)) != 0 : (slashes & (at - 1)) || scan->slash;
+                if (slash) flagged |= at;
+            } else {
+                begin = at;
+            }
+        }
+        if (!(string >> 63)) scan->slash = 0;
+        else if (begin) scan->slash = (slashes & (0 - begin)) != 0;
+        else scan->slash = slashes || scan->slash;
+    }
+
+    // eight offsets at a time, the stores past the last one are
+    // overwritten by the next block
+    uint32_t *out = scan->index + scan->len;
+    size_t found = cook__popcount64(bits);
+    for (size_t k = 0; k < found; k += 8) {
+        for (size_t j = 0; j < 8; j++) {
+            out[k + j] = (uint32_t)(pos + cook__ctz64(bits | (uint64_t)1 << 63));
+            bits &= bits - 1;
+        }
+    }
+    for (size_t k = 0; flagged && k < found; k++) {
+        if (flagged & (uint64_t)1 << (out[k] - pos)) out[k] |= COOK__JSON_ESCAPED;
+    }
+    scan->len += found;
+}
+
+#ifdef COOK__SIMD_X86
+
+static inline void cook__json_classify_sse2(const char *s, cook__json_block_t *b) {
+    __m128i q = _mm_set1_epi8('"'), bs = _mm_set1_epi8('\\'), lower = _mm_set1_epi8(0x20);
+    __m128i open = _mm_set1_epi8('{'), close = _mm_set1_epi8('}'), colon = _mm_set1_epi8(':'), comma = _mm_set1_epi8(',');
+    __m128i tab = _mm_set1_epi8('\t'), nl = _mm_set1_epi8('\n'), cr = _mm_set1_epi8('\r'), ctrl = _mm_set1_epi8(0x1F);
+    *b = (cook__json_block_t){0};
+    for (int k = 0; k < 4; k++) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(s + 16*k));
+        // '[' and ']' are '{' and '}' without the 0x20 bit
+        __m128i folded = _mm_or_si128(x, lower);
+        __m128i op = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(folded, open), _mm_cmpeq_epi8(folded, close)),
+                                  _mm_or_si128(_mm_cmpeq_epi8(x, colon), _mm_cmpeq_epi8(x, comma)));
+        __m128i space = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, lower), _mm_cmpeq_epi8(x, tab)),
+                                     _mm_or_si128(_mm_cmpeq_epi8(x, nl), _mm_cmpeq_epi8(x, cr)));
+        b->quote |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, q)) << 16*k;
+        b->backslash |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, bs)) << 16*k;
+        b->op |= (uint64_t)(unsigned)_mm_movemask_epi8(op) << 16*k;
+        b->space |= (uint64_t)(unsigned)_mm_movemask_epi8(space) << 16*k;
+        b->ctrl |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(x, ctrl), x)) << 16*k;
+    }
+}
+
+COOK__AVX2 static inline void cook__json_classify_avx2(const char *s, cook__json_block_t *b) {
+    __m256i q = _mm256_set1_epi8('"'), bs = _mm256_set1_epi8('\\'), lower = _mm256_set1_epi8(0x20);
+    __m256i open = _mm256_set1_epi8('{'), close = _mm256_set1_epi8('}');
+    __m256i colon = _mm256_set1_epi8(':'), comma = _mm256_set1_epi8(','), ctrl = _mm256_set1_epi8(0x1F);
+    // whitespace by its low nibble: ' ' 0x20, '\t' 0x09, '\n' 0x0A, '\r' 0x0D,
+    // bytes with the high bit set look up 0 and never match
+    __m256i spaces = _mm256_setr_epi8(' ', 0, 0, 0, 0, 0, 0, 0, 0, '\t', '\n', 0, 0, '\r', 0, 0,
+                                      ' ', 0, 0, 0, 0, 0, 0, 0, 0, '\t', '\n', 0, 0, '\r', 0, 0);
+    uint64_t masks[5][2];
+    for (int k = 0; k < 2; k++) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(s + 32*k));
+        __m256i folded = _mm256_or_si256(x, lower);
+        __m256i op = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(folded, open), _mm256_cmpeq_epi8(folded, close)),
+                                     _mm256_or_si256(_mm256_cmpeq_epi8(x, colon), _mm256_cmpeq_epi8(x, comma)));
+        masks[0][k] = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, q));
+        masks[1][k] = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, bs));
+        masks[2][k] = (uint32_t)_mm256_movemask_epi8(op);
+        masks[3][k] = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_shuffle_epi8(spaces, x), x));
+        masks[4][k] = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(x, ctrl), x));
+    }
+    b->quote = masks[0][0] | masks[0][1] << 32;
+    b->backslash = masks[1][0] | masks[1][1] << 32;
+    b->op = masks[2][0] | masks[2][1] << 32;
+    b->space = masks[3][0] | masks[3][1] << 32;
+    b->ctrl = masks[4][0] | masks[4][1] << 32;
+}
+
+static void cook__json_scan_sse2(cook__json_scan_t *scan, const char *s, size_t pos, size_t n) {
+    for (size_t i = 0; i < n; i += 64) {
+        cook__json_block_t b;
+        cook__json_classify_sse2(s + i, &b);
+        cook__json_scan_block(scan, &b, pos + i);
+    }
+}
+
+COOK__AVX2 static void cook__json_scan_avx2(cook__json_scan_t *scan, const char *s, size_t pos, size_t n) {
+    for (size_t i = 0; i < n; i += 64) {
+        cook__json_block_t b;
+        cook__json_classify_avx2(s + i, &b);
+        cook__json_scan_block(scan, &b, pos + i);
+    }
+}
+
+#endif // COOK__SIMD_X86
+
+// cook__json_scan - index the @n bytes at @s, a multiple of 64, which are
+// at offset @pos of the input
+static void cook__json_scan(cook__json_scan_t *scan, const char *s, size_t pos, size_t n) {
+#ifdef COOK__SIMD_X86
+    if (cook__cpu_avx2()) cook__json_scan_avx2(scan, s, pos, n);
+    else cook__json_scan_sse2(scan, s, pos, n);
+#else
+    for (size_t i = 0; i < n; i += 64) {
+        cook__json_block_t b = {0};
+        for (size_t k = 0; k < 64; k++) {
+            char c = s[i + k];
+            b.quote |= (uint64_t)(c == '"') << k;
+            b.backslash |= (uint64_t)(c == '\\') << k;
+            b.op |= (uint64_t)(c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',') << k;
+            b.space |= (uint64_t)(c == ' ' || c == '\t' || c == '\n' || c == '\r') << k;
+            b.ctrl |= (uint64_t)((unsigned char)c < 0x20) << k;
+        }
+        cook__json_scan_block(scan, &b, pos + i);
+    }
+#endif
+}
+
+// cook__json_fail - record a parse error
+static bool cook__json_fail(cook_json_t *doc, const char *error, size_t offset) {
+    doc->len = 0;
+    doc->error = error;
+    doc->error_offset = offset;
+    return false;
+}
+
+// cook__json_number_len - length of the JSON number at @s, 0 if there is none
+static size_t cook__json_number_len(const char *s, const char *end) {
+    const char *p = s;
+    if (p < end && *p == '-') p++;
+    if (p < end && *p == '0') {
+        p++;
+    } else if (p < end && *p >= '1' && *p <= '9') {
+        while (p < end && *p >= '0' && *p <= '9') p++;
+    } else {
+        return 0;
+    }
+    if (p < end && *p == '.') {
+        if (++p == end || *p < '0' || *p > '9') return 0;
+        while (p < end && *p >= '0' && *p <= '9') p++;
+    }
+    if (p < end && (*p | 0x20) == 'e') {
+        p++;
+        if (p < end && (*p == '+' || *p == '-')) p++;
+        if (p == end || *p < '0' || *p > '9') return 0;
+        while (p < end && *p >= '0' && *p <= '9') p++;
+    }
+    return (size_t)(p - s);
+}
+
+// cook__json_scalar_end - whether a number or literal may end before @at
+static inline bool cook__json_scalar_end(cook_string_view_t text, size_t at) {
+    if (at == text.len) return true;
+    char c = text.data[at];
+    return c == ',' || c == ']' || c == '}' || c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == ':';
+}
+
+// cook__json_check_escapes - check the escapes of a string node
+static bool cook__json_check_escapes(cook_json_t *doc, cook_string_view_t text, const cook_json_node_t *node) {
+    const char *p = node->sv.data, *end = node->sv.data + node->sv.len;
+    while (p < end && (p = memchr(p, '\\', (size_t)(end - p))) != NULL) {
+        // a backslash is never the last byte, it would escape the quote
+        char c = p[1];
+        if (c == 'u') {
+            if (end - p < 6 || cook__hex_value(p[2]) > 15 || cook__hex_value(p[3]) > 15 ||
+                cook__hex_value(p[4]) > 15 || cook__hex_value(p[5]) > 15) {
+                return cook__json_fail(doc, "invalid \\u escape", (size_t)(p - text.data));
+            }
+            p += 6;
+        } else if (c == '"' || c == '\\' || c == '/' || c == 'b' || c == 'f' || c == 'n' || c == 'r' || c == 't') {
+            p += 2;
+        } else {
+            return cook__json_fail(doc, "invalid escape", (size_t)(p - text.data));
+        }
+    }
+    return true;
+}
+
+// cook__json_string_node - fill @node with the string whose quotes are at
+// @index[@i] and @index[@i + 1]
+static inline bool cook__json_string_node(cook_json_t *doc, cook_string_view_t text, const uint32_t *index,
+                                          size_t i, size_t count, cook_json_node_t *node) {
+    size_t open = index[i];
+    // everything up to the closing quote is masked out of the index, so the
+    // next offset is the closing quote if there is one
+    if (i + 1 == count) return cook__json_fail(doc, "unterminated string", open);
+    uint32_t close = index[i + 1];
+    const char *begin = text.data + open + 1, *end = text.data + (close & ~COOK__JSON_ESCAPED);
+    *node = (cook_json_node_t){cook_sv_from_parts(begin, (size_t)(end - begin)), COOK_JSON_STRING, 1, 0,
+                               (close & COOK__JSON_ESCAPED) != 0};
+    return !node->escaped || cook__json_check_escapes(doc, text, node);
+}
+
+// cook__json_literal - whether @word is at @at, followed by the end of
+// the value
+static inline bool cook__json_literal(cook_string_view_t text, size_t at, const char *word, size_t n) {
+    return text.len - at >= n && memcmp(text.data + at, word, n) == 0 && cook__json_scalar_end(text, at + n);
+}
+
+enum {
+    COOK__JSON_VALUE,
+    COOK__JSON_ELEMENT_OR_END,
+    COOK__JSON_KEY_OR_END,
+    COOK__JSON_KEY,
+    COOK__JSON_AFTER,
+};
+
+// stage two state, carried from chunk to chunk
+typedef struct cook__json_parser {
+    uint32_t stack[COOK_JSON_MAX_DEPTH]; // nodes of the open containers
+    size_t depth;
+    size_t len;                          // nodes on the tape
+    int state;
+} cook__json_parser_t;
+
+// cook__json_build - stage two, check the grammar and add the values to
+// the tape
+// @index: offsets from stage one
+// @count: number of offsets
+// @final: the offsets go up to the end of the input, otherwise the last
+//         two are left for the next call, a key looks two ahead
+// @used: receives the number of offsets consumed
+static bool cook__json_build(cook_json_t *doc, cook_string_view_t text, cook__json_parser_t *p,
+                             const uint32_t *index, size_t count, bool final, size_t *used) {
+    const char *s = text.data;
+    cook_json_node_t *nodes = doc->nodes;
+    uint32_t *stack = p->stack;
+    size_t len = p->len, depth = p->depth, i = 0;
+    size_t stop = final ? count : count > 2 ? count - 2 : 0;
+    int state = p->state;
+    // the innermost open container, its count is kept in @elements while
+    // it is innermost, the node would have to be reloaded after every store
+    cook_json_node_t *parent = depth > 0 ? &nodes[stack[depth - 1]] : NULL;
+    char close = !parent ? 0 : parent->type == COOK_JSON_OBJECT ? '}' : ']';
+    uint32_t elements = parent ? parent->count : 0;
+    while (i < stop) {
+        size_t at = index[i];
+        char c = s[at];
+        switch (state) {
+        case COOK__JSON_AFTER:
+            i++;
+            if (c == ',' && depth > 0) {
+                if (close == '}') {
+                    state = COOK__JSON_KEY;
+                } else {
+                    elements++;
+                    state = COOK__JSON_VALUE;
+                }
+            } else if (depth > 0 && c == close) {
+                parent->skip = (uint32_t)(len - (size_t)(parent - nodes));
+                parent->sv.len = (size_t)(s + at + 1 - parent->sv.data);
+                parent->count = elements;
+                if (--depth > 0) {
+                    parent = &nodes[stack[depth - 1]];
+                    close = parent->type == COOK_JSON_OBJECT ? '}' : ']';
+                    elements = parent->count;
+                } else {
+                    // no byte closes anything after the root, not even NUL
+                    parent = NULL;
+                    close = 0;
+                }
+            } else {
+                return cook__json_fail(doc, depth == 0 ? "trailing characters" :
+                                       close == '}' ? "expected ',' or '}'" : "expected ',' or ']'", at);
+            }
+            continue;
+
+        case COOK__JSON_KEY_OR_END:
+            if (c == '}') {
+                state = COOK__JSON_AFTER;
+                continue;
+            }
+            // fallthrough
+        case COOK__JSON_KEY:
+            if (c != '"') return cook__json_fail(doc, "expected a string key", at);
+            elements++;
+            if (!cook__json_string_node(doc, text, index, i, count, &nodes[len])) return false;
+            len++;
+            i += 2;
+            if (i == count || s[index[i]] != ':') {
+                return cook__json_fail(doc, "expected ':'", i == count ? text.len : index[i]);
+            }
+            i++;
+            state = COOK__JSON_VALUE;
+            continue;
+
+        case COOK__JSON_ELEMENT_OR_END:
+            if (c == ']') {
+                state = COOK__JSON_AFTER;
+                continue;
+            }
+            elements++;
+            // fallthrough
+        default:
+            break;
+        }
+
+        cook_json_node_t *node = &nodes[len++];
+        *node = (cook_json_node_t){cook_sv_from_parts(s + at, 0), COOK_JSON_NULL, 1, 0, false};
+        state = COOK__JSON_AFTER;
+        i++;
+        switch (c) {
+        case '{':
+        case '[':
+            if (depth == COOK_JSON_MAX_DEPTH) return cook__json_fail(doc, "nested too deeply", at);
+            node->type = c == '{' ? COOK_JSON_OBJECT : COOK_JSON_ARRAY;
+            if (parent) parent->count = elements;
+            stack[depth++] = (uint32_t)(len - 1);
+            parent = node;
+            elements = 0;
+            close = c == '{' ? '}' : ']';
+            state = c == '{' ? COOK__JSON_KEY_OR_END : COOK__JSON_ELEMENT_OR_END;
+            break;
+        case '"':
+            if (!cook__json_string_node(doc, text, index, i - 1, count, node)) return false;
+            i++;
+            break;
+        case 't':
+            if (!cook__json_literal(text, at, "true", 4)) return cook__json_fail(doc, "invalid literal", at);
+            node->type = COOK_JSON_TRUE;
+            node->sv.len = 4;
+            break;
+        case 'f':
+            if (!cook__json_literal(text, at, "false", 5)) return cook__json_fail(doc, "invalid literal", at);
+            node->type = COOK_JSON_FALSE;
+            node->sv.len = 5;
+            break;
+        case 'n':
+            if (!cook__json_literal(text, at, "null", 4)) return cook__json_fail(doc, "invalid literal", at);
+            node->sv.len = 4;
+            break;
+        default: {
+            size_t n = cook__json_number_len(s + at, s + text.len);
+            if (n == 0 || !cook__json_scalar_end(text, at + n)) {
+                bool other = c == ',' || c == ':' || c == ']' || c == '}';
+                return cook__json_fail(doc, other ? "expected a value" : "invalid number", at);
+            }
+            node->type = COOK_JSON_NUMBER;
+            node->sv.len = n;
+        } break;
+        }
+    }
+    if (final && (depth > 0 || state != COOK__JSON_AFTER)) {
+        return cook__json_fail(doc, "unexpected end of input", text.len);
+    }
+    if (parent) parent->count = elements;
+    p->len = len;
+    p->depth = depth;
+    p->state = state;
+    *used = i;
+    return true;
+}
+
+// cook__json_reserve - make room for @cap nodes, keeping the first @len
+static void cook__json_reserve(cook_json_t *doc, cook_arena_t *arena, size_t cap, size_t len) {
+    if (doc->cap >= cap) return;
+    if (cap < 2*doc->cap) cap = 2*doc->cap;
+    if (arena) {
+        // the old nodes stay in the arena until it is reset
+        cook_json_node_t *nodes = cook_arena_alloc(arena, cap*sizeof(*nodes));
+        COOK_ASSERT(nodes != NULL && "out of memory");
+        if (len > 0) memcpy(nodes, doc->nodes, len*sizeof(*nodes));
+        doc->nodes = nodes;
+    } else {
+        doc->nodes = COOK__REALLOC(doc->nodes, cap*sizeof(*doc->nodes), "json");
+        COOK_ASSERT(doc->nodes != NULL && "out of memory");
+    }
+    doc->cap = cap;
+}
+
+COOKDEF bool cook_json_parse(cook_json_t *doc, cook_string_view_t text, cook_arena_t *arena) {
+    doc->len = 0;
+    doc->error = NULL;
+    doc->error_offset = 0;
+    // offsets are 31-bit, the top bit flags strings with escapes
+    if (text.len >= COOK__JSON_ESCAPED) return cook__json_fail(doc, "input too large", 0);
+    // nodes from an arena are never reused
+    if (arena || doc->arena) {
+        if (!doc->arena && doc->nodes) COOK__FREE(doc->nodes);
+        doc->nodes = NULL;
+        doc->cap = 0;
+        doc->arena = arena != NULL;
+    }
+    // at most one offset per byte of a chunk, two left over from the last
+    // one and the unrolled stores past the end
+    if (doc->index_cap < COOK__JSON_CHUNK + 128) {
+        doc->index_cap = COOK__JSON_CHUNK + 128;
+        doc->index = COOK__REALLOC(doc->index, doc->index_cap*sizeof(*doc->index), "json");
+        COOK_ASSERT(doc->index != NULL && "out of memory");
+    }
+
+    // both stages run a chunk at a time, so the offsets stay in cache
+    cook__json_scan_t scan = {.index = doc->index, .error = SIZE_MAX};
+    cook__json_parser_t parser;
+    parser.depth = 0;
+    parser.len = 0;
+    parser.state = COOK__JSON_VALUE;
+    size_t pos = 0, consumed = 0;
+    for (;;) {
+        size_t n = text.len - pos < COOK__JSON_CHUNK ? text.len - pos : COOK__JSON_CHUNK;
+        size_t full = n & ~(size_t)63;
+        cook__json_scan(&scan, text.data + pos, pos, full);
+        if (full < n) {
+            // spaces are never indexed
+            char tail[64];
+            memset(tail, ' ', sizeof(tail));
+            memcpy(tail, text.data + pos + full, n - full);
+            cook__json_scan(&scan, tail, pos + full, sizeof(tail));
+        }
+        if (scan.error != SIZE_MAX) return cook__json_fail(doc, "control character in string", scan.error);
+        pos += n;
+
+        // the offsets are two per container and string, one per other value
+        // and one per comma and colon, at least 2*nodes - 1 in a document;
+        // while it is parsed each open container still lacks its closing one
+        cook__json_reserve(doc, arena, (consumed + scan.len + 1 + COOK_JSON_MAX_DEPTH)/2, parser.len);
+        size_t used;
+        if (!cook__json_build(doc, text, &parser, scan.index, scan.len, pos == text.len, &used)) return false;
+        if (pos == text.len) break;
+        consumed += used;
+        scan.len -= used;
+        memmove(scan.index, scan.index + used, scan.len*sizeof(*scan.index));
+    }
+    doc->len = parser.len;
+    return true;
+}
+
+COOKDEF void cook_json_free(cook_json_t *doc) {
+    if (doc->nodes && !doc->arena) COOK__FREE(doc->nodes);
+    if (doc->index) COOK__FREE(doc->index);
+    *doc = (cook_json_t){0};
+}
+
+COOKDEF const cook_json_node_t *cook_json_root(const cook_json_t *doc) {
+    return doc->len > 0 ? doc->nodes : NULL;
+}
+
+COOKDEF cook_json_iter_t cook_json_iter(const cook_json_node_t *node) {
+    if (!node || (node->type != COOK_JSON_ARRAY && node->type != COOK_JSON_OBJECT)) {
+        return (cook_json_iter_t){0};
+    }
+    return (cook_json_iter_t) {
+        .at = node + 1,
+        .end = node + node->skip,
+        .object = node->type == COOK_JSON_OBJECT
+    };
+}
+
+COOKDEF bool cook_json_iter_next(cook_json_iter_t *it, const cook_json_node_t **key,
+                                 const cook_json_node_t **value) {
+    if (it->at >= it->end) return false;
+    if (key) *key = it->object ? it->at : NULL;
+    if (it->object) it->at++;
+    *value = it->at;
+    it->at += it->at->skip;
+    return true;
+}
+
+COOKDEF const cook_json_node_t *cook_json_get(const cook_json_node_t *object, const char *key) {
+    if (!object || object->type != COOK_JSON_OBJECT) return NULL;
+    cook_string_view_t want = cook_sv_from_cstr(key);
+    cook_string_builder_t sb = {0};
+    const cook_json_node_t *found = NULL, *k, *v;
+    cook_json_iter_t it = cook_json_iter(object);
+    while (!found && cook_json_iter_next(&it, &k, &v)) {
+        if (!k->escaped) {
+            if (cook_sv_equal(k->sv, want)) found = v;
+            continue;
+        }
+        cook_sb_reset(&sb);
+        if (cook_sv_equal(cook_json_string(k, &sb), want)) found = v;
+    }
+    cook_sb_free(&sb);
+    return found;
+}
+
+COOKDEF cook_string_view_t cook_json_string(const cook_json_node_t *node, cook_string_builder_t *sb) {
+    if (!node->escaped) return node->sv;
+    size_t start = sb->len;
+    cook_string_view_t rest = node->sv;
+    while (rest.len > 0) {
+        size_t i = cook_sv_find_char(rest, '\\');
+        if (i == COOK_SV_NPOS) {
+            cook_sb_append_sv(sb, rest);
+            break;
+        }
+        cook_sb_append_parts(sb, rest.data, i);
+        // the escapes were checked by the parser
+        const char *p = rest.data + i;
+        size_t used = 2;
+        switch (p[1]) {
+        case 'b': cook_sb_append_parts(sb, "\b", 1); break;
+        case 'f': cook_sb_append_parts(sb, "\f", 1); break;
+        case 'n': cook_sb_append_parts(sb, "\n", 1); break;
+        case 'r': cook_sb_append_parts(sb, "\r", 1); break;
+        case 't': cook_sb_append_parts(sb, "\t", 1); break;
+        case 'u': {
+            uint32_t cp = 0;
+            for (int k = 2; k < 6; k++) cp = cp << 4 | cook__hex_value(p[k]);
+            used = 6;
+            // a surrogate pair is two escapes, a lone half is replaced
+            if (cp >= 0xD800 && cp <= 0xDBFF && rest.len - i >= 12 && p[6] == '\\' && p[7] == 'u') {
+                uint32_t lo = 0;
+                for (int k = 8; k < 12; k++) lo = lo << 4 | cook__hex_value(p[k]);
+                if (lo >= 0xDC00 && lo <= 0xDFFF) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                    used = 12;
+                }
+            }
+            if (cp >= 0xD800 && cp <= 0xDFFF) cp = COOK_UTF8_REPLACEMENT;
+            cook_sb_append_utf8(sb, cp);
+        } break;
+        default: cook_sb_append_parts(sb, p + 1, 1); break;
+        }
+        rest.data += i + used;
+        rest.len -= i + used;
+    }
+    return cook_sv_from_parts(sb->items + start, sb->len - start);
+}
+
+COOKDEF bool cook_json_number(const cook_json_node_t *node, double *out) {
+    if (!node || node->type != COOK_JSON_NUMBER) return false;
+    return cook_sv_parse_f64(node->sv, out) == node->sv.len;
+}
+
+COOKDEF bool cook_json_int(const cook_json_node_t *node, int64_t *out) {
+    if (!node || node->type != COOK_JSON_NUMBER) return false;
+    return cook_sv_parse_i64(node->sv, out) == node->sv.len;
+}
+
+#define COOK__REGEX_NONE UINT32_MAX
+#define COOK__REGEX_MAX_INSTS 100000
+#define COOK__REGEX_MAX_REPEAT 1000
+#define COOK__REGEX_MAX_DEPTH 256
+
+enum {
+    COOK__REGEX_BYTE,  // takes a byte of bits, then goes to out
+    COOK__REGEX_SPLIT, // goes to out and out1 without taking a byte
+    COOK__REGEX_BOL,   // goes to out at the start of the text
+    COOK__REGEX_EOL,   // goes to out at the end of the text
+    COOK__REGEX_MATCH,
+};
+
+struct cook__regex_inst {
+    int kind;
+    uint32_t out;
+    uint32_t out1;
+    uint64_t bits[4];
+};
+
+#define COOK__REGEX_MATCHED 1u // the set holds MATCH
+#define COOK__REGEX_AT_END  2u // the set reaches MATCH at the end of the text
+#define COOK__REGEX_DEAD    4u // the empty set, no match can follow
+
+struct cook__regex_state {
+    size_t hash;
+    uint32_t flags;
+    uint32_t count;
+    uint32_t *ids; // NFA states, sorted
+    cook__regex_state_t *next[]; // per class, NULL until first taken
+};
+
+// the parse tree, children are linked through sibling
+enum {
+    COOK__REGEX_SET,
+    COOK__REGEX_CAT,
+    COOK__REGEX_ALT,
+    COOK__REGEX_REPEAT,
+    COOK__REGEX_START,
+    COOK__REGEX_END,
+};
+
+typedef struct cook__regex_node {
+    int kind;
+    uint32_t child;
+    uint32_t sibling;
+    uint32_t min;
+    uint32_t max; // COOK__REGEX_NONE for no limit
+    uint64_t bits[4];
+} cook__regex_node_t;
+
+typedef struct cook__regex_parser {
+    const char *begin;
+    const char *p;
+    const char *end;
+    size_t depth;
+    struct { cook__regex_node_t *items; size_t len, cap; } nodes;
+    struct { cook__regex_inst_t *items; size_t len, cap; } prog;
+    struct { uint32_t *items; size_t len, cap; } stack; // children of the sequences being compiled
+    const char *error;
+    size_t error_offset;
+} cook__regex_parser_t;
+
+static uint32_t cook__regex_fail(cook__regex_parser_t *p, const char *error, const char *at) {
+    if (!p->error) {
+        p->error = error;
+        p->error_offset = (size_t)(at - p->begin);
+    }
+    return COOK__REGEX_NONE;
+}
+
+static uint32_t cook__regex_node(cook__regex_parser_t *p, int kind) {
+    cook__regex_node_t node = {kind, COOK__REGEX_NONE, COOK__REGEX_NONE, 0, 0, {0}};
+    cook_vec_push(&p->nodes, node);
+    return (uint32_t)p->nodes.len - 1;
+}
+
+static inline void cook__regex_add(uint64_t bits[4], unsigned lo, unsigned hi) {
+    for (unsigned b = lo; b <= hi; b++) bits[b >> 6] |= (uint64_t)1 << (b & 63);
+}
+
+// cook__regex_add_ranges - add ASCII ranges, given as pairs of first and
+// last byte, or everything outside them
+static void cook__regex_add_ranges(uint64_t bits[4], const char *ranges, bool negate) {
+    uint64_t in[4] = {0};
+    for (; *ranges; ranges += 2) cook__regex_add(in, (unsigned char)ranges[0], (unsigned char)ranges[1]);
+    for (size_t k = 0; k < 4; k++) bits[k] |= negate ? ~in[k] : in[k];
+}
+
+#define COOK__REGEX_DIGIT "09"
+#define COOK__REGEX_WORD  "09AZaz__"
+#define COOK__REGEX_SPACE "\t\r  "
+
+// cook__regex_escape - the bytes of the escape after a '\' at @p->p
+//
+// Return: false if it is not a valid escape
+static bool cook__regex_escape(cook__regex_parser_t *p, uint64_t bits[4]) {
+    const char *at = p->p - 1;
+    if (p->p == p->end) {
+        cook__regex_fail(p, "trailing backslash", at);
+        return false;
+    }
+    char c = *p->p++;
+    const char *ranges = NULL;
+    switch (c | 0x20) {
+    case 'd': ranges = COOK__REGEX_DIGIT; break;
+    case 'w': ranges = COOK__REGEX_WORD; break;
+    case 's': ranges = COOK__REGEX_SPACE; break;
+    default: break;
+    }
+    if (ranges) {
+        cook__regex_add_ranges(bits, ranges, c >= 'A' && c <= 'Z');
+        return true;
+    }
+    unsigned b;
+    switch (c) {
+    case 'n': b = '\n'; break;
+    case 't': b = '\t'; break;
+    case 'r': b = '\r'; break;
+    case 'f': b = '\f'; break;
+    case 'v': b = '\v'; break;
+    case '0': b = 0; break;
+    case 'x':
+        if (p->end - p->p < 2 || cook__hex_value(p->p[0]) > 15 || cook__hex_value(p->p[1]) > 15) {
+            cook__regex_fail(p, "invalid \\x escape", at);
+            return false;
+        }
+        b = cook__hex_value(p->p[0])*16 + cook__hex_value(p->p[1]);
+        p->p += 2;
+        break;
+    default:
+        if ((c >= '0' && c <= '9') || ((c | 0x20) >= 'a' && (c | 0x20) <= 'z')) {
+            cook__regex_fail(p, "unknown escape", at);
+            return false;
+        }
+        b = (unsigned char)c;
+        break;
+    }
+    cook__regex_add(bits, b, b);
+    return true;
+}
+
+// cook__regex_class - parse a class after its '['
+static uint32_t cook__regex_class(cook__regex_parser_t *p) {
+    static const struct {
+        const char *name;
+        const char *ranges;
+    } named[] = {
+        {"alpha", "AZaz"}, {"digit", COOK__REGEX_DIGIT}, {"alnum", "09AZaz"}, {"space", COOK__REGEX_SPACE},
+        {"upper", "AZ"}, {"lower", "az"}, {"xdigit", "09AFaf"}, {"punct", "!/:@[`{~"},
+    };
+    const char *open = p->p - 1;
+    uint64_t bits[4] = {0};
+    bool negate = p->p < p->end && *p->p == '^';
+    if (negate) p->p++;
+    for (bool first = true; ; first = false) {
+        if (p->p == p->end) return cook__regex_fail(p, "missing ']'", open);
+        if (*p->p == ']' && !first) break;
+        if (*p->p == '[' && p->end - p->p >= 2 && p->p[1] == ':') {
+            const char *name = p->p + 2, *close = name;
+            while (close + 1 < p->end && !(close[0] == ':' && close[1] == ']')) close++;
+            size_t k = 0;
+            while (k < cook_arr_len(named) && !(strlen(named[k].name) == (size_t)(close - name) &&
+                                                memcmp(named[k].name, name, (size_t)(close - name)) == 0)) {
+                k++;
+            }
+            if (close + 1 >= p->end || k == cook_arr_len(named)) return cook__regex_fail(p, "unknown class name", p->p);
+            cook__regex_add_ranges(bits, named[k].ranges, false);
+            p->p = close + 2;
+            continue;
+        }
+        unsigned lo = (unsigned char)*p->p++;
+        if (lo == '\\') {
+            uint64_t escaped[4] = {0};
+            if (!cook__regex_escape(p, escaped)) return COOK__REGEX_NONE;
+            // a single byte may start a range, \d and the like may not
+            int count = 0;
+            for (size_t k = 0; k < 4; k++) count += (int)cook__popcount64(escaped[k]);
+            if (count != 1) {
+                for (size_t k = 0; k < 4; k++) bits[k] |= escaped[k];
+                continue;
+            }
+            for (lo = 0; !((escaped[lo >> 6] >> (lo & 63)) & 1); lo++) {}
+        }
+        unsigned hi = lo;
+        if (p->end - p->p >= 2 && p->p[0] == '-' && p->p[1] != ']') {
+            const char *dash = p->p++;
+            hi = (unsigned char)*p->p++;
+            if (hi == '\\') {
+                if (p->p == p->end) return cook__regex_fail(p, "trailing backslash", p->p - 1);
+                hi = (unsigned char)*p->p++;
+            }
+            if (hi < lo) return cook__regex_fail(p, "invalid range", dash);
+        }
+        cook__regex_add(bits, lo, hi);
+    }
+    p->p++;
+    if (negate) {
+        for (size_t k = 0; k < 4; k++) bits[k] = ~bits[k];
+    }
+    uint32_t node = cook__regex_node(p, COOK__REGEX_SET);
+    memcpy(p->nodes.items[node].bits, bits, sizeof(bits));
+    return node;
+}
+
+static uint32_t cook__regex_alt(cook__regex_parser_t *p);
+
+static uint32_t cook__regex_atom(cook__regex_parser_t *p) {
+    const char *at = p->p;
+    char c = *p->p++;
+    uint32_t node;
+    switch (c) {
+    case '(':
+        if (++p->depth > COOK__REGEX_MAX_DEPTH) return cook__regex_fail(p, "nested too deeply", at);
+        if (p->end - p->p >= 2 && p->p[0] == '?' && p->p[1] == ':') p->p += 2;
+        node = cook__regex_alt(p);
+        if (node == COOK__REGEX_NONE) return node;
+        if (p->p == p->end) return cook__regex_fail(p, "missing ')'", at);
+        p->p++;
+        p->depth--;
+        return node;
+    case '[':
+        return cook__regex_class(p);
+    case '^':
+        return cook__regex_node(p, COOK__REGEX_START);
+    case '$':
+        return cook__regex_node(p, COOK__REGEX_END);
+    case '*':
+    case '+':
+    case '?':
+        return cook__regex_fail(p, "nothing to repeat", at);
+    default: {
+        uint64_t bits[4] = {0};
+        if (c == '.') {
+            cook__regex_add(bits, 0, 255);
+            bits['\n' >> 6] &= ~((uint64_t)1 << ('\n' & 63));
+        } else if (c == '\\') {
+            if (!cook__regex_escape(p, bits)) return COOK__REGEX_NONE;
+        } else {
+            cook__regex_add(bits, (unsigned char)c, (unsigned char)c);
+        }
+        node = cook__regex_node(p, COOK__REGEX_SET);
+        memcpy(p->nodes.items[node].bits, bits, sizeof(bits));
+        return node;
+    }
+    }
+}
+
+// cook__regex_count - parse a decimal repeat count
+//
+// Return: false if there are no digits
+static bool cook__regex_count(cook__regex_parser_t *p, uint32_t *n) {
+    const char *start = p->p;
+    uint32_t v = 0;
+    while (p->p < p->end && *p->p >= '0' && *p->p <= '9') {
+        if (v <= COOK__REGEX_MAX_REPEAT) v = v*10 + (uint32_t)(*p->p - '0');
+        p->p++;
+    }
+    *n = v;
+    return p->p > start;
+}
+
+// cook__regex_bounds - parse "{m}", "{m,}" or "{m,n}" at @p->p
+//
+// Return: false if it is not one, @p->p is left alone then and the '{' is
+//         a literal
+static bool cook__regex_bounds(cook__regex_parser_t *p, uint32_t *min, uint32_t *max) {
+    const char *start = p->p++;
+    if (cook__regex_count(p, min)) {
+        *max = *min;
+        if (p->p < p->end && *p->p == ',') {
+            p->p++;
+            *max = COOK__REGEX_NONE;
+            if (p->p < p->end && *p->p != '}') cook__regex_count(p, max);
+        }
+        if (p->p < p->end && *p->p == '}') {
+            p->p++;
+            return true;
+        }
+    }
+    p->p = start;
+    return false;
+}
+
+static uint32_t cook__regex_repeat(cook__regex_parser_t *p) {
+    uint32_t node = cook__regex_atom(p);
+    for (size_t stacked = 0; node != COOK__REGEX_NONE && p->p < p->end; stacked++) {
+        const char *at = p->p;
+        uint32_t min, max;
+        if (*p->p == '*') {
+            min = 0, max = COOK__REGEX_NONE, p->p++;
+        } else if (*p->p == '+') {
+            min = 1, max = COOK__REGEX_NONE, p->p++;
+        } else if (*p->p == '?') {
+            min = 0, max = 1, p->p++;
+        } else if (*p->p != '{' || !cook__regex_bounds(p, &min, &max)) {
+            break;
+        }
+        if (min > COOK__REGEX_MAX_REPEAT || (max != COOK__REGEX_NONE && max > COOK__REGEX_MAX_REPEAT)) {
+            return cook__regex_fail(p, "repeat count too large", at);
+        }
+        if (max < min) return cook__regex_fail(p, "invalid repeat count", at);
+        int kind = p->nodes.items[node].kind;
+        if (kind == COOK__REGEX_START || kind == COOK__REGEX_END) return cook__regex_fail(p, "nothing to repeat", at);
+        if (stacked >= COOK__REGEX_MAX_DEPTH) return cook__regex_fail(p, "nested too deeply", at);
+        // lazy quantifiers match the same texts
+        if (p->p < p->end && *p->p == '?') p->p++;
+        uint32_t repeat = cook__regex_node(p, COOK__REGEX_REPEAT);
+        p->nodes.items[repeat].child = node;
+        p->nodes.items[repeat].min = min;
+        p->nodes.items[repeat].max = max;
+        node = repeat;
+    }
+    return node;
+}
+
+static uint32_t cook__regex_cat(cook__regex_parser_t *p) {
+    uint32_t cat = cook__regex_node(p, COOK__REGEX_CAT), last = COOK__REGEX_NONE;
+    while (p->p < p->end && *p->p != '|' && *p->p != ')') {
+        uint32_t node = cook__regex_repeat(p);
+        if (node == COOK__REGEX_NONE) return node;
+        if (last == COOK__REGEX_NONE) {
+            p->nodes.items[cat].child = node;
+        } else {
+            p->nodes.items[last].sibling = node;
+        }
+        last = node;
+    }
+    return cat;
+}
+
+static uint32_t cook__regex_alt(cook__regex_parser_t *p) {
+    uint32_t node = cook__regex_cat(p);
+    if (node == COOK__REGEX_NONE || p->p == p->end || *p->p != '|') return node;
+    uint32_t alt = cook__regex_node(p, COOK__REGEX_ALT), last = node;
+    p->nodes.items[alt].child = node;
+    while (p->p < p->end && *p->p == '|') {
+        p->p++;
+        node = cook__regex_cat(p);
+        if (node == COOK__REGEX_NONE) return node;
+        p->nodes.items[last].sibling = node;
+        last = node;
+    }
+    return alt;
+}
+
+static uint32_t cook__regex_inst(cook__regex_parser_t *p, int kind, uint32_t out, uint32_t out1) {
+    if (p->prog.len >= COOK__REGEX_MAX_INSTS) return cook__regex_fail(p, "regex too large", p->end);
+    cook__regex_inst_t inst = {kind, out, out1, {0}};
+    cook_vec_push(&p->prog, inst);
+    return (uint32_t)p->prog.len - 1;
+}
+
+// cook__regex_compile - instructions for a parse tree node, which continue
+// at @next
+//
+// Note: a sequence is compiled last to first, so every part knows its
+//       successor, and a repeat compiles its child once per copy
+//
+// Return: entry instruction, COOK__REGEX_NONE if the NFA grew too large
+static uint32_t cook__regex_compile(cook__regex_parser_t *p, uint32_t index, uint32_t next) {
+    cook__regex_node_t node = p->nodes.items[index];
+    switch (node.kind) {
+    case COOK__REGEX_SET: {
+        uint32_t inst = cook__regex_inst(p, COOK__REGEX_BYTE, next, COOK__REGEX_NONE);
+        if (inst != COOK__REGEX_NONE) memcpy(p->prog.items[inst].bits, node.bits, sizeof(node.bits));
+        return inst;
+    }
+    case COOK__REGEX_START:
+        return cook__regex_inst(p, COOK__REGEX_BOL, next, COOK__REGEX_NONE);
+    case COOK__REGEX_END:
+        return cook__regex_inst(p, COOK__REGEX_EOL, next, COOK__REGEX_NONE);
+    case COOK__REGEX_CAT: {
+        size_t base = p->stack.len;
+        for (uint32_t child = node.child; child != COOK__REGEX_NONE; child = p->nodes.items[child].sibling) {
+            cook_vec_push(&p->stack, child);
+        }
+        while (p->stack.len > base && next != COOK__REGEX_NONE) {
+            next = cook__regex_compile(p, p->stack.items[--p->stack.len], next);
+        }
+        p->stack.len = base;
+        return next;
+    }
+    case COOK__REGEX_ALT: {
+        uint32_t entry = COOK__REGEX_NONE;
+        for (uint32_t child = node.child; child != COOK__REGEX_NONE; child = p->nodes.items[child].sibling) {
+            uint32_t e = cook__regex_compile(p, child, next);
+            if (e == COOK__REGEX_NONE) return e;
+            entry = entry == COOK__REGEX_NONE ? e : cook__regex_inst(p, COOK__REGEX_SPLIT, entry, e);
+            if (entry == COOK__REGEX_NONE) return entry;
+        }
+        return entry;
+    }
+    default: {
+        // x{2,4} is x x (x (x)?)?, x{2,} is x x x*
+        uint32_t entry = next;
+        if (node.max == COOK__REGEX_NONE) {
+            uint32_t loop = cook__regex_inst(p, COOK__REGEX_SPLIT, COOK__REGEX_NONE, next);
+            if (loop == COOK__REGEX_NONE) return loop;
+            uint32_t body = cook__regex_compile(p, node.child, loop);
+            if (body == COOK__REGEX_NONE) return body;
+            p->prog.items[loop].out = body;
+            entry = loop;
+        } else {
+            for (uint32_t i = node.min; i < node.max && entry != COOK__REGEX_NONE; i++) {
+                uint32_t body = cook__regex_compile(p, node.child, entry);
+                if (body == COOK__REGEX_NONE) return body;
+                entry = cook__regex_inst(p, COOK__REGEX_SPLIT, body, next);
+            }
+        }
+        for (uint32_t i = 0; i < node.min && entry != COOK__REGEX_NONE; i++) {
+            entry = cook__regex_compile(p, node.child, entry);
+        }
+        return entry;
+    }
+    }
+}
+
+// cook__regex_prefix - the literal every match starts with, from the front
+// of the top sequence
+static cook_string_view_t cook__regex_prefix(const cook__regex_parser_t *p, uint32_t root, char *buf, size_t cap) {
+    size_t len = 0;
+    const cook__regex_node_t *nodes = p->nodes.items;
+    if (nodes[root].kind != COOK__REGEX_CAT) return cook_sv_from_parts(buf, 0);
+    for (uint32_t child = nodes[root].child; child != COOK__REGEX_NONE && len < cap; child = nodes[child].sibling) {
+        const cook__regex_node_t *node = &nodes[child];
+        // the first copy of x+ or x{2,} is still a prefix, and then it ends
+        bool last = false;
+        if (node->kind == COOK__REGEX_REPEAT && node->min > 0) {
+            node = &nodes[node->child];
+            last = true;
+        }
+        if (node->kind != COOK__REGEX_SET) break;
+        int count = 0;
+        unsigned byte = 0;
+        for (size_t k = 0; k < 4; k++) {
+            count += (int)cook__popcount64(node->bits[k]);
+            if (node->bits[k]) byte = (unsigned)(k*64 + cook__ctz64(node->bits[k]));
+        }
+        if (count != 1) break;
+        buf[len++] = (char)byte;
+        if (last) break;
+    }
+    return cook_sv_from_parts(buf, len);
+}
+
+static size_t cook__regex_hash(const uint32_t *ids, size_t n) {
+    uint64_t h = 14695981039346656037ull;
+    for (size_t i = 0; i < n; i++) h = (h ^ ids[i])*1099511628211ull;
+    return (size_t)(h ^ h >> 29);
+}
+
+static int cook__regex_id_compare(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+// cook__regex_push - queue an NFA state for the closure, once per build
+static inline void cook__regex_push(cook_regex_t *re, size_t *top, uint32_t id) {
+    if (re->mark[id] == re->gen) return;
+    re->mark[id] = re->gen;
+    re->stack[(*top)++] = id;
+}
+
+static void cook__regex_next_gen(cook_regex_t *re) {
+    if (++re->gen == 0) {
+        memset(re->mark, 0, re->prog_len*sizeof(uint32_t));
+        re->gen = 1;
+    }
+}
+
+// cook__regex_closure - the BYTE, EOL and MATCH states reachable from the
+// queued ones without taking a byte, into @re->set, sorted
+//
+// Return: number of states
+static size_t cook__regex_closure(cook_regex_t *re, size_t top, bool at_start) {
+    size_t n = 0;
+    while (top > 0) {
+        uint32_t id = re->stack[--top];
+        const cook__regex_inst_t *inst = &re->prog[id];
+        switch (inst->kind) {
+        case COOK__REGEX_SPLIT:
+            cook__regex_push(re, &top, inst->out1);
+            cook__regex_push(re, &top, inst->out);
+            break;
+        case COOK__REGEX_BOL:
+            if (at_start) cook__regex_push(re, &top, inst->out);
+            break;
+        default:
+            re->set[n++] = id;
+            break;
+        }
+    }
+    qsort(re->set, n, sizeof(uint32_t), cook__regex_id_compare);
+    return n;
+}
+
+// cook__regex_flags - what the set in @re->set means for the matcher
+static uint32_t cook__regex_flags(cook_regex_t *re, size_t n, bool at_start) {
+    if (n == 0) return COOK__REGEX_DEAD;
+    uint32_t flags = 0;
+    size_t top = 0;
+    cook__regex_next_gen(re);
+    for (size_t i = 0; i < n; i++) {
+        int kind = re->prog[re->set[i]].kind;
+        if (kind == COOK__REGEX_MATCH) flags |= COOK__REGEX_MATCHED | COOK__REGEX_AT_END;
+        if (kind == COOK__REGEX_EOL) cook__regex_push(re, &top, re->set[i]);
+    }
+    // at the end of the text, '$' lets everything through
+    while (top > 0 && !(flags & COOK__REGEX_AT_END)) {
+        const cook__regex_inst_t *inst = &re->prog[re->stack[--top]];
+        switch (inst->kind) {
+        case COOK__REGEX_SPLIT:
+            cook__regex_push(re, &top, inst->out1);
+            cook__regex_push(re, &top, inst->out);
+            break;
+        case COOK__REGEX_BOL:
+            if (at_start) cook__regex_push(re, &top, inst->out);
+            break;
+        case COOK__REGEX_EOL:
+            cook__regex_push(re, &top, inst->out);
+            break;
+        case COOK__REGEX_MATCH:
+            flags |= COOK__REGEX_AT_END;
+            break;
+        default:
+            break;
+        }
+    }
+    return flags;
+}
+
+static void cook__regex_table_add(cook_regex_t *re, cook__regex_state_t *state) {
+    size_t mask = re->table_cap - 1, i = state->hash & mask;
+    while (re->table[i] != NULL) i = (i + 1) & mask;
+    re->table[i] = state;
+}
+
+// cook__regex_state - the DFA state for the set in @re->set, made if new
+static cook__regex_state_t *cook__regex_state(cook_regex_t *re, size_t n, bool at_start) {
+    size_t hash = cook__regex_hash(re->set, n), mask = re->table_cap - 1;
+    for (size_t i = hash & mask; re->table[i] != NULL; i = (i + 1) & mask) {
+        cook__regex_state_t *s = re->table[i];
+        if (s->hash == hash && s->count == n && memcmp(s->ids, re->set, n*sizeof(uint32_t)) == 0) return s;
+    }
+    size_t size = sizeof(cook__regex_state_t) + re->class_count*sizeof(cook__regex_state_t *) + n*sizeof(uint32_t);
+    cook__regex_state_t *state = cook_arena_alloc(&re->cache, size);
+    re->cache_used += size;
+    state->hash = hash;
+    state->flags = cook__regex_flags(re, n, at_start);
+    state->count = (uint32_t)n;
+    state->ids = (uint32_t *)(state->next + re->class_count);
+    memcpy(state->ids, re->set, n*sizeof(uint32_t));
+    // no byte leads out of the empty set
+    for (size_t c = 0; c < re->class_count; c++) state->next[c] = n == 0 ? state : NULL;
+
+    // keep the table at most half full
+    if (2*(++re->state_count) > re->table_cap) {
+        cook__regex_state_t **old = re->table;
+        size_t old_cap = re->table_cap;
+        re->table_cap *= 2;
+        re->table = COOK__ALLOC(re->table_cap*sizeof(*re->table), "regex");
+        COOK_ASSERT(re->table && "out of memory");
+        memset(re->table, 0, re->table_cap*sizeof(*re->table));
+        for (size_t i = 0; i < old_cap; i++) {
+            if (old[i]) cook__regex_table_add(re, old[i]);
+        }
+        COOK__FREE(old);
+    }
+    cook__regex_table_add(re, state);
+    return state;
+}
+
+// cook__regex_restart - drop every DFA state and make the two start states
+static void cook__regex_restart(cook_regex_t *re) {
+    cook_arena_reset(&re->cache);
+    memset(re->table, 0, re->table_cap*sizeof(*re->table));
+    re->state_count = 0;
+    re->cache_used = 0;
+    size_t top = 0;
+    cook__regex_next_gen(re);
+    cook__regex_push(re, &top, re->entry);
+    re->start = cook__regex_state(re, cook__regex_closure(re, top, true), true);
+    top = 0;
+    cook__regex_next_gen(re);
+    cook__regex_push(re, &top, re->entry);
+    re->restart = cook__regex_state(re, cook__regex_closure(re, top, false), false);
+}
+
+// cook__regex_step - the state after a byte of class @c in @state, made and
+// linked in if new
+//
+// Note: may drop the whole cache first, @state is gone then
+static cook__regex_state_t *cook__regex_step(cook_regex_t *re, cook__regex_state_t *state, size_t c) {
+    size_t top = 0, b = 0;
+    while (re->classes[b] != c) b++;
+    cook__regex_next_gen(re);
+    for (size_t i = 0; i < state->count; i++) {
+        const cook__regex_inst_t *inst = &re->prog[state->ids[i]];
+        if (inst->kind == COOK__REGEX_BYTE && ((inst->bits[b >> 6] >> (b & 63)) & 1)) {
+            cook__regex_push(re, &top, inst->out);
+        }
+    }
+    // a match may start at every byte
+    cook__regex_push(re, &top, re->entry);
+    size_t n = cook__regex_closure(re, top, false);
+    if (re->cache_used > COOK_REGEX_CACHE_SIZE) {
+        // the restart needs @re->set and one half of the stack, the set
+        // waits in the other half
+        memcpy(re->stack + re->prog_len, re->set, n*sizeof(uint32_t));
+        cook__regex_restart(re);
+        memcpy(re->set, re->stack + re->prog_len, n*sizeof(uint32_t));
+        re->cache_resets++;
+        return cook__regex_state(re, n, false);
+    }
+    cook__regex_state_t *next = cook__regex_state(re, n, false);
+    state->next[c] = next;
+    return next;
+}
+
+COOKDEF bool cook_regex_init(cook_regex_t *re, cook_string_view_t pattern) {
+    memset(re, 0, sizeof(*re));
+    cook__regex_parser_t p = {0};
+    p.begin = p.p = pattern.data;
+    p.end = pattern.data + pattern.len;
+    uint32_t root = cook__regex_alt(&p);
+    if (root != COOK__REGEX_NONE && p.p < p.end) cook__regex_fail(&p, "unmatched ')'", p.p);
+    uint32_t match = COOK__REGEX_NONE;
+    if (!p.error) match = cook__regex_inst(&p, COOK__REGEX_MATCH, COOK__REGEX_NONE, COOK__REGEX_NONE);
+    if (!p.error) re->entry = cook__regex_compile(&p, root, match);
+    cook_vec_free(&p.stack);
+    if (p.error) {
+        re->error = p.error;
+        re->error_offset = p.error_offset;
+        cook_vec_free(&p.nodes);
+        cook_vec_free(&p.prog);
+        return false;
+    }
+
+    char buf[64];
+    cook_string_view_t prefix = cook__regex_prefix(&p, root, buf, sizeof(buf));
+    cook_vec_free(&p.nodes);
+    // a one-byte prefix is too common to be worth a search call every time
+    if (prefix.len > 1) {
+        char *copy = COOK__ALLOC(prefix.len, "regex");
+        COOK_ASSERT(copy && "out of memory");
+        memcpy(copy, prefix.data, prefix.len);
+        re->prefix = cook_sv_from_parts(copy, prefix.len);
+    }
+    re->prog = p.prog.items;
+    re->prog_len = p.prog.len;
+
+    // a new class wherever some byte set changes its mind
+    re->class_count = 1;
+    for (unsigned b = 1; b < 256; b++) {
+        bool boundary = false;
+        for (size_t i = 0; i < re->prog_len && !boundary; i++) {
+            const uint64_t *bits = re->prog[i].bits;
+            boundary = re->prog[i].kind == COOK__REGEX_BYTE &&
+                       ((bits[b >> 6] >> (b & 63)) & 1) != ((bits[(b - 1) >> 6] >> ((b - 1) & 63)) & 1);
+        }
+        if (boundary) re->class_count++;
+        re->classes[b] = (unsigned char)(re->class_count - 1);
+    }
+
+    re->mark = COOK__ALLOC(re->prog_len*sizeof(uint32_t), "regex");
+    re->stack = COOK__ALLOC(2*re->prog_len*sizeof(uint32_t), "regex");
+    re->set = COOK__ALLOC(re->prog_len*sizeof(uint32_t), "regex");
+    re->table_cap = 64;
+    re->table = COOK__ALLOC(re->table_cap*sizeof(*re->table), "regex");
+    COOK_ASSERT(re->mark && re->stack && re->set && re->table && "out of memory");
+    memset(re->mark, 0, re->prog_len*sizeof(uint32_t));
+    cook__regex_restart(re);
+    return true;
+}
+
+COOKDEF void cook_regex_free(cook_regex_t *re) {
+    if (re->prog) COOK__FREE(re->prog);
+    if (re->prefix.data) COOK__FREE((char *)re->prefix.data);
+    if (re->mark) COOK__FREE(re->mark);
+    if (re->stack) COOK__FREE(re->stack);
+    if (re->set) COOK__FREE(re->set);
+    if (re->table) COOK__FREE(re->table);
+    cook_arena_free(&re->cache);
+    memset(re, 0, sizeof(*re));
+}
+
+COOKDEF bool cook_regex_match(cook_regex_t *re, cook_string_view_t text) {
+    const unsigned char *s = (const unsigned char *)text.data;
+    cook__regex_state_t *state = re->start;
+    if (state->flags & COOK__REGEX_MATCHED) return true;
+    for (size_t i = 0; i < text.len; i++) {
+        if (state == re->restart && re->prefix.len > 0) {
+            size_t at = cook_sv_find(cook_sv_from_parts(text.data + i, text.len - i), re->prefix);
+            if (at == COOK_SV_NPOS) return false;
+            i += at;
+        }
+        size_t c = re->classes[s[i]];
+        cook__regex_state_t *next = state->next[c];
+        state = next ? next : cook__regex_step(re, state, c);
+        if (state->flags & (COOK__REGEX_MATCHED | COOK__REGEX_DEAD)) return !(state->flags & COOK__REGEX_DEAD);
+    }
+    return (state->flags & COOK__REGEX_AT_END) != 0;
+}
+
+
+struct cook__rope_node {
+    cook__rope_node_t *left;
+    cook__rope_node_t *right;
+    const char *data; // the piece
+    size_t len;
+    size_t size; // bytes of the subtree
+    int height;
+};
+
+static inline size_t cook__rope_size(const cook__rope_node_t *t) {
+    return t ? t->size : 0;
+}
+
+static inline int cook__rope_height(const cook__rope_node_t *t) {
+    return t ? t->height : 0;
+}
+
+// cook__rope_update - recompute the size and height of @t from its children
+static inline cook__rope_node_t *cook__rope_update(cook__rope_node_t *t) {
+    int hl = cook__rope_height(t->left), hr = cook__rope_height(t->right);
+    t->size = cook__rope_size(t->left) + t->len + cook__rope_size(t->right);
+    t->height = (hl > hr ? hl : hr) + 1;
+    return t;
+}
+
+static cook__rope_node_t *cook__rope_node(cook_rope_t *rope, const char *data, size_t len) {
+    cook__rope_node_t *t = cook_pool_alloc(&rope->nodes);
+    *t = (cook__rope_node_t){NULL, NULL, data, len, len, 1};
+    rope->pieces++;
+    return t;
+}
+
+static cook__rope_node_t *cook__rope_rotate_left(cook__rope_node_t *t) {
+    cook__rope_node_t *r = t->right;
+    t->right = r->left;
+    r->left = cook__rope_update(t);
+    return cook__rope_update(r);
+}
+
+static cook__rope_node_t *cook__rope_rotate_right(cook__rope_node_t *t) {
+    cook__rope_node_t *l = t->left;
+    t->left = l->right;
+    l->right = cook__rope_update(t);
+    return cook__rope_update(l);
+}
+
+// Join-based AVL (Blelloch, Ferizovic and Sun, "Just Join for Parallel
+// Ordered Sets", 2016): join() puts a node between two trees of any heights
+// in time proportional to the difference of the heights, split and concat
+// are built from it.
+
+// cook__rope_join_right - join @l, @k and @r when @l is the taller tree:
+// go down the right spine of @l to a subtree as high as @r
+static cook__rope_node_t *cook__rope_join_right(cook__rope_node_t *l, cook__rope_node_t *k, cook__rope_node_t *r) {
+    cook__rope_node_t *c = l->right;
+    if (cook__rope_height(c) <= cook__rope_height(r) + 1) {
+        k->left = c;
+        k->right = r;
+        cook__rope_update(k);
+        if (k->height <= cook__rope_height(l->left) + 1) {
+            l->right = k;
+            return cook__rope_update(l);
+        }
+        l->right = cook__rope_rotate_right(k);
+        return cook__rope_rotate_left(l);
+    }
+    l->right = cook__rope_join_right(c, k, r);
+    if (l->right->height <= cook__rope_height(l->left) + 1) return cook__rope_update(l);
+    return cook__rope_rotate_left(l);
+}
+
+// cook__rope_join_left - the mirror of cook__rope_join_right()
+static cook__rope_node_t *cook__rope_join_left(cook__rope_node_t *l, cook__rope_node_t *k, cook__rope_node_t *r) {
+    cook__rope_node_t *c = r->left;
+    if (cook__rope_height(c) <= cook__rope_height(l) + 1) {
+        k->left = l;
+        k->right = c;
+        cook__rope_update(k);
+        if (k->height <= cook__rope_height(r->right) + 1) {
+            r->left = k;
+            return cook__rope_update(r);
+        }
+        r->left = cook__rope_rotate_left(k);
+        return cook__rope_rotate_right(r);
+    }
+    r->left = cook__rope_join_left(l, k, c);
+    if (r->left->height <= cook__rope_height(r->right) + 1) return cook__rope_update(r);
+    return cook__rope_rotate_right(r);
+}
+
+// cook__rope_join - the tree of @l, then the piece of @k, then @r
+static cook__rope_node_t *cook__rope_join(cook__rope_node_t *l, cook__rope_node_t *k, cook__rope_node_t *r) {
+    int hl = cook__rope_height(l), hr = cook__rope_height(r);
+    if (hl > hr + 1) return cook__rope_join_right(l, k, r);
+    if (hr > hl + 1) return cook__rope_join_left(l, k, r);
+    k->left = l;
+    k->right = r;
+    return cook__rope_update(k);
+}
+
+// cook__rope_take_first - unlink the first piece of @t
+// @first: set to the node of the first piece
+//
+// Return: the rest of the tree
+static cook__rope_node_t *cook__rope_take_first(cook__rope_node_t *t, cook__rope_node_t **first) {
+    if (!t->left) {
+        *first = t;
+        return t->right;
+    }
+    cook__rope_node_t *rest = cook__rope_take_first(t->left, first);
+    return cook__rope_join(rest, t, t->right);
+}
+
+// cook__rope_concat - the tree of @l, then @r
+static cook__rope_node_t *cook__rope_concat(cook__rope_node_t *l, cook__rope_node_t *r) {
+    if (!l) return r;
+    if (!r) return l;
+    cook__rope_node_t *k;
+    r = cook__rope_take_first(r, &k);
+    return cook__rope_join(l, k, r);
+}
+
+// cook__rope_split - split @t into the bytes before @pos and the rest, a
+// piece that straddles @pos is cut in two
+static void cook__rope_split(cook_rope_t *rope, cook__rope_node_t *t, size_t pos,
+                             cook__rope_node_t **l, cook__rope_node_t **r) {
+    if (!t || pos == 0) {
+        *l = NULL;
+        *r = t;
+        return;
+    }
+    if (pos >= t->size) {
+        *l = t;
+        *r = NULL;
+        return;
+    }
+    size_t left = cook__rope_size(t->left);
+    cook__rope_node_t *a, *b;
+    if (pos <= left) {
+        cook__rope_split(rope, t->left, pos, &a, &b);
+        *r = cook__rope_join(b, t, t->right);
+        *l = a;
+    } else if (pos >= left + t->len) {
+        cook__rope_split(rope, t->right, pos - left - t->len, &a, &b);
+        *l = cook__rope_join(t->left, t, a);
+        *r = b;
+    } else {
+        size_t at = pos - left;
+        cook__rope_node_t *tail = cook__rope_node(rope, t->data + at, t->len - at);
+        t->len = at;
+        *r = cook__rope_join(NULL, tail, t->right);
+        *l = cook__rope_join(t->left, t, NULL);
+    }
+}
+
+// cook__rope_drop - give every node of @t back to the pool
+static void cook__rope_drop(cook_rope_t *rope, cook__rope_node_t *t) {
+    while (t) {
+        cook__rope_node_t *right = t->right;
+        cook__rope_drop(rope, t->left);
+        cook_pool_free(&rope->nodes, t);
+        rope->pieces--;
+        t = right;
+    }
+}
+
+COOKDEF void cook_rope_init(cook_rope_t *rope, cook_string_view_t text) {
+    memset(rope, 0, sizeof(*rope));
+    cook_pool_init(&rope->nodes, sizeof(cook__rope_node_t), 0);
+    if (text.len > 0) rope->root = cook__rope_node(rope, text.data, text.len);
+}
+
+COOKDEF void cook_rope_free(cook_rope_t *rope) {
+    cook_pool_destroy(&rope->nodes);
+    cook_arena_free(&rope->text);
+    memset(rope, 0, sizeof(*rope));
+}
+
+COOKDEF size_t cook_rope_len(const cook_rope_t *rope) {
+    return cook__rope_size(rope->root);
+}
+
+COOKDEF void cook_rope_insert(cook_rope_t *rope, size_t pos, cook_string_view_t sv) {
+    COOK_ASSERT(pos <= cook_rope_len(rope) && "position out of range");
+    if (sv.len == 0) return;
+    // alignment 1 keeps the inserts of one arena block back to back
+    char *copy = cook_arena_alloc_aligned(&rope->text, sv.len, 1);
+    memcpy(copy, sv.data, sv.len);
+
+    cook__rope_node_t *l, *r;
+    cook__rope_split(rope, rope->root, pos, &l, &r);
+    cook__rope_node_t *last = l;
+    while (last && last->right) last = last->right;
+    if (last && last->data + last->len == copy) {
+        // the piece before ends where the copy starts, typing: grow it
+        for (cook__rope_node_t *t = l; t; t = t->right) t->size += sv.len;
+        last->len += sv.len;
+        rope->root = cook__rope_concat(l, r);
+    } else {
+        rope->root = cook__rope_join(l, cook__rope_node(rope, copy, sv.len), r);
+    }
+}
+
+COOKDEF void cook_rope_delete(cook_rope_t *rope, size_t pos, size_t len) {
+    size_t size = cook_rope_len(rope);
+    if (pos >= size || len == 0) return;
+    if (len > size - pos) len = size - pos;
+    cook__rope_node_t *l, *mid, *r;
+    cook__rope_split(rope, rope->root, pos, &l, &mid);
+    cook__rope_split(rope, mid, len, &mid, &r);
+    cook__rope_drop(rope, mid);
+    rope->root = cook__rope_concat(l, r);
+}
+
+COOKDEF char cook_rope_index(const cook_rope_t *rope, size_t pos) {
+    COOK_ASSERT(pos < cook_rope_len(rope) && "position out of range");
+    const cook__rope_node_t *t = rope->root;
+    for (;;) {
+        size_t left = cook__rope_size(t->left);
+        if (pos < left) {
+            t = t->left;
+        } else if (pos - left < t->len) {
+            return t->data[pos - left];
+        } else {
+            pos -= left + t->len;
+            t = t->right;
+        }
+    }
+}
+
+COOKDEF cook_rope_iter_t cook_rope_iter(const cook_rope_t *rope, size_t pos) {
+    cook_rope_iter_t it;
+    it.top = 0;
+    it.skip = 0;
+    // keep the nodes where the path goes left, they come after the position
+    cook__rope_node_t *t = pos < cook_rope_len(rope) ? rope->root : NULL;
+    while (t) {
+        size_t left = cook__rope_size(t->left);
+        if (pos < left) {
+            it.stack[it.top++] = t;
+            t = t->left;
+        } else if (pos - left < t->len) {
+            it.stack[it.top++] = t;
+            it.skip = pos - left;
+            break;
+        } else {
+            pos -= left + t->len;
+            t = t->right;
+        }
+    }
+    return it;
+}
+
+COOKDEF bool cook_rope_iter_next(cook_rope_iter_t *it, cook_string_view_t *chunk) {
+    if (it->top == 0) return false;
+    cook__rope_node_t *t = it->stack[--it->top];
+    *chunk = cook_sv_from_parts(t->data + it->skip, t->len - it->skip);
+    it->skip = 0;
+    for (t = t->right; t; t = t->left) it->stack[it->top++] = t;
+    return true;
+}
+
+COOKDEF cook_string_view_t cook_rope_flatten(const cook_rope_t *rope, cook_string_builder_t *sb) {
+    size_t start = sb->len;
+    cook_sb_reserve(sb, cook_rope_len(rope));
+    cook_rope_iter_t it = cook_rope_iter(rope, 0);
+    cook_string_view_t chunk;
+    while (cook_rope_iter_next(&it, &chunk)) {
+        memcpy(sb->items + sb->len, chunk.data, chunk.len);
+        sb->len += chunk.len;
+    }
+    return cook_sv_from_parts(sb->items + start, sb->len - start);
+}
+
+COOKDEF bool cook_rope_write(const cook_rope_t *rope, cook_writer_t *w) {
+    cook_rope_iter_t it = cook_rope_iter(rope, 0);
+    cook_string_view_t chunk;
+    while (cook_rope_iter_next(&it, &chunk)) {
+        while (chunk.len > 0) {
+            long n = w->write(w, chunk.data, chunk.len);
+            if (n <= 0) return false;
+            chunk.data += n;
+            chunk.len -= (size_t)n;
+        }
+    }
+    return true;
+}
+
+
+static unsigned char _temp_buffer[COOK_TEMP_BUFFER_CAP] = {0};
+static size_t _temp_buffer_used = 0;
+
+COOKDEF void *cook_temp_alloc(size_t size) {
+    return cook_temp_alloc_aligned(size, sizeof(void*));
+}
+
+COOKDEF void *cook_temp_alloc_aligned(size_t size, size_t align) {
+    COOK_ASSERT(COOK_IS_POW2(align) && align <= COOK_PAGE_SIZE && "invalid alignment");
+    if (size == 0) return NULL;
+    uintptr_t base = (uintptr_t)_temp_buffer;
+    size_t aligned_used = COOK_ALIGN_UP(base + _temp_buffer_used, (uintptr_t)align) - base;
+    if (aligned_used > COOK_TEMP_BUFFER_CAP || size > COOK_TEMP_BUFFER_CAP - aligned_used) return NULL;
+    void *ptr = _temp_buffer + aligned_used;
+    _temp_buffer_used = aligned_used + size;
+    return ptr;
+}
+
+COOKDEF size_t cook_temp_save(void) {
+    return _temp_buffer_used;
+}
+
+COOKDEF void cook_temp_rewind(size_t checkpoint) {
+    _temp_buffer_used = checkpoint;
+}
+
+COOKDEF void cook_temp_reset(void) {
+    _temp_buffer_used = 0;
+}
+
+COOKDEF const char *cook_temp_strdup(const char *cstr) {
+    return cook_temp_strsub(cstr, 0, strlen(cstr) + 1);
+}
+
+COOKDEF const char *cook_temp_strndup(const char *cstr, size_t n) {
+    return cook_temp_strsub(cstr, 0, n);
+}
+
+COOKDEF const char *cook_temp_strsub(const char *cstr, size_t begin, size_t end) {
+    if (!cstr || begin >= end) return NULL;
+
+    size_t sub_len = end - begin;
+    char *ptr = cook_temp_alloc(sub_len + 1);
+    COOK_ASSERT(ptr != NULL && "out of temporary buffer");
+
+    for (size_t i = 0; i < sub_len ; i++) {
+        ptr[i] = cstr[begin + i];
+    }
+    ptr[sub_len] = '\0';
+
+    return ptr;
+}
+
+COOKDEF const char *cook_temp_strfmt(const char *fmt, ...) {
+    if (!fmt) return NULL;
+
+    va_list args;
+
+    va_start(args, fmt);
+    int len = vsnprintf(NULL, 0, fmt, args);
+    va_end(args);
+    if (len < 0) return NULL;
+
+    void *ptr = cook_temp_alloc((size_t)len + 1);
+    COOK_ASSERT(ptr != NULL && "out of temporary buffer");
+
+    va_start(args, fmt);
+    vsnprintf(ptr, (size_t)len + 1, fmt, args);
+    va_end(args);
+
+    return ptr;
+}
+
+COOKDEF const char *cook_temp_sv_to_cstr(cook_string_view_t sv) {
+    char *ptr = cook_temp_alloc(sv.len + 1);
+    COOK_ASSERT(ptr != NULL && "out of temporary buffer");
+    memcpy(ptr, sv.data, sv.len);
+    ptr[sv.len] = '\0';
+    return ptr;
+}
+
+COOKDEF const char *cook_temp_path_join(const char *path1, const char *path2) {
+    if (!path1 || !*path1) return cook_temp_strdup(path2 ? path2 : "");
+    if (!path2 || !*path2) return cook_temp_strdup(path1);
+
+    size_t len1 = strlen(path1);
+    bool has_sep1 = len1 > 0 && (path1[len1 - 1] == '/' || path1[len1 - 1] == '\\');
+    bool has_sep2 = path2[0] == '/' || path2[0] == '\\';
+
+    size_t total_len = len1 + strlen(path2) + 2;
+    char *buffer = cook_temp_alloc(total_len);
+    if (!buffer) return NULL;
+
+    strcpy(buffer, path1);
+
+    if (!has_sep1 && !has_sep2) {
+        // need separator
+#ifdef _WIN32
+        strcat(buffer, "\\");
 #else
-#  include <unistd.h>
-#  include <dirent.h>
-#  include <fcntl.h>
-#  include <sys/types.h>
-#  include <utime.h>
+        strcat(buffer, "/");
 #endif
+        strcat(buffer, path2);
+    } else if (has_sep1 && has_sep2) {
+        // skip leading separator in path2
+        strcat(buffer, path2 + 1);
+    } else {
+        // directly concatenate
+        strcat(buffer, path2);
+    }
 
-#ifdef _WIN32
-#  define chdir(p) (_chdir(p))
-#  define getcwd(d, s) (_getcwd(d, s))
-#  define rmdir(p) (_rmdir(p))
-#  ifndef fileno
-#    define fileno(f) (_fileno(f))
-#  endif
+    return buffer;
+}
+
+COOKDEF const char *cook_temp_path_dirname(const char *path) {
+    if (!path || !*path) return "./";
+
+    // find last separator
+    const char *last_sep = NULL;
+    const char *p = path;
+    while (*p) {
+        if (*p == '/' || *p == '\\') last_sep = p;
+        p++;
+    }
+
+    // no separator found
+    if (!last_sep) return "./";
+
+    // copy directory part
+    size_t dir_len = last_sep - path + 1;
+    char *result = cook_temp_alloc(dir_len + 1);
+    if (!result) return NULL;
+
+    memcpy(result, path, dir_len);
+    result[dir_len] = '\0';
+    return result;
+}
+
+COOKDEF const char *cook_temp_path_basename(const char *path) {
+    if (!path || !*path) return "";
+
+    // find last separator
+    const char *last_sep = NULL;
+    const char *p = path;
+    while (*p) {
+        if (*p == '/' || *p == '\\') last_sep = p;
+        p++;
+    }
+
+    // no separator, whole path is basename
+    if (!last_sep) return cook_temp_strdup(path);
+
+    // return part after last separator
+    return cook_temp_strdup(last_sep + 1);
+}
+
+#if !defined(_WIN32) && defined(MAP_ANONYMOUS)
+#  define COOK__HAS_MMAP 1
 #endif
 
-#ifdef _WIN32
-#  ifndef S_ISDIR
-#    define S_ISDIR(mode) (mode&_S_IFDIR)
-#  endif
-#  ifndef S_ISREG
-#    define S_ISREG(mode) (mode&_S_IFREG)
-#  endif
-#  define STAT_STRUCT struct _stati64
-#  define STAT_FUNC _stati64
-#else
-#  define STAT_STRUCT struct stat
-#  define STAT_FUNC stat
+#define COOK__PAGES_ANY_HUGE (COOK_PAGES_HUGE | COOK_PAGES_HUGETLB)
+
+COOKDEF size_t cook_pages_round(size_t size, unsigned int flags) {
+    size_t unit = (flags & COOK__PAGES_ANY_HUGE) ? COOK_HUGE_PAGE_SIZE : COOK_PAGE_SIZE;
+    return COOK_ALIGN_UP(size, unit);
+}
+
+#ifdef COOK__HAS_MMAP
+
+// cook__pages_map_thp - map @len bytes aligned to a huge page, so that
+//                       transparent huge pages can back the whole range
+static void *cook__pages_map_thp(size_t len) {
+    size_t over = len + COOK_HUGE_PAGE_SIZE;
+    char *raw = mmap(NULL, over, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) return NULL;
+    char *ptr = (char *)COOK_ALIGN_UP((uintptr_t)raw, (uintptr_t)COOK_HUGE_PAGE_SIZE);
+    if (ptr > raw) munmap(raw, ptr - raw);
+    if (raw + over > ptr + len) munmap(ptr + len, raw + over - (ptr + len));
+#ifdef MADV_HUGEPAGE
+    madvise(ptr, len, MADV_HUGEPAGE);
+#endif
+    return ptr;
+}
+
+// cook__pages_prefault - fault in every page of a fresh mapping
+static void cook__pages_prefault(void *ptr, size_t len) {
+#ifdef MADV_POPULATE_WRITE
+    if (madvise(ptr, len, MADV_POPULATE_WRITE) == 0) return;
 #endif
+    for (size_t i = 0; i < len; i += COOK_PAGE_SIZE) ((volatile char *)ptr)[i] = 0;
+}
 
-struct cook_dir_t {
-    bool closed;
-#ifdef _WIN32
-    intptr_t hFile;
-    char pattern[COOK_MAX_PATH_LEN + 1];
+COOKDEF void *cook_pages_alloc(size_t size, unsigned int flags) {
+    if (size == 0) return NULL;
+    size_t len = cook_pages_round(size, flags);
+    void *ptr = NULL;
+
+#ifdef MAP_HUGETLB
+    if (flags & COOK_PAGES_HUGETLB) {
+        int mflags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+#ifdef MAP_POPULATE
+        if (flags & COOK_PAGES_POPULATE) mflags |= MAP_POPULATE;
+#endif
+        ptr = mmap(NULL, len, PROT_READ | PROT_WRITE, mflags, -1, 0);
+        if (ptr != MAP_FAILED) return ptr;
+        ptr = NULL; // no huge pages reserved, fall back to THP
+    }
+#endif
+
+    if (flags & COOK__PAGES_ANY_HUGE) {
+        // populate after madvise, so the faults already get huge pages
+        ptr = cook__pages_map_thp(len);
+        if (ptr && (flags & COOK_PAGES_POPULATE)) cook__pages_prefault(ptr, len);
+        return ptr;
+    }
+
+    int mflags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_POPULATE
+    if (flags & COOK_PAGES_POPULATE) mflags |= MAP_POPULATE;
+#endif
+    ptr = mmap(NULL, len, PROT_READ | PROT_WRITE, mflags, -1, 0);
+    return ptr == MAP_FAILED ? NULL : ptr;
+}
+
+COOKDEF void *cook_pages_realloc(void *ptr, size_t old_size, size_t new_size, unsigned int flags) {
+    if (!ptr) return cook_pages_alloc(new_size, flags);
+    size_t old_len = cook_pages_round(old_size, flags);
+    size_t new_len = cook_pages_round(new_size, flags);
+    if (old_len == new_len) return ptr;
+
+#ifdef MREMAP_MAYMOVE
+    if (flags & COOK__PAGES_ANY_HUGE) {
+        // the kernel picks a page aligned address when it moves a mapping,
+        // so grow in place or move the pages onto an aligned range
+        void *new_ptr = mremap(ptr, old_len, new_len, 0);
+        if (new_ptr != MAP_FAILED) return new_ptr;
+#ifdef MREMAP_FIXED
+        void *dst = cook__pages_map_thp(new_len);
+        if (dst) {
+            new_ptr = mremap(ptr, old_len, new_len, MREMAP_MAYMOVE | MREMAP_FIXED, dst);
+            if (new_ptr != MAP_FAILED) {
+#ifdef MADV_HUGEPAGE
+                madvise(new_ptr, new_len, MADV_HUGEPAGE);
+#endif
+                return new_ptr;
+            }
+            munmap(dst, new_len);
+        }
+#endif
+    } else {
+        void *new_ptr = mremap(ptr, old_len, new_len, MREMAP_MAYMOVE);
+        if (new_ptr != MAP_FAILED) return new_ptr;
+    }
+#endif
+
+    void *fresh = cook_pages_alloc(new_size, flags);
+    if (!fresh) return NULL;
+    memcpy(fresh, ptr, old_len < new_len ? old_len : new_len);
+    munmap(ptr, old_len);
+    return fresh;
+}
+
+COOKDEF void cook_pages_free(void *ptr, size_t size, unsigned int flags) {
+    if (!ptr) return;
+    munmap(ptr, cook_pages_round(size, flags));
+}
+
+COOKDEF void cook_pages_release(void *ptr, size_t size, unsigned int flags) {
+    uintptr_t begin = COOK_ALIGN_UP((uintptr_t)ptr, (uintptr_t)COOK_PAGE_SIZE);
+    uintptr_t end = COOK_ALIGN_DOWN((uintptr_t)ptr + size, (uintptr_t)COOK_PAGE_SIZE);
+    if (end <= begin) return;
+    int advice = MADV_DONTNEED;
+#ifdef MADV_FREE
+    if (flags & COOK_PAGES_LAZY_FREE) advice = MADV_FREE;
 #else
-    DIR *dp;
+    (void) flags;
 #endif
-    char buffer[COOK_MAX_PATH_LEN + 1];
+    madvise((void *)begin, end - begin, advice);
+}
+
+#else // COOK__HAS_MMAP
+
+COOKDEF void *cook_pages_alloc(size_t size, unsigned int flags) {
+    if (size == 0) return NULL;
+    size_t len = cook_pages_round(size, flags);
+    void *ptr = COOK__ALLOC(len, "pages");
+    if (ptr) memset(ptr, 0, len);
+    return ptr;
+}
+
+COOKDEF void *cook_pages_realloc(void *ptr, size_t old_size, size_t new_size, unsigned int flags) {
+    size_t old_len = ptr ? cook_pages_round(old_size, flags) : 0;
+    size_t new_len = cook_pages_round(new_size, flags);
+    char *new_ptr = COOK__REALLOC(ptr, new_len, "pages");
+    if (new_ptr && new_len > old_len) memset(new_ptr + old_len, 0, new_len - old_len);
+    return new_ptr;
+}
+
+COOKDEF void cook_pages_free(void *ptr, size_t size, unsigned int flags) {
+    (void) size;
+    (void) flags;
+    if (ptr) COOK__FREE(ptr);
+}
+
+COOKDEF void cook_pages_release(void *ptr, size_t size, unsigned int flags) {
+    (void) ptr;
+    (void) size;
+    (void) flags;
+}
+
+#endif // COOK__HAS_MMAP
+
+struct cook_arena_block {
+    cook_arena_block_t *next;
+    size_t used;
+    size_t cap;
+    unsigned char data[];
 };
 
-COOKDEF char *cook_fs_readfile(const char *path) {
-    FILE *fp = NULL;
-    char *buffer = NULL;
-    long size;
+// cook__arena_new_block - allocate an empty block that fits @size at @align
+// @arena: pointer to arena
+// @size: size of the allocation that triggered the block
+// @align: alignment of that allocation
+static cook_arena_block_t *cook__arena_new_block(cook_arena_t *arena, size_t size, size_t align) {
+    size_t cap = arena->block_size ? arena->block_size : COOK_ARENA_BLOCK_SIZE;
+    if (cap < size + align - 1) cap = size + align - 1;
+    cook_arena_block_t *block;
+    if (arena->page_flags) {
+        // use the whole mapping, it is rounded to pages anyway
+        size_t map_size = cook_pages_round(sizeof(*block) + cap, arena->page_flags);
+        block = cook_pages_alloc(map_size, arena->page_flags);
+        cap = map_size - sizeof(*block);
+    } else {
+        block = COOK__ALLOC(sizeof(*block) + cap, "arena");
+    }
+    COOK_ASSERT(block != NULL && "out of memory");
+    block->next = NULL;
+    block->used = 0;
+    block->cap = cap;
+    return block;
+}
 
-    fp = fopen(path, "rb");
-    if (!fp) goto fail;
+// cook__arena_bump - try to carve an aligned allocation out of one block
+// @block: block to allocate from
+// @size: size in bytes
+// @align: alignment in bytes
+//
+// Return: pointer to memory, or NULL if the block is too full
+static void *cook__arena_bump(cook_arena_block_t *block, size_t size, size_t align) {
+    uintptr_t base = (uintptr_t)block->data;
+    size_t offset = COOK_ALIGN_UP(base + block->used, (uintptr_t)align) - base;
+    if (offset > block->cap || size > block->cap - offset) return NULL;
+    block->used = offset + size;
+    return block->data + offset;
+}
 
-    fseek(fp, 0, SEEK_END);
-    size = ftell(fp);
-    rewind(fp);
-    if (size <= 0) goto fail;
+COOKDEF void *cook_arena_alloc(cook_arena_t *arena, size_t size) {
+    return cook_arena_alloc_aligned(arena, size, sizeof(void*));
+}
+
+COOKDEF void *cook_arena_alloc_aligned(cook_arena_t *arena, size_t size, size_t align) {
+    COOK_ASSERT(COOK_IS_POW2(align) && align <= COOK_PAGE_SIZE && "invalid alignment");
+    if (size == 0) return NULL;
 
-    buffer = malloc(size + 1);
-    if (fread(buffer, size, 1, fp) != 1) goto fail;
-    buffer[size] = '\0';
+    if (!arena->end) {
+        if (!arena->begin) arena->begin = cook__arena_new_block(arena, size, align);
+        arena->end = arena->begin;
+    }
 
-    fclose(fp);
-    return buffer;
-fail:
-    if (!fp) fclose(fp);
-    if (!buffer) free(buffer);
-    return NULL;
+    void *ptr;
+    while (!(ptr = cook__arena_bump(arena->end, size, align))) {
+        if (!arena->end->next) arena->end->next = cook__arena_new_block(arena, size, align);
+        arena->end = arena->end->next;
+    }
+    return ptr;
 }
 
-COOKDEF char *cook_fs_cwd(void) {
-    char *path = NULL;
-    size_t size = 128;
+COOKDEF void *cook_arena_memdup(cook_arena_t *arena, const void *data, size_t size) {
+    void *ptr = cook_arena_alloc(arena, size);
+    if (ptr) memcpy(ptr, data, size);
+    return ptr;
+}
 
-    while (1) {
-        char *temp_path = realloc(path, size);
-        path = temp_path;
-        if (getcwd(temp_path, size)) break;
-        if (errno != ERANGE) {
-            free(temp_path);
-            fprintf(stderr, "ERROR: cook_fs_cwd: %s\n", strerror(errno));
-            return NULL;
+COOKDEF cook_arena_mark_t cook_arena_save(cook_arena_t *arena) {
+    return (cook_arena_mark_t) {
+        .block = arena->end,
+        .used = arena->end ? arena->end->used : 0
+    };
+}
+
+COOKDEF void cook_arena_rewind(cook_arena_t *arena, cook_arena_mark_t mark) {
+    bool release = arena->page_flags & (COOK_PAGES_RELEASE | COOK_PAGES_LAZY_FREE);
+    cook_arena_block_t *block;
+    if (mark.block) {
+        if (release && mark.block->used > mark.used) {
+            cook_pages_release(mark.block->data + mark.used,
+                               mark.block->used - mark.used, arena->page_flags);
         }
-        size *= 2;
+        mark.block->used = mark.used;
+        block = mark.block->next;
+    } else {
+        block = arena->begin;
     }
+    for (; block; block = block->next) {
+        if (release && block->used > 0) cook_pages_release(block->data, block->used, arena->page_flags);
+        block->used = 0;
+    }
+    arena->end = mark.block;
+}
 
-    return path;
+COOKDEF void cook_arena_reset(cook_arena_t *arena) {
+    cook_arena_rewind(arena, (cook_arena_mark_t) {0});
 }
 
-COOKDEF bool cook_fs_mkdir(const char *path) {
-#ifdef _WIN32
-#  define cook__fs_mkdir _mkdir
-#else
-#  define cook__fs_mkdir(path) (mkdir((path), \
-    S_IRUSR | S_IWUSR | S_IXUSR | S_IRGRP | S_IWGRP | S_IXGRP | S_IROTH | S_IXOTH))
-#endif
-    if (cook__fs_mkdir(path) != 0) {
-        fprintf(stderr, "ERROR: cook_fs_mkdir: %s\n", strerror(errno));
-        return false;
+COOKDEF void cook_arena_free(cook_arena_t *arena) {
+    cook_arena_block_t *block = arena->begin;
+    while (block) {
+        cook_arena_block_t *next = block->next;
+        if (arena->page_flags) {
+            cook_pages_free(block, sizeof(*block) + block->cap, arena->page_flags);
+        } else {
+            COOK__FREE(block);
+        }
+        block = next;
     }
-    return true;
+    arena->begin = NULL;
+    arena->end = NULL;
 }
 
-COOKDEF bool cook_fs_rmdir(const char *path) {
-    if (rmdir(path) != 0) {
-        fprintf(stderr, "ERROR: cook_fs_rmdir: %s\n", strerror(errno));
-        return false;
-    }
-    return true;
+COOKDEF const char *cook_arena_strfmt(cook_arena_t *arena, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    const char *result = cook_arena_vstrfmt(arena, fmt, args);
+    va_end(args);
+    return result;
 }
 
-COOKDEF bool cook_fs_chdir(const char *path) {
-    if (chdir(path) != 0) {
-        fprintf(stderr, "ERROR: cook_fs_chdir: %s\n", strerror(errno));
-        return false;
+COOKDEF const char *cook_arena_vstrfmt(cook_arena_t *arena, const char *fmt, va_list args) {
+    if (!fmt) return NULL;
+
+    va_list copy;
+    va_copy(copy, args);
+    int len = vsnprintf(NULL, 0, fmt, copy);
+    va_end(copy);
+    if (len < 0) return NULL;
+
+    char *ptr = cook_arena_alloc(arena, (size_t)len + 1);
+    vsnprintf(ptr, (size_t)len + 1, fmt, args);
+    return ptr;
+}
+
+static COOK_THREAD_LOCAL cook_arena_t cook__scratch_arenas[COOK_SCRATCH_COUNT];
+
+COOKDEF cook_scratch_t cook_scratch_begin(cook_arena_t **conflicts, size_t count) {
+    for (size_t i = 0; i < COOK_SCRATCH_COUNT; i++) {
+        cook_arena_t *arena = &cook__scratch_arenas[i];
+        bool conflict = false;
+        for (size_t j = 0; j < count && !conflict; j++) conflict = conflicts[j] == arena;
+        if (!conflict) return (cook_scratch_t) { arena, cook_arena_save(arena) };
     }
-    return true;
+    COOK_ASSERT(0 && "all scratch arenas conflict, raise COOK_SCRATCH_COUNT");
+    return (cook_scratch_t) {0};
 }
 
-COOKDEF cook_dir_t *cook_fs_opendir(const char *path) {
-    cook_dir_t *handle = NULL;
+COOKDEF void cook_scratch_end(cook_scratch_t scratch) {
+    cook_arena_rewind(scratch.arena, scratch.mark);
+}
 
-    handle = malloc(sizeof(cook_dir_t));
-    if (!handle) COOK_ASSERT(handle != NULL && "out of memory");
+COOKDEF void cook_scratch_release(void) {
+    for (size_t i = 0; i < COOK_SCRATCH_COUNT; i++) cook_arena_free(&cook__scratch_arenas[i]);
+}
 
+// cook__spin_lock - take a spin lock, yield the cpu while it is contended
+// @lock: pointer to lock word (0 = unlocked)
+static void cook__spin_lock(volatile long *lock) {
+    for (int spins = 0; ; spins++) {
+#if defined(_MSC_VER)
+        if (_InterlockedExchange(lock, 1) == 0) return;
+#else
+        if (__atomic_exchange_n(lock, 1, __ATOMIC_ACQUIRE) == 0) return;
+#endif
+        if (spins < 64) continue;
 #ifdef _WIN32
-    handle->hFile = 0L;
-    if (strlen(path) > COOK_MAX_PATH_LEN - 2) {
-        fprintf(stderr, "ERROR: cook_fs_opendir: path too long: %s\n", path);
-        goto fail;
-    } else {
-        snprintf(handle->pattern, sizeof(handle->pattern), "%s/*", path);
-    }
+        SwitchToThread();
 #else
-    handle->dp = opendir(path);
-    if (!handle->dp) {
-        fprintf(stderr, "ERROR: cook_fs_opendir: %s\n", strerror(errno));
-        goto fail;
+        sched_yield();
+#endif
     }
+}
+
+// cook__spin_unlock - release a spin lock
+// @lock: pointer to lock word
+static void cook__spin_unlock(volatile long *lock) {
+#if defined(_MSC_VER)
+    _InterlockedExchange(lock, 0);
+#else
+    __atomic_store_n(lock, 0, __ATOMIC_RELEASE);
 #endif
-    handle->closed = false;
+}
 
-    return handle;
-fail:
-    if (!handle) free(handle);
-    return NULL;
+static void *cook__heap_alloc(cook_allocator_t *a, size_t size) {
+    (void) a;
+    return COOK__ALLOC(size, "heap");
 }
 
-COOKDEF void cook_fs_closedir(cook_dir_t *handle) {
-#ifdef _WIN32
-    if (!handle->closed && handle->hFile) _findclose(handle->hFile);
-#else
-    if (!handle->closed && handle->dp) closedir(handle->dp);
+static void *cook__heap_realloc(cook_allocator_t *a, void *ptr, size_t old_size, size_t new_size) {
+    (void) a;
+    (void) old_size;
+    return COOK__REALLOC(ptr, new_size, "heap");
+}
+
+static void cook__heap_free(cook_allocator_t *a, void *ptr, size_t size) {
+    (void) a;
+    (void) size;
+    COOK__FREE(ptr);
+}
+
+COOKDEF cook_allocator_t *cook_heap_allocator(void) {
+    static cook_allocator_t heap = {
+        .ctx = NULL,
+        .alloc = cook__heap_alloc,
+        .realloc = cook__heap_realloc,
+        .free = cook__heap_free
+    };
+    return &heap;
+}
+
+COOKDEF void cook_free(void *ptr) {
+    if (ptr) COOK__FREE(ptr);
+}
+
+#ifdef COOK_ALLOC_STATS
+
+#ifndef COOK_STATS_MAX_TAGS
+#define COOK_STATS_MAX_TAGS 64
 #endif
-    free(handle);
+
+#ifndef COOK_STATS_MAX_SITES
+#define COOK_STATS_MAX_SITES 1024
+#endif
+
+// live block, remembers what to subtract when it is freed
+typedef struct {
+    void *ptr;
+    size_t size;
+    unsigned int tag;
+    unsigned int site;
+} cook__stats_block_t;
+
+static struct {
+    volatile long lock;
+    cook_alloc_stats_t total;
+    cook_alloc_stats_t tags[COOK_STATS_MAX_TAGS];
+    size_t tags_len;
+    cook_alloc_stats_t sites[COOK_STATS_MAX_SITES];
+    size_t sites_len;
+    cook__stats_block_t *blocks;   // open addressing, linear probing
+    size_t blocks_len;
+    size_t blocks_cap;
+} cook__stats = {0};
+
+static size_t cook__stats_hash_ptr(void *ptr) {
+    uint64_t h = (uint64_t)(uintptr_t)ptr;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return (size_t)h;
 }
 
-COOKDEF const char *cook_fs_readdir(cook_dir_t *handle) {
-#ifdef _WIN32
-    struct _finddata_t c_file;
-    if (handle->hFile == 0L) { /* first entry */
-        if ((handle->hFile = _findfirst(handle->pattern, &c_file)) == -1L) {
-            fprintf(stderr, "ERROR: cook_fs_readdir: %s\n", strerror(errno));
-            handle->closed = true;
-            return NULL;
-        } else {
-            if (strlen(c_file.name) > COOK_MAX_PATH_LEN) {
-                fprintf(stderr, "ERROR: cook_fs_readdir: path too long: %s\n", c_file.name);
-                return NULL;
-            }
-            snprintf(handle->buffer, sizeof(handle->buffer), "%s", c_file.name);
-            return handle->buffer;
+// cook__stats_find_tag - find or add the counters of a tag (lock held)
+static unsigned int cook__stats_find_tag(const char *tag) {
+    if (!tag) tag = "other";
+    for (size_t i = 0; i < cook__stats.tags_len; i++) {
+        const char *name = cook__stats.tags[i].tag;
+        if (name == tag || strcmp(name, tag) == 0) return (unsigned int)i;
+    }
+    // the last slot collects everything once the table is full
+    if (cook__stats.tags_len == COOK_STATS_MAX_TAGS) return COOK_STATS_MAX_TAGS - 1;
+    cook__stats.tags[cook__stats.tags_len].tag = tag;
+    return (unsigned int)cook__stats.tags_len++;
+}
+
+// cook__stats_find_site - find or add the counters of a callsite (lock held)
+static unsigned int cook__stats_find_site(const char *tag, const char *file, size_t line) {
+    if (!tag) tag = "other";
+    for (size_t i = 0; i < cook__stats.sites_len; i++) {
+        cook_alloc_stats_t *site = &cook__stats.sites[i];
+        if (site->line != line) continue;
+        if (site->file != file && strcmp(site->file, file) != 0) continue;
+        if (site->tag != tag && strcmp(site->tag, tag) != 0) continue;
+        return (unsigned int)i;
+    }
+    if (cook__stats.sites_len == COOK_STATS_MAX_SITES) return COOK_STATS_MAX_SITES - 1;
+    cook_alloc_stats_t *site = &cook__stats.sites[cook__stats.sites_len];
+    site->tag = tag;
+    site->file = file;
+    site->line = line;
+    return (unsigned int)cook__stats.sites_len++;
+}
+
+// cook__stats_find_block - find the slot of a live block, or the empty slot
+//                          where it would go (lock held, table not empty)
+static size_t cook__stats_find_block(void *ptr) {
+    size_t mask = cook__stats.blocks_cap - 1;
+    size_t i = cook__stats_hash_ptr(ptr) & mask;
+    while (cook__stats.blocks[i].ptr && cook__stats.blocks[i].ptr != ptr) i = (i + 1) & mask;
+    return i;
+}
+
+// cook__stats_remove_block - delete a slot, shifting the probe chain back (lock held)
+static void cook__stats_remove_block(size_t i) {
+    size_t mask = cook__stats.blocks_cap - 1;
+    size_t j = i;
+    cook__stats.blocks[i].ptr = NULL;
+    for (;;) {
+        j = (j + 1) & mask;
+        if (!cook__stats.blocks[j].ptr) break;
+        size_t home = cook__stats_hash_ptr(cook__stats.blocks[j].ptr) & mask;
+        // move j into the hole if its home is not within (i, j]
+        if ((i <= j) ? (home <= i || home > j) : (home <= i && home > j)) {
+            cook__stats.blocks[i] = cook__stats.blocks[j];
+            cook__stats.blocks[j].ptr = NULL;
+            i = j;
         }
-    } else { /* next entry */
-        if (_findnext(handle->hFile, &c_file) == -1L) {
-            /* no more entries => close directory */
-            _findclose(handle->hFile);
-            handle->closed = true;
-            return NULL;
+    }
+    cook__stats.blocks_len--;
+}
+
+// cook__stats_account - add (or with @sign < 0 remove) live bytes (lock held)
+static void cook__stats_account(cook__stats_block_t *block, int sign) {
+    cook_alloc_stats_t *all[3] = {
+        &cook__stats.total, &cook__stats.tags[block->tag], &cook__stats.sites[block->site]
+    };
+    for (size_t k = 0; k < 3; k++) {
+        if (sign > 0) {
+            all[k]->live_bytes += block->size;
+            if (all[k]->live_bytes > all[k]->peak_bytes) all[k]->peak_bytes = all[k]->live_bytes;
         } else {
-            if (strlen(c_file.name) > COOK_MAX_PATH_LEN) {
-                fprintf(stderr, "ERROR: cook_fs_readdir: path too long: %s\n", c_file.name);
-                return NULL;
-            }
-            snprintf(handle->buffer, sizeof(handle->buffer), "%s", c_file.name);
-            return handle->buffer;
+            all[k]->live_bytes -= block->size;
         }
     }
-#else
-    struct dirent *entry;
-    if ((entry = readdir(handle->dp)) != NULL) {
-        if (strlen(entry->d_name) > COOK_MAX_PATH_LEN) {
-            fprintf(stderr, "ERROR: cook_fs_readdir: path too long: %s\n", entry->d_name);
-            return NULL;
+}
+
+// cook__stats_untrack - forget a live block if we know it (lock held)
+static bool cook__stats_untrack(void *ptr, cook__stats_block_t *out) {
+    if (!ptr || cook__stats.blocks_len == 0) return false;
+    size_t i = cook__stats_find_block(ptr);
+    if (!cook__stats.blocks[i].ptr) return false;
+    *out = cook__stats.blocks[i];
+    cook__stats_account(out, -1);
+    cook__stats_remove_block(i);
+    return true;
+}
+
+// cook__stats_track - remember a new live block (lock held)
+static void cook__stats_track(cook__stats_block_t block) {
+    if (2*(cook__stats.blocks_len + 1) > cook__stats.blocks_cap) {
+        cook__stats_block_t *old = cook__stats.blocks;
+        size_t old_cap = cook__stats.blocks_cap;
+        cook__stats.blocks_cap = old_cap ? 2*old_cap : 1024;
+        cook__stats.blocks = COOK_ALLOC(cook__stats.blocks_cap*sizeof(*old));
+        COOK_ASSERT(cook__stats.blocks != NULL && "out of memory");
+        memset(cook__stats.blocks, 0, cook__stats.blocks_cap*sizeof(*old));
+        for (size_t i = 0; i < old_cap; i++) {
+            if (old[i].ptr) cook__stats.blocks[cook__stats_find_block(old[i].ptr)] = old[i];
         }
-        snprintf(handle->buffer, sizeof(handle->buffer), "%s", entry->d_name);
-        return handle->buffer;
+        COOK_FREE(old);
+    }
+    size_t i = cook__stats_find_block(block.ptr);
+    if (cook__stats.blocks[i].ptr) {
+        // address came back from a block freed behind our back
+        cook__stats_account(&cook__stats.blocks[i], -1);
     } else {
-        /* no more entries => close directory */
-        closedir(handle->dp);
-        handle->closed = true;
+        cook__stats.blocks_len++;
+    }
+    cook__stats.blocks[i] = block;
+    cook__stats_account(&block, +1);
+}
+
+COOKDEF void *cook_stats_alloc(size_t size, const char *tag, const char *file, size_t line) {
+    void *ptr = COOK_ALLOC(size);
+    if (!ptr) return NULL;
+
+    cook__spin_lock(&cook__stats.lock);
+    cook__stats_block_t block = {
+        .ptr = ptr,
+        .size = size,
+        .tag = cook__stats_find_tag(tag),
+        .site = cook__stats_find_site(tag, file, line)
+    };
+    cook_alloc_stats_t *all[3] = {
+        &cook__stats.total, &cook__stats.tags[block.tag], &cook__stats.sites[block.site]
+    };
+    for (size_t k = 0; k < 3; k++) {
+        all[k]->allocs++;
+        all[k]->bytes += size;
+    }
+    cook__stats_track(block);
+    cook__spin_unlock(&cook__stats.lock);
+    return ptr;
+}
+
+COOKDEF void *cook_stats_realloc(void *ptr, size_t size, const char *tag, const char *file, size_t line) {
+    if (!ptr) return cook_stats_alloc(size, tag, file, line);
+
+    // forget the old block first, the address means nothing after realloc
+    cook__spin_lock(&cook__stats.lock);
+    cook__stats_block_t old = {0};
+    bool known = cook__stats_untrack(ptr, &old);
+    cook__spin_unlock(&cook__stats.lock);
+
+    void *new_ptr = COOK_REALLOC(ptr, size);
+
+    cook__spin_lock(&cook__stats.lock);
+    if (!new_ptr) {
+        if (known) cook__stats_track(old);
+        cook__spin_unlock(&cook__stats.lock);
         return NULL;
     }
-#endif
+    cook__stats_block_t block = {
+        .ptr = new_ptr,
+        .size = size,
+        .tag = cook__stats_find_tag(tag),
+        .site = cook__stats_find_site(tag, file, line)
+    };
+    bool moved = known && old.ptr != new_ptr;
+    cook_alloc_stats_t *all[3] = {
+        &cook__stats.total, &cook__stats.tags[block.tag], &cook__stats.sites[block.site]
+    };
+    for (size_t k = 0; k < 3; k++) {
+        all[k]->reallocs++;
+        all[k]->bytes += size;
+        if (moved) all[k]->copy_bytes += old.size < size ? old.size : size;
+    }
+    cook__stats_track(block);
+    cook__spin_unlock(&cook__stats.lock);
+    return new_ptr;
 }
 
-COOKDEF bool cook_fs_move(const char *old_path, const char *new_path) {
-    if (rename(old_path, new_path) != 0) {
-        fprintf(stderr, "ERROR: cook_fs_move: %s\n", strerror(errno));
-        return false;
+COOKDEF void cook_stats_free(void *ptr) {
+    if (!ptr) return;
+
+    cook__spin_lock(&cook__stats.lock);
+    cook__stats_block_t old;
+    if (cook__stats_untrack(ptr, &old)) {
+        cook__stats.total.frees++;
+        cook__stats.tags[old.tag].frees++;
+        cook__stats.sites[old.site].frees++;
     }
-    return true;
+    cook__spin_unlock(&cook__stats.lock);
+    COOK_FREE(ptr);
 }
 
-COOKDEF bool cook_fs_stat(const char *path, cook_attr_t *attr_ptr) {
-    STAT_STRUCT info = {0};
-    if (STAT_FUNC(path, &info)) {
-        fprintf(stderr, "ERROR: cook_fs_stat: %s\n", strerror(errno));
-        return false;
+COOKDEF cook_alloc_stats_t cook_alloc_stats_get(const char *tag) {
+    cook_alloc_stats_t res = {0};
+    cook__spin_lock(&cook__stats.lock);
+    if (!tag) {
+        res = cook__stats.total;
+    } else {
+        for (size_t i = 0; i < cook__stats.tags_len; i++) {
+            if (strcmp(cook__stats.tags[i].tag, tag) == 0) res = cook__stats.tags[i];
+        }
     }
-    attr_ptr->mode  = info.st_mode;
-    attr_ptr->ino   = info.st_ino;
-    attr_ptr->atime = info.st_atime;
-    attr_ptr->mtime = info.st_mtime;
-    attr_ptr->ctime = info.st_ctime;
-    attr_ptr->size  = info.st_size;
-    return true;
+    cook__spin_unlock(&cook__stats.lock);
+    return res;
 }
 
-COOKDEF bool cook_fs_isdir(const char *path) {
-    cook_attr_t attr;
-    COOK_ASSERT(cook_fs_stat(path, &attr) && "unexpected error occurs");
-    return S_ISDIR(attr.mode);
+// cook__stats_print_row - print one row of counters
+static void cook__stats_print_row(const char *name, const cook_alloc_stats_t *st) {
+    printf("%-32s %10zu %10zu %10zu %14zu %12zu %12zu %12zu\n", name,
+           st->allocs, st->reallocs, st->frees, st->bytes,
+           st->live_bytes, st->peak_bytes, st->copy_bytes);
 }
 
-COOKDEF bool cook_fs_isfile(const char *path) {
-    cook_attr_t attr;
-    COOK_ASSERT(cook_fs_stat(path, &attr) && "unexpected error occurs");
-    return S_ISREG(attr.mode);
+// cook__stats_print_header - print the column names
+static void cook__stats_print_header(const char *first) {
+    printf("%-32s %10s %10s %10s %14s %12s %12s %12s\n", first,
+           "allocs", "reallocs", "frees", "bytes", "live", "peak", "copied");
 }
 
-COOKDEF bool cook_fs_exists(const char *path) {
-    cook_attr_t attr;
-    if (!cook_fs_stat(path, &attr)) return false;
-    return true;
+COOKDEF void cook_alloc_stats_summary(void) {
+    cook__spin_lock(&cook__stats.lock);
+    printf("-------------------------------------------------\n");
+    printf("Allocation summary:\n");
+    cook__stats_print_header("tag");
+    for (size_t i = 0; i < cook__stats.tags_len; i++) {
+        cook__stats_print_row(cook__stats.tags[i].tag, &cook__stats.tags[i]);
+    }
+    cook__stats_print_row("total", &cook__stats.total);
+    printf("-------------------------------------------------\n");
+    cook__spin_unlock(&cook__stats.lock);
 }
 
-COOKDEF const char *cook_fs_type2string(cook_attr_t *attr_ptr) {
-    int mode = attr_ptr->mode;
-    if (S_ISREG(mode)) {
-        return "file";
-    } else if (S_ISDIR(mode)) {
-        return "dir";
-    } else {
-        return "other";
+static int cook__stats_site_cmp(const void *a, const void *b) {
+    const cook_alloc_stats_t *x = *(const cook_alloc_stats_t *const *)a;
+    const cook_alloc_stats_t *y = *(const cook_alloc_stats_t *const *)b;
+    if (x->bytes != y->bytes) return x->bytes < y->bytes ? 1 : -1;
+    return x->allocs < y->allocs ? 1 : (x->allocs > y->allocs ? -1 : 0);
+}
+
+COOKDEF void cook_alloc_stats_detail(void) {
+    static const cook_alloc_stats_t *order[COOK_STATS_MAX_SITES];
+    char name[64];
+
+    cook__spin_lock(&cook__stats.lock);
+    for (size_t i = 0; i < cook__stats.sites_len; i++) order[i] = &cook__stats.sites[i];
+    qsort(order, cook__stats.sites_len, sizeof(order[0]), cook__stats_site_cmp);
+
+    printf("-------------------------------------------------\n");
+    printf("Allocation callsites:\n");
+    cook__stats_print_header("[tag] file:line");
+    for (size_t i = 0; i < cook__stats.sites_len; i++) {
+        const cook_alloc_stats_t *site = order[i];
+        const char *file = site->file;
+        // keep the tail of long paths, it is the informative part
+        size_t file_len = strlen(file);
+        if (file_len > 20) file += file_len - 20;
+        snprintf(name, sizeof(name), "[%s] %s:%zu", site->tag, file, site->line);
+        cook__stats_print_row(name, site);
     }
+    printf("-------------------------------------------------\n");
+    cook__spin_unlock(&cook__stats.lock);
 }
 
-COOKDEF const char *cook_fs_perm2string(cook_attr_t *attr_ptr) {
-    static char perms[10] = "---------";
-    for (int i = 0; i < 9; i++) perms[i] = '-';
-    int mode = attr_ptr->mode;
-#ifdef _WIN32
-    if (mode & _S_IREAD)  perms[0] = perms[3] = perms[6] = 'r';
-    if (mode & _S_IWRITE) perms[1] = perms[4] = perms[7] = 'w';
-    if (mode & _S_IEXEC)  perms[2] = perms[5] = perms[8] = 'x';
-#else
-    if (mode & S_IRUSR) perms[0] = 'r';
-    if (mode & S_IWUSR) perms[1] = 'w';
-    if (mode & S_IXUSR) perms[2] = 'x';
-    if (mode & S_IRGRP) perms[3] = 'r';
-    if (mode & S_IWGRP) perms[4] = 'w';
-    if (mode & S_IXGRP) perms[5] = 'x';
-    if (mode & S_IROTH) perms[6] = 'r';
-    if (mode & S_IWOTH) perms[7] = 'w';
-    if (mode & S_IXOTH) perms[8] = 'x';
-#endif
-    return perms;
+COOKDEF void cook_alloc_stats_reset(void) {
+    cook_alloc_stats_t *all[COOK_STATS_MAX_TAGS + COOK_STATS_MAX_SITES + 1];
+    size_t n = 0;
+
+    cook__spin_lock(&cook__stats.lock);
+    all[n++] = &cook__stats.total;
+    for (size_t i = 0; i < cook__stats.tags_len; i++) all[n++] = &cook__stats.tags[i];
+    for (size_t i = 0; i < cook__stats.sites_len; i++) all[n++] = &cook__stats.sites[i];
+    for (size_t i = 0; i < n; i++) {
+        all[i]->allocs = 0;
+        all[i]->reallocs = 0;
+        all[i]->frees = 0;
+        all[i]->bytes = 0;
+        all[i]->copy_bytes = 0;
+        all[i]->peak_bytes = all[i]->live_bytes;
+    }
+    cook__spin_unlock(&cook__stats.lock);
 }
 
-COOKDEF cook_string_view_t cook_sv_from_cstr(const char *cstr) {
-    return (cook_string_view_t) {
-        .data = cstr,
-        .len = cstr ? strlen(cstr) : 0
-    };
+#endif // COOK_ALLOC_STATS
+
+// slab header, padded so objects behind it keep max alignment
+struct cook_pool_slab {
+    cook_pool_slab_t *next;
+    size_t pad;
+};
+
+#define cook__pool_next(obj) (*(void **)(obj))
+
+// cook__pool_add_slab - allocate a new slab and thread it on the free list
+// @pool: pointer to pool (lock held)
+static void cook__pool_add_slab(cook_pool_t *pool) {
+    cook_pool_slab_t *slab = COOK__ALLOC(sizeof(*slab) + pool->obj_size*pool->slab_objs, "pool");
+    COOK_ASSERT(slab != NULL && "out of memory");
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+
+    // link back to front so the free list hands out objects in address order
+    char *base = (char *)(slab + 1);
+    for (size_t i = pool->slab_objs; i > 0; i--) {
+        void *obj = base + (i-1)*pool->obj_size;
+        cook__pool_next(obj) = pool->free_list;
+        pool->free_list = obj;
+    }
+    pool->total += pool->slab_objs;
 }
 
-COOKDEF cook_string_view_t cook_sv_from_parts(const char *data, size_t len) {
-    return (cook_string_view_t) {
-        .data = data,
-        .len = len
-    };
+static void *cook__pool_alloc(cook_allocator_t *a, size_t size) {
+    cook_pool_t *pool = a->ctx;
+    if (size > pool->obj_size) return NULL;
+    return cook_pool_alloc(pool);
 }
 
-COOKDEF bool cook_sv_equal(cook_string_view_t a, cook_string_view_t b) {
-    if (a.len == b.len && memcmp(a.data, b.data, a.len) == 0) {
-        return true;
-    } else {
-        return false;
-    }
+static void *cook__pool_realloc(cook_allocator_t *a, void *ptr, size_t old_size, size_t new_size) {
+    cook_pool_t *pool = a->ctx;
+    (void) old_size;
+    if (new_size > pool->obj_size) return NULL;
+    return ptr ? ptr : cook_pool_alloc(pool);
 }
 
-COOKDEF bool cook_sv_starts_with(cook_string_view_t sv, cook_string_view_t prefix) {
-    if (prefix.len > sv.len) return false;
-    return memcmp(sv.data, prefix.data, prefix.len) == 0;
+static void cook__pool_free(cook_allocator_t *a, void *ptr, size_t size) {
+    (void) size;
+    cook_pool_free(a->ctx, ptr);
 }
 
-COOKDEF bool cook_sv_ends_with(cook_string_view_t sv, cook_string_view_t postfix) {
-    if (postfix.len > sv.len) return false;
-    size_t offset = sv.len - postfix.len;
-    return memcmp(sv.data + offset, postfix.data, postfix.len) == 0;
+COOKDEF void cook_pool_init(cook_pool_t *pool, size_t obj_size, size_t slab_objs) {
+    if (obj_size < sizeof(void*)) obj_size = sizeof(void*);
+    pool->obj_size = COOK_ALIGN_UP(obj_size, sizeof(void*));
+    pool->slab_objs = slab_objs ? slab_objs : COOK_POOL_SLAB_OBJS;
+    pool->slabs = NULL;
+    pool->free_list = NULL;
+    pool->live = 0;
+    pool->total = 0;
+    pool->lock = 0;
+    pool->allocator.ctx = pool;
+    pool->allocator.alloc = cook__pool_alloc;
+    pool->allocator.realloc = cook__pool_realloc;
+    pool->allocator.free = cook__pool_free;
 }
 
-COOKDEF bool cook_sv_empty(cook_string_view_t sv) {
-    return sv.data == NULL || sv.len == 0;
+COOKDEF void cook_pool_destroy(cook_pool_t *pool) {
+    cook_pool_slab_t *slab = pool->slabs;
+    while (slab) {
+        cook_pool_slab_t *next = slab->next;
+        COOK__FREE(slab);
+        slab = next;
+    }
+    pool->slabs = NULL;
+    pool->free_list = NULL;
+    pool->live = 0;
+    pool->total = 0;
 }
 
-COOKDEF cook_string_view_t cook_sv_slice(cook_string_view_t sv, size_t begin, size_t end) {
-    cook_string_view_t res = {0};
+COOKDEF void *cook_pool_alloc(cook_pool_t *pool) {
+    cook__spin_lock(&pool->lock);
+    if (!pool->free_list) cook__pool_add_slab(pool);
+    void *obj = pool->free_list;
+    pool->free_list = cook__pool_next(obj);
+    pool->live++;
+    cook__spin_unlock(&pool->lock);
+    return obj;
+}
 
-    if (begin >= end || end - begin > sv.len) return res;
-    res.data = sv.data + begin;
-    res.len = end - begin;
-    return res;
+COOKDEF void cook_pool_free(cook_pool_t *pool, void *ptr) {
+    if (!ptr) return;
+    cook__spin_lock(&pool->lock);
+    cook__pool_next(ptr) = pool->free_list;
+    pool->free_list = ptr;
+    pool->live--;
+    cook__spin_unlock(&pool->lock);
 }
 
-COOKDEF cook_string_view_t cook_sv_ltrim(cook_string_view_t sv) {
-    cook_string_view_t res = {0};
-    for (size_t i = 0; i < sv.len; i++) {
-        if (sv.data[i] == ' ' || sv.data[i] == '\t') continue;
-        res.data = sv.data + i;
-        res.len = sv.len - i;
-        break;
+COOKDEF void cook_pool_free_bulk(cook_pool_t *pool, void **ptrs, size_t n) {
+    cook__spin_lock(&pool->lock);
+    for (size_t i = 0; i < n; i++) {
+        if (!ptrs[i]) continue;
+        cook__pool_next(ptrs[i]) = pool->free_list;
+        pool->free_list = ptrs[i];
+        pool->live--;
     }
-    return res;
+    cook__spin_unlock(&pool->lock);
 }
 
-COOKDEF cook_string_view_t cook_sv_rtrim(cook_string_view_t sv) {
-    cook_string_view_t res = {0};
-    for (size_t i = sv.len; i > 0; i--) {
-        if (sv.data[i-1] == ' ' || sv.data[i-1] == '\t') continue;
-        res.data = sv.data;
-        res.len = i;
-        break;
+COOKDEF void cook_pool_reset(cook_pool_t *pool) {
+    cook__spin_lock(&pool->lock);
+    pool->free_list = NULL;
+    for (cook_pool_slab_t *slab = pool->slabs; slab; slab = slab->next) {
+        char *base = (char *)(slab + 1);
+        for (size_t i = pool->slab_objs; i > 0; i--) {
+            void *obj = base + (i-1)*pool->obj_size;
+            cook__pool_next(obj) = pool->free_list;
+            pool->free_list = obj;
+        }
     }
-    return res;
+    pool->live = 0;
+    cook__spin_unlock(&pool->lock);
 }
 
-COOKDEF cook_string_view_t cook_sv_trim(cook_string_view_t sv) {
-    cook_string_view_t res;
-    res = cook_sv_ltrim(sv);
-    res = cook_sv_rtrim(res);
-    return res;
+COOKDEF cook_allocator_t *cook_pool_allocator(cook_pool_t *pool) {
+    return &pool->allocator;
 }
 
-COOKDEF cook_string_view_t cook_sv_chomp(cook_string_view_t sv) {
-    cook_string_view_t res = {0};
-    for (size_t i = sv.len; i > 0; i--) {
-        if (sv.data[i-1] == '\n' || sv.data[i-1] == '\r') continue;
-        res.data = sv.data;
-        res.len = i;
-        break;
+COOKDEF void cook_pool_cache_init(cook_pool_cache_t *cache, cook_pool_t *pool) {
+    cache->pool = pool;
+    cache->free_list = NULL;
+    cache->count = 0;
+}
+
+COOKDEF void *cook_pool_cache_alloc(cook_pool_cache_t *cache) {
+    if (!cache->free_list) {
+        // refill a whole batch under one lock
+        cook_pool_t *pool = cache->pool;
+        cook__spin_lock(&pool->lock);
+        for (size_t i = 0; i < COOK_POOL_CACHE_BATCH; i++) {
+            if (!pool->free_list) cook__pool_add_slab(pool);
+            void *obj = pool->free_list;
+            pool->free_list = cook__pool_next(obj);
+            cook__pool_next(obj) = cache->free_list;
+            cache->free_list = obj;
+        }
+        pool->live += COOK_POOL_CACHE_BATCH;
+        cook__spin_unlock(&pool->lock);
+        cache->count = COOK_POOL_CACHE_BATCH;
     }
-    return res;
+    void *obj = cache->free_list;
+    cache->free_list = cook__pool_next(obj);
+    cache->count--;
+    return obj;
 }
 
-COOKDEF void cook_sb_append_sv(cook_string_builder_t *sb, cook_string_view_t sv) {
-    cook_sb_append_parts(sb, sv.data, sv.len);
+COOKDEF void cook_pool_cache_free(cook_pool_cache_t *cache, void *ptr) {
+    if (!ptr) return;
+    cook__pool_next(ptr) = cache->free_list;
+    cache->free_list = ptr;
+    cache->count++;
+    if (cache->count < 2*COOK_POOL_CACHE_BATCH) return;
+
+    // too many cached objects, hand a batch back to the pool
+    cook_pool_t *pool = cache->pool;
+    cook__spin_lock(&pool->lock);
+    for (size_t i = 0; i < COOK_POOL_CACHE_BATCH; i++) {
+        void *obj = cache->free_list;
+        cache->free_list = cook__pool_next(obj);
+        cook__pool_next(obj) = pool->free_list;
+        pool->free_list = obj;
+    }
+    pool->live -= COOK_POOL_CACHE_BATCH;
+    cook__spin_unlock(&pool->lock);
+    cache->count -= COOK_POOL_CACHE_BATCH;
 }
 
-COOKDEF void cook_sb_append_parts(cook_string_builder_t *sb, const void *data, size_t len) {
-    if (sb->len + 1 > sb->cap) cook_vec_grow(sb);
-    memcpy(cook_vec_end(sb), data, len);
-    sb->len += len;
+COOKDEF void cook_pool_cache_flush(cook_pool_cache_t *cache) {
+    if (!cache->free_list) return;
+    cook_pool_t *pool = cache->pool;
+    cook__spin_lock(&pool->lock);
+    while (cache->free_list) {
+        void *obj = cache->free_list;
+        cache->free_list = cook__pool_next(obj);
+        cook__pool_next(obj) = pool->free_list;
+        pool->free_list = obj;
+    }
+    pool->live -= cache->count;
+    cook__spin_unlock(&pool->lock);
+    cache->count = 0;
 }
 
-COOKDEF void cook_sb_reset(cook_string_builder_t *sb) {
-    cook_vec_reset(sb);
+#define COOK__SC_CLASSES 40
+#define COOK__SC_HEADER  64
+#define COOK__SC_LARGE   0xffffffffu
+
+// span header, lives in the first COOK__SC_HEADER bytes of every span and
+// of every large mapping, found from any pointer by masking its low bits
+typedef struct {
+    unsigned int cls;
+    size_t size;        // large: usable size
+    void *raw;          // what to give back to the system
+    size_t raw_size;
+} cook__sc_span_t;
+
+typedef struct {
+    volatile long lock;
+    void *free_list;
+    size_t free_count;
+    size_t carved;          // objects cut from spans
+    long long in_use;       // published by thread caches
+    size_t allocs;          // published by thread caches
+    size_t requested;       // bytes asked for, published by thread caches
+} cook__sc_central_t;
+
+typedef struct {
+    void *list[COOK__SC_CLASSES];
+    size_t count[COOK__SC_CLASSES];
+    long long in_use[COOK__SC_CLASSES];
+    size_t allocs[COOK__SC_CLASSES];
+    size_t requested[COOK__SC_CLASSES];
+} cook__sc_cache_t;
+
+static COOK_CACHELINE_PADDED(cook__sc_central_t) cook__sc_central[COOK__SC_CLASSES];
+static COOK_THREAD_LOCAL cook__sc_cache_t cook__sc_cache;
+static struct {
+    volatile long lock;
+    size_t spans;
+    size_t count;
+    size_t bytes;
+} cook__sc_large;
+
+// cook__log2_floor - index of the highest set bit of a non-zero value
+static unsigned int cook__log2_floor(size_t n) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned int)(sizeof(unsigned long long)*8 - 1 - __builtin_clzll((unsigned long long)n));
+#else
+    unsigned int r = 0;
+    while (n >>= 1) r++;
+    return r;
+#endif
 }
 
-COOKDEF void cook_sb_free(cook_string_builder_t *sb) {
-    cook_vec_free(sb);
+// cook__sc_class_of - size class of a small request
+static size_t cook__sc_class_of(size_t size) {
+    if (size <= 128) return size ? (size - 1) >> 4 : 0;
+    unsigned int p = cook__log2_floor(size - 1); // size in (2^p, 2^(p+1)]
+    return 8 + (p - 7)*4 + ((size - 1 - ((size_t)1 << p)) >> (p - 2));
 }
 
-COOKDEF cook_string_view_t cook_sb_view(const cook_string_builder_t *sb) {
-    return (cook_string_view_t) {
-        .data = sb->items,
-        .len = sb->len
-    };
+// cook__sc_class_size - object size of a size class
+static size_t cook__sc_class_size(size_t cls) {
+    if (cls < 8) return 16*(cls + 1);
+    size_t k = cls - 8, p = 7 + k/4;
+    return ((size_t)1 << p) + (k%4 + 1)*((size_t)1 << (p - 2));
 }
 
-static unsigned char _temp_buffer[COOK_TEMP_BUFFER_CAP] = {0};
-static size_t _temp_buffer_used = 0;
+// cook__sc_batch - how many objects move between a cache and the depot at once
+static size_t cook__sc_batch(size_t cls) {
+    size_t n = 16*1024/cook__sc_class_size(cls);
+    return n < 4 ? 4 : (n > 64 ? 64 : n);
+}
 
-COOKDEF void *cook_temp_alloc(size_t size) {
-    if (size == 0) return NULL;
-    size_t aligned_used = COOK_ALIGN_UP(_temp_buffer_used, sizeof(void*));
-    if (aligned_used + size > COOK_TEMP_BUFFER_CAP) return NULL;
-    void *ptr = _temp_buffer + aligned_used;
-    _temp_buffer_used = aligned_used + size;
-    return ptr;
+// cook__sc_map - get @size bytes aligned to COOK_SC_SPAN_SIZE from the system
+// @size: size in bytes, multiple of COOK_PAGE_SIZE
+//
+// Note: stays off COOK_ALLOC, which may very well be this allocator
+static cook__sc_span_t *cook__sc_map(size_t size) {
+#ifdef COOK__HAS_MMAP
+    size_t over = size + COOK_SC_SPAN_SIZE;
+    char *raw = mmap(NULL, over, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) return NULL;
+    char *ptr = (char *)COOK_ALIGN_UP((uintptr_t)raw, (uintptr_t)COOK_SC_SPAN_SIZE);
+    if (ptr > raw) munmap(raw, ptr - raw);
+    if (raw + over > ptr + size) munmap(ptr + size, raw + over - (ptr + size));
+    cook__sc_span_t *span = (cook__sc_span_t *)ptr;
+    span->raw = ptr;
+    span->raw_size = size;
+#else
+    // the C library aligns without the slack of over-allocating by a span
+#  ifdef _WIN32
+    void *raw = _aligned_malloc(size, COOK_SC_SPAN_SIZE);
+    if (!raw) return NULL;
+#  else
+    void *raw = NULL;
+    if (posix_memalign(&raw, COOK_SC_SPAN_SIZE, size) != 0) return NULL;
+#  endif
+    cook__sc_span_t *span = (cook__sc_span_t *)raw;
+    span->raw = raw;
+    span->raw_size = size;
+#endif
+    return span;
 }
 
-COOKDEF size_t cook_temp_save(void) {
-    return _temp_buffer_used;
+// cook__sc_unmap - give a mapping from cook__sc_map() back
+static void cook__sc_unmap(cook__sc_span_t *span) {
+#ifdef COOK__HAS_MMAP
+    munmap(span->raw, span->raw_size);
+#elif defined(_WIN32)
+    _aligned_free(span->raw);
+#else
+    free(span->raw);
+#endif
 }
 
-COOKDEF void cook_temp_rewind(size_t checkpoint) {
-    _temp_buffer_used = checkpoint;
+// cook__sc_publish - move a cache's counters of one class to the depot (lock held)
+static void cook__sc_publish(cook__sc_cache_t *cache, cook__sc_central_t *central, size_t cls) {
+    central->in_use += cache->in_use[cls];
+    central->allocs += cache->allocs[cls];
+    central->requested += cache->requested[cls];
+    cache->in_use[cls] = 0;
+    cache->allocs[cls] = 0;
+    cache->requested[cls] = 0;
 }
 
-COOKDEF void cook_temp_reset(void) {
-    _temp_buffer_used = 0;
+// cook__sc_refill - move a batch of objects from the depot into the cache
+static bool cook__sc_refill(cook__sc_cache_t *cache, size_t cls) {
+    cook__sc_central_t *central = &cook__sc_central[cls].value;
+    size_t batch = cook__sc_batch(cls);
+    size_t obj_size = cook__sc_class_size(cls);
+
+    cook__spin_lock(&central->lock);
+    cook__sc_publish(cache, central, cls);
+    while (central->free_count < batch) {
+        cook__sc_span_t *span = cook__sc_map(COOK_SC_SPAN_SIZE);
+        if (!span) break;
+        span->cls = (unsigned int)cls;
+        span->size = obj_size;
+        size_t n = (COOK_SC_SPAN_SIZE - COOK__SC_HEADER)/obj_size;
+        char *base = (char *)span + COOK__SC_HEADER;
+        for (size_t i = n; i > 0; i--) {
+            void *obj = base + (i-1)*obj_size;
+            *(void **)obj = central->free_list;
+            central->free_list = obj;
+        }
+        central->free_count += n;
+        central->carved += n;
+    }
+    size_t n = central->free_count < batch ? central->free_count : batch;
+    for (size_t i = 0; i < n; i++) {
+        void *obj = central->free_list;
+        central->free_list = *(void **)obj;
+        *(void **)obj = cache->list[cls];
+        cache->list[cls] = obj;
+    }
+    central->free_count -= n;
+    cook__spin_unlock(&central->lock);
+
+    cache->count[cls] += n;
+    return n > 0;
 }
 
-COOKDEF const char *cook_temp_strdup(const char *cstr) {
-    return cook_temp_strsub(cstr, 0, strlen(cstr) + 1);
+// cook__sc_spill - move @n objects from the cache back to the depot
+static void cook__sc_spill(cook__sc_cache_t *cache, size_t cls, size_t n) {
+    cook__sc_central_t *central = &cook__sc_central[cls].value;
+    cook__spin_lock(&central->lock);
+    cook__sc_publish(cache, central, cls);
+    for (size_t i = 0; i < n; i++) {
+        void *obj = cache->list[cls];
+        cache->list[cls] = *(void **)obj;
+        *(void **)obj = central->free_list;
+        central->free_list = obj;
+    }
+    central->free_count += n;
+    cook__spin_unlock(&central->lock);
+    cache->count[cls] -= n;
 }
 
-COOKDEF const char *cook_temp_strndup(const char *cstr, size_t n) {
-    return cook_temp_strsub(cstr, 0, n);
+static void *cook__sc_large_alloc(size_t size) {
+    if (size > SIZE_MAX - COOK__SC_HEADER - COOK_PAGE_SIZE) return NULL;
+    size_t map_size = COOK_ALIGN_UP(size + COOK__SC_HEADER, (size_t)COOK_PAGE_SIZE);
+    cook__sc_span_t *span = cook__sc_map(map_size);
+    if (!span) return NULL;
+    span->cls = COOK__SC_LARGE;
+    span->size = map_size - COOK__SC_HEADER;
+
+    cook__spin_lock(&cook__sc_large.lock);
+    cook__sc_large.count++;
+    cook__sc_large.spans++;
+    cook__sc_large.bytes += span->size;
+    cook__spin_unlock(&cook__sc_large.lock);
+    return (char *)span + COOK__SC_HEADER;
 }
 
-COOKDEF const char *cook_temp_strsub(const char *cstr, size_t begin, size_t end) {
-    if (!cstr || begin >= end) return NULL;
+static void cook__sc_large_free(cook__sc_span_t *span) {
+    cook__spin_lock(&cook__sc_large.lock);
+    cook__sc_large.spans--;
+    cook__sc_large.bytes -= span->size;
+    cook__spin_unlock(&cook__sc_large.lock);
+    cook__sc_unmap(span);
+}
 
-    size_t sub_len = end - begin;
-    char *ptr = cook_temp_alloc(sub_len + 1);
-    COOK_ASSERT(ptr != NULL && "out of temporary buffer");
+// cook__sc_span_of - find the header of the span holding @ptr
+#define cook__sc_span_of(ptr) \
+    ((cook__sc_span_t *)COOK_ALIGN_DOWN((uintptr_t)(ptr), (uintptr_t)COOK_SC_SPAN_SIZE))
 
-    for (size_t i = 0; i < sub_len ; i++) {
-        ptr[i] = cstr[begin + i];
-    }
-    ptr[sub_len] = '\0';
+COOKDEF void *cook_sc_malloc(size_t size) {
+    if (size > COOK_SC_MAX_SMALL) return cook__sc_large_alloc(size);
 
-    return ptr;
+    size_t cls = cook__sc_class_of(size);
+    cook__sc_cache_t *cache = &cook__sc_cache;
+    if (!cache->list[cls] && !cook__sc_refill(cache, cls)) return NULL;
+
+    void *obj = cache->list[cls];
+    cache->list[cls] = *(void **)obj;
+    cache->count[cls]--;
+    cache->in_use[cls]++;
+    cache->allocs[cls]++;
+    cache->requested[cls] += size;
+    return obj;
 }
 
-COOKDEF const char *cook_temp_strfmt(const char *fmt, ...) {
-    if (!fmt) return NULL;
+COOKDEF void cook_sc_free(void *ptr) {
+    if (!ptr) return;
+    cook__sc_span_t *span = cook__sc_span_of(ptr);
+    if (span->cls == COOK__SC_LARGE) {
+        cook__sc_large_free(span);
+        return;
+    }
 
-    va_list args;
+    size_t cls = span->cls;
+    cook__sc_cache_t *cache = &cook__sc_cache;
+    *(void **)ptr = cache->list[cls];
+    cache->list[cls] = ptr;
+    cache->count[cls]++;
+    cache->in_use[cls]--;
 
-    va_start(args, fmt);
-    int len = vsnprintf(NULL, 0, fmt, args);
-    va_end(args);
-    if (len < 0) return NULL;
+    size_t batch = cook__sc_batch(cls);
+    if (cache->count[cls] > 2*batch) cook__sc_spill(cache, cls, batch);
+}
 
-    void *ptr = cook_temp_alloc((size_t)len + 1);
-    COOK_ASSERT(ptr != NULL && "out of temporary buffer");
+COOKDEF size_t cook_sc_usable_size(void *ptr) {
+    return cook__sc_span_of(ptr)->size;
+}
 
-    va_start(args, fmt);
-    vsnprintf(ptr, (size_t)len + 1, fmt, args);
-    va_end(args);
+COOKDEF void *cook_sc_realloc(void *ptr, size_t size) {
+    if (!ptr) return cook_sc_malloc(size);
+    if (size == 0) {
+        cook_sc_free(ptr);
+        return NULL;
+    }
 
-    return ptr;
+    cook__sc_span_t *span = cook__sc_span_of(ptr);
+    if (span->cls == COOK__SC_LARGE) {
+        // keep the mapping unless it would waste more than half of it
+        if (size > COOK_SC_MAX_SMALL && size <= span->size && size > span->size/2) return ptr;
+    } else if (size <= COOK_SC_MAX_SMALL && cook__sc_class_of(size) == span->cls) {
+        return ptr;
+    }
+
+    void *new_ptr = cook_sc_malloc(size);
+    if (!new_ptr) return NULL;
+    memcpy(new_ptr, ptr, span->size < size ? span->size : size);
+    cook_sc_free(ptr);
+    return new_ptr;
 }
 
-COOKDEF const char *cook_temp_sv_to_cstr(cook_string_view_t sv) {
-    char *ptr = cook_temp_alloc(sv.len + 1);
-    COOK_ASSERT(ptr != NULL && "out of temporary buffer");
-    memcpy(ptr, sv.data, sv.len);
-    ptr[sv.len] = '\0';
-    return ptr;
+COOKDEF void cook_sc_thread_flush(void) {
+    cook__sc_cache_t *cache = &cook__sc_cache;
+    for (size_t cls = 0; cls < COOK__SC_CLASSES; cls++) {
+        if (!cache->count[cls] && !cache->allocs[cls] && !cache->in_use[cls]) continue;
+        cook__sc_spill(cache, cls, cache->count[cls]);
+    }
 }
 
-COOKDEF const char *cook_temp_path_join(const char *path1, const char *path2) {
-    if (!path1 || !*path1) return cook_temp_strdup(path2 ? path2 : "");
-    if (!path2 || !*path2) return cook_temp_strdup(path1);
+COOKDEF void cook_sc_report(void) {
+    size_t total_mapped = 0, total_used = 0, total_requested = 0, total_free = 0;
 
-    size_t len1 = strlen(path1);
-    bool has_sep1 = len1 > 0 && (path1[len1 - 1] == '/' || path1[len1 - 1] == '\\');
-    bool has_sep2 = path2[0] == '/' || path2[0] == '\\';
+    printf("-------------------------------------------------\n");
+    printf("Size-class allocator report:\n");
+    printf("%8s %10s %10s %10s %10s %12s %10s %8s\n",
+           "class", "carved", "in use", "depot", "cached", "allocs", "avg req", "waste");
+    for (size_t cls = 0; cls < COOK__SC_CLASSES; cls++) {
+        cook__sc_central_t *central = &cook__sc_central[cls].value;
+        cook__spin_lock(&central->lock);
+        cook__sc_central_t c = *central;
+        cook__spin_unlock(&central->lock);
+        if (c.carved == 0) continue;
+
+        size_t obj_size = cook__sc_class_size(cls);
+        size_t in_use = c.in_use > 0 ? (size_t)c.in_use : 0;
+        size_t cached = c.carved - c.free_count - in_use;
+        double avg = c.allocs ? (double)c.requested/c.allocs : 0.0;
+        // internal fragmentation: what rounding up to the class costs
+        double waste = c.allocs ? 100.0*(1.0 - avg/obj_size) : 0.0;
+        printf("%8zu %10zu %10zu %10zu %10zu %12zu %10.1f %7.1f%%\n",
+               obj_size, c.carved, in_use, c.free_count, cached, c.allocs, avg, waste);
+
+        size_t spans = (c.carved + (COOK_SC_SPAN_SIZE - COOK__SC_HEADER)/obj_size - 1)
+                       / ((COOK_SC_SPAN_SIZE - COOK__SC_HEADER)/obj_size);
+        total_mapped += spans*COOK_SC_SPAN_SIZE;
+        total_used += in_use*obj_size;
+        total_requested += (size_t)(avg*in_use);
+        total_free += (c.carved - in_use)*obj_size;
+    }
 
-    size_t total_len = len1 + strlen(path2) + 2;
-    char *buffer = cook_temp_alloc(total_len);
-    if (!buffer) return NULL;
+    cook__spin_lock(&cook__sc_large.lock);
+    printf("large: %zu live mappings, %zu bytes, %zu allocated so far\n",
+           cook__sc_large.spans, cook__sc_large.bytes, cook__sc_large.count);
+    cook__spin_unlock(&cook__sc_large.lock);
 
-    strcpy(buffer, path1);
+    printf("spans: %zu bytes mapped, %zu in use (~%zu requested), %zu free\n",
+           total_mapped, total_used, total_requested, total_free);
+    if (total_mapped) {
+        printf("external fragmentation: %.1f%% of span memory is free\n",
+               100.0*(double)total_free/total_mapped);
+    }
+    printf("-------------------------------------------------\n");
+}
 
-    if (!has_sep1 && !has_sep2) {
-        // need separator
-#ifdef _WIN32
-        strcat(buffer, "\\");
+#define COOK__TLSF_ALIGN       16
+#define COOK__TLSF_SL_LOG2     5
+#define COOK__TLSF_SL_COUNT    (1 << COOK__TLSF_SL_LOG2)
+#define COOK__TLSF_FL_SHIFT    (COOK__TLSF_SL_LOG2 + 4) // 4 = log2(align)
+#define COOK__TLSF_FL_MAX      40                        // blocks up to 1 TB
+#define COOK__TLSF_FL_COUNT    (COOK__TLSF_FL_MAX - COOK__TLSF_FL_SHIFT + 1)
+#define COOK__TLSF_SMALL_BLOCK ((size_t)1 << COOK__TLSF_FL_SHIFT)
+#define COOK__TLSF_MAX_BLOCK   (((size_t)1 << COOK__TLSF_FL_MAX) - 1)
+
+#define COOK__TLSF_FREE      ((size_t)1)
+#define COOK__TLSF_PREV_FREE ((size_t)2)
+#define COOK__TLSF_FLAGS     (COOK__TLSF_FREE | COOK__TLSF_PREV_FREE)
+
+// block header, the payload starts right after it; the free list links
+// overlay the payload of free blocks
+typedef struct cook__tlsf_block cook__tlsf_block_t;
+struct cook__tlsf_block {
+    cook__tlsf_block_t *prev_phys;
+    size_t size; // payload size | flags
+    cook__tlsf_block_t *next_free;
+    cook__tlsf_block_t *prev_free;
+};
+
+#define COOK__TLSF_HEADER   (2*sizeof(size_t))
+#define COOK__TLSF_MIN_SIZE (2*sizeof(void*))
+
+struct cook_tlsf {
+    unsigned int fl_bitmap;
+    unsigned int sl_bitmap[COOK__TLSF_FL_COUNT];
+    cook__tlsf_block_t *blocks[COOK__TLSF_FL_COUNT][COOK__TLSF_SL_COUNT];
+    cook_allocator_t allocator;
+};
+
+// cook__tlsf_ffs - index of the lowest set bit of a non-zero word
+static int cook__tlsf_ffs(unsigned int word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(word);
 #else
-        strcat(buffer, "/");
+    int r = 0;
+    while (!(word & 1)) { word >>= 1; r++; }
+    return r;
 #endif
-        strcat(buffer, path2);
-    } else if (has_sep1 && has_sep2) {
-        // skip leading separator in path2
-        strcat(buffer, path2 + 1);
+}
+
+#define cook__tlsf_size(b)     ((b)->size & ~COOK__TLSF_FLAGS)
+#define cook__tlsf_payload(b)  ((void *)((char *)(b) + COOK__TLSF_HEADER))
+#define cook__tlsf_from_ptr(p) ((cook__tlsf_block_t *)((char *)(p) - COOK__TLSF_HEADER))
+#define cook__tlsf_next(b)     ((cook__tlsf_block_t *)((char *)(b) + COOK__TLSF_HEADER + cook__tlsf_size(b)))
+
+static void cook__tlsf_set_size(cook__tlsf_block_t *b, size_t size) {
+    b->size = size | (b->size & COOK__TLSF_FLAGS);
+}
+
+// cook__tlsf_mapping - first/second level bin of a block size
+static void cook__tlsf_mapping(size_t size, int *fl, int *sl) {
+    if (size < COOK__TLSF_SMALL_BLOCK) {
+        *fl = 0;
+        *sl = (int)(size/(COOK__TLSF_SMALL_BLOCK/COOK__TLSF_SL_COUNT));
     } else {
-        // directly concatenate
-        strcat(buffer, path2);
+        int f = (int)cook__log2_floor(size);
+        *sl = (int)(size >> (f - COOK__TLSF_SL_LOG2)) ^ COOK__TLSF_SL_COUNT;
+        *fl = f - (COOK__TLSF_FL_SHIFT - 1);
     }
+}
 
-    return buffer;
+// cook__tlsf_remove - unlink a free block from its bin
+static void cook__tlsf_remove(cook_tlsf_t *t, cook__tlsf_block_t *b) {
+    int fl, sl;
+    cook__tlsf_mapping(cook__tlsf_size(b), &fl, &sl);
+    if (b->prev_free) b->prev_free->next_free = b->next_free;
+    if (b->next_free) b->next_free->prev_free = b->prev_free;
+    if (t->blocks[fl][sl] == b) {
+        t->blocks[fl][sl] = b->next_free;
+        if (!b->next_free) {
+            t->sl_bitmap[fl] &= ~(1u << sl);
+            if (!t->sl_bitmap[fl]) t->fl_bitmap &= ~(1u << fl);
+        }
+    }
 }
 
-COOKDEF const char *cook_temp_path_dirname(const char *path) {
-    if (!path || !*path) return "./";
+// cook__tlsf_insert - put a free block at the head of its bin
+static void cook__tlsf_insert(cook_tlsf_t *t, cook__tlsf_block_t *b) {
+    int fl, sl;
+    cook__tlsf_mapping(cook__tlsf_size(b), &fl, &sl);
+    cook__tlsf_block_t *head = t->blocks[fl][sl];
+    b->prev_free = NULL;
+    b->next_free = head;
+    if (head) head->prev_free = b;
+    t->blocks[fl][sl] = b;
+    t->fl_bitmap |= 1u << fl;
+    t->sl_bitmap[fl] |= 1u << sl;
+}
 
-    // find last separator
-    const char *last_sep = NULL;
-    const char *p = path;
-    while (*p) {
-        if (*p == '/' || *p == '\\') last_sep = p;
-        p++;
+// cook__tlsf_mark_free - flag a block free and tell its physical successor
+static void cook__tlsf_mark_free(cook__tlsf_block_t *b) {
+    cook__tlsf_block_t *next = cook__tlsf_next(b);
+    b->size |= COOK__TLSF_FREE;
+    next->prev_phys = b;
+    next->size |= COOK__TLSF_PREV_FREE;
+}
+
+// cook__tlsf_mark_used - flag a block used and tell its physical successor
+static void cook__tlsf_mark_used(cook__tlsf_block_t *b) {
+    b->size &= ~COOK__TLSF_FREE;
+    cook__tlsf_next(b)->size &= ~COOK__TLSF_PREV_FREE;
+}
+
+// cook__tlsf_split - cut the tail beyond @size off a block and free it
+// @b: block whose payload is at least @size
+static void cook__tlsf_split(cook_tlsf_t *t, cook__tlsf_block_t *b, size_t size) {
+    size_t total = cook__tlsf_size(b);
+    if (total < size + COOK__TLSF_HEADER + COOK__TLSF_MIN_SIZE) return;
+
+    cook__tlsf_block_t *rest = (cook__tlsf_block_t *)((char *)cook__tlsf_payload(b) + size);
+    rest->size = total - size - COOK__TLSF_HEADER;
+    rest->prev_phys = b;
+    cook__tlsf_set_size(b, size);
+
+    // the tail may touch a free block (after realloc shrink), keep them merged
+    cook__tlsf_block_t *next = cook__tlsf_next(rest);
+    if (next->size & COOK__TLSF_FREE) {
+        cook__tlsf_remove(t, next);
+        rest->size += COOK__TLSF_HEADER + cook__tlsf_size(next);
     }
+    cook__tlsf_mark_free(rest);
+    cook__tlsf_insert(t, rest);
+}
 
-    // no separator found
-    if (!last_sep) return "./";
+// cook__tlsf_adjust - round a request to a valid block size, 0 if too large
+static size_t cook__tlsf_adjust(size_t size) {
+    if (size > COOK__TLSF_MAX_BLOCK) return 0;
+    size = COOK_ALIGN_UP(size, (size_t)COOK__TLSF_ALIGN);
+    return size < COOK__TLSF_MIN_SIZE ? COOK__TLSF_MIN_SIZE : size;
+}
 
-    // copy directory part
-    size_t dir_len = last_sep - path + 1;
-    char *result = cook_temp_alloc(dir_len + 1);
-    if (!result) return NULL;
+static void *cook__tlsf_alloc_cb(cook_allocator_t *a, size_t size) {
+    return cook_tlsf_malloc(a->ctx, size);
+}
 
-    memcpy(result, path, dir_len);
-    result[dir_len] = '\0';
-    return result;
+static void *cook__tlsf_realloc_cb(cook_allocator_t *a, void *ptr, size_t old_size, size_t new_size) {
+    (void) old_size;
+    return cook_tlsf_realloc(a->ctx, ptr, new_size);
 }
 
-COOKDEF const char *cook_temp_path_basename(const char *path) {
-    if (!path || !*path) return "";
+static void cook__tlsf_free_cb(cook_allocator_t *a, void *ptr, size_t size) {
+    (void) size;
+    cook_tlsf_free(a->ctx, ptr);
+}
 
-    // find last separator
-    const char *last_sep = NULL;
-    const char *p = path;
-    while (*p) {
-        if (*p == '/' || *p == '\\') last_sep = p;
-        p++;
+COOKDEF cook_tlsf_t *cook_tlsf_create(void *mem, size_t size) {
+    uintptr_t begin = COOK_ALIGN_UP((uintptr_t)mem, (uintptr_t)COOK__TLSF_ALIGN);
+    uintptr_t end = COOK_ALIGN_DOWN((uintptr_t)mem + size, (uintptr_t)COOK__TLSF_ALIGN);
+    size_t control = COOK_ALIGN_UP(sizeof(cook_tlsf_t), (size_t)COOK__TLSF_ALIGN);
+    size_t overhead = control + 2*COOK__TLSF_HEADER + COOK__TLSF_MIN_SIZE;
+    if (end <= begin || end - begin < overhead) return NULL;
+
+    cook_tlsf_t *t = (cook_tlsf_t *)begin;
+    memset(t, 0, sizeof(*t));
+    t->allocator.ctx = t;
+    t->allocator.alloc = cook__tlsf_alloc_cb;
+    t->allocator.realloc = cook__tlsf_realloc_cb;
+    t->allocator.free = cook__tlsf_free_cb;
+
+    // one big free block, then a used zero-size sentinel that stops merging
+    size_t payload = end - begin - control - 2*COOK__TLSF_HEADER;
+    if (payload > COOK__TLSF_MAX_BLOCK) payload = COOK_ALIGN_DOWN(COOK__TLSF_MAX_BLOCK, (size_t)COOK__TLSF_ALIGN);
+    cook__tlsf_block_t *b = (cook__tlsf_block_t *)(begin + control);
+    b->prev_phys = NULL;
+    b->size = payload;
+    cook__tlsf_block_t *sentinel = cook__tlsf_next(b);
+    sentinel->size = 0;
+    cook__tlsf_mark_free(b);
+    cook__tlsf_insert(t, b);
+    return t;
+}
+
+COOKDEF void *cook_tlsf_malloc(cook_tlsf_t *t, size_t size) {
+    size_t adjusted = cook__tlsf_adjust(size);
+    if (!adjusted) return NULL;
+
+    // round up to the next bin start, so any block of the found bin fits
+    size_t search = adjusted;
+    if (search >= COOK__TLSF_SMALL_BLOCK) {
+        size_t round = ((size_t)1 << (cook__log2_floor(search) - COOK__TLSF_SL_LOG2)) - 1;
+        if (search > COOK__TLSF_MAX_BLOCK - round) return NULL;
+        search += round;
     }
+    int fl, sl;
+    cook__tlsf_mapping(search, &fl, &sl);
+    if (fl >= COOK__TLSF_FL_COUNT) return NULL;
+
+    unsigned int sl_map = t->sl_bitmap[fl] & (~0u << sl);
+    if (!sl_map) {
+        unsigned int fl_map = fl + 1 < 32 ? t->fl_bitmap & (~0u << (fl + 1)) : 0;
+        if (!fl_map) return NULL;
+        fl = cook__tlsf_ffs(fl_map);
+        sl_map = t->sl_bitmap[fl];
+    }
+    sl = cook__tlsf_ffs(sl_map);
 
-    // no separator, whole path is basename
-    if (!last_sep) return cook_temp_strdup(path);
+    cook__tlsf_block_t *b = t->blocks[fl][sl];
+    cook__tlsf_remove(t, b);
+    cook__tlsf_mark_used(b);
+    cook__tlsf_split(t, b, adjusted);
+    return cook__tlsf_payload(b);
+}
 
-    // return part after last separator
-    return cook_temp_strdup(last_sep + 1);
+COOKDEF void cook_tlsf_free(cook_tlsf_t *t, void *ptr) {
+    if (!ptr) return;
+    cook__tlsf_block_t *b = cook__tlsf_from_ptr(ptr);
+    COOK_ASSERT(!(b->size & COOK__TLSF_FREE) && "double free");
+
+    if (b->size & COOK__TLSF_PREV_FREE) {
+        cook__tlsf_block_t *prev = b->prev_phys;
+        cook__tlsf_remove(t, prev);
+        cook__tlsf_set_size(prev, cook__tlsf_size(prev) + COOK__TLSF_HEADER + cook__tlsf_size(b));
+        b = prev;
+    }
+    cook__tlsf_block_t *next = cook__tlsf_next(b);
+    if (next->size & COOK__TLSF_FREE) {
+        cook__tlsf_remove(t, next);
+        cook__tlsf_set_size(b, cook__tlsf_size(b) + COOK__TLSF_HEADER + cook__tlsf_size(next));
+    }
+    cook__tlsf_mark_free(b);
+    cook__tlsf_insert(t, b);
+}
+
+COOKDEF void *cook_tlsf_realloc(cook_tlsf_t *t, void *ptr, size_t size) {
+    if (!ptr) return cook_tlsf_malloc(t, size);
+    if (size == 0) {
+        cook_tlsf_free(t, ptr);
+        return NULL;
+    }
+    size_t adjusted = cook__tlsf_adjust(size);
+    if (!adjusted) return NULL;
+
+    cook__tlsf_block_t *b = cook__tlsf_from_ptr(ptr);
+    size_t current = cook__tlsf_size(b);
+    cook__tlsf_block_t *next = cook__tlsf_next(b);
+    size_t available = current;
+    if (next->size & COOK__TLSF_FREE) available += COOK__TLSF_HEADER + cook__tlsf_size(next);
+
+    if (adjusted > available) {
+        void *fresh = cook_tlsf_malloc(t, size);
+        if (!fresh) return NULL;
+        memcpy(fresh, ptr, current);
+        cook_tlsf_free(t, ptr);
+        return fresh;
+    }
+
+    // grow into the free neighbour, or shrink, both in place
+    if (adjusted > current) {
+        cook__tlsf_remove(t, next);
+        cook__tlsf_set_size(b, available);
+        cook__tlsf_mark_used(b);
+    }
+    cook__tlsf_split(t, b, adjusted);
+    return ptr;
+}
+
+COOKDEF size_t cook_tlsf_free_bytes(cook_tlsf_t *t) {
+    size_t total = 0;
+    for (int fl = 0; fl < COOK__TLSF_FL_COUNT; fl++) {
+        for (int sl = 0; sl < COOK__TLSF_SL_COUNT; sl++) {
+            for (cook__tlsf_block_t *b = t->blocks[fl][sl]; b; b = b->next_free) {
+                total += cook__tlsf_size(b);
+            }
+        }
+    }
+    return total;
+}
+
+COOKDEF cook_allocator_t *cook_tlsf_allocator(cook_tlsf_t *t) {
+    return &t->allocator;
 }
 
 COOKDEF void cook_cmd_free(cook_cmd_t *cmd) {
@@ -1399,11 +10743,8 @@ COOKDEF void cook_cmd_print(cook_cmd_t *cmd, const char *prefix) {
 }
 
 COOKDEF bool cook_cmd_run(cook_cmd_t *cmd) {
-    if (cmd->cap == cmd->len) {
-        cook_sb_append(cmd, "");
-    } else {
-        cmd->items[cmd->len] = '\0';
-    }
+    if (cmd->cap == cmd->len) cook__vec_grow(cmd, "cmd");
+    cmd->items[cmd->len] = '\0';
     cook_cmd_print(cmd, "[INFO]");
     int status = system(cmd->items);
     if (status != 0) cook_cmd_print(cmd, "[ERROR]");
@@ -1457,11 +10798,35 @@ COOKDEF bool cook_expect_str_eq(const char *s1, const char *s2) {
 
 typedef cook_string_view_t string_view_t;
 typedef cook_string_builder_t string_builder_t;
+typedef cook_hashed_sv_t hashed_sv_t;
 typedef cook_cmd_t cmd_t;
 typedef cook_mucase_t mucase_t;
 typedef cook_musuite_t musuite_t;
 typedef cook_attr_t attr_t;
 typedef cook_dir_t dir_t;
+typedef cook_arena_t arena_t;
+typedef cook_arena_mark_t arena_mark_t;
+typedef cook_allocator_t allocator_t;
+typedef cook_pool_t pool_t;
+typedef cook_pool_cache_t pool_cache_t;
+typedef cook_tlsf_t tlsf_t;
+typedef cook_byteset_t byteset_t;
+typedef cook_sv_split_iter_t sv_split_iter_t;
+typedef cook_sv_line_iter_t sv_line_iter_t;
+typedef cook_match_t match_t;
+typedef cook_matcher_t matcher_t;
+typedef cook_match_stream_t match_stream_t;
+// no glob_t, <glob.h> has one
+typedef cook_csv_t csv_t;
+typedef cook_csv_field_t csv_field_t;
+typedef cook_csv_record_t csv_record_t;
+typedef cook_json_type_t json_type_t;
+typedef cook_json_node_t json_node_t;
+typedef cook_json_t json_t;
+// no regex_t, <regex.h> has one
+typedef cook_json_iter_t json_iter_t;
+typedef cook_rope_t rope_t;
+typedef cook_rope_iter_t rope_iter_t;
 
 #define fs_readfile    cook_fs_readfile
 #define fs_cwd         cook_fs_cwd
@@ -1487,6 +10852,10 @@ typedef cook_dir_t dir_t;
 #define vec_free     cook_vec_free
 #define vec_reset    cook_vec_reset
 #define vec_reverse  cook_vec_reverse
+#define vec_reserve_pages cook_vec_reserve_pages
+#define vec_push_pages    cook_vec_push_pages
+#define vec_free_pages    cook_vec_free_pages
+#define vec_sort_sv       cook_vec_sort_sv
 
 #define arr_len     cook_arr_len
 #define arr_foreach cook_arr_foreach
@@ -1496,8 +10865,10 @@ typedef cook_dir_t dir_t;
 #define ALIGN_DOWN   COOK_ALIGN_DOWN
 #define OFFSET_OF    COOK_OFFSET_OF
 #define CONTAINER_OF COOK_CONTAINER_OF
+#define IS_POW2      COOK_IS_POW2
 
 #define temp_alloc         cook_temp_alloc
+#define temp_alloc_aligned cook_temp_alloc_aligned
 #define temp_strdup        cook_temp_strdup
 #define temp_strndup       cook_temp_strndup
 #define temp_strsub        cook_temp_strsub
@@ -1509,10 +10880,73 @@ typedef cook_dir_t dir_t;
 #define temp_path_dirname  cook_temp_path_dirname
 #define temp_path_basename cook_temp_path_basename
 
+#define pages_round    cook_pages_round
+#define pages_alloc    cook_pages_alloc
+#define pages_realloc  cook_pages_realloc
+#define pages_free     cook_pages_free
+#define pages_release  cook_pages_release
+
+#define arena_alloc         cook_arena_alloc
+#define arena_alloc_aligned cook_arena_alloc_aligned
+#define arena_memdup        cook_arena_memdup
+#define arena_save          cook_arena_save
+#define arena_rewind        cook_arena_rewind
+#define arena_reset         cook_arena_reset
+#define arena_free          cook_arena_free
+#define arena_strfmt        cook_arena_strfmt
+#define arena_vstrfmt       cook_arena_vstrfmt
+
+typedef cook_scratch_t scratch_t;
+#define scratch_get     cook_scratch_get
+#define scratch_begin   cook_scratch_begin
+#define scratch_end     cook_scratch_end
+#define scratch_release cook_scratch_release
+#define SCRATCH_SCOPE   COOK_SCRATCH_SCOPE
+
+#ifdef COOK_ALLOC_STATS
+typedef cook_alloc_stats_t alloc_stats_t;
+#define alloc_stats_get     cook_alloc_stats_get
+#define alloc_stats_summary cook_alloc_stats_summary
+#define alloc_stats_detail  cook_alloc_stats_detail
+#define alloc_stats_reset   cook_alloc_stats_reset
+#endif
+
+#define heap_allocator    cook_heap_allocator
+#define pool_init         cook_pool_init
+#define pool_destroy      cook_pool_destroy
+#define pool_alloc        cook_pool_alloc
+#define pool_free         cook_pool_free
+#define pool_free_bulk    cook_pool_free_bulk
+#define pool_reset        cook_pool_reset
+#define pool_allocator    cook_pool_allocator
+#define pool_cache_init   cook_pool_cache_init
+#define pool_cache_alloc  cook_pool_cache_alloc
+#define pool_cache_free   cook_pool_cache_free
+#define pool_cache_flush  cook_pool_cache_flush
+
+#define sc_malloc       cook_sc_malloc
+#define sc_realloc      cook_sc_realloc
+#define sc_free         cook_sc_free
+#define sc_usable_size  cook_sc_usable_size
+#define sc_thread_flush cook_sc_thread_flush
+#define sc_report       cook_sc_report
+
+#define tlsf_create     cook_tlsf_create
+#define tlsf_malloc     cook_tlsf_malloc
+#define tlsf_realloc    cook_tlsf_realloc
+#define tlsf_free       cook_tlsf_free
+#define tlsf_free_bytes cook_tlsf_free_bytes
+#define tlsf_allocator  cook_tlsf_allocator
+
 #define sv_from_cstr   cook_sv_from_cstr
 #define sv_from_parts  cook_sv_from_parts
 #define sv_equal       cook_sv_equal
 #define sv_compare     cook_sv_compare
+#define sv_compare_nocase cook_sv_compare_nocase
+#define sv_equal_nocase cook_sv_equal_nocase
+#define sv_common_prefix cook_sv_common_prefix
+#define sv_sort        cook_sv_sort
+#define sv_sort_parallel cook_sv_sort_parallel
 #define sv_starts_with cook_sv_starts_with
 #define sv_ends_with   cook_sv_ends_with
 #define sv_empty       cook_sv_empty
@@ -1521,13 +10955,123 @@ typedef cook_dir_t dir_t;
 #define sv_ltrim       cook_sv_ltrim
 #define sv_rtrim       cook_sv_rtrim
 #define sv_chomp       cook_sv_chomp
-
-#define sb_append_sv    cook_sb_append_sv
-#define sb_append_parts cook_sb_append_parts
-#define sb_reset        cook_sb_reset
-#define sb_free         cook_sb_free
-#define sb_view         cook_sb_view
-#define sb_append       cook_sb_append
+#define sv_find_char   cook_sv_find_char
+#define sv_rfind_char  cook_sv_rfind_char
+#define sv_find_any    cook_sv_find_any
+#define sv_find        cook_sv_find
+#define sv_count_char  cook_sv_count_char
+#define SV_NPOS        COOK_SV_NPOS
+#define sv_find_byteset  cook_sv_find_byteset
+#define sv_chop_by_delim cook_sv_chop_by_delim
+#define sv_chop_by_set   cook_sv_chop_by_set
+#define sv_chop_by_space cook_sv_chop_by_space
+#define sv_split_iter    cook_sv_split_iter
+#define sv_split_next    cook_sv_split_next
+#define sv_line_iter     cook_sv_line_iter
+#define sv_line_next     cook_sv_line_next
+#define sv_count_lines   cook_sv_count_lines
+#define byteset_make     cook_byteset_make
+#define byteset_has      cook_byteset_has
+#define byteset_from_pred cook_byteset_from_pred
+#define sv_ltrim_set     cook_sv_ltrim_set
+#define sv_rtrim_set     cook_sv_rtrim_set
+#define sv_trim_set      cook_sv_trim_set
+#define sv_trim_space    cook_sv_trim_space
+#define sv_is_digits     cook_sv_is_digits
+#define ascii_lower      cook_ascii_lower
+#define ascii_upper      cook_ascii_upper
+#define ascii_replace    cook_ascii_replace
+#define sv_parse_u64     cook_sv_parse_u64
+#define sv_parse_u32     cook_sv_parse_u32
+#define sv_parse_u16     cook_sv_parse_u16
+#define sv_parse_u8      cook_sv_parse_u8
+#define sv_parse_i64     cook_sv_parse_i64
+#define sv_parse_i32     cook_sv_parse_i32
+#define sv_parse_i16     cook_sv_parse_i16
+#define sv_parse_i8      cook_sv_parse_i8
+#define sv_parse_hex     cook_sv_parse_hex
+#define sv_parse_f64     cook_sv_parse_f64
+#define sv_parse_f32     cook_sv_parse_f32
+
+#define sb_append_sv         cook_sb_append_sv
+#define sb_append_parts      cook_sb_append_parts
+#define sb_reserve           cook_sb_reserve
+#define sb_concat_n          cook_sb_concat_n
+#define sb_concat            cook_sb_concat
+#define sb_join              cook_sb_join
+#define sb_reset             cook_sb_reset
+#define sb_free              cook_sb_free
+#define sb_view              cook_sb_view
+#define sb_append            cook_sb_append
+#define sb_appendf           cook_sb_appendf
+#define sb_vappendf          cook_sb_vappendf
+#define sb_to_lower          cook_sb_to_lower
+#define sb_to_upper          cook_sb_to_upper
+#define sb_replace_byte      cook_sb_replace_byte
+#define sb_append_u64        cook_sb_append_u64
+#define sb_append_i64        cook_sb_append_i64
+#define sb_append_u64_padded cook_sb_append_u64_padded
+#define sb_append_hex        cook_sb_append_hex
+#define sb_append_f64        cook_sb_append_f64
+#define sb_append_f32        cook_sb_append_f32
+
+#define sv_hash     cook_sv_hash
+#define hsv_from_sv cook_hsv_from_sv
+#define hsv_from_sb cook_hsv_from_sb
+#define hsv_equal   cook_hsv_equal
+#define hsv_view    cook_hsv_view
+
+#define sb_append_utf8  cook_sb_append_utf8
+#define sb_append_utf16 cook_sb_append_utf16
+#define sb_append_utf32 cook_sb_append_utf32
+
+#define utf8_validate   cook_utf8_validate
+#define utf8_valid      cook_utf8_valid
+#define utf8_is_ascii   cook_utf8_is_ascii
+#define utf8_count      cook_utf8_count
+#define utf8_next       cook_utf8_next
+
+#define matcher_init cook_matcher_init
+#define matcher_free cook_matcher_free
+#define matcher_find cook_matcher_find
+#define matcher_feed cook_matcher_feed
+
+#define glob_init   cook_glob_init
+#define glob_free   cook_glob_free
+#define glob_match  cook_glob_match
+#define glob_filter cook_glob_filter
+
+#define csv_from_sv         cook_csv_from_sv
+#define csv_from_reader     cook_csv_from_reader
+#define csv_free            cook_csv_free
+#define csv_next            cook_csv_next
+#define csv_unescape        cook_csv_unescape
+#define csv_parse_parallel  cook_csv_parse_parallel
+
+#define json_parse     cook_json_parse
+#define json_free      cook_json_free
+#define json_root      cook_json_root
+#define json_iter      cook_json_iter
+#define json_iter_next cook_json_iter_next
+#define json_get       cook_json_get
+#define json_string    cook_json_string
+#define json_number    cook_json_number
+#define json_int       cook_json_int
+
+#define regex_init  cook_regex_init
+#define regex_free  cook_regex_free
+#define regex_match cook_regex_match
+
+#define rope_init      cook_rope_init
+#define rope_free      cook_rope_free
+#define rope_len       cook_rope_len
+#define rope_insert    cook_rope_insert
+#define rope_delete    cook_rope_delete
+#define rope_index     cook_rope_index
+#define rope_iter      cook_rope_iter
+#define rope_iter_next cook_rope_iter_next
+#define rope_flatten   cook_rope_flatten
+#define rope_write     cook_rope_write
 
 #define cmd_append      cook_cmd_append
 #define cmd_append_many cook_cmd_append_many
@@ -0,0 +1,43 @@
+#define COOK_ALLOC_STATS
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+
+typedef struct numbers {
+    int *items;
+    size_t len;
+    size_t cap;
+} numbers_t;
+
+int main(void)
+{
+    numbers_t numbers = {0};
+    for (int i = 0; i < 10000; i++) cook_vec_push(&numbers, i);
+
+    cook_string_builder_t sb = {0};
+    for (int i = 0; i < 100; i++) cook_sb_append(&sb, "line %d\n", i);
+
+    char *content = cook_fs_readfile(__FILE__);
+    char *cwd = cook_fs_cwd();
+    cook_dir_t *dir = cook_fs_opendir(".");
+    while (cook_fs_readdir(dir)) {}
+    cook_fs_closedir(dir);
+
+    cook_arena_t arena = {0};
+    for (int i = 0; i < 100; i++) cook_arena_alloc(&arena, 4096);
+
+    cook_alloc_stats_summary();
+    cook_alloc_stats_detail();
+
+    cook_alloc_stats_t vec = cook_alloc_stats_get("vec");
+    printf("vec: %zu reallocs copied %zu bytes\n", vec.reallocs, vec.copy_bytes);
+
+    cook_alloc_stats_reset();
+    cook_free(content);
+    cook_free(cwd);
+    cook_vec_free(&numbers);
+    cook_sb_free(&sb);
+    cook_arena_free(&arena);
+    cook_alloc_stats_summary();
+
+    return 0;
+}
@@ -0,0 +1,46 @@
+#define COOK_IMPLEMENTATION
+#define COOK_STRIP_PREFIX
+#include "cook.h"
+
+typedef struct counters {
+    COOK_CACHELINE_PADDED(long) hits;
+    COOK_CACHELINE_PADDED(long) misses;
+} COOK_CACHELINE_ALIGNED counters_t;
+
+int main(void)
+{
+    cook_arena_t arena = {0};
+
+    char *name = cook_arena_memdup(&arena, "arena", 6);
+    printf("name = %s\n", name);
+
+    cook_arena_mark_t mark = cook_arena_save(&arena);
+    float *v = cook_arena_alloc_aligned(&arena, 64*sizeof(float), 32);
+    printf("v = %p, 32-byte aligned: %d\n", (void *)v, (uintptr_t)v % 32 == 0);
+    cook_arena_rewind(&arena, mark);
+    float *w = cook_arena_alloc_aligned(&arena, 64*sizeof(float), 32);
+    printf("w = %p, same as v: %d\n", (void *)w, v == w);
+
+    void *page = cook_arena_alloc_aligned(&arena, 100, COOK_PAGE_SIZE);
+    printf("page = %p, page aligned: %d\n", page, (uintptr_t)page % COOK_PAGE_SIZE == 0);
+
+    cook_arena_reset(&arena);
+    printf("after reset: %p\n", cook_arena_alloc(&arena, 6));
+    cook_arena_free(&arena);
+
+    size_t checkpoint = temp_save();
+    void *t1 = temp_alloc(3);
+    void *t2 = temp_alloc_aligned(128, 64);
+    printf("t1 = %p, t2 = %p, 64-byte aligned: %d\n", t1, t2, (uintptr_t)t2 % 64 == 0);
+    temp_rewind(checkpoint);
+    printf("rewind exact: %d\n", temp_alloc(3) == t1 && temp_alloc_aligned(128, 64) == t2);
+    temp_reset();
+
+    counters_t c[2] = {0};
+    c[0].hits.value++;
+    c[1].misses.value++;
+    printf("sizeof(counters_t) = %zu, stride in cache lines = %zu\n",
+           sizeof(counters_t), sizeof(counters_t)/COOK_CACHELINE);
+
+    return 0;
+}
@@ -0,0 +1,44 @@
+// bench.h - tiny timing helpers shared by the benchmark examples
+//
+// Define _GNU_SOURCE (or _POSIX_C_SOURCE) before any include to get
+// clock_gettime under -std=c99.
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+// bench_now - monotonic time in seconds
+static inline double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec*1e-9;
+}
+
+// bench_rand - xorshift64*, deterministic across runs
+static inline uint64_t bench_rand(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+// bench_report_ops - print time and throughput in operations per second
+static inline void bench_report_ops(const char *name, double secs, double ops) {
+    printf("%-40s %10.3f ms %12.2f Mops/s\n", name, secs*1e3, ops/secs/1e6);
+}
+
+// bench_report_bytes - print time and throughput in bytes per second
+static inline void bench_report_bytes(const char *name, double secs, double bytes) {
+    printf("%-40s %10.3f ms %12.2f MB/s\n", name, secs*1e3, bytes/secs/1e6);
+}
+
+// bench_sink - keep the optimizer from dropping a computed value
+static volatile uint64_t bench_sink_value;
+static inline void bench_sink(uint64_t v) { bench_sink_value += v; }
+
+#endif // BENCH_H
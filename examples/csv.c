@@ -0,0 +1,203 @@
+#define _GNU_SOURCE
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+#include "bench.h"
+
+#define CSV_PATH "/tmp/cook_csv.csv"
+
+static const char *cities[] = {"Berlin", "\"Washington, D.C.\"", "Tokyo", "\"The \"\"Big\"\" Apple\"", "Lagos"};
+
+static const char *reviews[] = {
+    "\"Arrived late, but the support team was helpful and refunded the shipping without any fuss.\"",
+    "Works as described and the battery easily lasts a full day of heavy use with plenty to spare",
+    "\"Third order this year; quality is consistent, packaging could use less plastic, though.\"",
+};
+
+// rows of "id,city,amount,note", with quoted cities and a multi-line note
+// now and then, or a long review as the note
+static cook_string_view_t make_csv(size_t size, bool long_notes) {
+    cook_string_builder_t sb = {0};
+    cook_sb_append(&sb, "id,city,amount,note\r\n");
+    uint64_t rng = 42;
+    for (size_t id = 0; sb.len < size; id++) {
+        uint64_t r = bench_rand(&rng);
+        const char *note = long_notes ? reviews[(r >> 32) % 3] : (r >> 32) % 16 ? "ok" : "\"line one\nline two\"";
+        cook_sb_append(&sb, "%zu,%s,%u.%02u,%s\r\n", id, cities[r % 5], (unsigned)(r >> 8) % 10000,
+                       (unsigned)(r >> 24) % 100, note);
+    }
+    return cook_sb_view(&sb);
+}
+
+typedef struct totals {
+    size_t records;
+    size_t fields;
+    size_t bytes; // unescaped field bytes
+} totals_t;
+
+// the usual hand-written state machine, one byte at a time, copying the
+// unescaped field to a buffer
+static totals_t byte_loop(cook_string_view_t csv) {
+    totals_t t = {0};
+    char field[4096];
+    size_t len = 0;
+    bool quoted = false, pending = false;
+    for (size_t i = 0; i < csv.len; i++) {
+        char c = csv.data[i];
+        pending = true;
+        if (quoted) {
+            if (c != '"') {
+                if (len < sizeof(field)) field[len++] = c;
+            } else if (i + 1 < csv.len && csv.data[i + 1] == '"') {
+                if (len < sizeof(field)) field[len++] = '"';
+                i++;
+            } else {
+                quoted = false;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',' || c == '\n') {
+            if (c == '\n' && len > 0 && field[len - 1] == '\r') len--;
+            t.fields++;
+            t.bytes += len;
+            len = 0;
+            if (c == '\n') {
+                t.records++;
+                pending = false;
+            }
+        } else if (len < sizeof(field)) {
+            field[len++] = c;
+        }
+    }
+    if (pending) {
+        t.fields++;
+        t.bytes += len;
+        t.records++;
+    }
+    return t;
+}
+
+static void count_record(totals_t *t, const cook_csv_record_t *record, cook_string_builder_t *sb) {
+    t->records++;
+    t->fields += record->len;
+    for (size_t i = 0; i < record->len; i++) {
+        // only fields with "" pairs need a copy
+        if (!record->items[i].escaped) {
+            t->bytes += record->items[i].sv.len;
+            continue;
+        }
+        cook_sb_reset(sb);
+        t->bytes += cook_csv_unescape(record->items[i], sb).len;
+    }
+}
+
+static totals_t cook_whole(cook_string_view_t csv) {
+    totals_t t = {0};
+    cook_csv_t reader = cook_csv_from_sv(csv, ',');
+    cook_csv_record_t record = {0};
+    cook_string_builder_t sb = {0};
+    while (cook_csv_next(&reader, &record)) count_record(&t, &record, &sb);
+    cook_vec_free(&record);
+    cook_sb_free(&sb);
+    return t;
+}
+
+static long file_read(cook_reader_t *r, void *buf, size_t size) {
+    size_t n = fread(buf, 1, size, r->ctx);
+    return n > 0 ? (long)n : (ferror(r->ctx) ? -1 : 0);
+}
+
+static totals_t cook_stream(void) {
+    totals_t t = {0};
+    FILE *fp = fopen(CSV_PATH, "rb");
+    if (!fp) return t;
+    cook_reader_t file = {.ctx = fp, .read = file_read};
+    cook_csv_t reader = cook_csv_from_reader(&file, ',');
+    cook_csv_record_t record = {0};
+    cook_string_builder_t sb = {0};
+    while (cook_csv_next(&reader, &record)) count_record(&t, &record, &sb);
+    cook_vec_free(&record);
+    cook_sb_free(&sb);
+    cook_csv_free(&reader);
+    fclose(fp);
+    return t;
+}
+
+// one slot per chunk, each padded to its own cache line
+typedef struct chunk_totals {
+    totals_t t;
+    cook_string_builder_t sb;
+    char pad[64];
+} chunk_totals_t;
+
+static void count_parallel(const cook_csv_record_t *record, size_t chunk, void *user) {
+    chunk_totals_t *c = (chunk_totals_t *)user + chunk;
+    count_record(&c->t, record, &c->sb);
+}
+
+static totals_t cook_parallel(cook_string_view_t csv) {
+    static chunk_totals_t chunks[64];
+    memset(chunks, 0, sizeof(chunks));
+    size_t count = cook_csv_parse_parallel(csv, ',', 0, count_parallel, chunks);
+    totals_t t = {0};
+    for (size_t i = 0; i < count; i++) {
+        t.records += chunks[i].t.records;
+        t.fields += chunks[i].t.fields;
+        t.bytes += chunks[i].t.bytes;
+        cook_sb_free(&chunks[i].sb);
+    }
+    return t;
+}
+
+static void report(const char *name, double secs, totals_t t, totals_t expected, size_t size) {
+    char label[64];
+    snprintf(label, sizeof(label), "%s (%zu)", name, t.records);
+    bench_report_bytes(label, secs, (double)size);
+    if (t.records != expected.records || t.fields != expected.fields || t.bytes != expected.bytes) {
+        printf("    ^ differs: %zu fields, %zu bytes\n", t.fields, t.bytes);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    cook_csv_t demo = cook_csv_from_sv(cook_sv_from_cstr("name,quote\r\nAda,\"said \"\"hi\"\", then left\"\n"), ',');
+    cook_csv_record_t record = {0};
+    cook_string_builder_t sb = {0};
+    while (cook_csv_next(&demo, &record)) {
+        for (size_t i = 0; i < record.len; i++) {
+            cook_sb_reset(&sb);
+            printf("["SV_FMT"]", SV_ARG(cook_csv_unescape(record.items[i], &sb)));
+        }
+        printf("\n");
+    }
+    cook_vec_free(&record);
+    cook_sb_free(&sb);
+
+    size_t size = (size_t)512 << 20;
+    if (argc > 1) size = (size_t)strtoull(argv[1], NULL, 10) << 20;
+    for (int long_notes = 0; long_notes <= 1; long_notes++) {
+        cook_string_view_t csv = make_csv(size, long_notes);
+        FILE *fp = fopen(CSV_PATH, "wb");
+        bool written = fp && fwrite(csv.data, 1, csv.len, fp) == csv.len;
+        if (fp) fclose(fp);
+
+        printf("---------- %zu MB of CSV, %s ----------\n", csv.len >> 20, long_notes ? "long text fields" : "short fields");
+        double start = bench_now();
+        totals_t expected = byte_loop(csv);
+        report("byte loop state machine", bench_now() - start, expected, expected, csv.len);
+        start = bench_now();
+        totals_t whole = cook_whole(csv);
+        report("cook_csv_from_sv", bench_now() - start, whole, expected, csv.len);
+        if (written) {
+            start = bench_now();
+            totals_t stream = cook_stream();
+            report("cook_csv_from_reader (file)", bench_now() - start, stream, expected, csv.len);
+        }
+        start = bench_now();
+        totals_t parallel = cook_parallel(csv);
+        report("cook_csv_parse_parallel", bench_now() - start, parallel, expected, csv.len);
+
+        remove(CSV_PATH);
+        free((char *)csv.data);
+    }
+    return 0;
+}
@@ -0,0 +1,123 @@
+#define _GNU_SOURCE
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+#include "bench.h"
+
+#define RUNS 4
+
+typedef struct values {
+    int64_t *ints;
+    uint64_t *ids;
+    double *doubles;
+    float *floats;
+    size_t count;
+} values_t;
+
+// counters of every magnitude, ids, prices, measurements and ratios
+static values_t make_values(size_t count) {
+    values_t v = {malloc(count*sizeof(int64_t)), malloc(count*sizeof(uint64_t)), malloc(count*sizeof(double)),
+                  malloc(count*sizeof(float)), count};
+    uint64_t rng = 48;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t r = bench_rand(&rng);
+        v.ints[i] = (int64_t)(r >> (r % 64)) * (r & 1 ? -1 : 1);
+        v.ids[i] = bench_rand(&rng);
+        switch (i % 3) {
+        case 0: v.doubles[i] = (double)(r >> 44)/100.0; break;
+        case 1: v.doubles[i] = (double)(r >> 11)*0x1p-53; break;
+        default: v.doubles[i] = (double)(int64_t)(r >> 20)*1e-9 - 4e3; break;
+        }
+        v.floats[i] = (float)v.doubles[i];
+    }
+    return v;
+}
+
+static void report(const char *name, double secs, size_t bytes, size_t count) {
+    char label[64];
+    snprintf(label, sizeof(label), "%s (%zu)", name, bytes);
+    bench_report_ops(label, secs, (double)count);
+}
+
+// reads back every number of a comma separated list
+static size_t count_exact(cook_string_view_t text, const double *doubles, const float *floats) {
+    size_t exact = 0;
+    cook_sv_split_iter_t it = cook_sv_split_iter(text, cook_sv_from_cstr(","));
+    cook_string_view_t field;
+    for (size_t i = 0; cook_sv_split_next(&it, &field) && field.len > 0; i++) {
+        if (doubles) {
+            double d = 0;
+            exact += cook_sv_parse_f64(field, &d) == field.len && d == doubles[i];
+        } else {
+            float f = 0;
+            exact += cook_sv_parse_f32(field, &f) == field.len && f == floats[i];
+        }
+    }
+    return exact;
+}
+
+#define BENCH(name, sb, count, append)                  \
+    do {                                                \
+        double best = 1e9;                              \
+        for (int r = 0; r < RUNS; r++) {                \
+            cook_sb_reset(sb);                          \
+            double start = bench_now();                 \
+            for (size_t i = 0; i < (count); i++) {      \
+                append;                                 \
+            }                                           \
+            double secs = bench_now() - start;          \
+            if (secs < best) best = secs;               \
+        }                                               \
+        report(name, best, (sb)->len, count);           \
+    } while (0)
+
+int main(int argc, char **argv)
+{
+    cook_string_builder_t sb = {0};
+    double samples[] = {0.1, 1.0/3, 100, 1e21, 1.5e-7, -0.0, 5e-324};
+    for (size_t i = 0; i < cook_arr_len(samples); i++) {
+        cook_sb_append_f64(&sb, samples[i]);
+        cook_sb_append_parts(&sb, " ", 1);
+    }
+    cook_sb_append_f32(&sb, 0.1f);
+    cook_sb_append_parts(&sb, " ", 1);
+    cook_sb_append_i64(&sb, INT64_MIN);
+    cook_sb_append_parts(&sb, " ", 1);
+    cook_sb_append_u64_padded(&sb, 7, 3, '0');
+    cook_sb_append_parts(&sb, " ", 1);
+    cook_sb_append_hex(&sb, 0xbeef, 8);
+    printf(SV_FMT"\n", SV_ARG(cook_sb_view(&sb)));
+
+    size_t count = (size_t)1 << 21;
+    if (argc > 1) count = (size_t)strtoull(argv[1], NULL, 10) << 10;
+    values_t v = make_values(count);
+
+    printf("---------- %zu integers ----------\n", count);
+    BENCH("cook_sb_appendf \"%lld,\"", &sb, count, cook_sb_appendf(&sb, "%lld,", (long long)v.ints[i]));
+    BENCH("cook_sb_append_i64", &sb, count, (cook_sb_append_i64(&sb, v.ints[i]), cook_sb_append_parts(&sb, ",", 1)));
+    BENCH("cook_sb_appendf \"%016llx,\"", &sb, count, cook_sb_appendf(&sb, "%016llx,", (unsigned long long)v.ids[i]));
+    BENCH("cook_sb_append_hex, width 16", &sb, count, (cook_sb_append_hex(&sb, v.ids[i], 16), cook_sb_append_parts(&sb, ",", 1)));
+    BENCH("cook_sb_appendf \"%8llu,\"", &sb, count, cook_sb_appendf(&sb, "%8llu,", (unsigned long long)(v.ids[i] >> 40)));
+    BENCH("cook_sb_append_u64_padded", &sb, count,
+          (cook_sb_append_u64_padded(&sb, v.ids[i] >> 40, 8, ' '), cook_sb_append_parts(&sb, ",", 1)));
+
+    printf("---------- %zu doubles ----------\n", count);
+    BENCH("cook_sb_appendf \"%g,\"", &sb, count, cook_sb_appendf(&sb, "%g,", v.doubles[i]));
+    printf("    %zu read back exactly\n", count_exact(cook_sb_view(&sb), v.doubles, NULL));
+    BENCH("cook_sb_appendf \"%.17g,\"", &sb, count, cook_sb_appendf(&sb, "%.17g,", v.doubles[i]));
+    printf("    %zu read back exactly\n", count_exact(cook_sb_view(&sb), v.doubles, NULL));
+    BENCH("cook_sb_append_f64", &sb, count, (cook_sb_append_f64(&sb, v.doubles[i]), cook_sb_append_parts(&sb, ",", 1)));
+    printf("    %zu read back exactly\n", count_exact(cook_sb_view(&sb), v.doubles, NULL));
+
+    printf("---------- %zu floats ----------\n", count);
+    BENCH("cook_sb_appendf \"%.9g,\"", &sb, count, cook_sb_appendf(&sb, "%.9g,", (double)v.floats[i]));
+    printf("    %zu read back exactly\n", count_exact(cook_sb_view(&sb), NULL, v.floats));
+    BENCH("cook_sb_append_f32", &sb, count, (cook_sb_append_f32(&sb, v.floats[i]), cook_sb_append_parts(&sb, ",", 1)));
+    printf("    %zu read back exactly\n", count_exact(cook_sb_view(&sb), NULL, v.floats));
+
+    cook_sb_free(&sb);
+    free(v.ints);
+    free(v.ids);
+    free(v.doubles);
+    free(v.floats);
+    return 0;
+}
@@ -0,0 +1,213 @@
+#define _GNU_SOURCE
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+#include "bench.h"
+#include <fnmatch.h>
+
+#define RUNS 4
+
+static const char *dirs[] = {"src", "lib", "tests", "node_modules", "build", "docs", ".git", "vendor"};
+static const char *parts[] = {"core", "util", "net", "ui", "io", "objects", "components", "parser"};
+static const char *bases[] = {"main", "index", "config", "widget", "handler", "README", "server", "types"};
+static const char *exts[] = {".c", ".h", ".cpp", ".ts", ".tsx", ".test.ts", ".test.tsx", ".json", ".md", ".o",
+                             ".py", ".rs", ".go", ".pack", ".js", ".map"};
+
+// paths of a source tree, 1-5 directories deep, the names back to back
+static cook_string_view_t *make_tree(size_t count, char **storage) {
+    cook_string_view_t *paths = malloc(count*sizeof(*paths));
+    char *buf = malloc(count*96), *p = buf;
+    uint64_t rng = 44;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t r = bench_rand(&rng);
+        int n = snprintf(p, 96, "%s", dirs[r % 8]);
+        for (size_t d = 0; d < (r >> 3) % 5; d++) n += snprintf(p + n, 96 - n, "/%s", parts[(r >> (6 + 3*d)) % 8]);
+        n += snprintf(p + n, 96 - n, "/%s%u%s", bases[(r >> 24) % 8], (unsigned)(r >> 27) % 100, exts[(r >> 40) % 16]);
+        paths[i] = cook_sv_from_parts(p, (size_t)n);
+        p += n;
+    }
+    *storage = buf;
+    return paths;
+}
+
+// the base names of @paths, pointing into the same bytes
+static cook_string_view_t *base_names(const cook_string_view_t *paths, size_t count) {
+    cook_string_view_t *names = malloc(count*sizeof(*names));
+    for (size_t i = 0; i < count; i++) {
+        size_t slash = cook_sv_rfind_char(paths[i], '/');
+        names[i] = cook_sv_from_parts(paths[i].data + slash + 1, paths[i].len - slash - 1);
+    }
+    return names;
+}
+
+// the strcmp chain every caller of cook_fs_readdir ends up writing
+static bool is_source(cook_string_view_t name) {
+    size_t dot = cook_sv_rfind_char(name, '.');
+    if (dot == COOK_SV_NPOS) return false;
+    cook_string_view_t ext = cook_sv_from_parts(name.data + dot, name.len - dot);
+    return cook_sv_equal(ext, cook_sv_from_cstr(".c")) || cook_sv_equal(ext, cook_sv_from_cstr(".h")) ||
+           cook_sv_equal(ext, cook_sv_from_cstr(".cpp")) || cook_sv_equal(ext, cook_sv_from_cstr(".py")) ||
+           cook_sv_equal(ext, cook_sv_from_cstr(".rs")) || cook_sv_equal(ext, cook_sv_from_cstr(".go")) ||
+           cook_sv_equal(ext, cook_sv_from_cstr(".ts")) || cook_sv_equal(ext, cook_sv_from_cstr(".js"));
+}
+
+// fnmatch() wants C strings and one call per pattern
+static size_t fnmatch_count(const cook_string_view_t *names, size_t count, const char **patterns, size_t n, int flags) {
+    size_t matches = 0;
+    char buf[128];
+    for (size_t i = 0; i < count; i++) {
+        memcpy(buf, names[i].data, names[i].len);
+        buf[names[i].len] = '\0';
+        for (size_t k = 0; k < n; k++) {
+            if (fnmatch(patterns[k], buf, flags) == 0) {
+                matches++;
+                break;
+            }
+        }
+    }
+    return matches;
+}
+
+typedef struct workload {
+    const char *name;
+    const cook_string_view_t *names;
+    size_t count;
+    const char **globs;    // for cook_glob_init
+    size_t glob_count;
+    const char **fnmatch;  // the same for fnmatch(), without "**" and "{}"
+    size_t fnmatch_count;
+    int flags;
+    bool (*chain)(cook_string_view_t name); // a hand-written check, may be NULL
+} workload_t;
+
+static void report(const char *name, double secs, size_t matches, size_t count) {
+    char label[64];
+    snprintf(label, sizeof(label), "%s (%zu)", name, matches);
+    bench_report_ops(label, secs, (double)count);
+}
+
+static void run(const workload_t *w) {
+    cook_string_view_t patterns[16];
+    for (size_t i = 0; i < w->glob_count; i++) patterns[i] = cook_sv_from_cstr(w->globs[i]);
+    cook_glob_t glob;
+    double start = bench_now();
+    if (!cook_glob_init(&glob, patterns, w->glob_count)) {
+        printf("could not compile %s\n", w->name);
+        return;
+    }
+    printf("---------- %s: %zu names, %zu states, compiled in %.3f ms ----------\n",
+           w->name, w->count, glob.state_count, (bench_now() - start)*1e3);
+
+    cook_string_view_t *copy = malloc(w->count*sizeof(*copy));
+    double best[4] = {1e9, 1e9, 1e9, 1e9};
+    size_t found[4] = {0};
+    for (int r = 0; r < RUNS; r++) {
+        start = bench_now();
+        found[0] = fnmatch_count(w->names, w->count, w->fnmatch, w->fnmatch_count, w->flags);
+        double secs = bench_now() - start;
+        if (secs < best[0]) best[0] = secs;
+
+        if (w->chain) {
+            start = bench_now();
+            found[1] = 0;
+            for (size_t i = 0; i < w->count; i++) found[1] += w->chain(w->names[i]);
+            secs = bench_now() - start;
+            if (secs < best[1]) best[1] = secs;
+        }
+
+        start = bench_now();
+        found[2] = 0;
+        for (size_t i = 0; i < w->count; i++) found[2] += cook_glob_match(&glob, w->names[i], NULL);
+        secs = bench_now() - start;
+        if (secs < best[2]) best[2] = secs;
+
+        memcpy(copy, w->names, w->count*sizeof(*copy));
+        start = bench_now();
+        found[3] = cook_glob_filter(&glob, copy, w->count);
+        secs = bench_now() - start;
+        if (secs < best[3]) best[3] = secs;
+    }
+    report("fnmatch, one call per pattern", best[0], found[0], w->count);
+    if (w->chain) report("strcmp chain", best[1], found[1], w->count);
+    report("cook_glob_match", best[2], found[2], w->count);
+    report("cook_glob_filter", best[3], found[3], w->count);
+    if (found[3] != found[2] || (w->chain && found[1] != found[2])) printf("    ^ counts differ\n");
+    free(copy);
+    cook_glob_free(&glob);
+}
+
+int main(int argc, char **argv)
+{
+    cook_string_view_t sources[] = {cook_sv_from_cstr("*.{c,h}"), cook_sv_from_cstr("nob*")};
+    cook_glob_t glob;
+    cook_glob_init(&glob, sources, cook_arr_len(sources));
+    cook_dir_t *dir = cook_fs_opendir(".");
+    const char *name;
+    while (dir && (name = cook_fs_readdir(dir)) != NULL) {
+        size_t pattern;
+        if (cook_glob_match(&glob, cook_sv_from_cstr(name), &pattern)) printf("%s (pattern %zu) ", name, pattern);
+    }
+    if (dir) cook_fs_closedir(dir);
+    cook_glob_free(&glob);
+    cook_string_view_t tests = cook_sv_from_cstr("src/**/*.test.{ts,tsx}");
+    cook_glob_init(&glob, &tests, 1);
+    printf("\nsrc/a.test.ts: %d, src/ui/b/c.test.tsx: %d, lib/d.test.ts: %d\n",
+           cook_glob_match(&glob, cook_sv_from_cstr("src/a.test.ts"), NULL),
+           cook_glob_match(&glob, cook_sv_from_cstr("src/ui/b/c.test.tsx"), NULL),
+           cook_glob_match(&glob, cook_sv_from_cstr("lib/d.test.ts"), NULL));
+    cook_glob_free(&glob);
+
+    // "**/" also matches no directory when it starts an alternative
+    const struct { const char *glob, *name; bool match; } checks[] = {
+        {"src/{**/*.c,*.h}", "src/main.c", true},
+        {"src/{**/*.c,*.h}", "src/a/b/main.c", true},
+        {"src/{**/*.c,*.h}", "src/a/main.h", false},
+        {"{**/*.c,Makefile}", "main.c", true},
+        {"{**/*.c,Makefile}", "a/main.c", true},
+        {"a/{**/b,c}", "a/b", true},
+        {"a/{**/b,c}", "a/x/y/b", true},
+        {"a/{x**/b,c}", "a/b", false},
+    };
+    size_t wrong = 0;
+    for (size_t i = 0; i < cook_arr_len(checks); i++) {
+        cook_string_view_t pattern = cook_sv_from_cstr(checks[i].glob);
+        cook_glob_init(&glob, &pattern, 1);
+        if (cook_glob_match(&glob, cook_sv_from_cstr(checks[i].name), NULL) != checks[i].match) {
+            printf("    ^ %s on %s should be %d\n", checks[i].glob, checks[i].name, checks[i].match);
+            wrong++;
+        }
+        cook_glob_free(&glob);
+    }
+    printf("brace checks: %zu, wrong: %zu\n", cook_arr_len(checks), wrong);
+
+    size_t count = (size_t)1 << 20;
+    if (argc > 1) count = (size_t)strtoull(argv[1], NULL, 10) << 10;
+    char *storage;
+    cook_string_view_t *paths = make_tree(count, &storage);
+    cook_string_view_t *names = base_names(paths, count);
+
+    const char *source_globs[] = {"*.c", "*.h", "*.cpp", "*.py", "*.rs", "*.go", "*.ts", "*.js"};
+    run(&(workload_t){"source extensions, base names", names, count, source_globs, 8, source_globs, 8, 0, is_source});
+
+    // fnmatch() has no "**" and no braces; without FNM_PATHNAME its '*'
+    // crosses '/', which is what these need
+    const char *test_globs[] = {"src/**/*.test.{ts,tsx}", "**/node_modules/**", "**/.git/**"};
+    const char *test_fnmatch[] = {"src/*.test.ts", "src/*.test.tsx", "node_modules/*", "*/node_modules/*", ".git/*", "*/.git/*"};
+    run(&(workload_t){"tests and ignored directories, full paths", paths, count, test_globs, 3, test_fnmatch, 6, 0, NULL});
+
+    // a backtracking matcher may try many ways to split the name among the
+    // stars, the DFA reads every byte once
+    size_t bad_count = count/64;
+    char *aaa = malloc(48*bad_count);
+    for (size_t i = 0; i < bad_count; i++) {
+        memset(aaa + 48*i, 'a', 48);
+        paths[i] = cook_sv_from_parts(aaa + 48*i, 48);
+    }
+    const char *stars[] = {"*a*a*a*a*a*a*b"};
+    run(&(workload_t){"many stars, \"*a*a*a*a*a*a*b\"", paths, bad_count, stars, 1, stars, 1, 0, NULL});
+
+    free(aaa);
+    free(names);
+    free(paths);
+    free(storage);
+    return 0;
+}
@@ -0,0 +1,145 @@
+#define _GNU_SOURCE
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+#include "bench.h"
+
+#define RUNS 4
+#define TABLES 4 // routes, auth cache, rate limits, metrics
+
+static const char *prefixes[] = {"/api/v1/users/", "/api/v1/orders/", "/api/v2/search?q=", "/static/assets/",
+                                 "/internal/health/"};
+
+// request paths, most of them sharing a long prefix
+static cook_string_view_t *make_paths(size_t count, char **storage) {
+    cook_string_view_t *paths = malloc(count*sizeof(*paths));
+    char *buf = malloc(count*48), *p = buf;
+    uint64_t rng = 46;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t r = bench_rand(&rng);
+        int n = snprintf(p, 48, "%s%u", prefixes[r % 5], (unsigned)(r >> 8) % 100000);
+        paths[i] = cook_sv_from_parts(p, (size_t)n);
+        p += n;
+    }
+    *storage = buf;
+    return paths;
+}
+
+// a linear probing set of keys, the way a cache in a router is written
+typedef struct table {
+    cook_hashed_sv_t *slots;
+    size_t cap;
+} table_t;
+
+static void table_insert(table_t *t, cook_hashed_sv_t key) {
+    size_t i = key.hash & (t->cap - 1);
+    while (t->slots[i].data && !cook_hsv_equal(t->slots[i], key)) i = (i + 1) & (t->cap - 1);
+    t->slots[i] = key;
+}
+
+// looked up with a hashed key
+static bool table_find(const table_t *t, cook_hashed_sv_t key) {
+    for (size_t i = key.hash & (t->cap - 1); t->slots[i].data; i = (i + 1) & (t->cap - 1)) {
+        if (cook_hsv_equal(t->slots[i], key)) return true;
+    }
+    return false;
+}
+
+// looked up with a plain string view: hashed again, and every probe compares
+// bytes
+static bool table_find_sv(const table_t *t, cook_string_view_t key) {
+    for (size_t i = cook_sv_hash(key) & (t->cap - 1); t->slots[i].data; i = (i + 1) & (t->cap - 1)) {
+        if (cook_sv_equal(cook_hsv_view(t->slots[i]), key)) return true;
+    }
+    return false;
+}
+
+// the FNV-1a byte loop most hand-written tables use
+static uint64_t fnv1a(cook_string_view_t sv) {
+    uint64_t h = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < sv.len; i++) h = (h ^ (unsigned char)sv.data[i])*0x100000001B3ull;
+    return h;
+}
+
+static void report(const char *name, double secs, size_t found, size_t ops) {
+    char label[64];
+    snprintf(label, sizeof(label), "%s (%zu)", name, found);
+    bench_report_ops(label, secs, (double)ops);
+}
+
+int main(int argc, char **argv)
+{
+    cook_string_builder_t sb = {0};
+    cook_sb_append(&sb, "/api/v1/users/%d", 42);
+    cook_hashed_sv_t a = cook_hsv_from_sb(&sb);
+    cook_hashed_sv_t b = cook_hsv_from_sv(cook_sv_from_cstr("/api/v1/users/42"));
+    printf(SV_FMT" %016llx, equal: %d\n", SV_ARG(cook_hsv_view(a)), (unsigned long long)a.hash, cook_hsv_equal(a, b));
+    cook_sb_free(&sb);
+
+    size_t count = (size_t)1 << 20;
+    if (argc > 1) count = (size_t)strtoull(argv[1], NULL, 10) << 10;
+    char *storage;
+    cook_string_view_t *paths = make_paths(count, &storage);
+
+    // every table holds a different half of the keys
+    table_t tables[TABLES];
+    size_t cap = 1;
+    while (cap < count) cap <<= 1;
+    for (size_t t = 0; t < TABLES; t++) {
+        tables[t] = (table_t){calloc(cap, sizeof(cook_hashed_sv_t)), cap};
+        for (size_t i = 0; i < count; i++) {
+            if ((i + t) % 2) table_insert(&tables[t], cook_hsv_from_sv(paths[i]));
+        }
+    }
+    size_t probes = 0, used = 0;
+    for (size_t i = 0; i < cap; i++) {
+        if (!tables[0].slots[i].data) continue;
+        used++;
+        probes += ((i - (tables[0].slots[i].hash & (cap - 1))) & (cap - 1)) + 1;
+    }
+    printf("---------- %zu paths, %d tables, %.2f probes per key ----------\n", count, TABLES, (double)probes/(double)used);
+
+    double best[4] = {1e9, 1e9, 1e9, 1e9};
+    size_t found[4] = {0};
+    for (int r = 0; r < RUNS; r++) {
+        double start = bench_now();
+        uint64_t sum = 0;
+        for (size_t i = 0; i < count; i++) sum += fnv1a(paths[i]);
+        bench_sink(sum);
+        double secs = bench_now() - start;
+        if (secs < best[0]) best[0] = secs;
+
+        start = bench_now();
+        sum = 0;
+        for (size_t i = 0; i < count; i++) sum += cook_sv_hash(paths[i]);
+        bench_sink(sum);
+        secs = bench_now() - start;
+        if (secs < best[1]) best[1] = secs;
+
+        start = bench_now();
+        found[2] = 0;
+        for (size_t i = 0; i < count; i++) {
+            for (size_t t = 0; t < TABLES; t++) found[2] += table_find_sv(&tables[t], paths[i]);
+        }
+        secs = bench_now() - start;
+        if (secs < best[2]) best[2] = secs;
+
+        start = bench_now();
+        found[3] = 0;
+        for (size_t i = 0; i < count; i++) {
+            cook_hashed_sv_t key = cook_hsv_from_sv(paths[i]);
+            for (size_t t = 0; t < TABLES; t++) found[3] += table_find(&tables[t], key);
+        }
+        secs = bench_now() - start;
+        if (secs < best[3]) best[3] = secs;
+    }
+    report("fnv1a byte loop", best[0], count, count);
+    report("cook_sv_hash", best[1], count, count);
+    report("sv key, hashed per table", best[2], found[2], count*TABLES);
+    report("cook_hsv_from_sv once", best[3], found[3], count*TABLES);
+    if (found[2] != found[3]) printf("    ^ counts differ\n");
+
+    for (size_t t = 0; t < TABLES; t++) free(tables[t].slots);
+    free(paths);
+    free(storage);
+    return 0;
+}
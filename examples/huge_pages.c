@@ -0,0 +1,104 @@
+#define _GNU_SOURCE
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+#include "bench.h"
+
+#include <sys/resource.h>
+
+#define N_RANDOM_READS (16*1024*1024)
+
+typedef struct mode {
+    const char *name;
+    bool heap;
+    unsigned int flags;
+} mode_t_;
+
+typedef struct u64_vec {
+    uint64_t *items;
+    size_t len;
+    size_t cap;
+} u64_vec_t;
+
+static long minor_faults(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt;
+}
+
+static void run(const mode_t_ *mode, size_t size) {
+    long faults = minor_faults();
+    double start = bench_now();
+
+    unsigned char *buf = mode->heap ? malloc(size) : cook_pages_alloc(size, mode->flags);
+    if (!buf) {
+        printf("%-24s allocation failed\n", mode->name);
+        return;
+    }
+    memset(buf, 1, size);
+    double touched = bench_now();
+
+    uint64_t rng = 42, sum = 0;
+    size_t words = size/sizeof(uint64_t);
+    for (size_t i = 0; i < N_RANDOM_READS; i++) {
+        sum += ((uint64_t *)buf)[bench_rand(&rng) % words];
+    }
+    bench_sink(sum);
+    double done = bench_now();
+
+    printf("%-24s first touch %8.1f ms %8.2f GB/s | random reads %8.2f Mops/s | faults %ld\n",
+           mode->name, (touched - start)*1e3, size/(touched - start)/1e9,
+           N_RANDOM_READS/(done - touched)/1e6, minor_faults() - faults);
+
+    if (mode->heap) free(buf);
+    else cook_pages_free(buf, size, mode->flags);
+}
+
+int main(int argc, char **argv)
+{
+    size_t size = (size_t)256 << 20;
+    if (argc > 1) size = (size_t)strtoull(argv[1], NULL, 10) << 20;
+
+    // page-backed vectors, grown in turns so that they get in each other's
+    // way and have to move, which must keep them huge page aligned
+    u64_vec_t vec = {0}, other = {0};
+    size_t moves = 0;
+    for (uint64_t i = 0; i < 1000000; i++) {
+        uint64_t *items = vec.items;
+        cook_vec_push_pages(&vec, i, COOK_PAGES_HUGE);
+        cook_vec_push_pages(&other, i, COOK_PAGES_HUGE);
+        moves += items && items != vec.items;
+        COOK_ASSERT((uintptr_t)vec.items % COOK_HUGE_PAGE_SIZE == 0);
+        COOK_ASSERT((uintptr_t)other.items % COOK_HUGE_PAGE_SIZE == 0);
+    }
+    printf("vec len: %zu, cap: %zu, moved %zu times, huge page aligned: %d\n",
+           vec.len, vec.cap, moves, (uintptr_t)vec.items % COOK_HUGE_PAGE_SIZE == 0);
+    cook_vec_free_pages(&vec, COOK_PAGES_HUGE);
+    cook_vec_free_pages(&other, COOK_PAGES_HUGE);
+
+    // a huge-page arena that gives rewound memory back to the OS
+    cook_arena_t arena = {
+        .block_size = 64 << 20,
+        .page_flags = COOK_PAGES_HUGE | COOK_PAGES_RELEASE
+    };
+    cook_arena_mark_t mark = cook_arena_save(&arena);
+    char *block = cook_arena_alloc(&arena, 32 << 20);
+    memset(block, 1, 32 << 20);
+    cook_arena_rewind(&arena, mark);
+    block = cook_arena_alloc(&arena, 32 << 20);
+    printf("arena after rewind reads back released page: %d\n", block[COOK_PAGE_SIZE*4]);
+    cook_arena_free(&arena);
+
+    const mode_t_ modes[] = {
+        {"malloc",             true,  0},
+        {"mmap",               false, COOK_PAGES_MMAP},
+        {"mmap + populate",    false, COOK_PAGES_MMAP | COOK_PAGES_POPULATE},
+        {"thp",                false, COOK_PAGES_HUGE},
+        {"thp + populate",     false, COOK_PAGES_HUGE | COOK_PAGES_POPULATE},
+        {"hugetlb",            false, COOK_PAGES_HUGETLB},
+    };
+
+    printf("---------- %zu MB buffer ----------\n", size >> 20);
+    for (size_t i = 0; i < cook_arr_len(modes); i++) run(&modes[i], size);
+
+    return 0;
+}
@@ -0,0 +1,259 @@
+#define _GNU_SOURCE
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+#include "bench.h"
+
+#define RUNS 4
+
+static const char *names[] = {"Ada Lovelace", "Grace Hopper", "Edsger Dijkstra", "Barbara Liskov", "Ken Thompson"};
+static const char *cities[] = {"Berlin", "Tokyo", "S\\u00e3o Paulo", "Lagos", "Z\\u00fcrich"};
+static const char *messages[] = {
+    "GET /api/v1/users?page=2 took 12ms",
+    "failed to open \\\"C:\\\\data\\\\cache.db\\\": permission denied",
+    "user said: \\\"caf\\u00e9 is closed\\\"\\nretrying in 5s",
+    "\\u65e5\\u672c\\u8a9e \\u30c6\\u30ad\\u30b9\\u30c8 \\ud83c\\udf63 ok",
+};
+
+// pages of API responses: small objects with nested arrays and objects
+static void make_users(cook_string_builder_t *sb, size_t size) {
+    uint64_t rng = 43;
+    cook_sb_append(sb, "[");
+    for (size_t id = 0; sb->len < size; id++) {
+        uint64_t r = bench_rand(&rng);
+        cook_sb_append(sb, "%s{\"id\": %zu, \"name\": \"%s\", \"email\": \"user%zu@example.com\", \"active\": %s, "
+                       "\"score\": %u.%02u, \"tags\": [\"admin\", \"beta\"], \"address\": {\"city\": \"%s\", "
+                       "\"zip\": \"%05u\"}, \"manager\": null}", id ? ",\n  " : "\n  ", id, names[r % 5], id,
+                       (r >> 8) % 2 ? "true" : "false", (unsigned)(r >> 16) % 100, (unsigned)(r >> 24) % 100,
+                       cities[(r >> 32) % 5], (unsigned)(r >> 40) % 100000);
+    }
+    cook_sb_append(sb, "\n]\n");
+}
+
+// a GeoJSON-like polygon: arrays of coordinate pairs
+static void make_numbers(cook_string_builder_t *sb, size_t size) {
+    uint64_t rng = 44;
+    cook_sb_append(sb, "{\"type\": \"Polygon\", \"coordinates\": [");
+    for (size_t i = 0; sb->len < size; i++) {
+        uint64_t r = bench_rand(&rng);
+        cook_sb_append(sb, "%s[%d.%06u,%d.%06u]", i ? "," : "", (int)(r % 360) - 180, (unsigned)(r >> 9) % 1000000,
+                       (int)(r >> 29) % 180 - 90, (unsigned)(r >> 40) % 1000000);
+    }
+    cook_sb_append(sb, "]}");
+}
+
+// log records, most of the bytes in strings, many with escapes
+static void make_strings(cook_string_builder_t *sb, size_t size) {
+    uint64_t rng = 45;
+    cook_sb_append(sb, "[");
+    for (size_t i = 0; sb->len < size; i++) {
+        uint64_t r = bench_rand(&rng);
+        cook_sb_append(sb, "%s{\"level\":\"%s\",\"message\":\"%s\",\"trace\":\"%016llx\"}", i ? "," : "",
+                       r % 8 ? "info" : "error", messages[(r >> 8) % 4], (unsigned long long)r);
+    }
+    cook_sb_append(sb, "]");
+}
+
+// the usual recursive descent parser, one byte at a time, filling the same
+// kind of tape as cook_json_parse()
+typedef struct naive {
+    const char *s;
+    size_t len;
+    size_t at;
+    cook_json_node_t *nodes;
+    size_t count;
+} naive_t;
+
+static void naive_space(naive_t *p) {
+    while (p->at < p->len && (p->s[p->at] == ' ' || p->s[p->at] == '\n' || p->s[p->at] == '\r' || p->s[p->at] == '\t')) {
+        p->at++;
+    }
+}
+
+static bool naive_string(naive_t *p) {
+    cook_json_node_t *node = &p->nodes[p->count++];
+    size_t begin = ++p->at;
+    bool escaped = false;
+    while (p->at < p->len && p->s[p->at] != '"') {
+        if ((unsigned char)p->s[p->at] < 0x20) return false;
+        if (p->s[p->at] == '\\') {
+            escaped = true;
+            p->at += p->at + 1 < p->len && p->s[p->at + 1] == 'u' ? 6 : 2;
+        } else {
+            p->at++;
+        }
+    }
+    if (p->at >= p->len) return false;
+    *node = (cook_json_node_t){cook_sv_from_parts(p->s + begin, p->at - begin), COOK_JSON_STRING, 1, 0, escaped};
+    p->at++;
+    return true;
+}
+
+static bool naive_value(naive_t *p) {
+    naive_space(p);
+    if (p->at >= p->len) return false;
+    char c = p->s[p->at];
+    if (c == '"') return naive_string(p);
+    size_t index = p->count++, begin = p->at;
+    cook_json_node_t *node = &p->nodes[index];
+    if (c == '{' || c == '[') {
+        char close = c == '{' ? '}' : ']';
+        uint32_t count = 0;
+        p->at++;
+        naive_space(p);
+        if (p->at < p->len && p->s[p->at] == close) {
+            p->at++;
+        } else {
+            for (;;) {
+                count++;
+                if (c == '{') {
+                    naive_space(p);
+                    if (p->at >= p->len || p->s[p->at] != '"' || !naive_string(p)) return false;
+                    naive_space(p);
+                    if (p->at >= p->len || p->s[p->at++] != ':') return false;
+                }
+                if (!naive_value(p)) return false;
+                naive_space(p);
+                if (p->at >= p->len) return false;
+                char next = p->s[p->at++];
+                if (next == close) break;
+                if (next != ',') return false;
+            }
+        }
+        node = &p->nodes[index];
+        *node = (cook_json_node_t){cook_sv_from_parts(p->s + begin, p->at - begin),
+                                   c == '{' ? COOK_JSON_OBJECT : COOK_JSON_ARRAY, (uint32_t)(p->count - index), count, false};
+        return true;
+    }
+    *node = (cook_json_node_t){cook_sv_from_parts(p->s + begin, 0), COOK_JSON_NUMBER, 1, 0, false};
+    if (c == 't' || c == 'f' || c == 'n') {
+        const char *word = c == 't' ? "true" : c == 'f' ? "false" : "null";
+        size_t n = strlen(word);
+        if (p->len - p->at < n || memcmp(p->s + p->at, word, n) != 0) return false;
+        node->type = c == 't' ? COOK_JSON_TRUE : c == 'f' ? COOK_JSON_FALSE : COOK_JSON_NULL;
+        p->at += n;
+    } else {
+        while (p->at < p->len && ((p->s[p->at] >= '0' && p->s[p->at] <= '9') || p->s[p->at] == '-' || p->s[p->at] == '+' ||
+                                  p->s[p->at] == '.' || (p->s[p->at] | 0x20) == 'e')) {
+            p->at++;
+        }
+        if (p->at == begin) return false;
+    }
+    node->sv.len = p->at - begin;
+    return true;
+}
+
+static size_t naive_parse(cook_string_view_t text, cook_json_node_t *nodes) {
+    naive_t p = {text.data, text.len, 0, nodes, 0};
+    if (!naive_value(&p)) return 0;
+    naive_space(&p);
+    return p.at == p.len ? p.count : 0;
+}
+
+// what a caller would do next: convert every number, decode every string
+static double walk(const cook_json_node_t *nodes, size_t count, cook_string_builder_t *sb) {
+    double sum = 0, x;
+    for (size_t i = 0; i < count; i++) {
+        if (cook_json_number(&nodes[i], &x)) sum += x;
+        if (nodes[i].type == COOK_JSON_STRING) {
+            cook_sb_reset(sb);
+            sum += (double)cook_json_string(&nodes[i], sb).len;
+        }
+    }
+    return sum;
+}
+
+static void report(const char *name, double best, size_t nodes, size_t size) {
+    char label[64];
+    snprintf(label, sizeof(label), "%s (%zu)", name, nodes);
+    bench_report_bytes(label, best, (double)size);
+}
+
+static void run(const char *name, cook_string_view_t text) {
+    printf("---------- %s, %zu MB ----------\n", name, text.len >> 20);
+    cook_json_node_t *tape = malloc(text.len*sizeof(*tape));
+    cook_json_t doc = {0}, arena_doc = {0};
+    cook_arena_t arena = {0};
+    cook_string_builder_t sb = {0};
+    double naive = 1e9, heap = 1e9, in_arena = 1e9, walked = 1e9;
+    size_t naive_count = 0;
+    for (int r = 0; r < RUNS; r++) {
+        double start = bench_now();
+        naive_count = naive_parse(text, tape);
+        double secs = bench_now() - start;
+        if (secs < naive) naive = secs;
+
+        start = bench_now();
+        cook_json_parse(&doc, text, NULL);
+        secs = bench_now() - start;
+        if (secs < heap) heap = secs;
+
+        start = bench_now();
+        cook_json_parse(&arena_doc, text, &arena);
+        secs = bench_now() - start;
+        if (secs < in_arena) in_arena = secs;
+        cook_arena_reset(&arena);
+
+        start = bench_now();
+        bench_sink((uint64_t)walk(doc.nodes, doc.len, &sb));
+        secs = bench_now() - start;
+        if (secs < walked) walked = secs;
+    }
+    report("recursive descent, byte loop", naive, naive_count, text.len);
+    report("cook_json_parse", heap, doc.len, text.len);
+    report("cook_json_parse, arena nodes", in_arena, doc.len, text.len);
+    report("  then numbers and strings", walked, doc.len, text.len);
+    bool same = naive_count == doc.len;
+    for (size_t i = 0; same && i < doc.len; i++) {
+        same = tape[i].sv.data == doc.nodes[i].sv.data && tape[i].sv.len == doc.nodes[i].sv.len &&
+               tape[i].skip == doc.nodes[i].skip && tape[i].count == doc.nodes[i].count;
+    }
+    if (!same) printf("    ^ tapes differ%s%s\n", doc.error ? ": " : "", doc.error ? doc.error : "");
+
+    cook_sb_free(&sb);
+    cook_arena_free(&arena);
+    cook_json_free(&arena_doc);
+    cook_json_free(&doc);
+    free(tape);
+}
+
+int main(int argc, char **argv)
+{
+    cook_string_view_t text = cook_sv_from_cstr(
+        "{\"users\": [{\"name\": \"Ada\", \"age\": 36, \"langs\": [\"en\", \"fr\"]},\n"
+        "            {\"name\": \"Jos\\u00e9 \\\"Pepe\\\"\", \"age\": 41, \"langs\": []}]}");
+    cook_json_t doc = {0};
+    cook_string_builder_t sb = {0};
+    if (cook_json_parse(&doc, text, NULL)) {
+        cook_json_iter_t it = cook_json_iter(cook_json_get(cook_json_root(&doc), "users"));
+        const cook_json_node_t *user;
+        while (cook_json_iter_next(&it, NULL, &user)) {
+            int64_t age = 0;
+            cook_json_int(cook_json_get(user, "age"), &age);
+            cook_sb_reset(&sb);
+            printf("["SV_FMT", %lld, %u langs] ", SV_ARG(cook_json_string(cook_json_get(user, "name"), &sb)),
+                   (long long)age, cook_json_get(user, "langs")->count);
+        }
+        printf("%zu nodes\n", doc.len);
+    }
+    // a NUL after the root is a trailing character like any other
+    cook_string_view_t bad[] = {cook_sv_from_cstr("{\"a\": [1, 2,]}"), cook_sv_from_parts("[1] \0", 5),
+                                cook_sv_from_parts("1 \0", 3), cook_sv_from_parts("\"a\"\0", 4)};
+    for (size_t i = 0; i < cook_arr_len(bad); i++) {
+        if (!cook_json_parse(&doc, bad[i], NULL)) printf("error: %s at offset %zu\n", doc.error, doc.error_offset);
+        else printf("    ^ input %zu parsed\n", i);
+    }
+    cook_json_free(&doc);
+    cook_sb_free(&sb);
+
+    size_t size = (size_t)256 << 20;
+    if (argc > 1) size = (size_t)strtoull(argv[1], NULL, 10) << 20;
+    void (*makers[])(cook_string_builder_t *, size_t) = {make_users, make_numbers, make_strings};
+    const char *shapes[] = {"API responses", "numeric arrays", "string-heavy logs"};
+    for (size_t i = 0; i < cook_arr_len(makers); i++) {
+        cook_string_builder_t json = {0};
+        makers[i](&json, size);
+        run(shapes[i], cook_sb_view(&json));
+        cook_sb_free(&json);
+    }
+    return 0;
+}
@@ -0,0 +1,139 @@
+#define _GNU_SOURCE
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+#include "bench.h"
+
+#define LOG_PATH "/tmp/cook_lines.log"
+
+static const char *levels[] = {"INFO", "WARN", "DEBUG", "ERROR"};
+static const char *paths[] = {"/", "/api/v1/users", "/static/app.js", "/api/v1/orders/search"};
+
+// writes up to @size bytes of log lines, every tenth one CRLF terminated,
+// returns the bytes written or 0
+static size_t write_log(const char *path, size_t size) {
+    FILE *fp = fopen(path, "wb");
+    if (!fp) return 0;
+    uint64_t rng = 41;
+    size_t len = 0;
+    while (len < size) {
+        char line[256];
+        uint64_t r = bench_rand(&rng);
+        int n = snprintf(line, sizeof(line), "2026-10-19T%02d:%02d:%02d %s worker-%d path=%s status=%d%s\n",
+                         (int)(r % 24), (int)(r >> 8) % 60, (int)(r >> 16) % 60, levels[(r >> 24) % 4],
+                         (int)(r >> 28) % 16, paths[(r >> 40) % 4], (r >> 44) % 8 ? 200 : 500,
+                         (r >> 48) % 10 ? "" : "\r");
+        if ((size_t)n > size - len) break;
+        fwrite(line, 1, (size_t)n, fp);
+        len += (size_t)n;
+    }
+    return fclose(fp) == 0 ? len : 0;
+}
+
+typedef struct totals {
+    size_t lines;
+    size_t bytes; // line bytes without line endings
+} totals_t;
+
+static totals_t getline_loop(const char *path) {
+    totals_t t = {0};
+    FILE *fp = fopen(path, "rb");
+    char *line = NULL;
+    size_t cap = 0;
+    ssize_t n;
+    while ((n = getline(&line, &cap, fp)) > 0) {
+        cook_string_view_t sv = cook_sv_chomp(cook_sv_from_parts(line, (size_t)n));
+        t.lines++;
+        t.bytes += sv.len;
+    }
+    free(line);
+    fclose(fp);
+    return t;
+}
+
+// the loop every tool started with: a byte loop for '\n', then chomp
+static totals_t byte_loop(cook_string_view_t text) {
+    totals_t t = {0};
+    size_t start = 0;
+    for (size_t i = 0; i < text.len; i++) {
+        if (text.data[i] != '\n') continue;
+        cook_string_view_t sv = cook_sv_chomp(cook_sv_from_parts(text.data + start, i - start));
+        t.lines++;
+        t.bytes += sv.len;
+        start = i + 1;
+    }
+    if (start < text.len) {
+        t.lines++;
+        t.bytes += text.len - start;
+    }
+    return t;
+}
+
+static totals_t line_iter(cook_string_view_t text) {
+    totals_t t = {0};
+    cook_sv_line_iter_t it = cook_sv_line_iter(text);
+    cook_string_view_t line;
+    while (cook_sv_line_next(&it, &line)) {
+        t.lines++;
+        t.bytes += line.len;
+    }
+    return t;
+}
+
+static void report(const char *name, double secs, totals_t t, size_t size) {
+    char label[64];
+    snprintf(label, sizeof(label), "%s (%zu)", name, t.lines);
+    bench_report_bytes(label, secs, (double)size);
+}
+
+int main(int argc, char **argv)
+{
+    cook_sv_line_iter_t it = cook_sv_line_iter(cook_sv_from_cstr("first\r\nsecond\n\nlast"));
+    cook_string_view_t line;
+    while (cook_sv_line_next(&it, &line)) printf("["SV_FMT"]", SV_ARG(line));
+    printf(" %zu lines\n", cook_sv_count_lines(cook_sv_from_cstr("first\r\nsecond\n\nlast")));
+
+    size_t size = (size_t)2 << 30;
+    if (argc > 1) size = (size_t)strtoull(argv[1], NULL, 10) << 20;
+    size = write_log(LOG_PATH, size);
+    if (size == 0) {
+        fprintf(stderr, "ERROR: could not write %s\n", LOG_PATH);
+        return 1;
+    }
+
+    printf("---------- %zu MB log file ----------\n", size >> 20);
+    double start = bench_now();
+    totals_t reference = getline_loop(LOG_PATH);
+    report("getline + cook_sv_chomp", bench_now() - start, reference, size);
+
+    // wc reads the file itself, the page cache is warm from getline
+    start = bench_now();
+    FILE *wc = popen("wc -l < "LOG_PATH, "r");
+    unsigned long long wc_lines = 0;
+    if (wc && fscanf(wc, "%llu", &wc_lines) == 1 && pclose(wc) == 0) {
+        report("wc -l", bench_now() - start, (totals_t){(size_t)wc_lines, 0}, size);
+    }
+
+    start = bench_now();
+    cook_string_view_t text = cook_sv_from_parts(cook_fs_readfile(LOG_PATH), size);
+    double read_secs = bench_now() - start;
+    bench_report_bytes("cook_fs_readfile", read_secs, (double)size);
+
+    start = bench_now();
+    totals_t bytes = byte_loop(text);
+    report("  + byte loop + cook_sv_chomp", bench_now() - start, bytes, size);
+    start = bench_now();
+    totals_t lines = line_iter(text);
+    report("  + cook_sv_line_next", bench_now() - start, lines, size);
+    start = bench_now();
+    size_t count = cook_sv_count_lines(text);
+    report("  + cook_sv_count_lines", bench_now() - start, (totals_t){count, 0}, size);
+
+    if (bytes.lines != reference.lines || bytes.bytes != reference.bytes ||
+        lines.lines != reference.lines || lines.bytes != reference.bytes || count != reference.lines) {
+        printf("    ^ results differ from getline\n");
+    }
+
+    cook_free((char *)text.data);
+    remove(LOG_PATH);
+    return 0;
+}
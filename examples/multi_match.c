@@ -0,0 +1,159 @@
+#define _GNU_SOURCE
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+#include "bench.h"
+
+// the per-pattern baseline slows down with every pattern, it only gets a
+// prefix of the log, NAIVE_BYTES/patterns long
+#define NAIVE_BYTES ((size_t)512 << 20)
+#define CHUNK_SIZE ((size_t)64 << 10)
+
+static const char *levels[] = {"INFO", "WARN", "DEBUG", "ERROR"};
+static const char *events[] = {"request served", "cache miss", "retrying upstream", "connection timeout",
+                               "worker panic", "connection refused", "slow query", "deadlock detected"};
+
+static char *make_log(size_t size) {
+    char *log = malloc(size);
+    uint64_t rng = 2026;
+    size_t len = 0;
+    while (len < size) {
+        char line[256];
+        uint64_t r = bench_rand(&rng);
+        // the last four events, the interesting ones, are rare
+        size_t event = (r >> 52) % 64 ? (r >> 40) % 4 : 4 + (r >> 40) % 4;
+        int n = snprintf(line, sizeof(line), "2026-10-19T%02d:%02d:%02d %s worker-%d user=u%05u %s dur=%ums\n",
+                         (int)(r % 24), (int)(r >> 8) % 60, (int)(r >> 16) % 60, levels[(r >> 24) % 4],
+                         (int)(r >> 28) % 16, (unsigned)(r >> 32) % 100000, events[event],
+                         (unsigned)(r >> 48) % 2000);
+        if (len + (size_t)n > size) break;
+        memcpy(log + len, line, (size_t)n);
+        len += (size_t)n;
+    }
+    memset(log + len, '\n', size - len);
+    return log;
+}
+
+// lines that contain any pattern, one memmem per pattern and line
+static size_t naive_lines(cook_string_view_t log, const cook_string_view_t *patterns, size_t count) {
+    size_t lines = 0;
+    while (log.len > 0) {
+        cook_string_view_t line = cook_sv_chop_by_delim(&log, '\n');
+        for (size_t p = 0; p < count; p++) {
+            if (memmem(line.data, line.len, patterns[p].data, patterns[p].len)) {
+                lines++;
+                break;
+            }
+        }
+    }
+    return lines;
+}
+
+// the same with one search over the whole log, skipping to the next line
+// after every hit
+static size_t cook_lines(cook_string_view_t log, const cook_matcher_t *m) {
+    size_t lines = 0;
+    cook_match_t match;
+    while (cook_matcher_find(m, log, &match)) {
+        lines++;
+        const char *eol = memchr(log.data + match.offset, '\n', log.len - match.offset);
+        size_t next = eol ? (size_t)(eol - log.data) + 1 : log.len;
+        log.data += next;
+        log.len -= next;
+    }
+    return lines;
+}
+
+static bool count_match(cook_match_t match, void *user) {
+    (void)match;
+    (*(size_t *)user)++;
+    return true;
+}
+
+// every match, fed in chunks as if read from a file
+static size_t cook_stream(cook_string_view_t log, const cook_matcher_t *m) {
+    size_t matches = 0;
+    cook_match_stream_t stream = {0};
+    for (size_t i = 0; i < log.len; i += CHUNK_SIZE) {
+        size_t n = log.len - i < CHUNK_SIZE ? log.len - i : CHUNK_SIZE;
+        cook_matcher_feed(m, &stream, cook_sv_from_parts(log.data + i, n), count_match, &matches);
+    }
+    return matches;
+}
+
+static void report(const char *name, double secs, size_t count, size_t bytes) {
+    char label[64];
+    snprintf(label, sizeof(label), "%s (%zu)", name, count);
+    bench_report_bytes(label, secs, (double)bytes);
+}
+
+static void run(const char *name, cook_string_view_t log, const cook_string_view_t *patterns, size_t count) {
+    cook_matcher_t m;
+    double start = bench_now();
+    cook_matcher_init(&m, patterns, count);
+    printf("---------- %s: %zu patterns, %zu states, compiled in %.3f ms ----------\n",
+           name, count, m.state_count, (bench_now() - start)*1e3);
+
+    size_t limit = NAIVE_BYTES/count;
+    cook_string_view_t prefix = cook_sv_from_parts(log.data, log.len < limit ? log.len : limit);
+    start = bench_now();
+    size_t naive = naive_lines(prefix, patterns, count);
+    report(prefix.len < log.len ? "lines, memmem per pattern, prefix" : "lines, memmem per pattern",
+           bench_now() - start, naive, prefix.len);
+    if (cook_lines(prefix, &m) != naive) printf("    ^ differs from cook_matcher_find\n");
+
+    start = bench_now();
+    size_t lines = cook_lines(log, &m);
+    report("lines, cook_matcher_find", bench_now() - start, lines, log.len);
+
+    start = bench_now();
+    size_t matches = cook_stream(log, &m);
+    report("matches, cook_matcher_feed", bench_now() - start, matches, log.len);
+    cook_matcher_free(&m);
+}
+
+static bool print_match(cook_match_t match, void *user) {
+    const cook_string_view_t *words = user;
+    printf(SV_FMT"@%zu ", SV_ARG(words[match.pattern]), match.offset);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    cook_string_view_t words[] = {cook_sv_from_cstr("he"), cook_sv_from_cstr("she"),
+                                  cook_sv_from_cstr("his"), cook_sv_from_cstr("hers")};
+    cook_matcher_t m;
+    cook_matcher_init(&m, words, cook_arr_len(words));
+    // a stream split in the middle of "hers"
+    cook_match_stream_t stream = {0};
+    cook_matcher_feed(&m, &stream, cook_sv_from_cstr("ushe h"), print_match, words);
+    cook_matcher_feed(&m, &stream, cook_sv_from_cstr("ers his"), print_match, words);
+    cook_match_t first;
+    cook_matcher_find(&m, cook_sv_from_cstr("ushers"), &first);
+    printf("| first in \"ushers\": "SV_FMT"@%zu\n", SV_ARG(words[first.pattern]), first.offset);
+    cook_matcher_free(&m);
+
+    size_t size = (size_t)1 << 30;
+    if (argc > 1) size = (size_t)strtoull(argv[1], NULL, 10) << 20;
+    cook_string_view_t log = cook_sv_from_parts(make_log(size), size);
+
+    cook_string_view_t alerts[] = {cook_sv_from_cstr("timeout"), cook_sv_from_cstr("panic"),
+                                   cook_sv_from_cstr("refused"), cook_sv_from_cstr("deadlock"),
+                                   cook_sv_from_cstr("segfault"), cook_sv_from_cstr("out of memory")};
+    run("alert keywords", log, alerts, cook_arr_len(alerts));
+
+    // a watch list of users, about 1 line in 200 hits one
+    size_t count = 500;
+    char (*names)[16] = malloc(count*sizeof(*names));
+    cook_string_view_t *users = malloc(count*sizeof(*users));
+    uint64_t rng = 40;
+    for (size_t i = 0; i < count; i++) {
+        int n = snprintf(names[i], sizeof(names[i]), "user=u%05u ", (unsigned)(bench_rand(&rng) % 100000));
+        users[i] = cook_sv_from_parts(names[i], (size_t)n);
+    }
+    run("user watch list", log, users, count);
+
+    free(users);
+    free(names);
+    free((char *)log.data);
+    return 0;
+}
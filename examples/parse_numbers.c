@@ -0,0 +1,135 @@
+#define _GNU_SOURCE
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+#include "bench.h"
+
+// rows of "id,count,price,ratio\n", the shape of a typical numeric CSV
+static cook_string_view_t make_csv(size_t rows) {
+    cook_string_builder_t sb = {0};
+    uint64_t rng = 36;
+    for (size_t i = 0; i < rows; i++) {
+        uint64_t r = bench_rand(&rng);
+        double price = (double)(r >> 40)/100.0;
+        double ratio = (double)(bench_rand(&rng) >> 11)*0x1p-53;
+        cook_sb_append(&sb, "%zu,%d,%.2f,%.17g\n", i, (int)(r % 2000001) - 1000000, price, ratio);
+    }
+    return cook_sb_view(&sb);
+}
+
+typedef struct totals {
+    int64_t ints;
+    double floats;
+    size_t count;
+} totals_t;
+
+// strtol/strtod need NUL-terminated input, which the CSV happens to be
+static totals_t parse_libc(cook_string_view_t csv, double *out) {
+    totals_t t = {0};
+    const char *p = csv.data, *end = csv.data + csv.len;
+    while (p < end) {
+        char *next;
+        t.ints += strtoll(p, &next, 10);
+        t.ints += strtol(next + 1, &next, 10);
+        for (int i = 0; i < 2; i++) {
+            out[t.count++] = strtod(next + 1, &next);
+        }
+        p = next + 1;
+    }
+    return t;
+}
+
+static totals_t parse_cook(cook_string_view_t csv, double *out) {
+    totals_t t = {0};
+    while (csv.len > 0) {
+        int64_t id = 0;
+        int32_t count = 0;
+        size_t n = cook_sv_parse_i64(csv, &id);
+        n += 1 + cook_sv_parse_i32(cook_sv_from_parts(csv.data + n + 1, csv.len - n - 1), &count);
+        t.ints += id + count;
+        for (int i = 0; i < 2; i++) {
+            n += 1 + cook_sv_parse_f64(cook_sv_from_parts(csv.data + n + 1, csv.len - n - 1), &out[t.count++]);
+        }
+        csv.data += n + 1;
+        csv.len -= n + 1;
+    }
+    return t;
+}
+
+int main(int argc, char **argv)
+{
+    cook_string_view_t cell = cook_sv_from_cstr("-42,3.5e2,0xff");
+    int32_t i;
+    double d;
+    uint64_t h;
+    size_t n = cook_sv_parse_i32(cell, &i);
+    n += 1 + cook_sv_parse_f64(cook_sv_from_parts(cell.data + n + 1, cell.len - n - 1), &d);
+    cook_sv_parse_hex(cook_sv_from_parts(cell.data + n + 1, cell.len - n - 1), &h);
+    printf("%d %g %llu\n", i, d, (unsigned long long)h);
+
+    // more than 19 digits right at, just above and just below the point
+    // halfway between two floats, where only all the digits decide
+    const char *halfway[] = {
+        "9007199254740993", "9007199254740993.0000000000000000000001", "9007199254740992.9999999999999999999999",
+        "1.00000005960464477539062500000000001", "1.000000059604644775390625", "1.00000005960464477539062499999999999",
+        "179769313486231580793728971405303415079934132710037826936173778980444968292764750946649017977587207096330"
+        "286416692887910946555547851940402630657488671505820681908902000708383676273854845817711531764475730270069"
+        "855571366959622842914819860834936475292719074168444365510704342711559699508093042880177904174497792",
+        "4.9406564584124654417656879286822137236505980e-324",
+        "2.4703282292062327208828439643411068618252990130716238221279284125033775363510437593264991818081799618989"
+        "828234772285886546332835517796989819938739800539093906315035659515570226392290858392449105184435931802849"
+        "936536152500319370457678249219365623669863658480757001585769269903706311928279558551332927834338409351978"
+        "015531246597263579574622766465272827220056374006485499977096599470454020828166226237857393450736339007967"
+        "761930577506740176324673600968951340535537458516661134223766678604162159680461914467291840300530057530849"
+        "048765391711386591646239524912623653881879636239373280423891018672348497668235089863388587925628302755995"
+        "657524455507255189313690836254779186948667994968324049705821028513185451396213837722826145437693412532098"
+        "591327667236328125e-324",
+        "2.4703282292062327208828439643411068618252990130716238221279284125033775363510437593264991818081799618989"
+        "828234772285886546332835517796989819938739800539093906315035659515570226392290858392449105184435931802849"
+        "936536152500319370457678249219365623669863658480757001585769269903706311928279558551332927834338409351978"
+        "015531246597263579574622766465272827220056374006485499977096599470454020828166226237857393450736339007967"
+        "761930577506740176324673600968951340535537458516661134223766678604162159680461914467291840300530057530849"
+        "048765391711386591646239524912623653881879636239373280423891018672348497668235089863388587925628302755995"
+        "657524455507255189313690836254779186948667994968324049705821028513185451396213837722826145437693412532098"
+        "5913276672363281250000000000000000000000000000001e-324",
+    };
+    size_t halfway_mismatches = 0;
+    for (size_t k = 0; k < cook_arr_len(halfway); k++) {
+        double expect = strtod(halfway[k], NULL);
+        float expect_f = strtof(halfway[k], NULL), f;
+        cook_sv_parse_f64(cook_sv_from_cstr(halfway[k]), &d);
+        cook_sv_parse_f32(cook_sv_from_cstr(halfway[k]), &f);
+        halfway_mismatches += memcmp(&d, &expect, sizeof(d)) != 0 || memcmp(&f, &expect_f, sizeof(f)) != 0;
+    }
+    printf("halfway cases: %zu, mismatches: %zu\n", cook_arr_len(halfway), halfway_mismatches);
+
+    size_t rows = 2000000;
+    if (argc > 1) rows = (size_t)strtoull(argv[1], NULL, 10);
+    cook_string_view_t csv = make_csv(rows);
+    double *libc_floats = malloc(rows*2*sizeof(double));
+    double *cook_floats = malloc(rows*2*sizeof(double));
+
+    printf("---------- parsing %zu rows, %zu MB ----------\n", rows, csv.len >> 20);
+    double start = bench_now();
+    totals_t libc = parse_libc(csv, libc_floats);
+    double libc_secs = bench_now() - start;
+    start = bench_now();
+    totals_t cook = parse_cook(csv, cook_floats);
+    double cook_secs = bench_now() - start;
+
+    bench_report_bytes("strtoll/strtol/strtod", libc_secs, (double)csv.len);
+    bench_report_ops("  numbers", libc_secs, (double)rows*4);
+    bench_report_bytes("cook_sv_parse_i64/i32/f64", cook_secs, (double)csv.len);
+    bench_report_ops("  numbers", cook_secs, (double)rows*4);
+
+    // the floats have to match bit for bit, not just compare equal
+    size_t mismatches = libc.count != cook.count || libc.ints != cook.ints;
+    for (size_t k = 0; k < libc.count && k < cook.count; k++) {
+        mismatches += memcmp(&libc_floats[k], &cook_floats[k], sizeof(double)) != 0;
+    }
+    printf("mismatches: %zu\n", mismatches);
+
+    free(libc_floats);
+    free(cook_floats);
+    free((char *)csv.data);
+    return mismatches != 0 || halfway_mismatches != 0;
+}
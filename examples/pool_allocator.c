@@ -0,0 +1,121 @@
+#define _GNU_SOURCE
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+#include "bench.h"
+
+#include <pthread.h>
+
+#define N_OPS     2000000
+#define N_LIVE    1024
+#define N_THREADS 4
+
+typedef struct node {
+    struct node *next;
+    int value;
+    char payload[40];
+} node_t;
+
+static cook_pool_t shared_pool;
+
+static void bench_malloc_pairs(size_t n) {
+    void *live[N_LIVE] = {0};
+    for (size_t i = 0; i < n; i++) {
+        size_t k = i % N_LIVE;
+        free(live[k]);
+        live[k] = malloc(sizeof(node_t));
+    }
+    for (size_t k = 0; k < N_LIVE; k++) free(live[k]);
+}
+
+static void bench_pool_pairs(cook_pool_t *pool, size_t n) {
+    void *live[N_LIVE] = {0};
+    for (size_t i = 0; i < n; i++) {
+        size_t k = i % N_LIVE;
+        cook_pool_free(pool, live[k]);
+        live[k] = cook_pool_alloc(pool);
+    }
+    cook_pool_free_bulk(pool, live, N_LIVE);
+}
+
+static void *malloc_worker(void *arg) {
+    (void) arg;
+    bench_malloc_pairs(N_OPS);
+    return NULL;
+}
+
+static void *pool_worker(void *arg) {
+    (void) arg;
+    bench_pool_pairs(&shared_pool, N_OPS);
+    return NULL;
+}
+
+static void *pool_cache_worker(void *arg) {
+    (void) arg;
+    cook_pool_cache_t cache;
+    cook_pool_cache_init(&cache, &shared_pool);
+    void *live[N_LIVE] = {0};
+    for (size_t i = 0; i < N_OPS; i++) {
+        size_t k = i % N_LIVE;
+        cook_pool_cache_free(&cache, live[k]);
+        live[k] = cook_pool_cache_alloc(&cache);
+    }
+    for (size_t k = 0; k < N_LIVE; k++) cook_pool_cache_free(&cache, live[k]);
+    cook_pool_cache_flush(&cache);
+    return NULL;
+}
+
+static double run_threads(void *(*worker)(void *)) {
+    pthread_t threads[N_THREADS];
+    double start = bench_now();
+    for (int i = 0; i < N_THREADS; i++) pthread_create(&threads[i], NULL, worker, NULL);
+    for (int i = 0; i < N_THREADS; i++) pthread_join(threads[i], NULL);
+    return bench_now() - start;
+}
+
+int main(void)
+{
+    cook_pool_t pool;
+    cook_pool_init(&pool, sizeof(node_t), 0);
+
+    // build a small linked list out of the pool
+    node_t *head = NULL;
+    for (int i = 0; i < 5; i++) {
+        node_t *n = cook_pool_alloc(&pool);
+        n->value = i;
+        n->next = head;
+        head = n;
+    }
+    for (node_t *n = head; n; n = n->next) printf("node: %d\n", n->value);
+    printf("live: %zu, total: %zu\n", pool.live, pool.total);
+
+    // the same pool through the generic allocator interface
+    cook_allocator_t *a = cook_pool_allocator(&pool);
+    node_t *extra = cook_allocator_alloc(a, sizeof(node_t));
+    // more than one object is more than the pool serves, extra stays valid
+    void *grown = cook_allocator_realloc(a, extra, sizeof(node_t), 2*pool.obj_size);
+    printf("realloc past obj_size: %s\n", grown ? "served" : "NULL");
+    cook_allocator_free(a, extra, sizeof(node_t));
+
+    cook_pool_reset(&pool);
+    printf("after reset live: %zu, total: %zu\n", pool.live, pool.total);
+
+    printf("---------- single thread, %d alloc/free pairs ----------\n", N_OPS);
+    double start = bench_now();
+    bench_malloc_pairs(N_OPS);
+    bench_report_ops("malloc/free", bench_now() - start, N_OPS);
+
+    start = bench_now();
+    bench_pool_pairs(&pool, N_OPS);
+    bench_report_ops("cook_pool_alloc/free", bench_now() - start, N_OPS);
+
+    printf("---------- %d threads, %d alloc/free pairs each ----------\n", N_THREADS, N_OPS);
+    cook_pool_init(&shared_pool, sizeof(node_t), 0);
+    bench_report_ops("malloc/free", run_threads(malloc_worker), (double)N_OPS*N_THREADS);
+    bench_report_ops("cook_pool_alloc/free (shared)", run_threads(pool_worker), (double)N_OPS*N_THREADS);
+    bench_report_ops("cook_pool_cache_alloc/free", run_threads(pool_cache_worker), (double)N_OPS*N_THREADS);
+    printf("shared pool live: %zu, total: %zu\n", shared_pool.live, shared_pool.total);
+
+    cook_pool_destroy(&shared_pool);
+    cook_pool_destroy(&pool);
+    return 0;
+}
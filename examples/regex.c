@@ -0,0 +1,115 @@
+#define _GNU_SOURCE
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+#include "bench.h"
+#include <regex.h>
+
+#define RUNS 3
+
+static const char *levels[] = {"INFO", "WARN", "DEBUG", "ERROR"};
+static const char *events[] = {"request done", "connection refused", "cache miss", "connection timed out",
+                               "retrying", "connection reset by peer"};
+
+// log lines like the ones grep is pointed at
+static cook_string_view_t make_log(size_t size) {
+    cook_string_builder_t sb = {0};
+    uint64_t rng = 45;
+    while (sb.len < size) {
+        uint64_t r = bench_rand(&rng);
+        cook_sb_append(&sb, "2026-10-19T%02d:%02d:%02d %s worker-%d %s status=%d bytes=%u\n", (int)(r % 24),
+                       (int)(r >> 8) % 60, (int)(r >> 16) % 60, levels[(r >> 24) % 4], (int)(r >> 28) % 16,
+                       events[(r >> 32) % 6], (r >> 40) % 8 ? 200 : 500 + (int)(r >> 44) % 4, (unsigned)(r >> 48));
+    }
+    return cook_sb_view(&sb);
+}
+
+// regexec() on every line, REG_STARTEND saves the copy to a C string
+static size_t posix_count(const regex_t *re, cook_string_view_t text) {
+    size_t matches = 0;
+    cook_sv_line_iter_t it = cook_sv_line_iter(text);
+    cook_string_view_t line;
+    while (cook_sv_line_next(&it, &line)) {
+        regmatch_t range = {.rm_so = 0, .rm_eo = (regoff_t)line.len};
+        matches += regexec(re, line.data, 1, &range, REG_STARTEND) == 0;
+    }
+    return matches;
+}
+
+static size_t cook_count(cook_regex_t *re, cook_string_view_t text) {
+    size_t matches = 0;
+    cook_sv_line_iter_t it = cook_sv_line_iter(text);
+    cook_string_view_t line;
+    while (cook_sv_line_next(&it, &line)) matches += cook_regex_match(re, line);
+    return matches;
+}
+
+static void report(const char *name, double secs, size_t matches, size_t size) {
+    char label[64];
+    snprintf(label, sizeof(label), "%s (%zu)", name, matches);
+    bench_report_bytes(label, secs, (double)size);
+}
+
+static void run(const char *pattern, cook_string_view_t text) {
+    regex_t posix;
+    cook_regex_t re;
+    if (regcomp(&posix, pattern, REG_EXTENDED | REG_NOSUB) != 0) {
+        printf("regcomp rejects %s\n", pattern);
+        return;
+    }
+    if (!cook_regex_init(&re, cook_sv_from_cstr(pattern))) {
+        printf("cook_regex_init rejects %s: %s at %zu\n", pattern, re.error, re.error_offset);
+        regfree(&posix);
+        return;
+    }
+    printf("---------- \"%s\" ----------\n", pattern);
+    double best[2] = {1e9, 1e9};
+    size_t found[2] = {0};
+    for (int r = 0; r < RUNS; r++) {
+        double start = bench_now();
+        found[0] = posix_count(&posix, text);
+        double secs = bench_now() - start;
+        if (secs < best[0]) best[0] = secs;
+
+        start = bench_now();
+        found[1] = cook_count(&re, text);
+        secs = bench_now() - start;
+        if (secs < best[1]) best[1] = secs;
+    }
+    report("regexec, line by line", best[0], found[0], text.len);
+    report("cook_regex_match, line by line", best[1], found[1], text.len);
+    printf("    %zu DFA states, %zu cache resets\n", re.state_count, re.cache_resets);
+    if (found[0] != found[1]) printf("    ^ counts differ\n");
+    cook_regex_free(&re);
+    regfree(&posix);
+}
+
+int main(int argc, char **argv)
+{
+    cook_regex_t re;
+    if (cook_regex_init(&re, cook_sv_from_cstr("\\w+@\\w+\\.(com|org)"))) {
+        const char *texts[] = {"mail ada@example.org now", "no address here", "bob@host.com"};
+        for (size_t i = 0; i < cook_arr_len(texts); i++) {
+            printf("[%s] %s\n", texts[i], cook_regex_match(&re, cook_sv_from_cstr(texts[i])) ? "matches" : "does not match");
+        }
+        cook_regex_free(&re);
+    }
+    if (!cook_regex_init(&re, cook_sv_from_cstr("(a|b"))) printf("error: %s at offset %zu\n", re.error, re.error_offset);
+
+    size_t size = (size_t)64 << 20;
+    if (argc > 1) size = (size_t)strtoull(argv[1], NULL, 10) << 20;
+    cook_string_view_t text = make_log(size);
+    printf("---------- %zu MB of log lines ----------\n", text.len >> 20);
+
+    const char *patterns[] = {
+        "connection (refused|timed out)", // a literal every match starts with
+        "status=5[0-9]{2}",
+        "^2026-10-19T0[0-9]:[0-5][0-9]",
+        "(ERROR|WARN) worker-1[0-5] ",    // no common literal
+        "bytes=[0-9]*(1|3|5|7|9)$",
+        "(.*[0-9]){12}x",                 // many ways to match, never does
+    };
+    for (size_t i = 0; i < cook_arr_len(patterns); i++) run(patterns[i], text);
+
+    free((char *)text.data);
+    return 0;
+}
@@ -0,0 +1,191 @@
+#define _GNU_SOURCE
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+#include "bench.h"
+
+#define WRITE_PATH "/tmp/cook_rope.txt"
+#define EDITS (1 << 20)
+#define FLAT_EDITS 64 // each one moves half the document
+
+static const char *words[] = {"the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "lorem", "ipsum",
+                              "dolor", "sit", "amet", "consectetur", "adipiscing", "elit"};
+
+// lines of words, like a large log or source file
+static cook_string_view_t make_text(size_t size) {
+    cook_string_builder_t sb = {0};
+    uint64_t rng = 46;
+    while (sb.len < size) {
+        uint64_t r = bench_rand(&rng);
+        cook_sb_append_sv(&sb, cook_sv_from_cstr(words[r % 16]));
+        cook_sb_append_parts(&sb, (r >> 4) % 12 ? " " : "\n", 1);
+    }
+    return cook_sb_view(&sb);
+}
+
+typedef struct edit {
+    size_t pos;
+    size_t len;
+    bool insert; // insert @len bytes of the typed text, or delete @len bytes
+} edit_t;
+
+static const char typed[] = "the quick brown fox jumps over the lazy dog, THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG";
+
+static cook_string_view_t typed_text(const edit_t *e) {
+    return cook_sv_from_parts(typed + e->pos % 32, e->len);
+}
+
+// inserts and deletes of 1-32 bytes anywhere in the document
+static edit_t *random_edits(size_t len, size_t count) {
+    edit_t *edits = malloc(count*sizeof(*edits));
+    uint64_t rng = 47;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t r = bench_rand(&rng);
+        edits[i] = (edit_t){(r >> 6) % (len + 1), r % 32 + 1, (r >> 5) & 1};
+        if (edits[i].insert) {
+            len += edits[i].len;
+        } else if (edits[i].pos < len) {
+            len -= edits[i].len < len - edits[i].pos ? edits[i].len : len - edits[i].pos;
+        }
+    }
+    return edits;
+}
+
+// a cursor that types one byte at a time, backspaces now and then and
+// jumps somewhere else every 256 edits
+static edit_t *typing_edits(size_t len, size_t count) {
+    edit_t *edits = malloc(count*sizeof(*edits));
+    uint64_t rng = 48;
+    size_t cursor = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t r = bench_rand(&rng);
+        if (i % 256 == 0) cursor = (r >> 8) % (len + 1);
+        if (r % 8 == 0 && cursor > 0) {
+            edits[i] = (edit_t){--cursor, 1, false};
+            len--;
+        } else {
+            edits[i] = (edit_t){cursor++, 1, true};
+            len++;
+        }
+    }
+    return edits;
+}
+
+// what editing a flat buffer costs: everything after the edit moves
+static void flat_edit(cook_string_builder_t *sb, const edit_t *e) {
+    if (e->insert) {
+        cook_sb_reserve(sb, e->len);
+        memmove(sb->items + e->pos + e->len, sb->items + e->pos, sb->len - e->pos);
+        memcpy(sb->items + e->pos, typed_text(e).data, e->len);
+        sb->len += e->len;
+    } else if (e->pos < sb->len) {
+        size_t len = e->len < sb->len - e->pos ? e->len : sb->len - e->pos;
+        memmove(sb->items + e->pos, sb->items + e->pos + len, sb->len - e->pos - len);
+        sb->len -= len;
+    }
+}
+
+static void rope_edit(cook_rope_t *rope, const edit_t *e) {
+    if (e->insert) {
+        cook_rope_insert(rope, e->pos, typed_text(e));
+    } else {
+        cook_rope_delete(rope, e->pos, e->len);
+    }
+}
+
+static long file_write(cook_writer_t *w, const void *data, size_t size) {
+    size_t n = fwrite(data, 1, size, w->ctx);
+    return n > 0 ? (long)n : -1;
+}
+
+// time per operation, the flat builder does too few for Mops/s to say much
+static void report(const char *name, double secs, size_t count, size_t pieces) {
+    char label[64];
+    snprintf(label, sizeof(label), "%s (%zu)", name, pieces);
+    printf("%-40s %10.3f ms %12.3f us/op\n", label, secs*1e3, secs/(double)count*1e6);
+}
+
+static void run(const char *name, cook_string_view_t text, const edit_t *edits) {
+    printf("---------- %s, %zu MB ----------\n", name, text.len >> 20);
+    cook_string_builder_t flat = {0};
+    cook_sb_append_sv(&flat, text);
+    double start = bench_now();
+    for (size_t i = 0; i < FLAT_EDITS; i++) flat_edit(&flat, &edits[i]);
+    report("string builder, memmove", bench_now() - start, FLAT_EDITS, 1);
+
+    // the same edits, to check the rope against the builder
+    cook_rope_t rope;
+    cook_rope_init(&rope, text);
+    for (size_t i = 0; i < FLAT_EDITS; i++) rope_edit(&rope, &edits[i]);
+    cook_string_builder_t sb = {0};
+    cook_rope_flatten(&rope, &sb);
+    if (sb.len != flat.len || memcmp(sb.items, flat.items, sb.len) != 0) printf("    ^ texts differ\n");
+    cook_rope_free(&rope);
+
+    cook_rope_init(&rope, text);
+    start = bench_now();
+    for (size_t i = 0; i < EDITS; i++) rope_edit(&rope, &edits[i]);
+    report("cook_rope_insert/delete", bench_now() - start, EDITS, rope.pieces);
+
+    uint64_t rng = 49, sum = 0;
+    size_t len = cook_rope_len(&rope);
+    start = bench_now();
+    for (size_t i = 0; i < EDITS; i++) sum += (unsigned char)cook_rope_index(&rope, bench_rand(&rng) % len);
+    report("cook_rope_index", bench_now() - start, EDITS, rope.pieces);
+    bench_sink(sum);
+
+    cook_sb_reset(&sb);
+    start = bench_now();
+    cook_rope_flatten(&rope, &sb);
+    bench_report_bytes("cook_rope_flatten", bench_now() - start, (double)sb.len);
+
+    FILE *fp = fopen(WRITE_PATH, "wb");
+    if (fp) {
+        cook_writer_t w = {.ctx = fp, .write = file_write};
+        start = bench_now();
+        bool written = cook_rope_write(&rope, &w) && fflush(fp) == 0;
+        double secs = bench_now() - start;
+        fclose(fp);
+        if (written) bench_report_bytes("cook_rope_write (file)", secs, (double)len);
+        // the same bytes in one piece, for comparison
+        fp = fopen(WRITE_PATH, "wb");
+        start = bench_now();
+        written = fp && fwrite(sb.items, 1, sb.len, fp) == sb.len && fflush(fp) == 0;
+        secs = bench_now() - start;
+        if (fp) fclose(fp);
+        if (written) bench_report_bytes("fwrite of the flattened text", secs, (double)sb.len);
+        remove(WRITE_PATH);
+    }
+
+    cook_rope_free(&rope);
+    cook_sb_free(&sb);
+    cook_sb_free(&flat);
+}
+
+int main(int argc, char **argv)
+{
+    cook_rope_t demo;
+    cook_rope_init(&demo, cook_sv_from_cstr("hello world"));
+    cook_rope_insert(&demo, 5, cook_sv_from_cstr(","));
+    cook_rope_delete(&demo, 0, 1);
+    cook_rope_insert(&demo, 0, cook_sv_from_cstr("H"));
+    cook_rope_insert(&demo, cook_rope_len(&demo), cook_sv_from_cstr("!"));
+    cook_rope_iter_t it = cook_rope_iter(&demo, 0);
+    cook_string_view_t chunk;
+    while (cook_rope_iter_next(&it, &chunk)) printf("["SV_FMT"]", SV_ARG(chunk));
+    printf(" %zu bytes, %zu pieces, [7] = '%c'\n", cook_rope_len(&demo), demo.pieces, cook_rope_index(&demo, 7));
+    cook_rope_free(&demo);
+
+    size_t size = (size_t)256 << 20;
+    if (argc > 1) size = (size_t)strtoull(argv[1], NULL, 10) << 20;
+    cook_string_view_t text = make_text(size);
+
+    edit_t *edits = random_edits(text.len, EDITS);
+    run("random inserts and deletes of 1-32 bytes", text, edits);
+    free(edits);
+    edits = typing_edits(text.len, EDITS);
+    run("typing, a new place every 256 edits", text, edits);
+    free(edits);
+
+    free((char *)text.data);
+    return 0;
+}
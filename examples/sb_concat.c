@@ -0,0 +1,139 @@
+#define _GNU_SOURCE
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+#include "bench.h"
+
+#define RUNS 3
+#define BLOCK 4096 // pieces, a thousand "key=value;" records
+
+static const char *keys[] = {"id", "name", "status", "region", "latency_ms", "bytes", "path", "user"};
+static const char *values[] = {"42", "ada", "ok", "eu-west-1", "12", "65536", "/api/v1/users", "grace", "timeout",
+                               "us-east-2", "404", "0"};
+
+static size_t make_block(cook_string_view_t *pieces) {
+    uint64_t rng = 49;
+    size_t len = 0;
+    for (size_t i = 0; i < BLOCK; i += 4) {
+        uint64_t r = bench_rand(&rng);
+        pieces[i] = cook_sv_from_cstr(keys[r % 8]);
+        pieces[i + 1] = cook_sv_from_cstr("=");
+        pieces[i + 2] = cook_sv_from_cstr(values[(r >> 8) % 12]);
+        pieces[i + 3] = cook_sv_from_cstr(";");
+        len += pieces[i].len + pieces[i + 1].len + pieces[i + 2].len + pieces[i + 3].len;
+    }
+    return len;
+}
+
+// what code without a builder does: grow to the exact length every time
+static char *exact_realloc(const cook_string_view_t *pieces, size_t blocks, size_t *len) {
+    char *buf = NULL;
+    *len = 0;
+    for (size_t b = 0; b < blocks; b++) {
+        for (size_t i = 0; i < BLOCK; i++) {
+            buf = realloc(buf, *len + pieces[i].len);
+            memcpy(buf + *len, pieces[i].data, pieces[i].len);
+            *len += pieces[i].len;
+        }
+    }
+    return buf;
+}
+
+static void report(const char *name, double secs, size_t len, size_t grows) {
+    char label[64];
+    snprintf(label, sizeof(label), "%s (%zu grows)", name, grows);
+    bench_report_bytes(label, secs, (double)len);
+}
+
+int main(int argc, char **argv)
+{
+    cook_string_builder_t sb = {0};
+    cook_string_view_t dir = cook_sv_from_cstr("src"), name = cook_sv_from_cstr("cook");
+    cook_sb_concat(&sb, dir, cook_sv_from_cstr("/"), name, cook_sv_from_cstr(".c"));
+    cook_sb_append_parts(&sb, " ", 1);
+    cook_string_view_t flags[] = {cook_sv_from_cstr("-Wall"), cook_sv_from_cstr("-Wextra"), cook_sv_from_cstr("-O2")};
+    cook_sb_join(&sb, flags, cook_arr_len(flags), cook_sv_from_cstr(" "));
+    printf(SV_FMT"\n", SV_ARG(cook_sb_view(&sb)));
+    cook_sb_free(&sb);
+
+    size_t size = (size_t)100 << 20;
+    if (argc > 1) size = (size_t)strtoull(argv[1], NULL, 10) << 20;
+    static cook_string_view_t pieces[BLOCK];
+    size_t block_len = make_block(pieces), blocks = size/block_len + 1;
+    printf("---------- %zu MB from %zu pieces ----------\n", (blocks*block_len) >> 20, blocks*BLOCK);
+
+    char *naive = NULL;
+    size_t len = 0, grows[3] = {0};
+    double best[5] = {1e9, 1e9, 1e9, 1e9, 1e9};
+    cook_string_builder_t each = {0}, records = {0}, joined = {0}, reserved = {0};
+    for (int r = 0; r < RUNS; r++) {
+        // every run starts from nothing, growing is part of what is measured
+        free(naive);
+        cook_sb_free(&each);
+        cook_sb_free(&records);
+        cook_sb_free(&joined);
+        cook_sb_free(&reserved);
+
+        double start = bench_now();
+        naive = exact_realloc(pieces, blocks, &len);
+        double secs = bench_now() - start;
+        if (secs < best[0]) best[0] = secs;
+
+        grows[0] = 0;
+        start = bench_now();
+        for (size_t b = 0; b < blocks; b++) {
+            for (size_t i = 0; i < BLOCK; i++) {
+                size_t cap = each.cap;
+                cook_sb_append_sv(&each, pieces[i]);
+                grows[0] += each.cap != cap;
+            }
+        }
+        secs = bench_now() - start;
+        if (secs < best[1]) best[1] = secs;
+
+        grows[1] = 0;
+        start = bench_now();
+        for (size_t b = 0; b < blocks; b++) {
+            for (size_t i = 0; i < BLOCK; i += 4) {
+                size_t cap = records.cap;
+                cook_sb_concat(&records, pieces[i], pieces[i + 1], pieces[i + 2], pieces[i + 3]);
+                grows[1] += records.cap != cap;
+            }
+        }
+        secs = bench_now() - start;
+        if (secs < best[2]) best[2] = secs;
+
+        grows[2] = 0;
+        start = bench_now();
+        for (size_t b = 0; b < blocks; b++) {
+            size_t cap = joined.cap;
+            cook_sb_join(&joined, pieces, BLOCK, cook_sv_from_cstr(""));
+            grows[2] += joined.cap != cap;
+        }
+        secs = bench_now() - start;
+        if (secs < best[3]) best[3] = secs;
+
+        start = bench_now();
+        cook_sb_reserve(&reserved, blocks*block_len);
+        for (size_t b = 0; b < blocks; b++) cook_sb_join(&reserved, pieces, BLOCK, cook_sv_from_cstr(""));
+        secs = bench_now() - start;
+        if (secs < best[4]) best[4] = secs;
+    }
+    report("realloc to the exact length", best[0], len, blocks*BLOCK);
+    report("cook_sb_append_sv", best[1], each.len, grows[0]);
+    report("cook_sb_concat, a record a call", best[2], records.len, grows[1]);
+    report("cook_sb_join, a block a call", best[3], joined.len, grows[2]);
+    report("  after cook_sb_reserve", best[4], reserved.len, 1);
+
+    cook_string_view_t expected = cook_sv_from_parts(naive, len);
+    if (!cook_sv_equal(cook_sb_view(&each), expected) || !cook_sv_equal(cook_sb_view(&records), expected) ||
+        !cook_sv_equal(cook_sb_view(&joined), expected) || !cook_sv_equal(cook_sb_view(&reserved), expected)) {
+        printf("    ^ results differ\n");
+    }
+
+    cook_sb_free(&reserved);
+    cook_sb_free(&joined);
+    cook_sb_free(&records);
+    cook_sb_free(&each);
+    free(naive);
+    return 0;
+}
@@ -0,0 +1,116 @@
+#define _GNU_SOURCE
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+#include "bench.h"
+
+#define RUNS 4
+
+static const char *levels[] = {"INFO", "WARN", "DEBUG", "ERROR"};
+static const char *paths[] = {"/", "/api/v1/users", "/static/app.js", "/api/v1/orders/search"};
+
+// format in a scratch arena, then strlen and copy
+#define scratch_append(sb, fmt, ...)                                          \
+    do {                                                                      \
+        cook_scratch_t scratch = cook_scratch_get();                          \
+        const char *cstr = cook_arena_strfmt(scratch.arena, fmt, __VA_ARGS__); \
+        cook_sb_append_parts(sb, cstr, strlen(cstr));                         \
+        cook_scratch_end(scratch);                                            \
+    } while (0)
+
+// what cook_sb_append did as a macro: the same through the 8 KB temporary
+// buffer
+#define temp_append(sb, fmt, ...)                               \
+    do {                                                        \
+        size_t mark = cook_temp_save();                         \
+        const char *cstr = cook_temp_strfmt(fmt, __VA_ARGS__);  \
+        if (cstr) cook_sb_append_parts(sb, cstr, strlen(cstr)); \
+        cook_temp_rewind(mark);                                 \
+    } while (0)
+
+#define LOG_FMT "2026-10-19T%02d:%02d:%02d %s worker-%d path=%s status=%d bytes=%u\n"
+#define LOG_ARGS(r) (int)((r) % 24), (int)((r) >> 8) % 60, (int)((r) >> 16) % 60, levels[((r) >> 24) % 4], \
+                    (int)((r) >> 28) % 16, paths[((r) >> 40) % 4], ((r) >> 44) % 8 ? 200 : 500, (unsigned)((r) >> 48)
+
+static void report(const char *name, double secs, size_t bytes, size_t lines) {
+    char label[64];
+    snprintf(label, sizeof(label), "%s (%zu)", name, bytes);
+    bench_report_ops(label, secs, (double)lines);
+}
+
+int main(int argc, char **argv)
+{
+    cook_string_builder_t sb = {0};
+    cook_sb_appendf(&sb, "%s has %d bytes, ", "this", 42);
+    cook_sb_appendf(&sb, "and %.*s", 3, "onetwo");
+    printf(SV_FMT"\n", SV_ARG(cook_sb_view(&sb)));
+    // the builder's own bytes as argument need the copying cook_sb_append
+    cook_sb_append(&sb, " | %.*s", (int)sb.len, sb.items);
+    printf(SV_FMT"\n", SV_ARG(cook_sb_view(&sb)));
+
+    // longer than the temporary buffer
+    cook_sb_reset(&sb);
+    cook_sb_appendf(&sb, "[%*s]", 20000, "padded");
+    printf("%zu bytes formatted, temp buffer holds %d\n", sb.len, COOK_TEMP_BUFFER_CAP);
+    // and a copy of itself, formatted in a scratch arena
+    cook_sb_append(&sb, "%.*s", (int)sb.len, sb.items);
+    printf("%zu bytes after appending itself\n", sb.len);
+
+    size_t lines = (size_t)1 << 20;
+    if (argc > 1) lines = (size_t)strtoull(argv[1], NULL, 10) << 10;
+    printf("---------- %zu log lines ----------\n", lines);
+    double best[4] = {1e9, 1e9, 1e9, 1e9};
+    size_t bytes[4] = {0};
+    for (int run = 0; run < RUNS; run++) {
+        uint64_t rng = 47;
+        cook_sb_reset(&sb);
+        double start = bench_now();
+        for (size_t i = 0; i < lines; i++) {
+            uint64_t r = bench_rand(&rng);
+            temp_append(&sb, LOG_FMT, LOG_ARGS(r));
+        }
+        double secs = bench_now() - start;
+        if (secs < best[0]) best[0] = secs;
+        bytes[0] = sb.len;
+
+        rng = 47;
+        cook_sb_reset(&sb);
+        start = bench_now();
+        for (size_t i = 0; i < lines; i++) {
+            uint64_t r = bench_rand(&rng);
+            scratch_append(&sb, LOG_FMT, LOG_ARGS(r));
+        }
+        secs = bench_now() - start;
+        if (secs < best[1]) best[1] = secs;
+        bytes[1] = sb.len;
+
+        rng = 47;
+        cook_sb_reset(&sb);
+        start = bench_now();
+        for (size_t i = 0; i < lines; i++) {
+            uint64_t r = bench_rand(&rng);
+            cook_sb_appendf(&sb, LOG_FMT, LOG_ARGS(r));
+        }
+        secs = bench_now() - start;
+        if (secs < best[2]) best[2] = secs;
+        bytes[2] = sb.len;
+
+        rng = 47;
+        cook_sb_reset(&sb);
+        start = bench_now();
+        for (size_t i = 0; i < lines; i++) {
+            uint64_t r = bench_rand(&rng);
+            cook_sb_append(&sb, LOG_FMT, LOG_ARGS(r));
+        }
+        secs = bench_now() - start;
+        if (secs < best[3]) best[3] = secs;
+        bytes[3] = sb.len;
+    }
+    report("temp buffer, strlen, copy", best[0], bytes[0], lines);
+    report("scratch arena, strlen, copy", best[1], bytes[1], lines);
+    report("cook_sb_appendf", best[2], bytes[2], lines);
+    report("cook_sb_append, copy", best[3], bytes[3], lines);
+    if (bytes[0] != bytes[2] || bytes[1] != bytes[2] || bytes[3] != bytes[2]) printf("    ^ lengths differ\n");
+
+    cook_sb_free(&sb);
+    return 0;
+}
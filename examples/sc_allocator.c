@@ -0,0 +1,98 @@
+#define _GNU_SOURCE
+#define COOK_ALLOC(size)        cook_sc_malloc(size)
+#define COOK_REALLOC(ptr, size) cook_sc_realloc(ptr, size)
+#define COOK_FREE(ptr)          cook_sc_free(ptr)
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+#include "bench.h"
+
+#include <pthread.h>
+
+#define N_OPS     2000000
+#define N_SLOTS   4096
+#define N_THREADS 4
+
+typedef struct numbers {
+    int *items;
+    size_t len;
+    size_t cap;
+} numbers_t;
+
+typedef struct allocator {
+    const char *name;
+    void *(*alloc)(size_t size);
+    void (*free)(void *ptr);
+    void (*thread_exit)(void);
+} allocator_t_;
+
+static void *libc_malloc(size_t size) { return malloc(size); }
+static void libc_free(void *ptr) { free(ptr); }
+
+static const allocator_t_ allocators[] = {
+    {"malloc/free",          libc_malloc,    libc_free,    NULL},
+    {"cook_sc_malloc/free",  cook_sc_malloc, cook_sc_free, cook_sc_thread_flush},
+};
+
+// mostly small objects, now and then a bigger one, freed in random order
+static size_t random_size(uint64_t *rng) {
+    uint64_t r = bench_rand(rng);
+    if (r % 64 == 0) return 1024 + r % 8192;
+    return 8 + (r >> 8) % 248;
+}
+
+static void *worker(void *arg) {
+    const allocator_t_ *a = arg;
+    void *slots[N_SLOTS] = {0};
+    uint64_t rng = (uint64_t)(uintptr_t)&slots | 1;
+    for (size_t i = 0; i < N_OPS; i++) {
+        size_t k = bench_rand(&rng) % N_SLOTS;
+        a->free(slots[k]);
+        slots[k] = a->alloc(random_size(&rng));
+        *(char *)slots[k] = 1;
+    }
+    for (size_t k = 0; k < N_SLOTS; k++) a->free(slots[k]);
+    if (a->thread_exit) a->thread_exit();
+    return NULL;
+}
+
+static double run_threads(const allocator_t_ *a, int n) {
+    pthread_t threads[N_THREADS];
+    double start = bench_now();
+    for (int i = 0; i < n; i++) pthread_create(&threads[i], NULL, worker, (void *)a);
+    for (int i = 0; i < n; i++) pthread_join(threads[i], NULL);
+    return bench_now() - start;
+}
+
+int main(void)
+{
+    // all of cook runs on the size-class allocator now
+    numbers_t numbers = {0};
+    for (int i = 0; i < 100000; i++) cook_vec_push(&numbers, i);
+    cook_string_builder_t sb = {0};
+    for (int i = 0; i < 1000; i++) cook_sb_append(&sb, "%d,", i);
+    printf("vec len: %zu, sb len: %zu, usable: %zu\n",
+           numbers.len, sb.len, cook_sc_usable_size(sb.items));
+    cook_vec_free(&numbers);
+    cook_sb_free(&sb);
+
+    for (int n = 1; n <= N_THREADS; n *= 2) {
+        printf("---------- %d thread(s), %d random alloc/free each ----------\n", n, N_OPS);
+        for (size_t i = 0; i < cook_arr_len(allocators); i++) {
+            double secs = run_threads(&allocators[i], n);
+            bench_report_ops(allocators[i].name, secs, (double)N_OPS*n);
+        }
+    }
+
+    // leave a fragmented heap behind: keep every 8th object alive
+    static void *keep[N_SLOTS*8];
+    uint64_t rng = 7;
+    for (size_t i = 0; i < cook_arr_len(keep); i++) keep[i] = cook_sc_malloc(random_size(&rng));
+    for (size_t i = 0; i < cook_arr_len(keep); i++) {
+        if (i % 8) cook_sc_free(keep[i]);
+    }
+    cook_sc_thread_flush();
+    cook_sc_report();
+    for (size_t i = 0; i < cook_arr_len(keep); i += 8) cook_sc_free(keep[i]);
+
+    return 0;
+}
@@ -0,0 +1,49 @@
+#define _GNU_SOURCE
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+
+#include <ctype.h>
+#include <pthread.h>
+
+// builds its result in @out and needs scratch memory of its own
+static const char *shout_path(cook_arena_t *out, const char *dir, const char *name) {
+    cook_scratch_t scratch = cook_scratch_get(out);
+    const char *path = cook_arena_strfmt(scratch.arena, "%s/%s", dir, name);
+    char *result = cook_arena_memdup(out, path, strlen(path) + 1);
+    for (char *c = result; *c; c++) *c = (char)toupper((unsigned char)*c);
+    cook_scratch_end(scratch);
+    return result;
+}
+
+static void *worker(void *arg) {
+    cook_string_builder_t sb = {0};
+    cook_scratch_t scratch = cook_scratch_get();
+    for (int i = 0; i < 3; i++) {
+        const char *part = cook_arena_strfmt(scratch.arena, "[thread %d: %d]", *(int *)arg, i);
+        cook_sb_append_parts(&sb, part, strlen(part));
+    }
+    cook_scratch_end(scratch);
+    printf("%.*s\n", (int)sb.len, sb.items);
+    cook_sb_free(&sb);
+    cook_scratch_release();
+    return NULL;
+}
+
+int main(void)
+{
+    // the caller's result lives in a scratch arena too, shout_path() is
+    // handed the other one and cannot rewind the caller's memory
+    COOK_SCRATCH_SCOPE(outer) {
+        const char *a = shout_path(outer.arena, "usr", "lib");
+        const char *b = shout_path(outer.arena, "usr", "share");
+        printf("%s %s\n", a, b);
+    }
+
+    pthread_t threads[2];
+    int ids[2] = {0, 1};
+    for (int i = 0; i < 2; i++) pthread_create(&threads[i], NULL, worker, &ids[i]);
+    for (int i = 0; i < 2; i++) pthread_join(threads[i], NULL);
+
+    cook_scratch_release();
+    return 0;
+}
@@ -0,0 +1,115 @@
+#define _GNU_SOURCE
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+#include "bench.h"
+
+#include <ctype.h>
+
+#define BYTES_PER_RUN ((size_t)1 << 30)
+
+typedef void (*op_fn)(char *dst, cook_string_view_t src);
+
+static void memcpy_op(char *dst, cook_string_view_t src) { memcpy(dst, src.data, src.len); }
+static void cook_lower_op(char *dst, cook_string_view_t src) { cook_ascii_lower(dst, src); }
+static void cook_upper_op(char *dst, cook_string_view_t src) { cook_ascii_upper(dst, src); }
+static void cook_replace_op(char *dst, cook_string_view_t src) { cook_ascii_replace(dst, src, ' ', '_'); }
+static void cook_digits_op(char *dst, cook_string_view_t src) { *dst = cook_sv_is_digits(src); }
+static void cook_trim_op(char *dst, cook_string_view_t src) { *dst = (char)cook_sv_trim_space(src).len; }
+
+static void ctype_lower_op(char *dst, cook_string_view_t src) {
+    for (size_t i = 0; i < src.len; i++) dst[i] = (char)tolower((unsigned char)src.data[i]);
+}
+static void ctype_upper_op(char *dst, cook_string_view_t src) {
+    for (size_t i = 0; i < src.len; i++) dst[i] = (char)toupper((unsigned char)src.data[i]);
+}
+static void loop_replace_op(char *dst, cook_string_view_t src) {
+    for (size_t i = 0; i < src.len; i++) dst[i] = src.data[i] == ' ' ? '_' : src.data[i];
+}
+static void ctype_digits_op(char *dst, cook_string_view_t src) {
+    size_t i = 0;
+    while (i < src.len && isdigit((unsigned char)src.data[i])) i++;
+    *dst = i == src.len;
+}
+static void ctype_trim_op(char *dst, cook_string_view_t src) {
+    size_t begin = 0, end = src.len;
+    while (begin < end && isspace((unsigned char)src.data[begin])) begin++;
+    while (end > begin && isspace((unsigned char)src.data[end - 1])) end--;
+    *dst = (char)(end - begin);
+}
+
+typedef struct op {
+    const char *name;
+    op_fn cook;
+    op_fn baseline;
+    bool digits; // run on an all-digit input
+    bool padded; // run on an input that is whitespace except in the middle
+} op_t;
+
+static const op_t ops[] = {
+    {"lower       vs tolower loop",  cook_lower_op,   ctype_lower_op,  false, false},
+    {"upper       vs toupper loop",  cook_upper_op,   ctype_upper_op,  false, false},
+    {"replace     vs byte loop",     cook_replace_op, loop_replace_op, false, false},
+    {"is_digits   vs isdigit loop",  cook_digits_op,  ctype_digits_op, true,  false},
+    {"trim_space  vs isspace loops", cook_trim_op,    ctype_trim_op,   false, true},
+};
+
+static double gbps(op_fn fn, char *dst, cook_string_view_t src) {
+    size_t reps = BYTES_PER_RUN/src.len;
+    if (reps == 0) reps = 1;
+    double start = bench_now();
+    for (size_t i = 0; i < reps; i++) {
+        fn(dst, src);
+        bench_sink((uint64_t)dst[0]);
+    }
+    return (double)reps*src.len/(bench_now() - start)/1e9;
+}
+
+int main(void)
+{
+    cook_string_builder_t sb = {0};
+    cook_sb_append(&sb, "Hello, World from cook %d", 42);
+    cook_sb_to_upper(&sb);
+    cook_sb_replace_byte(&sb, ' ', '_');
+    cook_string_view_t padded = cook_sv_from_cstr(" \t\r\n  trimmed\v\f ");
+    cook_byteset_t quotes = cook_byteset_make(cook_sv_from_cstr("'\" "));
+    printf("%.*s | '"SV_FMT"' | '"SV_FMT"' | digits: %d %d\n", (int)sb.len, sb.items,
+           SV_ARG(cook_sv_trim_space(padded)), SV_ARG(cook_sv_trim_set(cook_sv_from_cstr(" 'hi' "), &quotes)),
+           cook_sv_is_digits(cook_sv_from_cstr("20261019")), cook_sv_is_digits(cook_sv_from_cstr("12a4")));
+    cook_sb_free(&sb);
+
+    size_t max_size = (size_t)256 << 20;
+    char *text = malloc(max_size);
+    char *digits = malloc(max_size);
+    char *blanks = malloc(max_size);
+    char *dst = malloc(max_size);
+    memset(dst, 0, max_size); // fault it in, memcpy runs first
+    uint64_t rng = 7;
+    for (size_t i = 0; i < max_size; i++) {
+        uint64_t r = bench_rand(&rng);
+        text[i] = "The Quick brown FOX, jumps over 13 lazy dogs. "[r % 46];
+        digits[i] = (char)('0' + r % 10);
+        blanks[i] = " \t\n\r"[r % 4];
+    }
+
+    const size_t sizes[] = {64, 16 << 10, max_size};
+    printf("%-30s %10s %14s %12s %12s\n", "", "size", "memcpy GB/s", "libc GB/s", "cook GB/s");
+    for (size_t s = 0; s < cook_arr_len(sizes); s++) {
+        size_t size = sizes[s];
+        blanks[size/2] = 'x';
+        double copy = gbps(memcpy_op, dst, cook_sv_from_parts(text, size));
+        for (size_t i = 0; i < cook_arr_len(ops); i++) {
+            const char *input = ops[i].digits ? digits : ops[i].padded ? blanks : text;
+            cook_string_view_t src = cook_sv_from_parts(input, size);
+            double base = gbps(ops[i].baseline, dst, src);
+            double cook = gbps(ops[i].cook, dst, src);
+            printf("%-30s %10zu %14.2f %12.2f %12.2f\n", ops[i].name, size, copy, base, cook);
+        }
+        blanks[size/2] = ' ';
+    }
+
+    free(text);
+    free(digits);
+    free(blanks);
+    free(dst);
+    return 0;
+}
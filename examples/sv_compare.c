@@ -0,0 +1,88 @@
+#define _GNU_SOURCE
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+#include "bench.h"
+
+#include <strings.h>
+
+// every run does the same number of comparisons
+#define COMPARES 20000000
+
+typedef int (*compare_fn)(cook_string_view_t a, cook_string_view_t b);
+
+static int memcmp_compare(cook_string_view_t a, cook_string_view_t b) {
+    int r = memcmp(a.data, b.data, a.len < b.len ? a.len : b.len);
+    return r ? r : (a.len > b.len) - (a.len < b.len);
+}
+
+// the keys are NUL-free, so strncasecmp sees all of the shorter one
+static int strncasecmp_compare(cook_string_view_t a, cook_string_view_t b) {
+    int r = strncasecmp(a.data, b.data, a.len < b.len ? a.len : b.len);
+    return r ? r : (a.len > b.len) - (a.len < b.len);
+}
+
+static int by_sv(const void *a, const void *b) {
+    return cook_sv_compare(*(const cook_string_view_t *)a, *(const cook_string_view_t *)b);
+}
+
+// @prefix bytes shared by every key, then @tail random bytes from @alphabet
+static cook_string_view_t *make_keys(size_t count, size_t prefix, size_t tail, const char *alphabet, uint64_t seed) {
+    size_t len = prefix + tail, k = strlen(alphabet);
+    char *text = malloc(count*len);
+    cook_string_view_t *keys = malloc(count*sizeof(*keys));
+    uint64_t rng = seed;
+    for (size_t i = 0; i < count; i++) {
+        char *key = text + i*len;
+        memset(key, 'p', prefix);
+        // short keys vary in length too
+        size_t n = tail > 8 ? tail - bench_rand(&rng) % 8 : tail;
+        for (size_t j = 0; j < n; j++) key[prefix + j] = alphabet[bench_rand(&rng) % k];
+        keys[i] = cook_sv_from_parts(key, prefix + n);
+    }
+    return keys;
+}
+
+static void run(const char *name, compare_fn fn, const cook_string_view_t *keys, size_t count) {
+    size_t rounds = COMPARES/(count - 1);
+    double start = bench_now();
+    int64_t sum = 0;
+    for (size_t r = 0; r < rounds; r++) {
+        for (size_t i = 0; i + 1 < count; i++) sum += fn(keys[i], keys[i + 1]) < 0;
+    }
+    double secs = bench_now() - start;
+    bench_sink((uint64_t)sum);
+    printf("%-40s %10.2f ns/compare\n", name, secs*1e9/((double)rounds*(count - 1)));
+}
+
+int main(void)
+{
+    const char *words[] = {"pear", "Apple", "apple", "app", "Banana", "apples"};
+    cook_string_view_t sorted[6];
+    for (size_t i = 0; i < 6; i++) sorted[i] = cook_sv_from_cstr(words[i]);
+    qsort(sorted, 6, sizeof(sorted[0]), by_sv);
+    for (size_t i = 0; i < 6; i++) printf(SV_FMT" ", SV_ARG(sorted[i]));
+    printf("| nocase(Apple, apple) = %d, common prefix(app, apples) = %zu\n",
+           cook_sv_compare_nocase(sorted[0], sorted[3]), cook_sv_common_prefix(sorted[2], sorted[4]));
+
+    struct {
+        const char *name;
+        size_t count, prefix, tail;
+        const char *alphabet;
+    } sets[] = {
+        // the long keys stay in L2 so the compare loop is what gets measured
+        {"short keys (8-16 bytes)",        100000, 0,    16, "ab"},
+        {"long shared prefix (1 KB + 16)", 1000,   1024, 16, "ab"},
+        {"random strings (56-64 bytes)",   100000, 0,    64, "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"},
+    };
+    for (size_t s = 0; s < cook_arr_len(sets); s++) {
+        cook_string_view_t *keys = make_keys(sets[s].count, sets[s].prefix, sets[s].tail, sets[s].alphabet, s + 1);
+        printf("---------- %s ----------\n", sets[s].name);
+        run("memcmp", memcmp_compare, keys, sets[s].count);
+        run("cook_sv_compare", cook_sv_compare, keys, sets[s].count);
+        run("strncasecmp", strncasecmp_compare, keys, sets[s].count);
+        run("cook_sv_compare_nocase", cook_sv_compare_nocase, keys, sets[s].count);
+        free((char *)keys[0].data);
+        free(keys);
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+#define _GNU_SOURCE
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+#include "bench.h"
+
+#define BYTES_PER_RUN ((size_t)256 << 20)
+
+typedef struct search {
+    const char *name;
+    size_t (*cook)(cook_string_view_t sv);
+    size_t (*libc)(cook_string_view_t sv);
+} search_t;
+
+static const char needle[] = "needle!";
+
+static size_t cook_find_char(cook_string_view_t sv) { return cook_sv_find_char(sv, '!'); }
+static size_t cook_rfind_char(cook_string_view_t sv) { return cook_sv_rfind_char(sv, '^'); }
+static size_t cook_find_any(cook_string_view_t sv) { return cook_sv_find_any(sv, cook_sv_from_cstr("!?;")); }
+static size_t cook_count_char(cook_string_view_t sv) { return cook_sv_count_char(sv, 'e'); }
+static size_t cook_find(cook_string_view_t sv) {
+    return cook_sv_find(sv, cook_sv_from_parts(needle, sizeof(needle) - 1));
+}
+
+static size_t libc_find_char(cook_string_view_t sv) {
+    const char *p = memchr(sv.data, '!', sv.len);
+    return p ? (size_t)(p - sv.data) : COOK_SV_NPOS;
+}
+static size_t libc_rfind_char(cook_string_view_t sv) {
+    const char *p = memrchr(sv.data, '^', sv.len);
+    return p ? (size_t)(p - sv.data) : COOK_SV_NPOS;
+}
+static size_t libc_find_any(cook_string_view_t sv) {
+    // sv.data is NUL-terminated right after sv.len bytes
+    return strcspn(sv.data, "!?;");
+}
+static size_t libc_count_char(cook_string_view_t sv) {
+    size_t count = 0;
+    for (const char *p = sv.data, *end = sv.data + sv.len; (p = memchr(p, 'e', (size_t)(end - p))); p++) count++;
+    return count;
+}
+static size_t libc_find(cook_string_view_t sv) {
+    const char *p = memmem(sv.data, sv.len, needle, sizeof(needle) - 1);
+    return p ? (size_t)(p - sv.data) : COOK_SV_NPOS;
+}
+
+static const search_t searches[] = {
+    {"find_char    vs memchr",  cook_find_char,  libc_find_char},
+    {"rfind_char   vs memrchr", cook_rfind_char, libc_rfind_char},
+    {"find_any     vs strcspn", cook_find_any,   libc_find_any},
+    {"find         vs memmem",  cook_find,       libc_find},
+    {"count_char   vs memchr",  cook_count_char, libc_count_char},
+};
+
+static double gbps(size_t (*fn)(cook_string_view_t), cook_string_view_t sv, size_t *result) {
+    size_t reps = BYTES_PER_RUN/sv.len;
+    double start = bench_now();
+    for (size_t i = 0; i < reps; i++) {
+        *result = fn(sv);
+        bench_sink(*result);
+    }
+    return (double)reps*sv.len/(bench_now() - start)/1e9;
+}
+
+int main(void)
+{
+    cook_string_view_t line = cook_sv_from_cstr("name=cook;version=0.9.0;license=MIT");
+    printf("find ';' at %zu, last '=' at %zu, 'version' at %zu, %zu '=' in total\n",
+           cook_sv_find_char(line, ';'), cook_sv_rfind_char(line, '='),
+           cook_sv_find(line, cook_sv_from_cstr("version")), cook_sv_count_char(line, '='));
+
+    // lowercase text without any of the searched bytes, the match sits at
+    // the far end (the front for rfind) so every byte has to be looked at
+    size_t max_size = (size_t)100 << 20;
+    char *text = malloc(max_size + 1);
+    uint64_t rng = 99;
+    for (size_t i = 0; i < max_size; i++) text[i] = "etaoinshrdlu    "[bench_rand(&rng) % 16];
+
+    const size_t sizes[] = {16, 256, 4096, 64 << 10, 1 << 20, (size_t)100 << 20};
+    printf("%-26s %10s %12s %12s\n", "", "size", "libc GB/s", "cook GB/s");
+    for (size_t s = 0; s < cook_arr_len(sizes); s++) {
+        size_t size = sizes[s];
+        char saved = text[size];
+        text[size] = '\0';
+        text[size - 1] = '!';
+        text[0] = '^';
+        if (size >= sizeof(needle)) memcpy(text + size - sizeof(needle) + 1, needle, sizeof(needle) - 1);
+
+        cook_string_view_t sv = cook_sv_from_parts(text, size);
+        for (size_t i = 0; i < cook_arr_len(searches); i++) {
+            size_t a, b;
+            double libc = gbps(searches[i].libc, sv, &a);
+            double cook = gbps(searches[i].cook, sv, &b);
+            printf("%-26s %10zu %12.2f %12.2f%s\n", searches[i].name, size, libc, cook,
+                   a == b ? "" : "  MISMATCH");
+        }
+
+        text[0] = 'e';
+        text[size - 1] = 'e';
+        if (size >= sizeof(needle)) memset(text + size - sizeof(needle) + 1, 'e', sizeof(needle) - 1);
+        text[size] = saved;
+    }
+
+    free(text);
+    return 0;
+}
@@ -0,0 +1,95 @@
+#define _GNU_SOURCE
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+#include "bench.h"
+
+typedef struct views {
+    cook_string_view_t *items;
+    size_t len;
+    size_t cap;
+} views_t;
+
+static const char *dirs[] = {"/usr/lib/x86_64-linux-gnu/", "/usr/share/doc/", "/home/user/src/project/", "/var/log/"};
+static const char *exts[] = {".so", ".h", ".c", ".txt", ".log"};
+
+// keys point into one builder, the views are made after it stops moving
+static views_t make_keys(cook_string_builder_t *sb, size_t count, bool paths) {
+    uint64_t rng = paths ? 1 : 2;
+    size_t *ends = malloc(count*sizeof(*ends));
+    for (size_t i = 0; i < count; i++) {
+        uint64_t r = bench_rand(&rng);
+        if (paths) {
+            cook_sb_append(sb, "%spkg-%u/module%u/file%u%s", dirs[r % 4], (unsigned)(r >> 8) % 500,
+                           (unsigned)(r >> 20) % 50, (unsigned)(r >> 32) % 1000, exts[(r >> 44) % 5]);
+        } else {
+            cook_sb_append(sb, "2026-10-19T%02u:%02u:%02u.%06u host-%02u worker-%u",
+                           (unsigned)(r % 24), (unsigned)(r >> 8) % 60, (unsigned)(r >> 16) % 60,
+                           (unsigned)(r >> 24) % 1000000, (unsigned)(r >> 44) % 32, (unsigned)(r >> 50) % 16);
+        }
+        ends[i] = sb->len;
+    }
+    views_t keys = {0};
+    for (size_t i = 0, begin = 0; i < count; begin = ends[i++]) {
+        cook_vec_push(&keys, cook_sv_from_parts(sb->items + begin, ends[i] - begin));
+    }
+    free(ends);
+    return keys;
+}
+
+static int memcmp_compare(const void *a, const void *b) {
+    const cook_string_view_t *x = a, *y = b;
+    int r = memcmp(x->data, y->data, x->len < y->len ? x->len : y->len);
+    return r ? r : (x->len > y->len) - (x->len < y->len);
+}
+
+static void qsort_views(cook_string_view_t *items, size_t count) {
+    qsort(items, count, sizeof(*items), memcmp_compare);
+}
+
+static void sort_parallel(cook_string_view_t *items, size_t count) {
+    cook_sv_sort_parallel(items, count, 0);
+}
+
+static void run(const char *name, void (*sort)(cook_string_view_t *, size_t), const views_t *keys,
+                const cook_string_view_t *expected) {
+    cook_string_view_t *items = malloc(keys->len*sizeof(*items));
+    memcpy(items, keys->items, keys->len*sizeof(*items));
+    double start = bench_now();
+    sort(items, keys->len);
+    double secs = bench_now() - start;
+    bool sorted = true;
+    for (size_t i = 0; expected && i < keys->len; i++) sorted &= cook_sv_equal(items[i], expected[i]);
+    bench_report_ops(name, secs, (double)keys->len);
+    if (!sorted) printf("    ^ differs from qsort\n");
+    if (!expected) memcpy((cook_string_view_t *)keys->items, items, keys->len*sizeof(*items));
+    free(items);
+}
+
+int main(int argc, char **argv)
+{
+    views_t names = {0};
+    const char *words[] = {"src/main.c", "src/cook.h", "README.md", "src/", "LICENSE", "src/main.c"};
+    for (size_t i = 0; i < cook_arr_len(words); i++) cook_vec_push(&names, cook_sv_from_cstr(words[i]));
+    cook_vec_sort_sv(&names);
+    cook_vec_foreach(cook_string_view_t, &names, name) printf(SV_FMT" ", SV_ARG(*name));
+    printf("\n");
+    cook_vec_free(&names);
+
+    size_t count = 2000000;
+    if (argc > 1) count = (size_t)strtoull(argv[1], NULL, 10);
+    for (int paths = 1; paths >= 0; paths--) {
+        cook_string_builder_t sb = {0};
+        views_t keys = make_keys(&sb, count, paths);
+        printf("---------- %zu %s ----------\n", count, paths ? "paths" : "log keys");
+        // the qsort result is the reference, kept in a copy of the keys
+        views_t reference = {0};
+        for (size_t i = 0; i < keys.len; i++) cook_vec_push(&reference, keys.items[i]);
+        run("qsort + memcmp", qsort_views, &reference, NULL);
+        run("cook_sv_sort", cook_sv_sort, &keys, reference.items);
+        run("cook_sv_sort_parallel", sort_parallel, &keys, reference.items);
+        cook_vec_free(&reference);
+        cook_vec_free(&keys);
+        cook_sb_free(&sb);
+    }
+    return 0;
+}
@@ -0,0 +1,123 @@
+#define _GNU_SOURCE
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+#include "bench.h"
+
+#include <ctype.h>
+
+static const char *levels[] = {"INFO", "WARN", "DEBUG", "ERROR"};
+static const char *paths[] = {"/", "/api/v1/users", "/static/app.js", "/api/v1/orders/search"};
+
+static char *make_log(size_t size) {
+    char *log = malloc(size);
+    uint64_t rng = 2026;
+    size_t len = 0;
+    while (len < size) {
+        char line[256];
+        uint64_t r = bench_rand(&rng);
+        int n = snprintf(line, sizeof(line),
+                         "2026-10-19T%02d:%02d:%02d %s worker-%d request id=%u path=%s status=%d dur=%ums\n",
+                         (int)(r % 24), (int)(r >> 8) % 60, (int)(r >> 16) % 60, levels[(r >> 24) % 4],
+                         (int)(r >> 28) % 16, (unsigned)(r >> 32) % 100000, paths[(r >> 40) % 4],
+                         (r >> 44) % 8 ? 200 : 500, (unsigned)(r >> 48) % 2000);
+        if (len + (size_t)n > size) break;
+        memcpy(log + len, line, (size_t)n);
+        len += (size_t)n;
+    }
+    memset(log + len, '\n', size - len);
+    return log;
+}
+
+static size_t naive_lines(cook_string_view_t log) {
+    size_t lines = 0;
+    for (size_t i = 0; i < log.len; i++) lines += log.data[i] == '\n';
+    return lines;
+}
+
+static size_t cook_lines(cook_string_view_t log) {
+    size_t lines = 0;
+    while (log.len > 0) {
+        cook_sv_chop_by_delim(&log, '\n');
+        lines++;
+    }
+    return lines;
+}
+
+static size_t naive_fields(cook_string_view_t log) {
+    size_t fields = 0;
+    bool in_field = false;
+    for (size_t i = 0; i < log.len; i++) {
+        char c = log.data[i];
+        bool delim = c == ' ' || c == '=' || c == '\n';
+        if (delim && in_field) fields++;
+        in_field = !delim;
+    }
+    return fields;
+}
+
+static size_t cook_fields(cook_string_view_t log) {
+    size_t fields = 0;
+    while (log.len > 0) {
+        cook_string_view_t line = cook_sv_chop_by_delim(&log, '\n');
+        cook_sv_split_iter_t it = cook_sv_split_iter(line, cook_sv_from_cstr(" ="));
+        cook_string_view_t field;
+        while (cook_sv_split_next(&it, &field)) fields += field.len > 0;
+    }
+    return fields;
+}
+
+static size_t naive_words(cook_string_view_t log) {
+    size_t words = 0;
+    size_t i = 0;
+    while (i < log.len) {
+        while (i < log.len && isspace((unsigned char)log.data[i])) i++;
+        if (i == log.len) break;
+        while (i < log.len && !isspace((unsigned char)log.data[i])) i++;
+        words++;
+    }
+    return words;
+}
+
+static size_t cook_words(cook_string_view_t log) {
+    size_t words = 0;
+    while (cook_sv_chop_by_space(&log).len > 0) words++;
+    return words;
+}
+
+static void run(const char *name, size_t (*fn)(cook_string_view_t), cook_string_view_t log) {
+    double start = bench_now();
+    size_t count = fn(log);
+    double secs = bench_now() - start;
+    char label[64];
+    snprintf(label, sizeof(label), "%s (%zu)", name, count);
+    bench_report_bytes(label, secs, (double)log.len);
+}
+
+int main(int argc, char **argv)
+{
+    cook_string_view_t rest = cook_sv_from_cstr("GET /index.html HTTP/1.1");
+    cook_string_view_t method = cook_sv_chop_by_delim(&rest, ' ');
+    cook_string_view_t path = cook_sv_chop_by_delim(&rest, ' ');
+    printf("method: "SV_FMT", path: "SV_FMT", version: "SV_FMT"\n",
+           SV_ARG(method), SV_ARG(path), SV_ARG(rest));
+
+    cook_sv_split_iter_t it = cook_sv_split_iter(cook_sv_from_cstr("a,,b;c,"), cook_sv_from_cstr(",;"));
+    cook_string_view_t field;
+    while (cook_sv_split_next(&it, &field)) printf("["SV_FMT"]", SV_ARG(field));
+    printf("\n");
+
+    size_t size = (size_t)1 << 30;
+    if (argc > 1) size = (size_t)strtoull(argv[1], NULL, 10) << 20;
+    cook_string_view_t log = cook_sv_from_parts(make_log(size), size);
+
+    printf("---------- splitting a %zu MB log ----------\n", size >> 20);
+    run("lines, byte loop", naive_lines, log);
+    run("lines, cook_sv_chop_by_delim", cook_lines, log);
+    run("fields, byte loop", naive_fields, log);
+    run("fields, cook_sv_split_iter", cook_fields, log);
+    run("words, isspace loop", naive_words, log);
+    run("words, cook_sv_chop_by_space", cook_words, log);
+
+    free((char *)log.data);
+    return 0;
+}
@@ -0,0 +1,96 @@
+#define _GNU_SOURCE
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+#include "bench.h"
+
+#define REGION_SIZE (256u << 20)
+#define N_SLOTS     8192
+#define N_OPS       1000000
+
+typedef struct heap {
+    const char *name;
+    void *(*alloc)(void *ctx, size_t size);
+    void (*free)(void *ctx, void *ptr);
+    void *ctx;
+} heap_t;
+
+static void *libc_alloc(void *ctx, size_t size) { (void) ctx; return malloc(size); }
+static void libc_free(void *ctx, void *ptr) { (void) ctx; free(ptr); }
+static void *tlsf_alloc(void *ctx, size_t size) { return cook_tlsf_malloc(ctx, size); }
+static void tlsf_free(void *ctx, void *ptr) { cook_tlsf_free(ctx, ptr); }
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// mixed sizes freed in random order, so free memory ends up in many holes
+static size_t random_size(uint64_t *rng) {
+    uint64_t r = bench_rand(rng);
+    switch (r % 16) {
+    case 0:  return 4096 + (r >> 8) % (256*1024);
+    case 1:
+    case 2:  return 512 + (r >> 8) % 4096;
+    default: return 16 + (r >> 8) % 496;
+    }
+}
+
+static void run(const heap_t *heap, double *latency) {
+    static void *slots[N_SLOTS];
+    uint64_t rng = 1234;
+    memset(slots, 0, sizeof(slots));
+
+    for (size_t i = 0; i < N_OPS; i++) {
+        size_t k = bench_rand(&rng) % N_SLOTS;
+        heap->free(heap->ctx, slots[k]);
+        size_t size = random_size(&rng);
+
+        double start = bench_now();
+        slots[k] = heap->alloc(heap->ctx, size);
+        latency[i] = bench_now() - start;
+
+        if (!slots[k]) {
+            printf("%s: out of memory\n", heap->name);
+            exit(1);
+        }
+        *(char *)slots[k] = 1;
+    }
+    for (size_t k = 0; k < N_SLOTS; k++) heap->free(heap->ctx, slots[k]);
+
+    qsort(latency, N_OPS, sizeof(double), cmp_double);
+    printf("%-8s p50 %6.0f ns | p99 %6.0f ns | p99.99 %8.0f ns | max %9.0f ns\n", heap->name,
+           latency[N_OPS/2]*1e9, latency[N_OPS/100*99]*1e9,
+           latency[N_OPS/10000*9999]*1e9, latency[N_OPS - 1]*1e9);
+}
+
+int main(void)
+{
+    // fault the region in up front, latency-bound code would do the same
+    void *region = malloc(REGION_SIZE);
+    memset(region, 0, REGION_SIZE);
+    cook_tlsf_t *tlsf = cook_tlsf_create(region, REGION_SIZE);
+
+    char *p = cook_tlsf_malloc(tlsf, 100);
+    p = cook_tlsf_realloc(tlsf, p, 200);
+    printf("p = %p, free bytes = %zu\n", (void *)p, cook_tlsf_free_bytes(tlsf));
+    cook_tlsf_free(tlsf, p);
+
+    // a string builder growing inside the region through the allocator interface
+    cook_allocator_t *a = cook_tlsf_allocator(tlsf);
+    char *buf = cook_allocator_alloc(a, 16);
+    buf = cook_allocator_realloc(a, buf, 16, 4096);
+    cook_allocator_free(a, buf, 4096);
+    printf("free bytes after round trip = %zu\n", cook_tlsf_free_bytes(tlsf));
+
+    double *latency = malloc(N_OPS*sizeof(double));
+    const heap_t heaps[] = {
+        {"malloc", libc_alloc, libc_free, NULL},
+        {"tlsf",   tlsf_alloc, tlsf_free, tlsf},
+    };
+    printf("---------- %d allocations, fragmenting workload ----------\n", N_OPS);
+    for (size_t i = 0; i < cook_arr_len(heaps); i++) run(&heaps[i], latency);
+
+    free(latency);
+    free(region);
+    return 0;
+}
@@ -0,0 +1,129 @@
+#define _GNU_SOURCE
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+#include "bench.h"
+
+#define TEXT_SIZE ((size_t)64 << 20)
+#define RUNS 4
+
+// the usual byte-at-a-time decoder loop, as a baseline
+static size_t naive_validate(cook_string_view_t sv) {
+    const unsigned char *s = (const unsigned char *)sv.data;
+    size_t i = 0;
+    while (i < sv.len) {
+        unsigned c = s[i];
+        size_t len;
+        uint32_t cp, min;
+        if (c < 0x80) {
+            i++;
+            continue;
+        } else if ((c & 0xE0) == 0xC0) {
+            len = 2, cp = c & 0x1F, min = 0x80;
+        } else if ((c & 0xF0) == 0xE0) {
+            len = 3, cp = c & 0x0F, min = 0x800;
+        } else if ((c & 0xF8) == 0xF0) {
+            len = 4, cp = c & 0x07, min = 0x10000;
+        } else {
+            return i;
+        }
+        if (sv.len - i < len) return i;
+        for (size_t k = 1; k < len; k++) {
+            if ((s[i + k] & 0xC0) != 0x80) return i;
+            cp = cp << 6 | (s[i + k] & 0x3F);
+        }
+        if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) return i;
+        i += len;
+    }
+    return sv.len;
+}
+
+static size_t cook_validate(cook_string_view_t sv) { return cook_utf8_validate(sv); }
+static size_t cook_count(cook_string_view_t sv) { return cook_utf8_count(sv); }
+
+static size_t iterate(cook_string_view_t sv) {
+    size_t count = 0;
+    uint32_t cp;
+    while (cook_utf8_next(&sv, &cp)) count += cp != COOK_UTF8_REPLACEMENT;
+    return count;
+}
+
+static cook_string_builder_t out = {0};
+
+static size_t to_utf16(cook_string_view_t sv) {
+    cook_sb_reset(&out);
+    cook_sb_append_utf16(&out, sv);
+    return out.len;
+}
+
+static size_t to_utf32(cook_string_view_t sv) {
+    cook_sb_reset(&out);
+    cook_sb_append_utf32(&out, sv);
+    return out.len;
+}
+
+// text made of words drawn from @words, separated by spaces
+static cook_string_view_t make_text(const char **words, size_t count) {
+    char *text = malloc(TEXT_SIZE);
+    uint64_t rng = count;
+    size_t len = 0;
+    for (;;) {
+        const char *word = words[bench_rand(&rng) % count];
+        size_t n = strlen(word);
+        if (len + n + 1 > TEXT_SIZE) break;
+        memcpy(text + len, word, n);
+        len += n;
+        text[len++] = ' ';
+    }
+    return cook_sv_from_parts(text, len);
+}
+
+static void run(const char *name, size_t (*fn)(cook_string_view_t), cook_string_view_t text) {
+    double best = 1e9;
+    size_t result = 0;
+    for (int r = 0; r < RUNS; r++) {
+        double start = bench_now();
+        result = fn(text);
+        double secs = bench_now() - start;
+        if (secs < best) best = secs;
+    }
+    bench_sink(result);
+    printf("%-40s %10.2f GB/s\n", name, (double)text.len/best/1e9);
+}
+
+int main(void)
+{
+    cook_string_view_t word = cook_sv_from_cstr("na\xc3\xafve \xe6\x97\xa5\xe6\x9c\xac \xf0\x9f\x8d\xa3");
+    printf("%zu bytes, %zu codepoints, valid: %d, truncated valid up to: %zu\n", word.len,
+           cook_utf8_count(word), cook_utf8_valid(word), cook_utf8_validate(cook_sv_from_parts(word.data, word.len - 1)));
+    uint32_t cp;
+    while (cook_utf8_next(&word, &cp)) printf("U+%04X ", cp);
+    printf("\n");
+
+    const char *ascii[] = {"the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog"};
+    const char *latin[] = {"le", "caf\xc3\xa9", "na\xc3\xafve", "stra\xc3\x9f" "e", "und", "der", "fa\xc3\xa7" "ade", "pi\xc3\xb1" "a"};
+    const char *cjk[] = {"\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e", "\xe4\xb8\xad\xe6\x96\x87", "\xed\x95\x9c\xea\xb5\xad\xec\x96\xb4",
+                         "\xe6\xbc\xa2\xe5\xad\x97"};
+    const char *emoji[] = {"\xf0\x9f\x8d\xa3", "\xf0\x9f\x9a\x80\xf0\x9f\x8c\x8d", "ok", "\xf0\x9f\x91\x8d"};
+    struct {
+        const char *name;
+        cook_string_view_t text;
+    } texts[] = {
+        {"ASCII", make_text(ascii, cook_arr_len(ascii))},
+        {"Latin-1 words", make_text(latin, cook_arr_len(latin))},
+        {"CJK", make_text(cjk, cook_arr_len(cjk))},
+        {"emoji", make_text(emoji, cook_arr_len(emoji))},
+    };
+
+    for (size_t i = 0; i < cook_arr_len(texts); i++) {
+        printf("---------- %s, %zu MB ----------\n", texts[i].name, texts[i].text.len >> 20);
+        run("validate, byte loop", naive_validate, texts[i].text);
+        run("cook_utf8_validate", cook_validate, texts[i].text);
+        run("cook_utf8_count", cook_count, texts[i].text);
+        run("cook_utf8_next loop", iterate, texts[i].text);
+        run("cook_sb_append_utf16", to_utf16, texts[i].text);
+        run("cook_sb_append_utf32", to_utf32, texts[i].text);
+        free((char *)texts[i].text.data);
+    }
+    cook_sb_free(&out);
+    return 0;
+}
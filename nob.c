@@ -13,6 +13,31 @@ static const char *example_src[] = {
     EXAMPLE_FOLDER"cmd.c",
     EXAMPLE_FOLDER"mutest.c",
     EXAMPLE_FOLDER"fs.c",
+    EXAMPLE_FOLDER"pool_allocator.c",
+    EXAMPLE_FOLDER"arena.c",
+    EXAMPLE_FOLDER"alloc_stats.c",
+    EXAMPLE_FOLDER"huge_pages.c",
+    EXAMPLE_FOLDER"sc_allocator.c",
+    EXAMPLE_FOLDER"tlsf.c",
+    EXAMPLE_FOLDER"scratch.c",
+    EXAMPLE_FOLDER"sv_search.c",
+    EXAMPLE_FOLDER"sv_split.c",
+    EXAMPLE_FOLDER"sv_ascii.c",
+    EXAMPLE_FOLDER"parse_numbers.c",
+    EXAMPLE_FOLDER"sv_compare.c",
+    EXAMPLE_FOLDER"sv_sort.c",
+    EXAMPLE_FOLDER"utf8.c",
+    EXAMPLE_FOLDER"multi_match.c",
+    EXAMPLE_FOLDER"lines.c",
+    EXAMPLE_FOLDER"csv.c",
+    EXAMPLE_FOLDER"json.c",
+    EXAMPLE_FOLDER"glob.c",
+    EXAMPLE_FOLDER"regex.c",
+    EXAMPLE_FOLDER"hashed_sv.c",
+    EXAMPLE_FOLDER"sb_format.c",
+    EXAMPLE_FOLDER"format_numbers.c",
+    EXAMPLE_FOLDER"sb_concat.c",
+    EXAMPLE_FOLDER"rope.c",
 };
 
 static const char *example_exe[] = {
@@ -23,6 +48,31 @@ static const char *example_exe[] = {
     EXAMPLE_FOLDER"cmd",
     EXAMPLE_FOLDER"mutest",
     EXAMPLE_FOLDER"fs",
+    EXAMPLE_FOLDER"pool_allocator",
+    EXAMPLE_FOLDER"arena",
+    EXAMPLE_FOLDER"alloc_stats",
+    EXAMPLE_FOLDER"huge_pages",
+    EXAMPLE_FOLDER"sc_allocator",
+    EXAMPLE_FOLDER"tlsf",
+    EXAMPLE_FOLDER"scratch",
+    EXAMPLE_FOLDER"sv_search",
+    EXAMPLE_FOLDER"sv_split",
+    EXAMPLE_FOLDER"sv_ascii",
+    EXAMPLE_FOLDER"parse_numbers",
+    EXAMPLE_FOLDER"sv_compare",
+    EXAMPLE_FOLDER"sv_sort",
+    EXAMPLE_FOLDER"utf8",
+    EXAMPLE_FOLDER"multi_match",
+    EXAMPLE_FOLDER"lines",
+    EXAMPLE_FOLDER"csv",
+    EXAMPLE_FOLDER"json",
+    EXAMPLE_FOLDER"glob",
+    EXAMPLE_FOLDER"regex",
+    EXAMPLE_FOLDER"hashed_sv",
+    EXAMPLE_FOLDER"sb_format",
+    EXAMPLE_FOLDER"format_numbers",
+    EXAMPLE_FOLDER"sb_concat",
+    EXAMPLE_FOLDER"rope",
 };
 
 bool clean(void)
@@ -50,8 +100,11 @@ int main(int argc, char **argv)
         cmd_append(&cmd, "-Wall", "-Wextra");
         cmd_append(&cmd, "-std=c99");
         cmd_append(&cmd, "-I./");
-        cmd_append(&cmd, "-ggdb");
+        cmd_append(&cmd, "-ggdb", "-O2");
         cmd_append(&cmd, "-o", example_exe[i], example_src[i]);
+#ifndef _WIN32
+        cmd_append(&cmd, "-pthread");
+#endif
         if (!cmd_run(&cmd)) return 1;
     }
 